@@ -1,6 +1,10 @@
 fn main() {
     // build and link
-    let dst = cmake::Config::new("src").build();
+    let mut config = cmake::Config::new("src");
+    if cfg!(feature = "stats") {
+        config.define("SWIFFT_ENABLE_STATS", "ON");
+    }
+    let dst = config.build();
     println!("cargo:rustc-link-search=native={}", dst.display());
     println!("cargo:rustc-link-lib=static=swifft");
 
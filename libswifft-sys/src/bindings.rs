@@ -101,6 +101,11 @@ pub const MAX_SWIFFT_VECTOR_SIZE: u32 = 32;
 pub const SWIFFT_INPUT_BLOCK_SIZE: u32 = 256;
 pub const SWIFFT_OUTPUT_BLOCK_SIZE: u32 = 128;
 pub const SWIFFT_COMPACT_BLOCK_SIZE: u32 = 64;
+pub const SWIFFT_CHUNK_SIZE: u32 = 8;
+pub const SWIFFT_INPUT_CHUNKS: u32 = 32;
+pub const SWIFFT_SHORT_CHUNKS_MULTIPLE: u32 = 4;
+pub const SWIFFT_PACKED_BLOCK_SIZE: u32 = 512;
+pub const SWIFFT_KEY_ELEMENTS: u32 = 2048;
 pub type __u_char = ::std::os::raw::c_uchar;
 pub type __u_short = ::std::os::raw::c_ushort;
 pub type __u_int = ::std::os::raw::c_uint;
@@ -212,6 +217,1127 @@ pub type uint_fast64_t = ::std::os::raw::c_ulong;
 pub type intmax_t = __intmax_t;
 pub type uintmax_t = __uintmax_t;
 pub type BitSequence = ::std::os::raw::c_uchar;
+#[doc = "! \\brief A SWIFFT key that is ready for use by keyed SWIFFT operations.\n! Initialize it using SWIFFT_InitKey. Use SWIFFT_ALIGN, or an allocator with\n! the same alignment, on each declaration of this data structure."]
+#[repr(C)]
+#[repr(align(64))]
+#[derive(Debug, Copy, Clone)]
+pub struct swifft_key_t {
+    #[doc = "< The key elements, centered and interleaved for the keyed operations"]
+    pub elements: [i16; 2048usize],
+}
+#[test]
+fn bindgen_test_layout_swifft_key_t() {
+    const UNINIT: ::std::mem::MaybeUninit<swifft_key_t> = ::std::mem::MaybeUninit::uninit();
+    let ptr = UNINIT.as_ptr();
+    assert_eq!(
+        ::std::mem::size_of::<swifft_key_t>(),
+        4096usize,
+        concat!("Size of: ", stringify!(swifft_key_t))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<swifft_key_t>(),
+        64usize,
+        concat!("Alignment of ", stringify!(swifft_key_t))
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).elements) as usize - ptr as usize },
+        0usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_key_t),
+            "::",
+            stringify!(elements)
+        )
+    );
+}
+pub const SWIFFT_ACCUMULATOR_HEADROOM: u32 = 126;
+#[doc = "! \\brief An unreduced sum of SWIFFT hash values, for adding up many of them with a single reduction.\n! Initialize it using SWIFFT_AccumulatorInit and reduce it using SWIFFT_Reduce. Use\n! SWIFFT_ALIGN, or an allocator with the same alignment, on each declaration of this data structure."]
+#[repr(C)]
+#[repr(align(64))]
+#[derive(Debug, Copy, Clone)]
+pub struct swifft_accumulator_t {
+    #[doc = "< The unreduced sums of the hash value elements"]
+    pub elements: [i16; 64usize],
+    #[doc = "< The number of hash values added or subtracted since the last fold"]
+    pub pending: ::std::os::raw::c_int,
+}
+#[test]
+fn bindgen_test_layout_swifft_accumulator_t() {
+    const UNINIT: ::std::mem::MaybeUninit<swifft_accumulator_t> = ::std::mem::MaybeUninit::uninit();
+    let ptr = UNINIT.as_ptr();
+    assert_eq!(
+        ::std::mem::size_of::<swifft_accumulator_t>(),
+        192usize,
+        concat!("Size of: ", stringify!(swifft_accumulator_t))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<swifft_accumulator_t>(),
+        64usize,
+        concat!("Alignment of ", stringify!(swifft_accumulator_t))
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).elements) as usize - ptr as usize },
+        0usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_accumulator_t),
+            "::",
+            stringify!(elements)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).pending) as usize - ptr as usize },
+        128usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_accumulator_t),
+            "::",
+            stringify!(pending)
+        )
+    );
+}
+pub const SWIFFT_EVAL_MAX_STACK: u32 = 8;
+#[doc = "< Pushes the hash value of the block in the operand array with index arg"]
+pub const swifft_opcode_t_SWIFFT_OP_LOAD: swifft_opcode_t = 0;
+#[doc = "< Pushes a hash value with each element equal to arg, mod 257"]
+pub const swifft_opcode_t_SWIFFT_OP_CONST: swifft_opcode_t = 1;
+#[doc = "< Pops b, pops a, and pushes a + b, element-wise"]
+pub const swifft_opcode_t_SWIFFT_OP_ADD: swifft_opcode_t = 2;
+#[doc = "< Pops b, pops a, and pushes a - b, element-wise"]
+pub const swifft_opcode_t_SWIFFT_OP_SUB: swifft_opcode_t = 3;
+#[doc = "< Pops b, pops a, and pushes a * b, element-wise"]
+pub const swifft_opcode_t_SWIFFT_OP_MUL: swifft_opcode_t = 4;
+#[doc = "! \\brief The operation codes of a program of SWIFFT_EvalMultiple."]
+pub type swifft_opcode_t = ::std::os::raw::c_uint;
+#[doc = "! \\brief An operation of a program of SWIFFT_EvalMultiple, which runs on a stack of hash values."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct swifft_op_t {
+    #[doc = "< The operation code, a swifft_opcode_t"]
+    pub opcode: i16,
+    #[doc = "< The argument of the operation, if any"]
+    pub arg: i16,
+}
+#[test]
+fn bindgen_test_layout_swifft_op_t() {
+    const UNINIT: ::std::mem::MaybeUninit<swifft_op_t> = ::std::mem::MaybeUninit::uninit();
+    let ptr = UNINIT.as_ptr();
+    assert_eq!(
+        ::std::mem::size_of::<swifft_op_t>(),
+        4usize,
+        concat!("Size of: ", stringify!(swifft_op_t))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<swifft_op_t>(),
+        2usize,
+        concat!("Alignment of ", stringify!(swifft_op_t))
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).opcode) as usize - ptr as usize },
+        0usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_op_t),
+            "::",
+            stringify!(opcode)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).arg) as usize - ptr as usize },
+        2usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_op_t),
+            "::",
+            stringify!(arg)
+        )
+    );
+}
+pub const SWIFFT_ARENA_SIZE: u32 = 2097152;
+#[doc = "! \\brief The statistics of a block pool."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct swifft_block_pool_stats_t {
+    #[doc = "< The number of mappings, of arenas and of arrays larger than an arena"]
+    pub mappings: usize,
+    #[doc = "< The number of mappings on explicit huge pages, the others relying on transparent ones"]
+    pub hugetlb: usize,
+    #[doc = "< The number of bytes mapped"]
+    pub mappedBytes: usize,
+    #[doc = "< The number of bytes of arrays given out and not yet freed, rounded up to their size classes"]
+    pub usedBytes: usize,
+    #[doc = "< The number of arrays given out"]
+    pub allocs: usize,
+    #[doc = "< The number of arrays given out that were recycled"]
+    pub reuses: usize,
+}
+#[test]
+fn bindgen_test_layout_swifft_block_pool_stats_t() {
+    const UNINIT: ::std::mem::MaybeUninit<swifft_block_pool_stats_t> = ::std::mem::MaybeUninit::uninit();
+    let ptr = UNINIT.as_ptr();
+    assert_eq!(
+        ::std::mem::size_of::<swifft_block_pool_stats_t>(),
+        48usize,
+        concat!("Size of: ", stringify!(swifft_block_pool_stats_t))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<swifft_block_pool_stats_t>(),
+        8usize,
+        concat!("Alignment of ", stringify!(swifft_block_pool_stats_t))
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).mappings) as usize - ptr as usize },
+        0usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_block_pool_stats_t),
+            "::",
+            stringify!(mappings)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).hugetlb) as usize - ptr as usize },
+        8usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_block_pool_stats_t),
+            "::",
+            stringify!(hugetlb)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).mappedBytes) as usize - ptr as usize },
+        16usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_block_pool_stats_t),
+            "::",
+            stringify!(mappedBytes)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).usedBytes) as usize - ptr as usize },
+        24usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_block_pool_stats_t),
+            "::",
+            stringify!(usedBytes)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).allocs) as usize - ptr as usize },
+        32usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_block_pool_stats_t),
+            "::",
+            stringify!(allocs)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).reuses) as usize - ptr as usize },
+        40usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_block_pool_stats_t),
+            "::",
+            stringify!(reuses)
+        )
+    );
+}
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct swifft_block_pool_s {
+    _unused: [u8; 0],
+}
+#[doc = "! \\brief A pool of arrays of blocks, opaque to the caller."]
+pub type swifft_block_pool_t = swifft_block_pool_s;
+extern "C" {
+    #[doc = "! \\brief Allocates a zero-initialized array of blocks, aligned to SWIFFT_ALIGNMENT.\n! An array of SWIFFT_ARENA_SIZE bytes or more is mapped on huge pages where available.\n!\n! \\param[in] nblocks the number of blocks.\n! \\param[in] blockSize the size of a block, such as SWIFFT_INPUT_BLOCK_SIZE.\n! \\returns the array, to free using SWIFFT_FreeBlocks, or NULL if memory is exhausted."]
+    pub fn SWIFFT_AllocBlocks(nblocks: usize, blockSize: usize) -> *mut ::std::os::raw::c_void;
+}
+extern "C" {
+    #[doc = "! \\brief Frees an array of blocks allocated by SWIFFT_AllocBlocks.\n!\n! \\param[in] blocks the array, or NULL."]
+    pub fn SWIFFT_FreeBlocks(blocks: *mut ::std::os::raw::c_void);
+}
+extern "C" {
+    #[doc = "! \\brief Creates a block pool, with no arenas until arrays are allocated from it.\n!\n! \\param[in] node the NUMA node whose memory the arenas prefer, or -1 for none.\n! \\returns the block pool, or NULL if memory is exhausted."]
+    pub fn SWIFFT_BlockPoolCreate(node: ::std::os::raw::c_int) -> *mut swifft_block_pool_t;
+}
+extern "C" {
+    #[doc = "! \\brief Allocates an array of blocks from a block pool, aligned to SWIFFT_ALIGNMENT.\n! It is zero-initialized when new, and holds what its previous user left in it when recycled.\n! Safe to call concurrently with other calls on the block pool, except for destroying it.\n!\n! \\param[in,out] pool the block pool.\n! \\param[in] nblocks the number of blocks.\n! \\param[in] blockSize the size of a block, such as SWIFFT_INPUT_BLOCK_SIZE.\n! \\returns the array, to free using SWIFFT_BlockPoolFree, or NULL if memory is exhausted."]
+    pub fn SWIFFT_BlockPoolAlloc(
+        pool: *mut swifft_block_pool_t,
+        nblocks: usize,
+        blockSize: usize,
+    ) -> *mut ::std::os::raw::c_void;
+}
+extern "C" {
+    #[doc = "! \\brief Returns an array of blocks to the block pool it was allocated from, for reuse.\n! Safe to call concurrently with other calls on the block pool, except for destroying it.\n!\n! \\param[in,out] pool the block pool.\n! \\param[in] blocks the array, or NULL."]
+    pub fn SWIFFT_BlockPoolFree(
+        pool: *mut swifft_block_pool_t,
+        blocks: *mut ::std::os::raw::c_void,
+    );
+}
+extern "C" {
+    #[doc = "! \\brief Returns the statistics of a block pool.\n!\n! \\param[in] pool the block pool.\n! \\param[out] stats the statistics."]
+    pub fn SWIFFT_BlockPoolGetStats(
+        pool: *mut swifft_block_pool_t,
+        stats: *mut swifft_block_pool_stats_t,
+    );
+}
+extern "C" {
+    #[doc = "! \\brief Destroys a block pool, unmapping its memory, including that of arrays not yet freed.\n!\n! \\param[in] pool the block pool, or NULL."]
+    pub fn SWIFFT_BlockPoolDestroy(pool: *mut swifft_block_pool_t);
+}
+pub const SWIFFT_INDEX_GROUP_SLOTS: u32 = 16;
+pub const SWIFFT_INDEX_NOT_FOUND: u64 = 18446744073709551615;
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct swifft_index_s {
+    _unused: [u8; 0],
+}
+#[doc = "! \\brief An index of compact SWIFFT digests, opaque to the caller."]
+pub type swifft_index_t = swifft_index_s;
+extern "C" {
+    #[doc = "! \\brief Creates an empty index in memory, on huge pages where available.\n!\n! \\param[in] maxEntries the number of entries the index can hold.\n! \\returns the index, or NULL if memory is exhausted."]
+    pub fn SWIFFT_IndexCreate(maxEntries: usize) -> *mut swifft_index_t;
+}
+extern "C" {
+    #[doc = "! \\brief Creates an empty index mapped from a file, which is created or truncated.\n!\n! \\param[in] path the path of the file.\n! \\param[in] maxEntries the number of entries the index can hold.\n! \\returns the index, or NULL if the file cannot be created or mapped, with errno set."]
+    pub fn SWIFFT_IndexCreateFile(
+        path: *const ::std::os::raw::c_char,
+        maxEntries: usize,
+    ) -> *mut swifft_index_t;
+}
+extern "C" {
+    #[doc = "! \\brief Opens an index mapped from a file created by SWIFFT_IndexCreateFile.\n! The index is used in place, without rebuilding it.\n!\n! \\param[in] path the path of the file.\n! \\param[in] writable whether to allow inserting into the index.\n! \\returns the index, or NULL if the file cannot be opened or mapped, with errno set,\n! e.g. to EINVAL if it is not an index in the format of the host."]
+    pub fn SWIFFT_IndexOpenFile(
+        path: *const ::std::os::raw::c_char,
+        writable: ::std::os::raw::c_int,
+    ) -> *mut swifft_index_t;
+}
+extern "C" {
+    #[doc = "! \\brief Inserts multiple compact digests into an index, each unless it is already there.\n! A digest repeated within the batch is inserted once, with the value of its first occurrence.\n!\n! \\param[in,out] index the index.\n! \\param[in] nblocks the number of digests.\n! \\param[in] compact the compact digests, each of 64 bytes (512 bit).\n! \\param[in] values the values of the digests, other than SWIFFT_INDEX_NOT_FOUND.\n! \\param[out] stored the values that the index holds for the digests, which equal their\n! values for the digests inserted and are those inserted before for the others, or NULL.\n! \\returns 0 on success, or -1 if the index is full or not writable, in which case only the\n! digests before the first that did not fit are inserted and have their stored values given."]
+    pub fn SWIFFT_IndexInsertMultiple(
+        index: *mut swifft_index_t,
+        nblocks: usize,
+        compact: *const BitSequence,
+        values: *const u64,
+        stored: *mut u64,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = "! \\brief Computes the compact digests of multiple blocks of input and inserts them into an index,\n! as SWIFFT_ComputeCompactMultiple does followed by SWIFFT_IndexInsertMultiple, tile by tile\n! so that the digests are inserted while they are in cache.\n!\n! \\param[in,out] index the index.\n! \\param[in] nblocks the number of blocks of input.\n! \\param[in] input the blocks of input, each of 256 bytes (2048 bit).\n! \\param[out] compact the resulting compact digests, each of 64 bytes (512 bit), or NULL if they are not needed.\n! \\param[in] values the values of the digests, other than SWIFFT_INDEX_NOT_FOUND.\n! \\param[out] stored the values that the index holds for the digests, as given by SWIFFT_IndexInsertMultiple, or NULL.\n! \\returns 0 on success, or -1 if the index is full or not writable, or if memory is exhausted."]
+    pub fn SWIFFT_IndexComputeInsertMultiple(
+        index: *mut swifft_index_t,
+        nblocks: usize,
+        input: *const BitSequence,
+        compact: *mut BitSequence,
+        values: *const u64,
+        stored: *mut u64,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = "! \\brief Looks up multiple compact digests in an index.\n!\n! \\param[in] index the index.\n! \\param[in] nblocks the number of digests.\n! \\param[in] compact the compact digests, each of 64 bytes (512 bit).\n! \\param[out] values the values of the digests, or SWIFFT_INDEX_NOT_FOUND for those not in the index."]
+    pub fn SWIFFT_IndexLookupMultiple(
+        index: *const swifft_index_t,
+        nblocks: usize,
+        compact: *const BitSequence,
+        values: *mut u64,
+    );
+}
+extern "C" {
+    #[doc = "! \\brief Returns the number of entries of an index.\n!\n! \\param[in] index the index.\n! \\returns the number of entries."]
+    pub fn SWIFFT_IndexCount(index: *const swifft_index_t) -> usize;
+}
+extern "C" {
+    #[doc = "! \\brief Returns the number of entries an index can hold.\n!\n! \\param[in] index the index.\n! \\returns the number of entries the index can hold."]
+    pub fn SWIFFT_IndexMaxEntries(index: *const swifft_index_t) -> usize;
+}
+extern "C" {
+    #[doc = "! \\brief Writes an index mapped from a file back to the file, waiting for the writes to complete.\n!\n! \\param[in] index the index.\n! \\returns 0 on success, or -1 on an error, with errno set. An index in memory always succeeds."]
+    pub fn SWIFFT_IndexSync(index: *mut swifft_index_t) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = "! \\brief Destroys an index, unmapping it. An index mapped from a file stays in the file,\n! which is written back by the system unless SWIFFT_IndexSync is called to do so before.\n!\n! \\param[in] index the index, or NULL."]
+    pub fn SWIFFT_IndexDestroy(index: *mut swifft_index_t);
+}
+#[doc = "! \\brief A function running a task on a range of its blocks.\n!\n! \\param[in] task the task.\n! \\param[in] begin the index of the first block of the range.\n! \\param[in] end the index past the last block of the range."]
+pub type swifft_task_fn = ::std::option::Option<
+    unsafe extern "C" fn(
+        task: *mut ::std::os::raw::c_void,
+        begin: usize,
+        end: usize,
+    ),
+>;
+pub const swifft_op_class_t_SWIFFT_OP_ARITH: swifft_op_class_t = 0;
+pub const swifft_op_class_t_SWIFFT_OP_COMPACT: swifft_op_class_t = 1;
+pub const swifft_op_class_t_SWIFFT_OP_FFT: swifft_op_class_t = 2;
+pub const swifft_op_class_t_SWIFFT_OP_HASH: swifft_op_class_t = 3;
+pub const swifft_op_class_t_SWIFFT_OP_CLASSES: swifft_op_class_t = 4;
+#[doc = "! \\brief The classes of operations on multiple blocks, by their cost per block."]
+pub type swifft_op_class_t = ::std::os::raw::c_uint;
+#[doc = "! \\brief A function running a task on all its blocks, e.g. using a caller-owned pool of threads.\n! It must call taskfn on disjoint ranges, each of at most grain blocks, covering\n! all blocks, and return only after all of these calls returned.\n!\n! \\param[in] context the context given to SWIFFT_SetExecutor.\n! \\param[in] taskfn the function running the task on a range of blocks.\n! \\param[in] task the task.\n! \\param[in] nblocks the number of blocks of the task.\n! \\param[in] grain the maximum number of blocks per range."]
+pub type swifft_executor_fn = ::std::option::Option<
+    unsafe extern "C" fn(
+        context: *mut ::std::os::raw::c_void,
+        taskfn: swifft_task_fn,
+        task: *mut ::std::os::raw::c_void,
+        nblocks: usize,
+        grain: ::std::os::raw::c_int,
+    ),
+>;
+extern "C" {
+    #[doc = "! \\brief Sets the number of threads of the native pool, including the calling thread.\n! Waits for running operations to complete. One thread, the default, disables the pool.\n! The pool is unavailable, and this has no effect, when the library was built without it.\n!\n! \\param[in] nthreads the number of threads, or 0 for the number of online processors."]
+    pub fn SWIFFT_SetThreads(nthreads: ::std::os::raw::c_int);
+}
+extern "C" {
+    #[doc = "! \\brief Returns the number of threads of the native pool, including the calling thread.\n!\n! \\returns the number of threads."]
+    pub fn SWIFFT_GetThreads() -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = "! \\brief Sets the maximum number of blocks per range that a thread runs at once.\n!\n! \\param[in] grain the number of blocks, or 0 for the default."]
+    pub fn SWIFFT_SetGrain(grain: ::std::os::raw::c_int);
+}
+extern "C" {
+    #[doc = "! \\brief Returns the maximum number of blocks per range that a thread runs at once.\n!\n! \\returns the number of blocks."]
+    pub fn SWIFFT_GetGrain() -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = "! \\brief Sets the maximum number of blocks that operations of a class run on the calling thread alone.\n!\n! \\param[in] op the class of operations, a swifft_op_class_t.\n! \\param[in] threshold the number of blocks, or SIZE_MAX for always running on the calling thread alone."]
+    pub fn SWIFFT_SetOpThreshold(op: ::std::os::raw::c_int, threshold: usize);
+}
+extern "C" {
+    #[doc = "! \\brief Returns the maximum number of blocks that operations of a class run on the calling thread alone.\n!\n! \\param[in] op the class of operations, a swifft_op_class_t.\n! \\returns the number of blocks, SWIFFT_BLOCKS_PARALLELIZATION_THRESHOLD unless set."]
+    pub fn SWIFFT_GetOpThreshold(op: ::std::os::raw::c_int) -> usize;
+}
+extern "C" {
+    #[doc = "! \\brief Sets the maximum number of blocks per range that a thread runs at once, for operations of a class.\n!\n! \\param[in] op the class of operations, a swifft_op_class_t.\n! \\param[in] grain the number of blocks, or 0 for the one of SWIFFT_GetGrain."]
+    pub fn SWIFFT_SetOpGrain(op: ::std::os::raw::c_int, grain: ::std::os::raw::c_int);
+}
+extern "C" {
+    #[doc = "! \\brief Returns the maximum number of blocks per range that a thread runs at once, for operations of a class.\n!\n! \\param[in] op the class of operations, a swifft_op_class_t.\n! \\returns the number of blocks."]
+    pub fn SWIFFT_GetOpGrain(op: ::std::os::raw::c_int) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = "! \\brief Sets an executor to run operations on multiple blocks, instead of the native pool.\n! Call it while no operations on multiple blocks run.\n!\n! \\param[in] executor the executor, or NULL to restore the native pool.\n! \\param[in] context the context to pass to the executor."]
+    pub fn SWIFFT_SetExecutor(
+        executor: swifft_executor_fn,
+        context: *mut ::std::os::raw::c_void,
+    );
+}
+extern "C" {
+    #[doc = "! \\brief Runs a task on all its blocks, in parallel as configured.\n!\n! \\param[in] nblocks the number of blocks of the task.\n! \\param[in] taskfn the function running the task on a range of blocks.\n! \\param[in] task the task."]
+    pub fn SWIFFT_ParallelFor(
+        nblocks: usize,
+        taskfn: swifft_task_fn,
+        task: *mut ::std::os::raw::c_void,
+    );
+}
+extern "C" {
+    #[doc = "! \\brief Runs a task on all its blocks, in parallel as configured, in ranges that start at multiples of some blocks.\n! With a number of blocks spanning whole pages, no two threads write the same page, and\n! the native pool and OpenMP deal out the same run of ranges to each thread for the same\n! number of blocks and threads, so pages first touched by a thread stay local to its node.\n!\n! \\param[in] nblocks the number of blocks of the task.\n! \\param[in] align the power of 2 that the first block of each range is a multiple of.\n! \\param[in] taskfn the function running the task on a range of blocks.\n! \\param[in] task the task."]
+    pub fn SWIFFT_ParallelForAligned(
+        nblocks: usize,
+        align: ::std::os::raw::c_int,
+        taskfn: swifft_task_fn,
+        task: *mut ::std::os::raw::c_void,
+    );
+}
+extern "C" {
+    #[doc = "! \\brief Runs a task of a class of operations on all its blocks, in parallel as configured for the class.\n!\n! \\param[in] nblocks the number of blocks of the task.\n! \\param[in] op the class of operations of the task, a swifft_op_class_t.\n! \\param[in] taskfn the function running the task on a range of blocks.\n! \\param[in] task the task."]
+    pub fn SWIFFT_ParallelForOp(
+        nblocks: usize,
+        op: ::std::os::raw::c_int,
+        taskfn: swifft_task_fn,
+        task: *mut ::std::os::raw::c_void,
+    );
+}
+extern "C" {
+    #[doc = "! \\brief Runs a task of a class of operations on all its blocks, in parallel as configured for the class,\n! in ranges that start at multiples of some blocks, as SWIFFT_ParallelForAligned does.\n!\n! \\param[in] nblocks the number of blocks of the task.\n! \\param[in] op the class of operations of the task, a swifft_op_class_t.\n! \\param[in] align the power of 2 that the first block of each range is a multiple of.\n! \\param[in] taskfn the function running the task on a range of blocks.\n! \\param[in] task the task."]
+    pub fn SWIFFT_ParallelForAlignedOp(
+        nblocks: usize,
+        op: ::std::os::raw::c_int,
+        align: ::std::os::raw::c_int,
+        taskfn: swifft_task_fn,
+        task: *mut ::std::os::raw::c_void,
+    );
+}
+pub type wchar_t = ::std::os::raw::c_int;
+#[repr(C)]
+#[repr(align(16))]
+#[derive(Debug, Copy, Clone)]
+pub struct max_align_t {
+    pub __clang_max_align_nonce1: ::std::os::raw::c_longlong,
+    pub __bindgen_padding_0: u64,
+    pub __clang_max_align_nonce2: u128,
+}
+#[test]
+fn bindgen_test_layout_max_align_t() {
+    const UNINIT: ::std::mem::MaybeUninit<max_align_t> = ::std::mem::MaybeUninit::uninit();
+    let ptr = UNINIT.as_ptr();
+    assert_eq!(
+        ::std::mem::size_of::<max_align_t>(),
+        32usize,
+        concat!("Size of: ", stringify!(max_align_t))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<max_align_t>(),
+        16usize,
+        concat!("Alignment of ", stringify!(max_align_t))
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).__clang_max_align_nonce1) as usize - ptr as usize },
+        0usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(max_align_t),
+            "::",
+            stringify!(__clang_max_align_nonce1)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).__clang_max_align_nonce2) as usize - ptr as usize },
+        16usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(max_align_t),
+            "::",
+            stringify!(__clang_max_align_nonce2)
+        )
+    );
+}
+#[doc = "< SWIFFT_ComputeMultiple, or SWIFFT_ComputeMultipleSigned given sign bits"]
+pub const swifft_request_op_t_SWIFFT_REQUEST_COMPUTE: swifft_request_op_t = 0;
+#[doc = "< SWIFFT_ComputeCompactMultiple"]
+pub const swifft_request_op_t_SWIFFT_REQUEST_COMPUTE_COMPACT: swifft_request_op_t = 1;
+#[doc = "< SWIFFT_ComputeMultipleSignedPacked"]
+pub const swifft_request_op_t_SWIFFT_REQUEST_COMPUTE_SIGNED_PACKED: swifft_request_op_t = 2;
+#[doc = "< SWIFFT_CompactMultiple, whose input is the blocks of hash values"]
+pub const swifft_request_op_t_SWIFFT_REQUEST_COMPACT: swifft_request_op_t = 3;
+#[doc = "< The number of operations"]
+pub const swifft_request_op_t_SWIFFT_REQUEST_OPS: swifft_request_op_t = 4;
+#[doc = "! \\brief The operations of requests of a queue."]
+pub type swifft_request_op_t = ::std::os::raw::c_uint;
+#[doc = "! \\brief A request of a queue, an operation on multiple blocks."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct swifft_request_t {
+    #[doc = "< The operation, a swifft_request_op_t"]
+    pub op: ::std::os::raw::c_int,
+    #[doc = "< The number of blocks to operate on"]
+    pub nblocks: usize,
+    #[doc = "< The blocks of input of the operation"]
+    pub input: *const BitSequence,
+    #[doc = "< The blocks of sign bits corresponding to the blocks of input, or NULL for unsigned input"]
+    pub sign: *const BitSequence,
+    #[doc = "< The resulting blocks of the operation"]
+    pub output: *mut BitSequence,
+    #[doc = "< Any data of the caller, returned with the completion"]
+    pub userData: *mut ::std::os::raw::c_void,
+}
+#[test]
+fn bindgen_test_layout_swifft_request_t() {
+    const UNINIT: ::std::mem::MaybeUninit<swifft_request_t> = ::std::mem::MaybeUninit::uninit();
+    let ptr = UNINIT.as_ptr();
+    assert_eq!(
+        ::std::mem::size_of::<swifft_request_t>(),
+        48usize,
+        concat!("Size of: ", stringify!(swifft_request_t))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<swifft_request_t>(),
+        8usize,
+        concat!("Alignment of ", stringify!(swifft_request_t))
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).op) as usize - ptr as usize },
+        0usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_request_t),
+            "::",
+            stringify!(op)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).nblocks) as usize - ptr as usize },
+        8usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_request_t),
+            "::",
+            stringify!(nblocks)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).input) as usize - ptr as usize },
+        16usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_request_t),
+            "::",
+            stringify!(input)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).sign) as usize - ptr as usize },
+        24usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_request_t),
+            "::",
+            stringify!(sign)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).output) as usize - ptr as usize },
+        32usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_request_t),
+            "::",
+            stringify!(output)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).userData) as usize - ptr as usize },
+        40usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_request_t),
+            "::",
+            stringify!(userData)
+        )
+    );
+}
+#[doc = "! \\brief A function called on a worker thread when a request of a queue completes.\n! The request no longer counts toward the depth of the queue, so the function may submit another.\n!\n! \\param[in] context the context given to SWIFFT_QueueCreate.\n! \\param[in] request the completed request."]
+pub type swifft_completion_fn = ::std::option::Option<
+    unsafe extern "C" fn(context: *mut ::std::os::raw::c_void, request: *const swifft_request_t),
+>;
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct swifft_queue_s {
+    _unused: [u8; 0],
+}
+#[doc = "! \\brief A queue of requests, opaque to the caller."]
+pub type swifft_queue_t = swifft_queue_s;
+extern "C" {
+    #[doc = "! \\brief Creates a queue and its worker threads.\n!\n! \\param[in] nworkers the number of worker threads, or 0 for the number of online processors.\n! \\param[in] depth the maximum number of requests submitted and not yet delivered, at least 1.\n! \\param[in] callback the function called when a request completes, or NULL for delivering completions to the completion ring.\n! \\param[in] context the context to pass to the callback.\n! \\returns the queue, or NULL if the parameters are invalid or resources are exhausted."]
+    pub fn SWIFFT_QueueCreate(
+        nworkers: ::std::os::raw::c_int,
+        depth: ::std::os::raw::c_int,
+        callback: swifft_completion_fn,
+        context: *mut ::std::os::raw::c_void,
+    ) -> *mut swifft_queue_t;
+}
+extern "C" {
+    #[doc = "! \\brief Submits a request to a queue, without waiting for it to run.\n!\n! \\param[in] queue the queue.\n! \\param[in] request the request, copied by the queue.\n! \\returns 0 on success, or -1 if the queue is full or the request is invalid."]
+    pub fn SWIFFT_QueueSubmit(
+        queue: *mut swifft_queue_t,
+        request: *const swifft_request_t,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = "! \\brief Takes completed requests from the completion ring of a queue, without waiting.\n!\n! \\param[in] queue the queue.\n! \\param[out] completions the completed requests, in the order they completed.\n! \\param[in] max the maximum number of completed requests to take.\n! \\returns the number of completed requests taken."]
+    pub fn SWIFFT_QueuePoll(
+        queue: *mut swifft_queue_t,
+        completions: *mut swifft_request_t,
+        max: ::std::os::raw::c_int,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = "! \\brief Takes a completed request from the completion ring of a queue, waiting for one if none is there.\n!\n! \\param[in] queue the queue.\n! \\param[out] completion the completed request.\n! \\returns 0 on success, or -1 if no request is in flight to wait for, or the queue has a callback."]
+    pub fn SWIFFT_QueueWait(
+        queue: *mut swifft_queue_t,
+        completion: *mut swifft_request_t,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = "! \\brief Returns a file descriptor readable while the completion ring of a queue is not empty.\n! It is owned by the queue, and the caller only polls it, e.g. using poll or epoll.\n!\n! \\param[in] queue the queue.\n! \\returns the file descriptor, or -1 if unavailable, e.g. off Linux or with a callback."]
+    pub fn SWIFFT_QueueFd(queue: *const swifft_queue_t) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = "! \\brief Waits until all requests submitted to a queue have completed.\n! Completions entering the completion ring stay there.\n!\n! \\param[in] queue the queue."]
+    pub fn SWIFFT_QueueDrain(queue: *mut swifft_queue_t);
+}
+extern "C" {
+    #[doc = "! \\brief Destroys a queue, after waiting until all requests submitted to it have completed.\n! Completions not taken from the completion ring are discarded.\n!\n! \\param[in] queue the queue, or NULL."]
+    pub fn SWIFFT_QueueDestroy(queue: *mut swifft_queue_t);
+}
+pub const SWIFFT_STATS_MAX_THREADS: u32 = 256;
+pub const swifft_stats_entry_t_SWIFFT_STATS_FFT: swifft_stats_entry_t = 0;
+pub const swifft_stats_entry_t_SWIFFT_STATS_FFTSUM: swifft_stats_entry_t = 1;
+pub const swifft_stats_entry_t_SWIFFT_STATS_COMPACT: swifft_stats_entry_t = 2;
+pub const swifft_stats_entry_t_SWIFFT_STATS_CONST_SET: swifft_stats_entry_t = 3;
+pub const swifft_stats_entry_t_SWIFFT_STATS_CONST_ADD: swifft_stats_entry_t = 4;
+pub const swifft_stats_entry_t_SWIFFT_STATS_CONST_SUB: swifft_stats_entry_t = 5;
+pub const swifft_stats_entry_t_SWIFFT_STATS_CONST_MUL: swifft_stats_entry_t = 6;
+pub const swifft_stats_entry_t_SWIFFT_STATS_SET: swifft_stats_entry_t = 7;
+pub const swifft_stats_entry_t_SWIFFT_STATS_ADD: swifft_stats_entry_t = 8;
+pub const swifft_stats_entry_t_SWIFFT_STATS_SUB: swifft_stats_entry_t = 9;
+pub const swifft_stats_entry_t_SWIFFT_STATS_MUL: swifft_stats_entry_t = 10;
+pub const swifft_stats_entry_t_SWIFFT_STATS_ACCUMULATOR_INIT: swifft_stats_entry_t = 11;
+pub const swifft_stats_entry_t_SWIFFT_STATS_ACCUMULATOR_ADD: swifft_stats_entry_t = 12;
+pub const swifft_stats_entry_t_SWIFFT_STATS_ACCUMULATOR_SUB: swifft_stats_entry_t = 13;
+pub const swifft_stats_entry_t_SWIFFT_STATS_REDUCE: swifft_stats_entry_t = 14;
+pub const swifft_stats_entry_t_SWIFFT_STATS_COMPUTE: swifft_stats_entry_t = 15;
+pub const swifft_stats_entry_t_SWIFFT_STATS_COMPUTE_SIGNED: swifft_stats_entry_t = 16;
+pub const swifft_stats_entry_t_SWIFFT_STATS_FFT_MULTIPLE: swifft_stats_entry_t = 17;
+pub const swifft_stats_entry_t_SWIFFT_STATS_FFTSUM_MULTIPLE: swifft_stats_entry_t = 18;
+pub const swifft_stats_entry_t_SWIFFT_STATS_COMPACT_MULTIPLE: swifft_stats_entry_t = 19;
+pub const swifft_stats_entry_t_SWIFFT_STATS_CONST_SET_MULTIPLE: swifft_stats_entry_t = 20;
+pub const swifft_stats_entry_t_SWIFFT_STATS_CONST_ADD_MULTIPLE: swifft_stats_entry_t = 21;
+pub const swifft_stats_entry_t_SWIFFT_STATS_CONST_SUB_MULTIPLE: swifft_stats_entry_t = 22;
+pub const swifft_stats_entry_t_SWIFFT_STATS_CONST_MUL_MULTIPLE: swifft_stats_entry_t = 23;
+pub const swifft_stats_entry_t_SWIFFT_STATS_SET_MULTIPLE: swifft_stats_entry_t = 24;
+pub const swifft_stats_entry_t_SWIFFT_STATS_ADD_MULTIPLE: swifft_stats_entry_t = 25;
+pub const swifft_stats_entry_t_SWIFFT_STATS_SUB_MULTIPLE: swifft_stats_entry_t = 26;
+pub const swifft_stats_entry_t_SWIFFT_STATS_MUL_MULTIPLE: swifft_stats_entry_t = 27;
+pub const swifft_stats_entry_t_SWIFFT_STATS_SUM_MULTIPLE: swifft_stats_entry_t = 28;
+pub const swifft_stats_entry_t_SWIFFT_STATS_LINEAR_COMBINATION: swifft_stats_entry_t = 29;
+pub const swifft_stats_entry_t_SWIFFT_STATS_EVAL_MULTIPLE: swifft_stats_entry_t = 30;
+pub const swifft_stats_entry_t_SWIFFT_STATS_COMPUTE_MULTIPLE: swifft_stats_entry_t = 31;
+pub const swifft_stats_entry_t_SWIFFT_STATS_COMPUTE_MULTIPLE_SIGNED: swifft_stats_entry_t = 32;
+pub const swifft_stats_entry_t_SWIFFT_STATS_COMPUTE_COMPACT_MULTIPLE: swifft_stats_entry_t = 33;
+pub const swifft_stats_entry_t_SWIFFT_STATS_UPDATE: swifft_stats_entry_t = 34;
+pub const swifft_stats_entry_t_SWIFFT_STATS_UPDATE_MULTIPLE: swifft_stats_entry_t = 35;
+pub const swifft_stats_entry_t_SWIFFT_STATS_COMPUTE_KEYED: swifft_stats_entry_t = 36;
+pub const swifft_stats_entry_t_SWIFFT_STATS_COMPUTE_SIGNED_KEYED: swifft_stats_entry_t = 37;
+pub const swifft_stats_entry_t_SWIFFT_STATS_COMPUTE_MULTIPLE_KEYED: swifft_stats_entry_t = 38;
+pub const swifft_stats_entry_t_SWIFFT_STATS_COMPUTE_MULTIPLE_SIGNED_KEYED: swifft_stats_entry_t = 39;
+pub const swifft_stats_entry_t_SWIFFT_STATS_COMPUTE_SIGNED_PACKED: swifft_stats_entry_t = 40;
+pub const swifft_stats_entry_t_SWIFFT_STATS_COMPUTE_MULTIPLE_SIGNED_PACKED: swifft_stats_entry_t = 41;
+pub const swifft_stats_entry_t_SWIFFT_STATS_COMPUTE_MULTI_KEY: swifft_stats_entry_t = 42;
+pub const swifft_stats_entry_t_SWIFFT_STATS_COMPUTE_SHORT: swifft_stats_entry_t = 43;
+pub const swifft_stats_entry_t_SWIFFT_STATS_COMPUTE_SIGNED_SHORT: swifft_stats_entry_t = 44;
+pub const swifft_stats_entry_t_SWIFFT_STATS_COMPUTE_MULTIPLE_SHORT: swifft_stats_entry_t = 45;
+pub const swifft_stats_entry_t_SWIFFT_STATS_COMPUTE_MULTIPLE_SIGNED_SHORT: swifft_stats_entry_t = 46;
+#[doc = "< The number of entry points"]
+pub const swifft_stats_entry_t_SWIFFT_STATS_ENTRIES: swifft_stats_entry_t = 47;
+#[doc = "! \\brief The entry points of the SWIFFT API whose calls are counted."]
+pub type swifft_stats_entry_t = ::std::os::raw::c_uint;
+#[doc = "! \\brief The statistics of an entry point of the SWIFFT API."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct swifft_entry_stats_t {
+    #[doc = "< The number of calls"]
+    pub calls: u64,
+    #[doc = "< The number of blocks operated on by the calls"]
+    pub blocks: u64,
+    #[doc = "< The wall-clock time spent in the calls"]
+    pub nanoseconds: u64,
+}
+#[test]
+fn bindgen_test_layout_swifft_entry_stats_t() {
+    const UNINIT: ::std::mem::MaybeUninit<swifft_entry_stats_t> = ::std::mem::MaybeUninit::uninit();
+    let ptr = UNINIT.as_ptr();
+    assert_eq!(
+        ::std::mem::size_of::<swifft_entry_stats_t>(),
+        24usize,
+        concat!("Size of: ", stringify!(swifft_entry_stats_t))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<swifft_entry_stats_t>(),
+        8usize,
+        concat!("Alignment of ", stringify!(swifft_entry_stats_t))
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).calls) as usize - ptr as usize },
+        0usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_entry_stats_t),
+            "::",
+            stringify!(calls)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).blocks) as usize - ptr as usize },
+        8usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_entry_stats_t),
+            "::",
+            stringify!(blocks)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).nanoseconds) as usize - ptr as usize },
+        16usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_entry_stats_t),
+            "::",
+            stringify!(nanoseconds)
+        )
+    );
+}
+#[doc = "! \\brief The statistics of the SWIFFT API."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct swifft_stats_t {
+    #[doc = "< Whether statistics are being collected"]
+    pub enabled: ::std::os::raw::c_int,
+    #[doc = "< The name of the instruction set used by the SWIFFT API, such as \"AVX2\""]
+    pub iset: *const ::std::os::raw::c_char,
+    #[doc = "< The statistics per entry point, indexed by swifft_stats_entry_t"]
+    pub entries: [swifft_entry_stats_t; 47usize],
+    #[doc = "< The number of runs of operations on multiple blocks on the calling thread alone"]
+    pub serialRuns: u64,
+    #[doc = "< The number of runs on the executor set by SWIFFT_SetExecutor"]
+    pub executorRuns: u64,
+    #[doc = "< The number of runs on the native pool or OpenMP"]
+    pub parallelRuns: u64,
+    #[doc = "< The wall-clock time of the parallel runs"]
+    pub parallelNanoseconds: u64,
+    #[doc = "< The sum, over the parallel runs, of the busy time of the busiest thread past the mean"]
+    pub imbalanceNanoseconds: u64,
+    #[doc = "< The number of blocks run by each thread of the parallel runs, by thread index"]
+    pub threadBlocks: [u64; 256usize],
+    #[doc = "< The busy time of each thread of the parallel runs, by thread index"]
+    pub threadNanoseconds: [u64; 256usize],
+}
+#[test]
+fn bindgen_test_layout_swifft_stats_t() {
+    const UNINIT: ::std::mem::MaybeUninit<swifft_stats_t> = ::std::mem::MaybeUninit::uninit();
+    let ptr = UNINIT.as_ptr();
+    assert_eq!(
+        ::std::mem::size_of::<swifft_stats_t>(),
+        5280usize,
+        concat!("Size of: ", stringify!(swifft_stats_t))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<swifft_stats_t>(),
+        8usize,
+        concat!("Alignment of ", stringify!(swifft_stats_t))
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).enabled) as usize - ptr as usize },
+        0usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_stats_t),
+            "::",
+            stringify!(enabled)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).iset) as usize - ptr as usize },
+        8usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_stats_t),
+            "::",
+            stringify!(iset)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).entries) as usize - ptr as usize },
+        16usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_stats_t),
+            "::",
+            stringify!(entries)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).serialRuns) as usize - ptr as usize },
+        1144usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_stats_t),
+            "::",
+            stringify!(serialRuns)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).executorRuns) as usize - ptr as usize },
+        1152usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_stats_t),
+            "::",
+            stringify!(executorRuns)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).parallelRuns) as usize - ptr as usize },
+        1160usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_stats_t),
+            "::",
+            stringify!(parallelRuns)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).parallelNanoseconds) as usize - ptr as usize },
+        1168usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_stats_t),
+            "::",
+            stringify!(parallelNanoseconds)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).imbalanceNanoseconds) as usize - ptr as usize },
+        1176usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_stats_t),
+            "::",
+            stringify!(imbalanceNanoseconds)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).threadBlocks) as usize - ptr as usize },
+        1184usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_stats_t),
+            "::",
+            stringify!(threadBlocks)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).threadNanoseconds) as usize - ptr as usize },
+        3232usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_stats_t),
+            "::",
+            stringify!(threadNanoseconds)
+        )
+    );
+}
+extern "C" {
+    #[doc = "! \\brief Enables or disables collecting statistics. They are disabled at first.\n!\n! \\param[in] enabled whether to collect statistics.\n! \\returns 0 on success, or -1 if the library was built without SWIFFT_ENABLE_STATS."]
+    pub fn SWIFFT_SetStatsEnabled(enabled: ::std::os::raw::c_int) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = "! \\brief Returns a snapshot of the statistics.\n! Counters updated concurrently may be read at slightly different times.\n!\n! \\param[out] stats the statistics."]
+    pub fn SWIFFT_GetStats(stats: *mut swifft_stats_t);
+}
+extern "C" {
+    #[doc = "! \\brief Resets all counters of the statistics to zero."]
+    pub fn SWIFFT_ResetStats();
+}
+extern "C" {
+    #[doc = "! \\brief Returns the name of an entry point of the SWIFFT API, such as \"SWIFFT_Compute\".\n!\n! \\param[in] entry the entry point, a swifft_stats_entry_t.\n! \\returns the name, or NULL if the entry point is invalid."]
+    pub fn SWIFFT_StatsEntryName(entry: ::std::os::raw::c_int) -> *const ::std::os::raw::c_char;
+}
+pub const SWIFFT_STREAM_MESSAGE_SIZE: u32 = 192;
+pub const SWIFFT_STREAM_DIGEST_SIZE: u32 = 64;
+#[doc = "! \\brief The state of hashing a message of any length.\n! Use SWIFFT_ALIGN, or an allocator with the same alignment, on each declaration of this data structure."]
+#[repr(C)]
+#[repr(align(64))]
+#[derive(Debug, Copy, Clone)]
+pub struct swifft_stream_t {
+    #[doc = "< The chaining value"]
+    pub chain: [BitSequence; 64usize],
+    #[doc = "< The block of input being filled, after the bytes of the chaining value"]
+    pub block: [BitSequence; 256usize],
+    #[doc = "< The number of message bytes so far"]
+    pub length: u64,
+    #[doc = "< The number of message bytes in the block being filled"]
+    pub buffered: usize,
+}
+#[test]
+fn bindgen_test_layout_swifft_stream_t() {
+    const UNINIT: ::std::mem::MaybeUninit<swifft_stream_t> = ::std::mem::MaybeUninit::uninit();
+    let ptr = UNINIT.as_ptr();
+    assert_eq!(
+        ::std::mem::size_of::<swifft_stream_t>(),
+        384usize,
+        concat!("Size of: ", stringify!(swifft_stream_t))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<swifft_stream_t>(),
+        64usize,
+        concat!("Alignment of ", stringify!(swifft_stream_t))
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).chain) as usize - ptr as usize },
+        0usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_stream_t),
+            "::",
+            stringify!(chain)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).block) as usize - ptr as usize },
+        64usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_stream_t),
+            "::",
+            stringify!(block)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).length) as usize - ptr as usize },
+        320usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_stream_t),
+            "::",
+            stringify!(length)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).buffered) as usize - ptr as usize },
+        328usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_stream_t),
+            "::",
+            stringify!(buffered)
+        )
+    );
+}
+extern "C" {
+    #[doc = "! \\brief Initializes a stream for hashing a new message.\n!\n! \\param[out] stream the stream."]
+    pub fn SWIFFT_StreamInit(stream: *mut swifft_stream_t);
+}
+extern "C" {
+    #[doc = "! \\brief Hashes more bytes of the message of a stream.\n! Runs of full blocks are computed in parallel as configured, using SWIFFT_ComputeMultiple.\n!\n! \\param[in,out] stream the stream.\n! \\param[in] data the bytes, of any alignment.\n! \\param[in] size the number of bytes."]
+    pub fn SWIFFT_StreamUpdate(
+        stream: *mut swifft_stream_t,
+        data: *const BitSequence,
+        size: usize,
+    );
+}
+extern "C" {
+    #[doc = "! \\brief Pads the message of a stream and returns its digest.\n!\n! \\param[in,out] stream the stream, to be initialized again before further use.\n! \\param[out] digest the digest, of size 64 bytes (512 bit)."]
+    pub fn SWIFFT_StreamFinal(stream: *mut swifft_stream_t, digest: *mut BitSequence);
+}
+pub const SWIFFT_TREE_MAX_LEAF_SIZE: u32 = 256;
+pub const SWIFFT_TREE_MAX_FANOUT: u32 = 4;
+pub const SWIFFT_TREE_DIGEST_SIZE: u32 = 64;
+extern "C" {
+    #[doc = "! \\brief Hashes a message as a tree.\n!\n! \\param[in] data the message, of any alignment. With leaves of SWIFFT_INPUT_BLOCK_SIZE bytes\n! and data aligned to SWIFFT_ALIGNMENT, e.g. memory-mapped, its full leaves are hashed in place.\n! \\param[in] size the number of bytes of the message.\n! \\param[in] leafSize the number of bytes per leaf, from 1 to SWIFFT_TREE_MAX_LEAF_SIZE.\n! \\param[in] fanout the number of digests per group, from 2 to SWIFFT_TREE_MAX_FANOUT.\n! \\param[out] digest the digest, of size 64 bytes (512 bit).\n! \\returns 0 on success, or -1 if the parameters are invalid or memory is exhausted."]
+    pub fn SWIFFT_TreeHash(
+        data: *const BitSequence,
+        size: usize,
+        leafSize: usize,
+        fanout: ::std::os::raw::c_int,
+        digest: *mut BitSequence,
+    ) -> ::std::os::raw::c_int;
+}
+pub const SWIFFT_PROFILE_ENV: &[u8; 15usize] = b"SWIFFT_PROFILE\0";
+pub const SWIFFT_PROFILE_MAX_SIZE: u32 = 256;
+pub const SWIFFT_PROFILE_ISET_SIZE: u32 = 16;
+#[doc = "! \\brief A profile of tuning the SWIFFT API to a machine."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct swifft_profile_t {
+    #[doc = "! The name of the instruction set, such as \"AVX2\""]
+    pub iset: [::std::os::raw::c_char; 16usize],
+    #[doc = "! The number of threads of the native pool the profile was measured with"]
+    pub threads: ::std::os::raw::c_int,
+    #[doc = "! The threshold per class of operations, indexed by swifft_op_class_t"]
+    pub threshold: [usize; 4usize],
+    #[doc = "! The grain per class of operations, indexed by swifft_op_class_t"]
+    pub grain: [::std::os::raw::c_int; 4usize],
+}
+#[test]
+fn bindgen_test_layout_swifft_profile_t() {
+    const UNINIT: ::std::mem::MaybeUninit<swifft_profile_t> = ::std::mem::MaybeUninit::uninit();
+    let ptr = UNINIT.as_ptr();
+    assert_eq!(
+        ::std::mem::size_of::<swifft_profile_t>(),
+        72usize,
+        concat!("Size of: ", stringify!(swifft_profile_t))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<swifft_profile_t>(),
+        8usize,
+        concat!("Alignment of ", stringify!(swifft_profile_t))
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).iset) as usize - ptr as usize },
+        0usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_profile_t),
+            "::",
+            stringify!(iset)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).threads) as usize - ptr as usize },
+        16usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_profile_t),
+            "::",
+            stringify!(threads)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).threshold) as usize - ptr as usize },
+        24usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_profile_t),
+            "::",
+            stringify!(threshold)
+        )
+    );
+    assert_eq!(
+        unsafe { ::std::ptr::addr_of!((*ptr).grain) as usize - ptr as usize },
+        56usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(swifft_profile_t),
+            "::",
+            stringify!(grain)
+        )
+    );
+}
+extern "C" {
+    #[doc = "! \\brief Sets the instruction set used by the SWIFFT API.\n! Call it while no operations run.\n!\n! \\param[in] iset the instruction-set name, such as \"AVX2\", or NULL for the best one supported by the CPU.\n! \\returns 0 on success, or -1 if the instruction set is not built into the library or not supported by the CPU."]
+    pub fn SWIFFT_SetInstructionSet(
+        iset: *const ::std::os::raw::c_char,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = "! \\brief Returns the name of the instruction set used by the SWIFFT API.\n!\n! \\returns the instruction-set name, such as \"AVX2\"."]
+    pub fn SWIFFT_GetInstructionSet() -> *const ::std::os::raw::c_char;
+}
+extern "C" {
+    #[doc = "! \\brief Returns the profile currently applied to the SWIFFT API.\n!\n! \\param[out] profile the profile."]
+    pub fn SWIFFT_GetProfile(profile: *mut swifft_profile_t);
+}
+extern "C" {
+    #[doc = "! \\brief Applies a profile to the SWIFFT API.\n! Call it while no operations run.\n!\n! \\param[in] profile the profile.\n! \\returns 0 on success, or -1 if its instruction set is unavailable, in which case nothing is applied."]
+    pub fn SWIFFT_SetProfile(profile: *const swifft_profile_t) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = "! \\brief Formats a profile as a line of text, without a line break.\n!\n! \\param[in] profile the profile.\n! \\param[out] text the text, of at most size bytes including its terminating null.\n! \\param[in] size the size of text, SWIFFT_PROFILE_MAX_SIZE being enough.\n! \\returns the length of the text, or -1 if it does not fit."]
+    pub fn SWIFFT_FormatProfile(
+        profile: *const swifft_profile_t,
+        text: *mut ::std::os::raw::c_char,
+        size: usize,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = "! \\brief Parses a profile from the text given by SWIFFT_FormatProfile.\n! Classes missing from the text keep the threshold and grain currently applied.\n!\n! \\param[in] text the text.\n! \\param[out] profile the profile.\n! \\returns 0 on success, or -1 if the text is not a profile."]
+    pub fn SWIFFT_ParseProfile(
+        text: *const ::std::os::raw::c_char,
+        profile: *mut swifft_profile_t,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = "! \\brief Tunes the SWIFFT API to the running machine, as configured for parallelism.\n! Applies the profile saved in the file, if any, when its instruction set is available and it\n! was measured with as many threads as the native pool has. Otherwise, measures and applies\n! a profile, and saves it in the file, if any. Measuring takes tens of milliseconds.\n! Call it while no operations run.\n!\n! \\param[in] path the file of the profile, or NULL for measuring without saving.\n! \\returns 0 if the saved profile was applied, 1 if a profile was measured and applied,\n! or -1 if memory for measuring was exhausted or saving the applied profile failed."]
+    pub fn SWIFFT_Tune(path: *const ::std::os::raw::c_char) -> ::std::os::raw::c_int;
+}
 extern "C" {
     #[doc = "! \\brief Computes the FFT phase of SWIFFT.\n!\n! \\param[in] input the blocks of input, each of 256 bytes (2048 bits).\n! \\param[in] sign the blocks of sign bits corresponding to blocks of input of 256 bytes (2048 bits).\n! \\param[in] m number of 8-elements in the input.\n! \\param[out] fftout the blocks of FFT-output elements, totaling N*m."]
     pub fn SWIFFT_fft(
@@ -233,7 +1359,7 @@ extern "C" {
 extern "C" {
     #[doc = "! \\brief Computes the FFT phase of SWIFFT for multiple blocks.\n!\n! \\param[in] nblocks the number of blocks to operate on.\n! \\param[in] input the blocks of input, each of 256 bytes (2048 bits).\n! \\param[in] sign the blocks of sign bits corresponding to blocks of input of 256 bytes (2048 bits).\n! \\param[in] m number of 8-elements in the input.\n! \\param[out] fftout the blocks of FFT-output elements, totaling N*m."]
     pub fn SWIFFT_fftMultiple(
-        nblocks: ::std::os::raw::c_int,
+        nblocks: usize,
         input: *const BitSequence,
         sign: *const BitSequence,
         m: ::std::os::raw::c_int,
@@ -243,7 +1369,7 @@ extern "C" {
 extern "C" {
     #[doc = "! \\brief Computes the FFT-sum phase of SWIFFT for multiple blocks.\n!\n! \\param[in] nblocks the number of blocks to operate on.\n! \\param[in] ikey the SWIFFT key.\n! \\param[in] ifftout the blocks of FFT-output elements, totaling N*m\n! \\param[in] m number of 8-elements in the input.\n! \\param[out] iout the blocks of output elements, each of 64 double-bytes (1024 bits)."]
     pub fn SWIFFT_fftsumMultiple(
-        nblocks: ::std::os::raw::c_int,
+        nblocks: usize,
         ikey: *const i16,
         ifftout: *const i16,
         m: ::std::os::raw::c_int,
@@ -282,10 +1408,26 @@ extern "C" {
     #[doc = "! \\brief Multiplies a SWIFFT hash value from another, element-wise.\n!\n! \\param[in,out] output the hash value of SWIFFT to modify.\n! \\param[in] operand the hash value to multiply by."]
     pub fn SWIFFT_Mul(output: *mut BitSequence, operand: *const BitSequence);
 }
+extern "C" {
+    #[doc = "! \\brief Initializes an accumulator of SWIFFT hash values to zero.\n!\n! \\param[out] acc the accumulator."]
+    pub fn SWIFFT_AccumulatorInit(acc: *mut swifft_accumulator_t);
+}
+extern "C" {
+    #[doc = "! \\brief Adds a SWIFFT hash value to an accumulator, without reducing the sum.\n! The elements are folded, with a partial reduction, once every SWIFFT_ACCUMULATOR_HEADROOM operations.\n!\n! \\param[in,out] acc the accumulator.\n! \\param[in] operand the reduced hash value to add."]
+    pub fn SWIFFT_AccumulatorAdd(acc: *mut swifft_accumulator_t, operand: *const BitSequence);
+}
+extern "C" {
+    #[doc = "! \\brief Subtracts a SWIFFT hash value from an accumulator, without reducing the difference.\n! The elements are folded, with a partial reduction, once every SWIFFT_ACCUMULATOR_HEADROOM operations.\n!\n! \\param[in,out] acc the accumulator.\n! \\param[in] operand the reduced hash value to subtract."]
+    pub fn SWIFFT_AccumulatorSub(acc: *mut swifft_accumulator_t, operand: *const BitSequence);
+}
+extern "C" {
+    #[doc = "! \\brief Reduces an accumulator of SWIFFT hash values to a hash value.\n! The result is the same as that of the additions and subtractions of the accumulator done using SWIFFT_Add and SWIFFT_Sub.\n!\n! \\param[in] acc the accumulator.\n! \\param[out] output the resulting hash value of SWIFFT."]
+    pub fn SWIFFT_Reduce(acc: *const swifft_accumulator_t, output: *mut BitSequence);
+}
 extern "C" {
     #[doc = "! \\brief Sets a constant value at each SWIFFT hash value element for multiple blocks.\n!\n! \\param[in] nblocks the number of blocks to operate on.\n! \\param[out] output the hash value of SWIFFT to modify, per block.\n! \\param[in] operand the constant value to set, per block."]
     pub fn SWIFFT_ConstSetMultiple(
-        nblocks: ::std::os::raw::c_int,
+        nblocks: usize,
         output: *mut BitSequence,
         operand: *const i16,
     );
@@ -293,7 +1435,7 @@ extern "C" {
 extern "C" {
     #[doc = "! \\brief Adds a constant value to each SWIFFT hash value element for multiple blocks.\n!\n! \\param[in] nblocks the number of blocks to operate on.\n! \\param[in,out] output the hash value of SWIFFT to modify, per block.\n! \\param[in] operand the constant value to add, per block."]
     pub fn SWIFFT_ConstAddMultiple(
-        nblocks: ::std::os::raw::c_int,
+        nblocks: usize,
         output: *mut BitSequence,
         operand: *const i16,
     );
@@ -301,7 +1443,7 @@ extern "C" {
 extern "C" {
     #[doc = "! \\brief Subtracts a constant value from each SWIFFT hash value element for multiple blocks.\n!\n! \\param[in] nblocks the number of blocks to operate on.\n! \\param[in,out] output the hash value of SWIFFT to modify, per block.\n! \\param[in] operand the constant value to subtract, per block."]
     pub fn SWIFFT_ConstSubMultiple(
-        nblocks: ::std::os::raw::c_int,
+        nblocks: usize,
         output: *mut BitSequence,
         operand: *const i16,
     );
@@ -309,7 +1451,7 @@ extern "C" {
 extern "C" {
     #[doc = "! \\brief Multiply a constant value into each SWIFFT hash value element for multiple blocks.\n!\n! \\param[in] nblocks the number of blocks to operate on.\n! \\param[in,out] output the hash value of SWIFFT to modify, per block.\n! \\param[in] operand the constant value to multiply by, per block."]
     pub fn SWIFFT_ConstMulMultiple(
-        nblocks: ::std::os::raw::c_int,
+        nblocks: usize,
         output: *mut BitSequence,
         operand: *const i16,
     );
@@ -317,7 +1459,7 @@ extern "C" {
 extern "C" {
     #[doc = "! \\brief Sets a SWIFFT hash value to another, element-wise, for multiple blocks.\n!\n! \\param[in] nblocks the number of blocks to operate on.\n! \\param[in,out] output the hash value of SWIFFT to modify.\n! \\param[in] operand the hash value to set to."]
     pub fn SWIFFT_SetMultiple(
-        nblocks: ::std::os::raw::c_int,
+        nblocks: usize,
         output: *mut BitSequence,
         operand: *const BitSequence,
     );
@@ -325,7 +1467,7 @@ extern "C" {
 extern "C" {
     #[doc = "! \\brief Adds a SWIFFT hash value to another, element-wise, for multiple blocks.\n!\n! \\param[in] nblocks the number of blocks to operate on.\n! \\param[in,out] output the hash value of SWIFFT to modify.\n! \\param[in] operand the hash value to add."]
     pub fn SWIFFT_AddMultiple(
-        nblocks: ::std::os::raw::c_int,
+        nblocks: usize,
         output: *mut BitSequence,
         operand: *const BitSequence,
     );
@@ -333,7 +1475,7 @@ extern "C" {
 extern "C" {
     #[doc = "! \\brief Subtracts a SWIFFT hash value from another, element-wise, for multiple blocks.\n!\n! \\param[in] nblocks the number of blocks to operate on.\n! \\param[in,out] output the hash value of SWIFFT to modify.\n! \\param[in] operand the hash value to subtract."]
     pub fn SWIFFT_SubMultiple(
-        nblocks: ::std::os::raw::c_int,
+        nblocks: usize,
         output: *mut BitSequence,
         operand: *const BitSequence,
     );
@@ -341,11 +1483,39 @@ extern "C" {
 extern "C" {
     #[doc = "! \\brief Multiplies a SWIFFT hash value from another, element-wise, for multiple blocks.\n!\n! \\param[in] nblocks the number of blocks to operate on.\n! \\param[in,out] output the hash value of SWIFFT to modify.\n! \\param[in] operand the hash value to multiply by."]
     pub fn SWIFFT_MulMultiple(
-        nblocks: ::std::os::raw::c_int,
+        nblocks: usize,
+        output: *mut BitSequence,
+        operand: *const BitSequence,
+    );
+}
+extern "C" {
+    #[doc = "! \\brief Sums SWIFFT hash values of multiple blocks, reducing only once per SWIFFT_ACCUMULATOR_HEADROOM blocks.\n! The result is the same as that of adding the hash values one by one using SWIFFT_Add.\n!\n! \\param[in] nblocks the number of blocks to sum.\n! \\param[in] operand the reduced hash values to sum, per block.\n! \\param[out] output the resulting hash value of SWIFFT."]
+    pub fn SWIFFT_SumMultiple(
+        nblocks: usize,
+        operand: *const BitSequence,
         output: *mut BitSequence,
+    );
+}
+extern "C" {
+    #[doc = "! \\brief Computes a linear combination of SWIFFT hash values of multiple blocks, reducing each product only partially.\n! The result is the sum of the products of the hash values by their coefficients, mod 257.\n!\n! \\param[in] nblocks the number of blocks to combine.\n! \\param[in] coeffs the coefficients, per block, in any range of int16_t.\n! \\param[in] operand the reduced hash values to combine, per block.\n! \\param[out] output the resulting hash value of SWIFFT."]
+    pub fn SWIFFT_LinearCombination(
+        nblocks: usize,
+        coeffs: *const i16,
         operand: *const BitSequence,
+        output: *mut BitSequence,
     );
 }
+extern "C" {
+    #[doc = "! \\brief Evaluates an element-wise expression of SWIFFT hash values for multiple blocks.\n! The program runs on a stack of hash values for each block, and leaves the result as the\n! only one on it. The stack of a range of blocks is held in a small buffer local to the\n! computation, so each operand is read and the output is written once, in a single\n! parallel run. Each operation reduces its result mod 257, as SWIFFT_Add does.\n!\n! \\param[in] nblocks the number of blocks to operate on.\n! \\param[in] program the operations of the expression, in postfix order.\n! \\param[in] nops the number of operations.\n! \\param[in] operands the arrays of reduced hash values of SWIFFT, per block, for SWIFFT_OP_LOAD.\n! \\param[in] noperands the number of arrays of operands.\n! \\param[out] output the resulting hash values of SWIFFT, per block, which may be an array of operands.\n! \\returns 0 on success, or -1 if the program is invalid or needs more than SWIFFT_EVAL_MAX_STACK hash values on the stack."]
+    pub fn SWIFFT_EvalMultiple(
+        nblocks: usize,
+        program: *const swifft_op_t,
+        nops: ::std::os::raw::c_int,
+        operands: *const *const BitSequence,
+        noperands: ::std::os::raw::c_int,
+        output: *mut BitSequence,
+    ) -> ::std::os::raw::c_int;
+}
 extern "C" {
     #[doc = "! \\brief Compacts a hash value of SWIFFT.\n! The result is not composable with other compacted hash values.\n!\n! \\param[in] output the hash value of SWIFFT, of size 128 bytes (1024 bit).\n! \\param[out] compact the compacted hash value of SWIFFT, of size 64 bytes (512 bit)."]
     pub fn SWIFFT_Compact(output: *const BitSequence, compact: *mut BitSequence);
@@ -353,11 +1523,15 @@ extern "C" {
 extern "C" {
     #[doc = "! \\brief Compacts a hash value of SWIFFT for multiple blocks.\n! The result is not composable with other compacted hash values.\n!\n! \\param[in] nblocks the number of blocks to operate on.\n! \\param[in] output the hash value of SWIFFT, of size 128 bytes (1024 bit).\n! \\param[out] compact the compacted hash value of SWIFFT, of size 64 bytes (512 bit)."]
     pub fn SWIFFT_CompactMultiple(
-        nblocks: ::std::os::raw::c_int,
+        nblocks: usize,
         output: *const BitSequence,
         compact: *mut BitSequence,
     );
 }
+extern "C" {
+    #[doc = "! \\brief Initializes a SWIFFT key from elements of Z_{257}.\n! The elements are given in the layout of FFT-output elements, which is the one\n! expected by SWIFFT_fftsum, and may be in any range of int16_t.\n!\n! \\param[out] key the SWIFFT key to initialize.\n! \\param[in] coefficients the elements of the key, of size 2048 double-bytes."]
+    pub fn SWIFFT_InitKey(key: *mut swifft_key_t, coefficients: *const i16);
+}
 extern "C" {
     #[doc = "! \\brief Computes the result of a SWIFFT operation.\n! The result is composable with other hash values.\n!\n! \\param[in] input the input of 256 bytes (2048 bit).\n! \\param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit)."]
     pub fn SWIFFT_Compute(input: *const BitSequence, output: *mut BitSequence);
@@ -373,7 +1547,7 @@ extern "C" {
 extern "C" {
     #[doc = "! \\brief Computes the result of multiple SWIFFT operations.\n! The result is composable with other hash values.\n!\n! \\param[in] nblocks the number of blocks to operate on.\n! \\param[in] input the blocks of input, each of 256 bytes (2048 bit).\n! \\param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit)."]
     pub fn SWIFFT_ComputeMultiple(
-        nblocks: ::std::os::raw::c_int,
+        nblocks: usize,
         input: *const BitSequence,
         output: *mut BitSequence,
     );
@@ -381,9 +1555,131 @@ extern "C" {
 extern "C" {
     #[doc = "! \\brief Computes the result of multiple SWIFFT operations.\n! The result is composable with other hash values.\n!\n! \\param[in] nblocks the number of blocks to operate on.\n! \\param[in] input the blocks of input, each of 256 bytes (2048 bit).\n! \\param[in] sign the blocks of sign bits corresponding to blocks of input of 256 bytes (2048 bit).\n! \\param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit)."]
     pub fn SWIFFT_ComputeMultipleSigned(
-        nblocks: ::std::os::raw::c_int,
+        nblocks: usize,
+        input: *const BitSequence,
+        sign: *const BitSequence,
+        output: *mut BitSequence,
+    );
+}
+extern "C" {
+    #[doc = "! \\brief Computes the compacted result of multiple SWIFFT operations.\n! The result is the same as that of SWIFFT_ComputeMultiple followed by SWIFFT_CompactMultiple.\n!\n! \\param[in] nblocks the number of blocks to operate on.\n! \\param[in] input the blocks of input, each of 256 bytes (2048 bit).\n! \\param[out] compact the resulting blocks of compacted hash values of SWIFFT, each of size 64 bytes (512 bit)."]
+    pub fn SWIFFT_ComputeCompactMultiple(
+        nblocks: usize,
+        input: *const BitSequence,
+        compact: *mut BitSequence,
+    );
+}
+extern "C" {
+    #[doc = "! \\brief Updates the result of a SWIFFT operation for a change of one chunk of its input.\n! The result is the same as that of SWIFFT_Compute on the changed input.\n!\n! \\param[in,out] output the hash value of SWIFFT to modify, of size 128 bytes (1024 bit).\n! \\param[in] oldChunk the old chunk of 8 bytes.\n! \\param[in] newChunk the new chunk of 8 bytes.\n! \\param[in] chunkIndex the index of the chunk in the input, from 0 to SWIFFT_INPUT_CHUNKS-1."]
+    pub fn SWIFFT_Update(
+        output: *mut BitSequence,
+        oldChunk: *const BitSequence,
+        newChunk: *const BitSequence,
+        chunkIndex: ::std::os::raw::c_int,
+    );
+}
+extern "C" {
+    #[doc = "! \\brief Updates the results of multiple SWIFFT operations, each for a change of one chunk of its input.\n! The result is the same as that of SWIFFT_ComputeMultiple on the changed inputs.\n!\n! \\param[in] nblocks the number of blocks to operate on.\n! \\param[in,out] output the blocks of hash values of SWIFFT to modify, each of size 128 bytes (1024 bit).\n! \\param[in] oldChunk the old chunks, one per block, each of 8 bytes.\n! \\param[in] newChunk the new chunks, one per block, each of 8 bytes.\n! \\param[in] chunkIndex the indices of the chunks in the inputs, one per block, each from 0 to SWIFFT_INPUT_CHUNKS-1."]
+    pub fn SWIFFT_UpdateMultiple(
+        nblocks: usize,
+        output: *mut BitSequence,
+        oldChunk: *const BitSequence,
+        newChunk: *const BitSequence,
+        chunkIndex: *const ::std::os::raw::c_int,
+    );
+}
+extern "C" {
+    #[doc = "! \\brief Computes the result of a SWIFFT operation using a given key.\n! The result is composable with other hash values computed using the same key.\n!\n! \\param[in] key the SWIFFT key.\n! \\param[in] input the input of 256 bytes (2048 bit).\n! \\param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit)."]
+    pub fn SWIFFT_ComputeKeyed(
+        key: *const swifft_key_t,
+        input: *const BitSequence,
+        output: *mut BitSequence,
+    );
+}
+extern "C" {
+    #[doc = "! \\brief Computes the result of a SWIFFT operation using a given key.\n! The result is composable with other hash values computed using the same key.\n!\n! \\param[in] key the SWIFFT key.\n! \\param[in] input the input of 256 bytes (2048 bit).\n! \\param[in] sign the sign bits corresponding to the input of 256 bytes (2048 bit).\n! \\param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit)."]
+    pub fn SWIFFT_ComputeSignedKeyed(
+        key: *const swifft_key_t,
+        input: *const BitSequence,
+        sign: *const BitSequence,
+        output: *mut BitSequence,
+    );
+}
+extern "C" {
+    #[doc = "! \\brief Computes the result of multiple SWIFFT operations using a given key.\n! The result is composable with other hash values computed using the same key.\n!\n! \\param[in] nblocks the number of blocks to operate on.\n! \\param[in] key the SWIFFT key.\n! \\param[in] input the blocks of input, each of 256 bytes (2048 bit).\n! \\param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit)."]
+    pub fn SWIFFT_ComputeMultipleKeyed(
+        nblocks: usize,
+        key: *const swifft_key_t,
+        input: *const BitSequence,
+        output: *mut BitSequence,
+    );
+}
+extern "C" {
+    #[doc = "! \\brief Computes the result of multiple SWIFFT operations using a given key.\n! The result is composable with other hash values computed using the same key.\n!\n! \\param[in] nblocks the number of blocks to operate on.\n! \\param[in] key the SWIFFT key.\n! \\param[in] input the blocks of input, each of 256 bytes (2048 bit).\n! \\param[in] sign the blocks of sign bits corresponding to blocks of input of 256 bytes (2048 bit).\n! \\param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit)."]
+    pub fn SWIFFT_ComputeMultipleSignedKeyed(
+        nblocks: usize,
+        key: *const swifft_key_t,
         input: *const BitSequence,
         sign: *const BitSequence,
         output: *mut BitSequence,
     );
 }
+extern "C" {
+    #[doc = "! \\brief Computes the result of a SWIFFT operation on packed signed input.\n! The packed input holds, for each chunk of 8 input bytes, the chunk followed by its 8 sign bytes,\n! so a {-1,0,1} vector is read as one stream rather than as separate input and sign blocks.\n! The result is the same as that of SWIFFT_ComputeSigned on the unpacked input and sign bits.\n!\n! \\param[in] packed the packed signed input of 512 bytes, as given by SWIFFT_PACKED_BLOCK_SIZE.\n! \\param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit)."]
+    pub fn SWIFFT_ComputeSignedPacked(packed: *const BitSequence, output: *mut BitSequence);
+}
+extern "C" {
+    #[doc = "! \\brief Computes the result of multiple SWIFFT operations on packed signed input.\n! The result is the same as that of SWIFFT_ComputeMultipleSigned on the unpacked blocks of input and sign bits.\n!\n! \\param[in] nblocks the number of blocks to operate on.\n! \\param[in] packed the blocks of packed signed input, each of 512 bytes.\n! \\param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit)."]
+    pub fn SWIFFT_ComputeMultipleSignedPacked(
+        nblocks: usize,
+        packed: *const BitSequence,
+        output: *mut BitSequence,
+    );
+}
+extern "C" {
+    #[doc = "! \\brief Computes the results of multiple SWIFFT operations under each of several keys.\n! The result for each key is the same as that of SWIFFT_ComputeMultipleKeyed, or of\n! SWIFFT_ComputeMultipleSignedKeyed given sign bits, but the FFT phase, which does not\n! depend on the key, is computed once per block.\n!\n! \\param[in] nblocks the number of blocks to operate on.\n! \\param[in] input the blocks of input, each of 256 bytes (2048 bit).\n! \\param[in] sign the blocks of sign bits corresponding to blocks of input of 256 bytes (2048 bit), or NULL for unsigned input.\n! \\param[in] nkeys the number of keys.\n! \\param[in] keys the SWIFFT keys.\n! \\param[out] outputs the resulting blocks of hash values of SWIFFT, per key, each block of size 128 bytes (1024 bit)."]
+    pub fn SWIFFT_ComputeMultiKey(
+        nblocks: usize,
+        input: *const BitSequence,
+        sign: *const BitSequence,
+        nkeys: ::std::os::raw::c_int,
+        keys: *const *const swifft_key_t,
+        outputs: *const *mut BitSequence,
+    );
+}
+extern "C" {
+    #[doc = "! \\brief Computes the result of a SWIFFT operation on short input.\n! The result is the same as that of SWIFFT_Compute on the input padded with zero bytes to 256 bytes,\n! but the work is proportional to the number of chunks of input.\n!\n! \\param[in] m the number of chunks of input, a multiple of SWIFFT_SHORT_CHUNKS_MULTIPLE up to SWIFFT_INPUT_CHUNKS.\n! \\param[in] input the input of m chunks of 8 bytes.\n! \\param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit).\n! \\returns 0 on success, or -1 if m is invalid."]
+    pub fn SWIFFT_ComputeShort(
+        m: ::std::os::raw::c_int,
+        input: *const BitSequence,
+        output: *mut BitSequence,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = "! \\brief Computes the result of a SWIFFT operation on short signed input.\n! The result is the same as that of SWIFFT_ComputeSigned on the input and sign bits padded with zero bytes to 256 bytes,\n! but the work is proportional to the number of chunks of input.\n!\n! \\param[in] m the number of chunks of input, a multiple of SWIFFT_SHORT_CHUNKS_MULTIPLE up to SWIFFT_INPUT_CHUNKS.\n! \\param[in] input the input of m chunks of 8 bytes.\n! \\param[in] sign the sign bits corresponding to the input of m chunks of 8 bytes.\n! \\param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit).\n! \\returns 0 on success, or -1 if m is invalid."]
+    pub fn SWIFFT_ComputeSignedShort(
+        m: ::std::os::raw::c_int,
+        input: *const BitSequence,
+        sign: *const BitSequence,
+        output: *mut BitSequence,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = "! \\brief Computes the result of multiple SWIFFT operations on short input.\n! The result is the same as that of SWIFFT_ComputeMultiple on the blocks of input each padded with zero bytes to 256 bytes.\n!\n! \\param[in] nblocks the number of blocks to operate on.\n! \\param[in] m the number of chunks of input per block, a multiple of SWIFFT_SHORT_CHUNKS_MULTIPLE up to SWIFFT_INPUT_CHUNKS.\n! \\param[in] input the blocks of input, each of m chunks of 8 bytes.\n! \\param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).\n! \\returns 0 on success, or -1 if m is invalid."]
+    pub fn SWIFFT_ComputeMultipleShort(
+        nblocks: usize,
+        m: ::std::os::raw::c_int,
+        input: *const BitSequence,
+        output: *mut BitSequence,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = "! \\brief Computes the result of multiple SWIFFT operations on short signed input.\n! The result is the same as that of SWIFFT_ComputeMultipleSigned on the blocks of input and\n! sign bits each padded with zero bytes to 256 bytes.\n!\n! \\param[in] nblocks the number of blocks to operate on.\n! \\param[in] m the number of chunks of input per block, a multiple of SWIFFT_SHORT_CHUNKS_MULTIPLE up to SWIFFT_INPUT_CHUNKS.\n! \\param[in] input the blocks of input, each of m chunks of 8 bytes.\n! \\param[in] sign the blocks of sign bits corresponding to blocks of input, each of m chunks of 8 bytes.\n! \\param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).\n! \\returns 0 on success, or -1 if m is invalid."]
+    pub fn SWIFFT_ComputeMultipleSignedShort(
+        nblocks: usize,
+        m: ::std::os::raw::c_int,
+        input: *const BitSequence,
+        sign: *const BitSequence,
+        output: *mut BitSequence,
+    ) -> ::std::os::raw::c_int;
+}
@@ -1,5 +1,13 @@
+option(SWIFFT_ENABLE_RUNTIME_DISPATCH "Select the instruction set of the SWIFFT API when the library is loaded" ON)
+option(SWIFFT_ENABLE_THREAD_POOL "Provide a native thread pool for SWIFFT operations on multiple blocks" ON)
+option(SWIFFT_ENABLE_STATS "Provide statistics of SWIFFT operations, collected once enabled at run time" OFF)
+
 if(NOT DEFINED SWIFFT_MACHINE_COMPILE_FLAGS)
-	set(SWIFFT_MACHINE_COMPILE_FLAGS -march=native)
+	if(SWIFFT_ENABLE_RUNTIME_DISPATCH)
+		set(SWIFFT_MACHINE_COMPILE_FLAGS "")
+	else()
+		set(SWIFFT_MACHINE_COMPILE_FLAGS -march=native)
+	endif()
 endif()
 
 set(SWIFFT_DEFAULT_FILE_COMPILE_FLAGS "${SWIFFT_MACHINE_COMPILE_FLAGS}")
@@ -12,3 +20,12 @@ if(SWIFFT_ENABLE_OPENMP)
                 set(CMAKE_EXE_LINKER_FLAGS "${CMAKE_EXE_LINKER_FLAGS} ${OpenMP_EXE_LINKER_FLAGS}")
         endif()
 endif()
+
+if(SWIFFT_ENABLE_THREAD_POOL)
+        find_package(Threads REQUIRED)
+        add_compile_definitions(SWIFFT_ENABLE_THREAD_POOL)
+endif()
+
+if(SWIFFT_ENABLE_STATS)
+        add_compile_definitions(SWIFFT_ENABLE_STATS)
+endif()
@@ -22,6 +22,14 @@
 #define __LIBSWIFFT_SWIFFT_H__
 
 #include "swifft_common.h"
+#include "swifft_alloc.h"
+#include "swifft_index.h"
+#include "swifft_pool.h"
+#include "swifft_queue.h"
+#include "swifft_stats.h"
+#include "swifft_stream.h"
+#include "swifft_tree.h"
+#include "swifft_tune.h"
 
 LIBSWIFFT_BEGIN_EXTERN_C
 
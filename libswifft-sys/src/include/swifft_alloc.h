@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2021 Yaron Gvili and Gvili Tech Ltd.
+ *
+ * See the accompanying LICENSE.txt file for licensing information.
+ */
+/*! \file include/swifft_alloc.h
+ * \brief LibSWIFFT public C API for allocating arrays of blocks
+ *
+ * Arrays of blocks, such as of input, sign, output or compact blocks, must be
+ * aligned to SWIFFT_ALIGNMENT. SWIFFT_AllocBlocks allocates such an array, on
+ * huge pages where available when it spans an arena at least.
+ *
+ * A block pool recycles arrays for callers that allocate them repeatedly, e.g.
+ * per batch. It carves arrays out of arenas of SWIFFT_ARENA_SIZE bytes, mapped
+ * on huge pages where available, optionally preferring the memory of a NUMA
+ * node, and touched when mapped. An array is given out at a size class, a power
+ * of 2 of bytes, and returns to its class when freed, and arrays larger than an
+ * arena get mappings of their own, kept for reuse. So once the pool has grown
+ * to a working set, allocating from it takes no system calls, page faults or
+ * misses of huge-page TLB entries.
+ */
+#ifndef __LIBSWIFFT_SWIFFT_ALLOC_H__
+#define __LIBSWIFFT_SWIFFT_ALLOC_H__
+
+#include <stddef.h> // for size_t
+#include "swifft_common.h"
+
+LIBSWIFFT_BEGIN_EXTERN_C
+
+//! The size of an arena of a block pool, that of a huge page on x86-64 and ARM64.
+#define SWIFFT_ARENA_SIZE (2*1024*1024)
+
+//! \brief The statistics of a block pool.
+typedef struct {
+	size_t mappings;    ///< The number of mappings, of arenas and of arrays larger than an arena
+	size_t hugetlb;     ///< The number of mappings on explicit huge pages, the others relying on transparent ones
+	size_t mappedBytes; ///< The number of bytes mapped
+	size_t usedBytes;   ///< The number of bytes of arrays given out and not yet freed, rounded up to their size classes
+	size_t allocs;      ///< The number of arrays given out
+	size_t reuses;      ///< The number of arrays given out that were recycled
+} swifft_block_pool_stats_t;
+
+//! \brief A pool of arrays of blocks, opaque to the caller.
+typedef struct swifft_block_pool_s swifft_block_pool_t;
+
+//! \brief Allocates a zero-initialized array of blocks, aligned to SWIFFT_ALIGNMENT.
+//! An array of SWIFFT_ARENA_SIZE bytes or more is mapped on huge pages where available.
+//!
+//! \param[in] nblocks the number of blocks.
+//! \param[in] blockSize the size of a block, such as SWIFFT_INPUT_BLOCK_SIZE.
+//! \returns the array, to free using SWIFFT_FreeBlocks, or NULL if memory is exhausted.
+void * SWIFFT_AllocBlocks(size_t nblocks, size_t blockSize);
+
+//! \brief Frees an array of blocks allocated by SWIFFT_AllocBlocks.
+//!
+//! \param[in] blocks the array, or NULL.
+void SWIFFT_FreeBlocks(void * blocks);
+
+//! \brief Creates a block pool, with no arenas until arrays are allocated from it.
+//!
+//! \param[in] node the NUMA node whose memory the arenas prefer, or -1 for none.
+//! \returns the block pool, or NULL if memory is exhausted.
+swifft_block_pool_t * SWIFFT_BlockPoolCreate(int node);
+
+//! \brief Allocates an array of blocks from a block pool, aligned to SWIFFT_ALIGNMENT.
+//! It is zero-initialized when new, and holds what its previous user left in it when recycled.
+//! Safe to call concurrently with other calls on the block pool, except for destroying it.
+//!
+//! \param[in,out] pool the block pool.
+//! \param[in] nblocks the number of blocks.
+//! \param[in] blockSize the size of a block, such as SWIFFT_INPUT_BLOCK_SIZE.
+//! \returns the array, to free using SWIFFT_BlockPoolFree, or NULL if memory is exhausted.
+void * SWIFFT_BlockPoolAlloc(swifft_block_pool_t * pool, size_t nblocks, size_t blockSize);
+
+//! \brief Returns an array of blocks to the block pool it was allocated from, for reuse.
+//! Safe to call concurrently with other calls on the block pool, except for destroying it.
+//!
+//! \param[in,out] pool the block pool.
+//! \param[in] blocks the array, or NULL.
+void SWIFFT_BlockPoolFree(swifft_block_pool_t * pool, void * blocks);
+
+//! \brief Returns the statistics of a block pool.
+//!
+//! \param[in] pool the block pool.
+//! \param[out] stats the statistics.
+void SWIFFT_BlockPoolGetStats(swifft_block_pool_t * pool, swifft_block_pool_stats_t * stats);
+
+//! \brief Destroys a block pool, unmapping its memory, including that of arrays not yet freed.
+//!
+//! \param[in] pool the block pool, or NULL.
+void SWIFFT_BlockPoolDestroy(swifft_block_pool_t * pool);
+
+LIBSWIFFT_END_EXTERN_C
+
+#endif /* __LIBSWIFFT_SWIFFT_ALLOC_H__ */
@@ -67,12 +67,41 @@ void LIBSWIFFT_API(SWIFFT_Sub)(BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
 void LIBSWIFFT_API(SWIFFT_Mul)(BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
 	const BitSequence operand[SWIFFT_OUTPUT_BLOCK_SIZE]);
 
+//! \brief Initializes an accumulator of SWIFFT hash values to zero.
+//!
+//! \param[out] acc the accumulator.
+void LIBSWIFFT_API(SWIFFT_AccumulatorInit)(swifft_accumulator_t * acc);
+
+//! \brief Adds a SWIFFT hash value to an accumulator, without reducing the sum.
+//! The elements are folded, with a partial reduction, once every SWIFFT_ACCUMULATOR_HEADROOM operations.
+//!
+//! \param[in,out] acc the accumulator.
+//! \param[in] operand the reduced hash value to add.
+void LIBSWIFFT_API(SWIFFT_AccumulatorAdd)(swifft_accumulator_t * acc,
+	const BitSequence operand[SWIFFT_OUTPUT_BLOCK_SIZE]);
+
+//! \brief Subtracts a SWIFFT hash value from an accumulator, without reducing the difference.
+//! The elements are folded, with a partial reduction, once every SWIFFT_ACCUMULATOR_HEADROOM operations.
+//!
+//! \param[in,out] acc the accumulator.
+//! \param[in] operand the reduced hash value to subtract.
+void LIBSWIFFT_API(SWIFFT_AccumulatorSub)(swifft_accumulator_t * acc,
+	const BitSequence operand[SWIFFT_OUTPUT_BLOCK_SIZE]);
+
+//! \brief Reduces an accumulator of SWIFFT hash values to a hash value.
+//! The result is the same as that of the additions and subtractions of the accumulator done using SWIFFT_Add and SWIFFT_Sub.
+//!
+//! \param[in] acc the accumulator.
+//! \param[out] output the resulting hash value of SWIFFT.
+void LIBSWIFFT_API(SWIFFT_Reduce)(const swifft_accumulator_t * acc,
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE]);
+
 //! \brief Sets a constant value at each SWIFFT hash value element for multiple blocks.
 //!
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[out] output the hash value of SWIFFT to modify, per block.
 //! \param[in] operand the constant value to set, per block.
-void LIBSWIFFT_API(SWIFFT_ConstSetMultiple)(int nblocks, BitSequence * output,
+void LIBSWIFFT_API(SWIFFT_ConstSetMultiple)(size_t nblocks, BitSequence * output,
 	const int16_t * operand);
 
 //! \brief Adds a constant value to each SWIFFT hash value element for multiple blocks.
@@ -80,7 +109,7 @@ void LIBSWIFFT_API(SWIFFT_ConstSetMultiple)(int nblocks, BitSequence * output,
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in,out] output the hash value of SWIFFT to modify, per block.
 //! \param[in] operand the constant value to add, per block.
-void LIBSWIFFT_API(SWIFFT_ConstAddMultiple)(int nblocks, BitSequence * output,
+void LIBSWIFFT_API(SWIFFT_ConstAddMultiple)(size_t nblocks, BitSequence * output,
 	const int16_t * operand);
 
 //! \brief Subtracts a constant value from each SWIFFT hash value element for multiple blocks.
@@ -88,7 +117,7 @@ void LIBSWIFFT_API(SWIFFT_ConstAddMultiple)(int nblocks, BitSequence * output,
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in,out] output the hash value of SWIFFT to modify, per block.
 //! \param[in] operand the constant value to subtract, per block.
-void LIBSWIFFT_API(SWIFFT_ConstSubMultiple)(int nblocks, BitSequence * output,
+void LIBSWIFFT_API(SWIFFT_ConstSubMultiple)(size_t nblocks, BitSequence * output,
 	const int16_t * operand);
 
 //! \brief Multiply a constant value into each SWIFFT hash value element for multiple blocks.
@@ -96,7 +125,7 @@ void LIBSWIFFT_API(SWIFFT_ConstSubMultiple)(int nblocks, BitSequence * output,
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in,out] output the hash value of SWIFFT to modify, per block.
 //! \param[in] operand the constant value to multiply by, per block.
-void LIBSWIFFT_API(SWIFFT_ConstMulMultiple)(int nblocks, BitSequence * output,
+void LIBSWIFFT_API(SWIFFT_ConstMulMultiple)(size_t nblocks, BitSequence * output,
 	const int16_t * operand);
 
 //! \brief Sets a SWIFFT hash value to another, element-wise, for multiple blocks.
@@ -104,7 +133,7 @@ void LIBSWIFFT_API(SWIFFT_ConstMulMultiple)(int nblocks, BitSequence * output,
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in,out] output the hash value of SWIFFT to modify.
 //! \param[in] operand the hash value to set to.
-void LIBSWIFFT_API(SWIFFT_SetMultiple)(int nblocks, BitSequence * output,
+void LIBSWIFFT_API(SWIFFT_SetMultiple)(size_t nblocks, BitSequence * output,
 	const BitSequence * operand);
 
 //! \brief Adds a SWIFFT hash value to another, element-wise, for multiple blocks.
@@ -112,7 +141,7 @@ void LIBSWIFFT_API(SWIFFT_SetMultiple)(int nblocks, BitSequence * output,
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in,out] output the hash value of SWIFFT to modify.
 //! \param[in] operand the hash value to add.
-void LIBSWIFFT_API(SWIFFT_AddMultiple)(int nblocks, BitSequence * output,
+void LIBSWIFFT_API(SWIFFT_AddMultiple)(size_t nblocks, BitSequence * output,
 	const BitSequence * operand);
 
 //! \brief Subtracts a SWIFFT hash value from another, element-wise, for multiple blocks.
@@ -120,7 +149,7 @@ void LIBSWIFFT_API(SWIFFT_AddMultiple)(int nblocks, BitSequence * output,
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in,out] output the hash value of SWIFFT to modify.
 //! \param[in] operand the hash value to subtract.
-void LIBSWIFFT_API(SWIFFT_SubMultiple)(int nblocks, BitSequence * output,
+void LIBSWIFFT_API(SWIFFT_SubMultiple)(size_t nblocks, BitSequence * output,
 	const BitSequence * operand);
 
 //! \brief Multiplies a SWIFFT hash value from another, element-wise, for multiple blocks.
@@ -128,5 +157,40 @@ void LIBSWIFFT_API(SWIFFT_SubMultiple)(int nblocks, BitSequence * output,
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in,out] output the hash value of SWIFFT to modify.
 //! \param[in] operand the hash value to multiply by.
-void LIBSWIFFT_API(SWIFFT_MulMultiple)(int nblocks, BitSequence * output,
+void LIBSWIFFT_API(SWIFFT_MulMultiple)(size_t nblocks, BitSequence * output,
 	const BitSequence * operand);
+
+//! \brief Sums SWIFFT hash values of multiple blocks, reducing only once per SWIFFT_ACCUMULATOR_HEADROOM blocks.
+//! The result is the same as that of adding the hash values one by one using SWIFFT_Add.
+//!
+//! \param[in] nblocks the number of blocks to sum.
+//! \param[in] operand the reduced hash values to sum, per block.
+//! \param[out] output the resulting hash value of SWIFFT.
+void LIBSWIFFT_API(SWIFFT_SumMultiple)(size_t nblocks, const BitSequence * operand,
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE]);
+
+//! \brief Computes a linear combination of SWIFFT hash values of multiple blocks, reducing each product only partially.
+//! The result is the sum of the products of the hash values by their coefficients, mod 257.
+//!
+//! \param[in] nblocks the number of blocks to combine.
+//! \param[in] coeffs the coefficients, per block, in any range of int16_t.
+//! \param[in] operand the reduced hash values to combine, per block.
+//! \param[out] output the resulting hash value of SWIFFT.
+void LIBSWIFFT_API(SWIFFT_LinearCombination)(size_t nblocks, const int16_t * coeffs, const BitSequence * operand,
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE]);
+
+//! \brief Evaluates an element-wise expression of SWIFFT hash values for multiple blocks.
+//! The program runs on a stack of hash values for each block, and leaves the result as the
+//! only one on it. The stack of a range of blocks is held in a small buffer local to the
+//! computation, so each operand is read and the output is written once, in a single
+//! parallel run. Each operation reduces its result mod 257, as SWIFFT_Add does.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] program the operations of the expression, in postfix order.
+//! \param[in] nops the number of operations.
+//! \param[in] operands the arrays of reduced hash values of SWIFFT, per block, for SWIFFT_OP_LOAD.
+//! \param[in] noperands the number of arrays of operands.
+//! \param[out] output the resulting hash values of SWIFFT, per block, which may be an array of operands.
+//! \returns 0 on success, or -1 if the program is invalid or needs more than SWIFFT_EVAL_MAX_STACK hash values on the stack.
+int LIBSWIFFT_API(SWIFFT_EvalMultiple)(size_t nblocks, const swifft_op_t * program, int nops,
+	const BitSequence * const * operands, int noperands, BitSequence * output);
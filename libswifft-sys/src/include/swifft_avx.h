@@ -11,7 +11,9 @@
 #ifndef __LIBSWIFFT_SWIFFT_AVX_H_
 #define __LIBSWIFFT_SWIFFT_AVX_H_
 
-#if defined(__AVX__)
+#include "swifft_common.h"
+
+#if defined(SWIFFT_HAVE_AVX)
 	#undef SWIFFT_ISET
         #define SWIFFT_ISET() AVX
         #include "swifft_iset.inl"
@@ -11,7 +11,9 @@
 #ifndef __LIBSWIFFT_SWIFFT_AVX2_H_
 #define __LIBSWIFFT_SWIFFT_AVX2_H_
 
-#if defined(__AVX2__)
+#include "swifft_common.h"
+
+#if defined(SWIFFT_HAVE_AVX2)
 	#undef SWIFFT_ISET
         #define SWIFFT_ISET() AVX2
         #include "swifft_iset.inl"
@@ -11,7 +11,9 @@
 #ifndef __LIBSWIFFT_SWIFFT_AVX512_H_
 #define __LIBSWIFFT_SWIFFT_AVX512_H_
 
-#if defined(__AVX512F__)
+#include "swifft_common.h"
+
+#if defined(SWIFFT_HAVE_AVX512)
 	#undef SWIFFT_ISET
         #define SWIFFT_ISET() AVX512
         #include "swifft_iset.inl"
@@ -0,0 +1,24 @@
+/*
+ * Copyright (C) 2021 Yaron Gvili and Gvili Tech Ltd.
+ *
+ * See the accompanying LICENSE.txt file for licensing information.
+ */
+/*! \file include/swifft_avx512bw.h
+ * \brief LibSWIFFT public C API for AVX512BW
+ *
+ * See "include/swifft_iset.inl" for code expanded here with SWIFFT_ISET set to AVX512BW.
+ */
+#ifndef __LIBSWIFFT_SWIFFT_AVX512BW_H_
+#define __LIBSWIFFT_SWIFFT_AVX512BW_H_
+
+#include "swifft_common.h"
+
+#if defined(SWIFFT_HAVE_AVX512BW)
+	#undef SWIFFT_ISET
+        #define SWIFFT_ISET() AVX512BW
+        #include "swifft_iset.inl"
+#else
+        #pragma message "LibSWIFFT API for AVX512BW is disabled"
+#endif
+
+#endif /* __LIBSWIFFT_SWIFFT_AVX512BW_H_ */
@@ -9,6 +9,7 @@
 #ifndef __LIBSWIFFT_SWIFFT_COMMON_H__
 #define __LIBSWIFFT_SWIFFT_COMMON_H__
 
+#include <stddef.h> // for size_t
 #include <stdint.h> // for int16_t
 #include "common.h"
 
@@ -24,6 +25,17 @@ typedef unsigned char BitSequence; ///< Basic buffer type
 //! Align attribute for SWIFFT vector
 #define SWIFFT_ALIGN __attribute__ ((aligned (SWIFFT_ALIGNMENT)))
 
+#if defined(__x86_64__) || defined(__i386__) || defined(__AVX__)
+	#define SWIFFT_HAVE_AVX     ///< The library provides the AVX instruction-set variant
+	#define SWIFFT_HAVE_AVX2    ///< The library provides the AVX2 instruction-set variant
+	#define SWIFFT_HAVE_AVX512  ///< The library provides the AVX512 instruction-set variant
+	#define SWIFFT_HAVE_AVX512BW ///< The library provides the AVX512BW instruction-set variant
+#endif
+#if defined(__aarch64__)
+	#define SWIFFT_HAVE_NEON    ///< The library provides the NEON instruction-set variant
+	#define SWIFFT_HAVE_SVE2    ///< The library provides the SVE2 instruction-set variant
+#endif
+
 //! The size in bytes of SWIFFT input.
 #define SWIFFT_INPUT_BLOCK_SIZE 256
 
@@ -33,4 +45,61 @@ typedef unsigned char BitSequence; ///< Basic buffer type
 //! The size in bytes of SWIFFT compact-form.
 #define SWIFFT_COMPACT_BLOCK_SIZE 64
 
+//! The size in bytes of a chunk of SWIFFT input, the input of one FFT.
+#define SWIFFT_CHUNK_SIZE 8
+
+//! The number of chunks of SWIFFT input.
+#define SWIFFT_INPUT_CHUNKS (SWIFFT_INPUT_BLOCK_SIZE / SWIFFT_CHUNK_SIZE)
+
+//! The number of chunks that short SWIFFT input, as hashed by SWIFFT_ComputeShort and
+//! its variants, must be a multiple of. Short input of m chunks is hashed as if padded
+//! with zero chunks to SWIFFT_INPUT_CHUNKS, using only the first m chunks of the key.
+#define SWIFFT_SHORT_CHUNKS_MULTIPLE 4
+
+//! The size in bytes of packed signed SWIFFT input. Each chunk of input bytes is
+//! followed by the chunk of its sign bytes, so a block is read as one stream.
+#define SWIFFT_PACKED_BLOCK_SIZE (2 * SWIFFT_INPUT_BLOCK_SIZE)
+
+//! The number of Z_{257} elements of a SWIFFT key.
+#define SWIFFT_KEY_ELEMENTS 2048
+
+//! \brief A SWIFFT key that is ready for use by keyed SWIFFT operations.
+//! Initialize it using SWIFFT_InitKey. Use SWIFFT_ALIGN, or an allocator with
+//! the same alignment, on each declaration of this data structure.
+typedef struct {
+	SWIFFT_ALIGN int16_t elements[SWIFFT_KEY_ELEMENTS]; ///< The key elements, centered and interleaved for the keyed operations
+} swifft_key_t;
+
+//! The number of reduced SWIFFT hash values that may be added to or subtracted from
+//! an accumulator before its elements are folded back into range. Each element
+//! of a reduced hash value is in {0,..,256}, and a folded element is in
+//! {-127,..,383}, so the unreduced sums stay within int16_t.
+#define SWIFFT_ACCUMULATOR_HEADROOM 126
+
+//! \brief An unreduced sum of SWIFFT hash values, for adding up many of them with a single reduction.
+//! Initialize it using SWIFFT_AccumulatorInit and reduce it using SWIFFT_Reduce. Use
+//! SWIFFT_ALIGN, or an allocator with the same alignment, on each declaration of this data structure.
+typedef struct {
+	SWIFFT_ALIGN int16_t elements[SWIFFT_OUTPUT_BLOCK_SIZE/sizeof(int16_t)]; ///< The unreduced sums of the hash value elements
+	int pending;                                                          ///< The number of hash values added or subtracted since the last fold
+} swifft_accumulator_t;
+
+//! The maximum number of hash values on the stack of a program of SWIFFT_EvalMultiple.
+#define SWIFFT_EVAL_MAX_STACK 8
+
+//! \brief The operation codes of a program of SWIFFT_EvalMultiple.
+typedef enum {
+	SWIFFT_OP_LOAD = 0,  ///< Pushes the hash value of the block in the operand array with index arg
+	SWIFFT_OP_CONST = 1, ///< Pushes a hash value with each element equal to arg, mod 257
+	SWIFFT_OP_ADD = 2,   ///< Pops b, pops a, and pushes a + b, element-wise
+	SWIFFT_OP_SUB = 3,   ///< Pops b, pops a, and pushes a - b, element-wise
+	SWIFFT_OP_MUL = 4    ///< Pops b, pops a, and pushes a * b, element-wise
+} swifft_opcode_t;
+
+//! \brief An operation of a program of SWIFFT_EvalMultiple, which runs on a stack of hash values.
+typedef struct {
+	int16_t opcode; ///< The operation code, a swifft_opcode_t
+	int16_t arg;    ///< The argument of the operation, if any
+} swifft_op_t;
+
 #endif /* __LIBSWIFFT_SWIFFT_COMMON_H__ */
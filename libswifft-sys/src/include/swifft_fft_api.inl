@@ -39,7 +39,7 @@ void LIBSWIFFT_API(SWIFFT_fftsum)(const int16_t * LIBSWIFFT_RESTRICT ikey,
 //! \param[in] sign the blocks of sign bits corresponding to blocks of input of 256 bytes (2048 bits).
 //! \param[in] m number of 8-elements in the input.
 //! \param[out] fftout the blocks of FFT-output elements, totaling N*m.
-void LIBSWIFFT_API(SWIFFT_fftMultiple)(int nblocks, const BitSequence * LIBSWIFFT_RESTRICT input, const BitSequence * LIBSWIFFT_RESTRICT sign, int m, int16_t * LIBSWIFFT_RESTRICT fftout);
+void LIBSWIFFT_API(SWIFFT_fftMultiple)(size_t nblocks, const BitSequence * LIBSWIFFT_RESTRICT input, const BitSequence * LIBSWIFFT_RESTRICT sign, int m, int16_t * LIBSWIFFT_RESTRICT fftout);
 
 //! \brief Computes the FFT-sum phase of SWIFFT for multiple blocks.
 //!
@@ -48,5 +48,5 @@ void LIBSWIFFT_API(SWIFFT_fftMultiple)(int nblocks, const BitSequence * LIBSWIFF
 //! \param[in] ifftout the blocks of FFT-output elements, totaling N*m
 //! \param[in] m number of 8-elements in the input.
 //! \param[out] iout the blocks of output elements, each of 64 double-bytes (1024 bits).
-void LIBSWIFFT_API(SWIFFT_fftsumMultiple)(int nblocks, const int16_t * LIBSWIFFT_RESTRICT ikey,
+void LIBSWIFFT_API(SWIFFT_fftsumMultiple)(size_t nblocks, const int16_t * LIBSWIFFT_RESTRICT ikey,
         const int16_t * LIBSWIFFT_RESTRICT ifftout, int m, int16_t * LIBSWIFFT_RESTRICT iout);
@@ -25,9 +25,17 @@ void LIBSWIFFT_API(SWIFFT_Compact)(const BitSequence output[SWIFFT_OUTPUT_BLOCK_
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in] output the hash value of SWIFFT, of size 128 bytes (1024 bit).
 //! \param[out] compact the compacted hash value of SWIFFT, of size 64 bytes (512 bit).
-void LIBSWIFFT_API(SWIFFT_CompactMultiple)(int nblocks, const BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
+void LIBSWIFFT_API(SWIFFT_CompactMultiple)(size_t nblocks, const BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
 	BitSequence compact[SWIFFT_COMPACT_BLOCK_SIZE]);
 
+//! \brief Initializes a SWIFFT key from elements of Z_{257}.
+//! The elements are given in the layout of FFT-output elements, which is the one
+//! expected by SWIFFT_fftsum, and may be in any range of int16_t.
+//!
+//! \param[out] key the SWIFFT key to initialize.
+//! \param[in] coefficients the elements of the key, of size 2048 double-bytes.
+void LIBSWIFFT_API(SWIFFT_InitKey)(swifft_key_t * key, const int16_t coefficients[SWIFFT_KEY_ELEMENTS]);
+
 //! \brief Computes the result of a SWIFFT operation.
 //! The result is composable with other hash values.
 //!
@@ -52,7 +60,7 @@ void LIBSWIFFT_API(SWIFFT_ComputeSigned)(const BitSequence input[SWIFFT_INPUT_BL
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in] input the blocks of input, each of 256 bytes (2048 bit).
 //! \param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).
-void LIBSWIFFT_API(SWIFFT_ComputeMultiple)(int nblocks, const BitSequence * input, BitSequence * output);
+void LIBSWIFFT_API(SWIFFT_ComputeMultiple)(size_t nblocks, const BitSequence * input, BitSequence * output);
 
 //! \brief Computes the result of multiple SWIFFT operations.
 //! The result is composable with other hash values.
@@ -61,5 +69,154 @@ void LIBSWIFFT_API(SWIFFT_ComputeMultiple)(int nblocks, const BitSequence * inpu
 //! \param[in] input the blocks of input, each of 256 bytes (2048 bit).
 //! \param[in] sign the blocks of sign bits corresponding to blocks of input of 256 bytes (2048 bit).
 //! \param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).
-void LIBSWIFFT_API(SWIFFT_ComputeMultipleSigned)(int nblocks, const BitSequence * input,
+void LIBSWIFFT_API(SWIFFT_ComputeMultipleSigned)(size_t nblocks, const BitSequence * input,
+	const BitSequence * sign, BitSequence * output);
+
+//! \brief Computes the compacted result of multiple SWIFFT operations.
+//! The result is the same as that of SWIFFT_ComputeMultiple followed by SWIFFT_CompactMultiple.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] input the blocks of input, each of 256 bytes (2048 bit).
+//! \param[out] compact the resulting blocks of compacted hash values of SWIFFT, each of size 64 bytes (512 bit).
+void LIBSWIFFT_API(SWIFFT_ComputeCompactMultiple)(size_t nblocks, const BitSequence * input, BitSequence * compact);
+
+//! \brief Updates the result of a SWIFFT operation for a change of one chunk of its input.
+//! The result is the same as that of SWIFFT_Compute on the changed input.
+//!
+//! \param[in,out] output the hash value of SWIFFT to modify, of size 128 bytes (1024 bit).
+//! \param[in] oldChunk the old chunk of 8 bytes.
+//! \param[in] newChunk the new chunk of 8 bytes.
+//! \param[in] chunkIndex the index of the chunk in the input, from 0 to SWIFFT_INPUT_CHUNKS-1.
+void LIBSWIFFT_API(SWIFFT_Update)(BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
+	const BitSequence oldChunk[SWIFFT_CHUNK_SIZE], const BitSequence newChunk[SWIFFT_CHUNK_SIZE],
+	int chunkIndex);
+
+//! \brief Updates the results of multiple SWIFFT operations, each for a change of one chunk of its input.
+//! The result is the same as that of SWIFFT_ComputeMultiple on the changed inputs.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in,out] output the blocks of hash values of SWIFFT to modify, each of size 128 bytes (1024 bit).
+//! \param[in] oldChunk the old chunks, one per block, each of 8 bytes.
+//! \param[in] newChunk the new chunks, one per block, each of 8 bytes.
+//! \param[in] chunkIndex the indices of the chunks in the inputs, one per block, each from 0 to SWIFFT_INPUT_CHUNKS-1.
+void LIBSWIFFT_API(SWIFFT_UpdateMultiple)(size_t nblocks, BitSequence * output,
+	const BitSequence * oldChunk, const BitSequence * newChunk, const int * chunkIndex);
+
+//! \brief Computes the result of a SWIFFT operation using a given key.
+//! The result is composable with other hash values computed using the same key.
+//!
+//! \param[in] key the SWIFFT key.
+//! \param[in] input the input of 256 bytes (2048 bit).
+//! \param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit).
+void LIBSWIFFT_API(SWIFFT_ComputeKeyed)(const swifft_key_t * key, const BitSequence input[SWIFFT_INPUT_BLOCK_SIZE],
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE]);
+
+//! \brief Computes the result of a SWIFFT operation using a given key.
+//! The result is composable with other hash values computed using the same key.
+//!
+//! \param[in] key the SWIFFT key.
+//! \param[in] input the input of 256 bytes (2048 bit).
+//! \param[in] sign the sign bits corresponding to the input of 256 bytes (2048 bit).
+//! \param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit).
+void LIBSWIFFT_API(SWIFFT_ComputeSignedKeyed)(const swifft_key_t * key, const BitSequence input[SWIFFT_INPUT_BLOCK_SIZE],
+	const BitSequence sign[SWIFFT_INPUT_BLOCK_SIZE],
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE]);
+
+//! \brief Computes the result of multiple SWIFFT operations using a given key.
+//! The result is composable with other hash values computed using the same key.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] key the SWIFFT key.
+//! \param[in] input the blocks of input, each of 256 bytes (2048 bit).
+//! \param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).
+void LIBSWIFFT_API(SWIFFT_ComputeMultipleKeyed)(size_t nblocks, const swifft_key_t * key, const BitSequence * input,
+	BitSequence * output);
+
+//! \brief Computes the result of multiple SWIFFT operations using a given key.
+//! The result is composable with other hash values computed using the same key.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] key the SWIFFT key.
+//! \param[in] input the blocks of input, each of 256 bytes (2048 bit).
+//! \param[in] sign the blocks of sign bits corresponding to blocks of input of 256 bytes (2048 bit).
+//! \param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).
+void LIBSWIFFT_API(SWIFFT_ComputeMultipleSignedKeyed)(size_t nblocks, const swifft_key_t * key, const BitSequence * input,
+	const BitSequence * sign, BitSequence * output);
+
+//! \brief Computes the result of a SWIFFT operation on packed signed input.
+//! The packed input holds, for each chunk of 8 input bytes, the chunk followed by its 8 sign bytes,
+//! so a {-1,0,1} vector is read as one stream rather than as separate input and sign blocks.
+//! The result is the same as that of SWIFFT_ComputeSigned on the unpacked input and sign bits.
+//!
+//! \param[in] packed the packed signed input of 512 bytes, as given by SWIFFT_PACKED_BLOCK_SIZE.
+//! \param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit).
+void LIBSWIFFT_API(SWIFFT_ComputeSignedPacked)(const BitSequence packed[SWIFFT_PACKED_BLOCK_SIZE],
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE]);
+
+//! \brief Computes the result of multiple SWIFFT operations on packed signed input.
+//! The result is the same as that of SWIFFT_ComputeMultipleSigned on the unpacked blocks of input and sign bits.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] packed the blocks of packed signed input, each of 512 bytes.
+//! \param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).
+void LIBSWIFFT_API(SWIFFT_ComputeMultipleSignedPacked)(size_t nblocks, const BitSequence * packed, BitSequence * output);
+
+//! \brief Computes the results of multiple SWIFFT operations under each of several keys.
+//! The result for each key is the same as that of SWIFFT_ComputeMultipleKeyed, or of
+//! SWIFFT_ComputeMultipleSignedKeyed given sign bits, but the FFT phase, which does not
+//! depend on the key, is computed once per block.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] input the blocks of input, each of 256 bytes (2048 bit).
+//! \param[in] sign the blocks of sign bits corresponding to blocks of input of 256 bytes (2048 bit), or NULL for unsigned input.
+//! \param[in] nkeys the number of keys.
+//! \param[in] keys the SWIFFT keys.
+//! \param[out] outputs the resulting blocks of hash values of SWIFFT, per key, each block of size 128 bytes (1024 bit).
+void LIBSWIFFT_API(SWIFFT_ComputeMultiKey)(size_t nblocks, const BitSequence * input, const BitSequence * sign,
+	int nkeys, const swifft_key_t * const * keys, BitSequence * const * outputs);
+
+//! \brief Computes the result of a SWIFFT operation on short input.
+//! The result is the same as that of SWIFFT_Compute on the input padded with zero bytes to 256 bytes,
+//! but the work is proportional to the number of chunks of input.
+//!
+//! \param[in] m the number of chunks of input, a multiple of SWIFFT_SHORT_CHUNKS_MULTIPLE up to SWIFFT_INPUT_CHUNKS.
+//! \param[in] input the input of m chunks of 8 bytes.
+//! \param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit).
+//! \returns 0 on success, or -1 if m is invalid.
+int LIBSWIFFT_API(SWIFFT_ComputeShort)(int m, const BitSequence * input,
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE]);
+
+//! \brief Computes the result of a SWIFFT operation on short signed input.
+//! The result is the same as that of SWIFFT_ComputeSigned on the input and sign bits padded with zero bytes to 256 bytes,
+//! but the work is proportional to the number of chunks of input.
+//!
+//! \param[in] m the number of chunks of input, a multiple of SWIFFT_SHORT_CHUNKS_MULTIPLE up to SWIFFT_INPUT_CHUNKS.
+//! \param[in] input the input of m chunks of 8 bytes.
+//! \param[in] sign the sign bits corresponding to the input of m chunks of 8 bytes.
+//! \param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit).
+//! \returns 0 on success, or -1 if m is invalid.
+int LIBSWIFFT_API(SWIFFT_ComputeSignedShort)(int m, const BitSequence * input, const BitSequence * sign,
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE]);
+
+//! \brief Computes the result of multiple SWIFFT operations on short input.
+//! The result is the same as that of SWIFFT_ComputeMultiple on the blocks of input each padded with zero bytes to 256 bytes.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] m the number of chunks of input per block, a multiple of SWIFFT_SHORT_CHUNKS_MULTIPLE up to SWIFFT_INPUT_CHUNKS.
+//! \param[in] input the blocks of input, each of m chunks of 8 bytes.
+//! \param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).
+//! \returns 0 on success, or -1 if m is invalid.
+int LIBSWIFFT_API(SWIFFT_ComputeMultipleShort)(size_t nblocks, int m, const BitSequence * input, BitSequence * output);
+
+//! \brief Computes the result of multiple SWIFFT operations on short signed input.
+//! The result is the same as that of SWIFFT_ComputeMultipleSigned on the blocks of input and
+//! sign bits each padded with zero bytes to 256 bytes.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] m the number of chunks of input per block, a multiple of SWIFFT_SHORT_CHUNKS_MULTIPLE up to SWIFFT_INPUT_CHUNKS.
+//! \param[in] input the blocks of input, each of m chunks of 8 bytes.
+//! \param[in] sign the blocks of sign bits corresponding to blocks of input, each of m chunks of 8 bytes.
+//! \param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).
+//! \returns 0 on success, or -1 if m is invalid.
+int LIBSWIFFT_API(SWIFFT_ComputeMultipleSignedShort)(size_t nblocks, int m, const BitSequence * input,
 	const BitSequence * sign, BitSequence * output);
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2021 Yaron Gvili and Gvili Tech Ltd.
+ *
+ * See the accompanying LICENSE.txt file for licensing information.
+ */
+/*! \file include/swifft_index.h
+ * \brief LibSWIFFT public C API for indexing compact SWIFFT digests
+ *
+ * An index maps compact digests, of SWIFFT_COMPACT_BLOCK_SIZE bytes, to 64-bit
+ * values, such as offsets of deduplicated content. It is an open-addressing table
+ * of groups of SWIFFT_INDEX_GROUP_SLOTS slots, each with a tag byte taken from
+ * the hash of its digest, so a probe matches the tags of a whole group using SIMD
+ * instructions and compares only the digests whose tags match. Operations run on
+ * batches of digests, prefetching the groups of the next digests of a batch while
+ * probing for the current ones.
+ *
+ * An index either lives in memory or is mapped from a file, whose format is the
+ * image of the index in memory, so reopening the file uses the index in place,
+ * without rebuilding it. The format is that of the host, whose byte order the file
+ * records. An index holds up to the number of entries it is created for, and its
+ * entries are never removed.
+ *
+ * An index may be probed from multiple threads at once, but not while it is being
+ * inserted into.
+ */
+#ifndef __LIBSWIFFT_SWIFFT_INDEX_H__
+#define __LIBSWIFFT_SWIFFT_INDEX_H__
+
+#include <stddef.h> // for size_t
+#include <stdint.h> // for uint64_t
+#include "swifft_common.h"
+
+LIBSWIFFT_BEGIN_EXTERN_C
+
+//! The number of slots of a group of an index, whose tags are matched at once.
+#define SWIFFT_INDEX_GROUP_SLOTS 16
+
+//! The value SWIFFT_IndexLookupMultiple gives for a digest not in the index, which may not be inserted.
+#define SWIFFT_INDEX_NOT_FOUND UINT64_MAX
+
+//! \brief An index of compact SWIFFT digests, opaque to the caller.
+typedef struct swifft_index_s swifft_index_t;
+
+//! \brief Creates an empty index in memory, on huge pages where available.
+//!
+//! \param[in] maxEntries the number of entries the index can hold.
+//! \returns the index, or NULL if memory is exhausted.
+swifft_index_t * SWIFFT_IndexCreate(size_t maxEntries);
+
+//! \brief Creates an empty index mapped from a file, which is created or truncated.
+//!
+//! \param[in] path the path of the file.
+//! \param[in] maxEntries the number of entries the index can hold.
+//! \returns the index, or NULL if the file cannot be created or mapped, with errno set.
+swifft_index_t * SWIFFT_IndexCreateFile(const char * path, size_t maxEntries);
+
+//! \brief Opens an index mapped from a file created by SWIFFT_IndexCreateFile.
+//! The index is used in place, without rebuilding it.
+//!
+//! \param[in] path the path of the file.
+//! \param[in] writable whether to allow inserting into the index.
+//! \returns the index, or NULL if the file cannot be opened or mapped, with errno set,
+//! e.g. to EINVAL if it is not an index in the format of the host.
+swifft_index_t * SWIFFT_IndexOpenFile(const char * path, int writable);
+
+//! \brief Inserts multiple compact digests into an index, each unless it is already there.
+//! A digest repeated within the batch is inserted once, with the value of its first occurrence.
+//!
+//! \param[in,out] index the index.
+//! \param[in] nblocks the number of digests.
+//! \param[in] compact the compact digests, each of 64 bytes (512 bit).
+//! \param[in] values the values of the digests, other than SWIFFT_INDEX_NOT_FOUND.
+//! \param[out] stored the values that the index holds for the digests, which equal their
+//! values for the digests inserted and are those inserted before for the others, or NULL.
+//! \returns 0 on success, or -1 if the index is full or not writable, in which case only the
+//! digests before the first that did not fit are inserted and have their stored values given.
+int SWIFFT_IndexInsertMultiple(swifft_index_t * index, size_t nblocks, const BitSequence * compact,
+	const uint64_t * values, uint64_t * stored);
+
+//! \brief Computes the compact digests of multiple blocks of input and inserts them into an index,
+//! as SWIFFT_ComputeCompactMultiple does followed by SWIFFT_IndexInsertMultiple, tile by tile
+//! so that the digests are inserted while they are in cache.
+//!
+//! \param[in,out] index the index.
+//! \param[in] nblocks the number of blocks of input.
+//! \param[in] input the blocks of input, each of 256 bytes (2048 bit).
+//! \param[out] compact the resulting compact digests, each of 64 bytes (512 bit), or NULL if they are not needed.
+//! \param[in] values the values of the digests, other than SWIFFT_INDEX_NOT_FOUND.
+//! \param[out] stored the values that the index holds for the digests, as given by SWIFFT_IndexInsertMultiple, or NULL.
+//! \returns 0 on success, or -1 if the index is full or not writable, or if memory is exhausted.
+int SWIFFT_IndexComputeInsertMultiple(swifft_index_t * index, size_t nblocks, const BitSequence * input,
+	BitSequence * compact, const uint64_t * values, uint64_t * stored);
+
+//! \brief Looks up multiple compact digests in an index.
+//!
+//! \param[in] index the index.
+//! \param[in] nblocks the number of digests.
+//! \param[in] compact the compact digests, each of 64 bytes (512 bit).
+//! \param[out] values the values of the digests, or SWIFFT_INDEX_NOT_FOUND for those not in the index.
+void SWIFFT_IndexLookupMultiple(const swifft_index_t * index, size_t nblocks, const BitSequence * compact,
+	uint64_t * values);
+
+//! \brief Returns the number of entries of an index.
+//!
+//! \param[in] index the index.
+//! \returns the number of entries.
+size_t SWIFFT_IndexCount(const swifft_index_t * index);
+
+//! \brief Returns the number of entries an index can hold.
+//!
+//! \param[in] index the index.
+//! \returns the number of entries the index can hold.
+size_t SWIFFT_IndexMaxEntries(const swifft_index_t * index);
+
+//! \brief Writes an index mapped from a file back to the file, waiting for the writes to complete.
+//!
+//! \param[in] index the index.
+//! \returns 0 on success, or -1 on an error, with errno set. An index in memory always succeeds.
+int SWIFFT_IndexSync(swifft_index_t * index);
+
+//! \brief Destroys an index, unmapping it. An index mapped from a file stays in the file,
+//! which is written back by the system unless SWIFFT_IndexSync is called to do so before.
+//!
+//! \param[in] index the index, or NULL.
+void SWIFFT_IndexDestroy(swifft_index_t * index);
+
+LIBSWIFFT_END_EXTERN_C
+
+#endif /* __LIBSWIFFT_SWIFFT_INDEX_H__ */
@@ -10,7 +10,7 @@
 
 #undef SWIFFT_ISET_NAME
 #ifndef SWIFFT_ISET
-        #error "SWIFFT_ISET() must be defined as AVX, AVX2, or AVX512"
+        #error "SWIFFT_ISET() must be defined as AVX, AVX2, AVX512, AVX512BW, NEON, or SVE2"
 #endif
 #define SWIFFT_ISET_NAME(name) LIBSWIFFT_CONCAT(name,SWIFFT_ISET()) ///< Adds a suffix SWIFFT_ISET, a macro which must be defined prior to including
 
@@ -89,6 +89,35 @@ void SWIFFT_ISET_NAME(SWIFFT_Sub_)(BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
 void SWIFFT_ISET_NAME(SWIFFT_Mul_)(BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
         const BitSequence operand[SWIFFT_OUTPUT_BLOCK_SIZE]);
 
+//! \brief Initializes an accumulator of SWIFFT hash values to zero.
+//!
+//! \param[out] acc the accumulator.
+void SWIFFT_ISET_NAME(SWIFFT_AccumulatorInit_)(swifft_accumulator_t * acc);
+
+//! \brief Adds a SWIFFT hash value to an accumulator, without reducing the sum.
+//! The elements are folded, with a partial reduction, once every SWIFFT_ACCUMULATOR_HEADROOM operations.
+//!
+//! \param[in,out] acc the accumulator.
+//! \param[in] operand the reduced hash value to add.
+void SWIFFT_ISET_NAME(SWIFFT_AccumulatorAdd_)(swifft_accumulator_t * acc,
+	const BitSequence operand[SWIFFT_OUTPUT_BLOCK_SIZE]);
+
+//! \brief Subtracts a SWIFFT hash value from an accumulator, without reducing the difference.
+//! The elements are folded, with a partial reduction, once every SWIFFT_ACCUMULATOR_HEADROOM operations.
+//!
+//! \param[in,out] acc the accumulator.
+//! \param[in] operand the reduced hash value to subtract.
+void SWIFFT_ISET_NAME(SWIFFT_AccumulatorSub_)(swifft_accumulator_t * acc,
+	const BitSequence operand[SWIFFT_OUTPUT_BLOCK_SIZE]);
+
+//! \brief Reduces an accumulator of SWIFFT hash values to a hash value.
+//! The result is the same as that of the additions and subtractions of the accumulator done using SWIFFT_Add and SWIFFT_Sub.
+//!
+//! \param[in] acc the accumulator.
+//! \param[out] output the resulting hash value of SWIFFT.
+void SWIFFT_ISET_NAME(SWIFFT_Reduce_)(const swifft_accumulator_t * acc,
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE]);
+
 //! \brief Computes the result of a SWIFFT operation.
 //! The result is composable with other hash values.
 //!
@@ -114,7 +143,7 @@ void SWIFFT_ISET_NAME(SWIFFT_ComputeSigned_)(const BitSequence input[SWIFFT_INPU
 //! \param[in] sign the blocks of sign bits corresponding to blocks of input of 256 bytes (2048 bits).
 //! \param[in] m number of 8-elements in the input.
 //! \param[out] fftout the blocks of FFT-output elements, totaling nblocks*N*m.
-void SWIFFT_ISET_NAME(SWIFFT_fftMultiple_)(int nblocks, const BitSequence * LIBSWIFFT_RESTRICT input, const BitSequence * LIBSWIFFT_RESTRICT sign, int m, int16_t * LIBSWIFFT_RESTRICT fftout);
+void SWIFFT_ISET_NAME(SWIFFT_fftMultiple_)(size_t nblocks, const BitSequence * LIBSWIFFT_RESTRICT input, const BitSequence * LIBSWIFFT_RESTRICT sign, int m, int16_t * LIBSWIFFT_RESTRICT fftout);
 
 //! \brief Computes the FFT-sum phase of SWIFFT for multiple blocks.
 //!
@@ -123,7 +152,7 @@ void SWIFFT_ISET_NAME(SWIFFT_fftMultiple_)(int nblocks, const BitSequence * LIBS
 //! \param[in] ifftout the blocks of FFT-output elements, totaling N*m
 //! \param[in] m number of 8-elements in the input.
 //! \param[out] iout the blocks of output elements, each of 64 double-bytes (1024 bits).
-void SWIFFT_ISET_NAME(SWIFFT_fftsumMultiple_)(int nblocks, const int16_t * LIBSWIFFT_RESTRICT ikey,
+void SWIFFT_ISET_NAME(SWIFFT_fftsumMultiple_)(size_t nblocks, const int16_t * LIBSWIFFT_RESTRICT ikey,
         const int16_t * LIBSWIFFT_RESTRICT ifftout, int m, int16_t * LIBSWIFFT_RESTRICT iout);
 
 //! \brief Compacts a hash value of SWIFFT for multiple blocks.
@@ -132,7 +161,7 @@ void SWIFFT_ISET_NAME(SWIFFT_fftsumMultiple_)(int nblocks, const int16_t * LIBSW
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in] output the hash value of SWIFFT, of size 128 bytes (1024 bit) per block.
 //! \param[out] compact the compacted hash value of SWIFFT, of size 64 bytes (512 bit) per block.
-void SWIFFT_ISET_NAME(SWIFFT_CompactMultiple_)(int nblocks, const BitSequence * output,
+void SWIFFT_ISET_NAME(SWIFFT_CompactMultiple_)(size_t nblocks, const BitSequence * output,
         BitSequence * compact);
 
 //! \brief Sets a constant value at each SWIFFT hash value element for multiple blocks.
@@ -140,7 +169,7 @@ void SWIFFT_ISET_NAME(SWIFFT_CompactMultiple_)(int nblocks, const BitSequence *
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[out] output the hash value of SWIFFT to modify, per block.
 //! \param[in] operand the constant value to set, per block.
-void SWIFFT_ISET_NAME(SWIFFT_ConstSetMultiple_)(int nblocks, BitSequence * output,
+void SWIFFT_ISET_NAME(SWIFFT_ConstSetMultiple_)(size_t nblocks, BitSequence * output,
         const int16_t * operand);
 
 //! \brief Adds a constant value to each SWIFFT hash value element for multiple blocks.
@@ -148,7 +177,7 @@ void SWIFFT_ISET_NAME(SWIFFT_ConstSetMultiple_)(int nblocks, BitSequence * outpu
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in,out] output the hash value of SWIFFT to modify, per block.
 //! \param[in] operand the constant value to add, per block.
-void SWIFFT_ISET_NAME(SWIFFT_ConstAddMultiple_)(int nblocks, BitSequence * output,
+void SWIFFT_ISET_NAME(SWIFFT_ConstAddMultiple_)(size_t nblocks, BitSequence * output,
         const int16_t * operand);
 
 //! \brief Subtracts a constant value from each SWIFFT hash value element for multiple blocks.
@@ -156,7 +185,7 @@ void SWIFFT_ISET_NAME(SWIFFT_ConstAddMultiple_)(int nblocks, BitSequence * outpu
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in,out] output the hash value of SWIFFT to modify, per block..
 //! \param[in] operand the constant value to subtract, per block.
-void SWIFFT_ISET_NAME(SWIFFT_ConstSubMultiple_)(int nblocks, BitSequence * output,
+void SWIFFT_ISET_NAME(SWIFFT_ConstSubMultiple_)(size_t nblocks, BitSequence * output,
         const int16_t * operand);
 
 //! \brief Multiply a constant value into each SWIFFT hash value element for multiple blocks.
@@ -164,7 +193,7 @@ void SWIFFT_ISET_NAME(SWIFFT_ConstSubMultiple_)(int nblocks, BitSequence * outpu
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in,out] output the hash value of SWIFFT to modify, per block..
 //! \param[in] operand the constant value to multiply by, per block.
-void SWIFFT_ISET_NAME(SWIFFT_ConstMulMultiple_)(int nblocks, BitSequence * output,
+void SWIFFT_ISET_NAME(SWIFFT_ConstMulMultiple_)(size_t nblocks, BitSequence * output,
         const int16_t * operand);
 
 //! \brief Sets a SWIFFT hash value to another, element-wise, for multiple blocks.
@@ -172,7 +201,7 @@ void SWIFFT_ISET_NAME(SWIFFT_ConstMulMultiple_)(int nblocks, BitSequence * outpu
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in,out] output the hash value of SWIFFT to modify, per block..
 //! \param[in] operand the hash value to set to, per block.
-void SWIFFT_ISET_NAME(SWIFFT_SetMultiple_)(int nblocks, BitSequence * output,
+void SWIFFT_ISET_NAME(SWIFFT_SetMultiple_)(size_t nblocks, BitSequence * output,
         const BitSequence * operand);
 
 //! \brief Adds a SWIFFT hash value to another, element-wise, for multiple blocks.
@@ -180,7 +209,7 @@ void SWIFFT_ISET_NAME(SWIFFT_SetMultiple_)(int nblocks, BitSequence * output,
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in,out] output the hash value of SWIFFT to modify, per block..
 //! \param[in] operand the hash value to add, per block.
-void SWIFFT_ISET_NAME(SWIFFT_AddMultiple_)(int nblocks, BitSequence * output,
+void SWIFFT_ISET_NAME(SWIFFT_AddMultiple_)(size_t nblocks, BitSequence * output,
         const BitSequence * operand);
 
 //! \brief Subtracts a SWIFFT hash value from another, element-wise, for multiple blocks.
@@ -188,7 +217,7 @@ void SWIFFT_ISET_NAME(SWIFFT_AddMultiple_)(int nblocks, BitSequence * output,
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in,out] output the hash value of SWIFFT to modify, per block..
 //! \param[in] operand the hash value to subtract, per block.
-void SWIFFT_ISET_NAME(SWIFFT_SubMultiple_)(int nblocks, BitSequence * output,
+void SWIFFT_ISET_NAME(SWIFFT_SubMultiple_)(size_t nblocks, BitSequence * output,
         const BitSequence * operand);
 
 //! \brief Multiplies a SWIFFT hash value from another, element-wise, for multiple blocks.
@@ -196,16 +225,51 @@ void SWIFFT_ISET_NAME(SWIFFT_SubMultiple_)(int nblocks, BitSequence * output,
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in,out] output the hash value of SWIFFT to modify, per block..
 //! \param[in] operand the hash value to multiply by, per block.
-void SWIFFT_ISET_NAME(SWIFFT_MulMultiple_)(int nblocks, BitSequence * output,
+void SWIFFT_ISET_NAME(SWIFFT_MulMultiple_)(size_t nblocks, BitSequence * output,
         const BitSequence * operand);
 
+//! \brief Sums SWIFFT hash values of multiple blocks, reducing only once per SWIFFT_ACCUMULATOR_HEADROOM blocks.
+//! The result is the same as that of adding the hash values one by one using SWIFFT_Add.
+//!
+//! \param[in] nblocks the number of blocks to sum.
+//! \param[in] operand the reduced hash values to sum, per block.
+//! \param[out] output the resulting hash value of SWIFFT.
+void SWIFFT_ISET_NAME(SWIFFT_SumMultiple_)(size_t nblocks, const BitSequence * operand,
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE]);
+
+//! \brief Computes a linear combination of SWIFFT hash values of multiple blocks, reducing each product only partially.
+//! The result is the sum of the products of the hash values by their coefficients, mod 257.
+//!
+//! \param[in] nblocks the number of blocks to combine.
+//! \param[in] coeffs the coefficients, per block, in any range of int16_t.
+//! \param[in] operand the reduced hash values to combine, per block.
+//! \param[out] output the resulting hash value of SWIFFT.
+void SWIFFT_ISET_NAME(SWIFFT_LinearCombination_)(size_t nblocks, const int16_t * coeffs, const BitSequence * operand,
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE]);
+
+//! \brief Evaluates an element-wise expression of SWIFFT hash values for multiple blocks.
+//! The program runs on a stack of hash values for each block, and leaves the result as the
+//! only one on it. The stack of a range of blocks is held in a small buffer local to the
+//! computation, so each operand is read and the output is written once, in a single
+//! parallel run. Each operation reduces its result mod 257, as SWIFFT_Add does.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] program the operations of the expression, in postfix order.
+//! \param[in] nops the number of operations.
+//! \param[in] operands the arrays of reduced hash values of SWIFFT, per block, for SWIFFT_OP_LOAD.
+//! \param[in] noperands the number of arrays of operands.
+//! \param[out] output the resulting hash values of SWIFFT, per block, which may be an array of operands.
+//! \returns 0 on success, or -1 if the program is invalid or needs more than SWIFFT_EVAL_MAX_STACK hash values on the stack.
+int SWIFFT_ISET_NAME(SWIFFT_EvalMultiple_)(size_t nblocks, const swifft_op_t * program, int nops,
+	const BitSequence * const * operands, int noperands, BitSequence * output);
+
 //! \brief Computes the result of multiple SWIFFT operations.
 //! The result is composable with other hash values.
 //!
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in] input the blocks of input, each of 256 bytes (2048 bit).
 //! \param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).
-void SWIFFT_ISET_NAME(SWIFFT_ComputeMultiple_)(int nblocks, const BitSequence * input, BitSequence * output);
+void SWIFFT_ISET_NAME(SWIFFT_ComputeMultiple_)(size_t nblocks, const BitSequence * input, BitSequence * output);
 
 //! \brief Computes the result of multiple SWIFFT operations.
 //! The result is composable with other hash values.
@@ -214,7 +278,154 @@ void SWIFFT_ISET_NAME(SWIFFT_ComputeMultiple_)(int nblocks, const BitSequence *
 //! \param[in] input the blocks of input, each of 256 bytes (2048 bit).
 //! \param[in] sign the blocks of sign bits corresponding to blocks of input of 256 bytes (2048 bit).
 //! \param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).
-void SWIFFT_ISET_NAME(SWIFFT_ComputeMultipleSigned_)(int nblocks, const BitSequence * input,
+void SWIFFT_ISET_NAME(SWIFFT_ComputeMultipleSigned_)(size_t nblocks, const BitSequence * input,
+        const BitSequence * sign, BitSequence * output);
+
+//! \brief Computes the compacted result of multiple SWIFFT operations.
+//! The result is the same as that of SWIFFT_ComputeMultiple followed by SWIFFT_CompactMultiple.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] input the blocks of input, each of 256 bytes (2048 bit).
+//! \param[out] compact the resulting blocks of compacted hash values of SWIFFT, each of size 64 bytes (512 bit).
+void SWIFFT_ISET_NAME(SWIFFT_ComputeCompactMultiple_)(size_t nblocks, const BitSequence * input, BitSequence * compact);
+
+//! \brief Updates the result of a SWIFFT operation for a change of one chunk of its input.
+//! The result is the same as that of SWIFFT_Compute on the changed input.
+//!
+//! \param[in,out] output the hash value of SWIFFT to modify, of size 128 bytes (1024 bit).
+//! \param[in] oldChunk the old chunk of 8 bytes.
+//! \param[in] newChunk the new chunk of 8 bytes.
+//! \param[in] chunkIndex the index of the chunk in the input, from 0 to SWIFFT_INPUT_CHUNKS-1.
+void SWIFFT_ISET_NAME(SWIFFT_Update_)(BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
+	const BitSequence oldChunk[SWIFFT_CHUNK_SIZE], const BitSequence newChunk[SWIFFT_CHUNK_SIZE],
+	int chunkIndex);
+
+//! \brief Updates the results of multiple SWIFFT operations, each for a change of one chunk of its input.
+//! The result is the same as that of SWIFFT_ComputeMultiple on the changed inputs.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in,out] output the blocks of hash values of SWIFFT to modify, each of size 128 bytes (1024 bit).
+//! \param[in] oldChunk the old chunks, one per block, each of 8 bytes.
+//! \param[in] newChunk the new chunks, one per block, each of 8 bytes.
+//! \param[in] chunkIndex the indices of the chunks in the inputs, one per block, each from 0 to SWIFFT_INPUT_CHUNKS-1.
+void SWIFFT_ISET_NAME(SWIFFT_UpdateMultiple_)(size_t nblocks, BitSequence * output,
+	const BitSequence * oldChunk, const BitSequence * newChunk, const int * chunkIndex);
+
+//! \brief Computes the result of a SWIFFT operation using a given key.
+//! The result is composable with other hash values computed using the same key.
+//!
+//! \param[in] key the SWIFFT key.
+//! \param[in] input the input of 256 bytes (2048 bit).
+//! \param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit).
+void SWIFFT_ISET_NAME(SWIFFT_ComputeKeyed_)(const swifft_key_t * key, const BitSequence input[SWIFFT_INPUT_BLOCK_SIZE],
+        BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE]);
+
+//! \brief Computes the result of a SWIFFT operation using a given key.
+//! The result is composable with other hash values computed using the same key.
+//!
+//! \param[in] key the SWIFFT key.
+//! \param[in] input the input of 256 bytes (2048 bit).
+//! \param[in] sign the sign bits corresponding to the input of 256 bytes (2048 bit).
+//! \param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit).
+void SWIFFT_ISET_NAME(SWIFFT_ComputeSignedKeyed_)(const swifft_key_t * key, const BitSequence input[SWIFFT_INPUT_BLOCK_SIZE],
+        const BitSequence sign[SWIFFT_INPUT_BLOCK_SIZE],
+        BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE]);
+
+//! \brief Computes the result of multiple SWIFFT operations using a given key.
+//! The result is composable with other hash values computed using the same key.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] key the SWIFFT key.
+//! \param[in] input the blocks of input, each of 256 bytes (2048 bit).
+//! \param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).
+void SWIFFT_ISET_NAME(SWIFFT_ComputeMultipleKeyed_)(size_t nblocks, const swifft_key_t * key, const BitSequence * input,
+        BitSequence * output);
+
+//! \brief Computes the result of multiple SWIFFT operations using a given key.
+//! The result is composable with other hash values computed using the same key.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] key the SWIFFT key.
+//! \param[in] input the blocks of input, each of 256 bytes (2048 bit).
+//! \param[in] sign the blocks of sign bits corresponding to blocks of input of 256 bytes (2048 bit).
+//! \param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).
+void SWIFFT_ISET_NAME(SWIFFT_ComputeMultipleSignedKeyed_)(size_t nblocks, const swifft_key_t * key, const BitSequence * input,
+        const BitSequence * sign, BitSequence * output);
+
+//! \brief Computes the result of a SWIFFT operation on packed signed input.
+//! The result is the same as that of SWIFFT_ComputeSigned on the unpacked input and sign bits.
+//!
+//! \param[in] packed the packed signed input of 512 bytes, each chunk of 8 input bytes followed by its 8 sign bytes.
+//! \param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit).
+void SWIFFT_ISET_NAME(SWIFFT_ComputeSignedPacked_)(const BitSequence packed[SWIFFT_PACKED_BLOCK_SIZE],
+        BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE]);
+
+//! \brief Computes the result of multiple SWIFFT operations on packed signed input.
+//! The result is the same as that of SWIFFT_ComputeMultipleSigned on the unpacked blocks of input and sign bits.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] packed the blocks of packed signed input, each of 512 bytes.
+//! \param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).
+void SWIFFT_ISET_NAME(SWIFFT_ComputeMultipleSignedPacked_)(size_t nblocks, const BitSequence * packed, BitSequence * output);
+
+//! \brief Computes the results of multiple SWIFFT operations under each of several keys.
+//! The result for each key is the same as that of SWIFFT_ComputeMultipleKeyed, or of
+//! SWIFFT_ComputeMultipleSignedKeyed given sign bits, but the FFT phase, which does not
+//! depend on the key, is computed once per block.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] input the blocks of input, each of 256 bytes (2048 bit).
+//! \param[in] sign the blocks of sign bits corresponding to blocks of input of 256 bytes (2048 bit), or NULL for unsigned input.
+//! \param[in] nkeys the number of keys.
+//! \param[in] keys the SWIFFT keys.
+//! \param[out] outputs the resulting blocks of hash values of SWIFFT, per key, each block of size 128 bytes (1024 bit).
+void SWIFFT_ISET_NAME(SWIFFT_ComputeMultiKey_)(size_t nblocks, const BitSequence * input, const BitSequence * sign,
+        int nkeys, const swifft_key_t * const * keys, BitSequence * const * outputs);
+
+//! \brief Computes the result of a SWIFFT operation on short input.
+//! The result is the same as that of SWIFFT_Compute on the input padded with zero bytes to 256 bytes,
+//! but the work is proportional to the number of chunks of input.
+//!
+//! \param[in] m the number of chunks of input, a multiple of SWIFFT_SHORT_CHUNKS_MULTIPLE up to SWIFFT_INPUT_CHUNKS.
+//! \param[in] input the input of m chunks of 8 bytes.
+//! \param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit).
+//! \returns 0 on success, or -1 if m is invalid.
+int SWIFFT_ISET_NAME(SWIFFT_ComputeShort_)(int m, const BitSequence * input,
+        BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE]);
+
+//! \brief Computes the result of a SWIFFT operation on short signed input.
+//! The result is the same as that of SWIFFT_ComputeSigned on the input and sign bits padded with zero bytes to 256 bytes,
+//! but the work is proportional to the number of chunks of input.
+//!
+//! \param[in] m the number of chunks of input, a multiple of SWIFFT_SHORT_CHUNKS_MULTIPLE up to SWIFFT_INPUT_CHUNKS.
+//! \param[in] input the input of m chunks of 8 bytes.
+//! \param[in] sign the sign bits corresponding to the input of m chunks of 8 bytes.
+//! \param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit).
+//! \returns 0 on success, or -1 if m is invalid.
+int SWIFFT_ISET_NAME(SWIFFT_ComputeSignedShort_)(int m, const BitSequence * input, const BitSequence * sign,
+        BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE]);
+
+//! \brief Computes the result of multiple SWIFFT operations on short input.
+//! The result is the same as that of SWIFFT_ComputeMultiple on the blocks of input each padded with zero bytes to 256 bytes.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] m the number of chunks of input per block, a multiple of SWIFFT_SHORT_CHUNKS_MULTIPLE up to SWIFFT_INPUT_CHUNKS.
+//! \param[in] input the blocks of input, each of m chunks of 8 bytes.
+//! \param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).
+//! \returns 0 on success, or -1 if m is invalid.
+int SWIFFT_ISET_NAME(SWIFFT_ComputeMultipleShort_)(size_t nblocks, int m, const BitSequence * input, BitSequence * output);
+
+//! \brief Computes the result of multiple SWIFFT operations on short signed input.
+//! The result is the same as that of SWIFFT_ComputeMultipleSigned on the blocks of input and
+//! sign bits each padded with zero bytes to 256 bytes.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] m the number of chunks of input per block, a multiple of SWIFFT_SHORT_CHUNKS_MULTIPLE up to SWIFFT_INPUT_CHUNKS.
+//! \param[in] input the blocks of input, each of m chunks of 8 bytes.
+//! \param[in] sign the blocks of sign bits corresponding to blocks of input, each of m chunks of 8 bytes.
+//! \param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).
+//! \returns 0 on success, or -1 if m is invalid.
+int SWIFFT_ISET_NAME(SWIFFT_ComputeMultipleSignedShort_)(size_t nblocks, int m, const BitSequence * input,
         const BitSequence * sign, BitSequence * output);
 
 LIBSWIFFT_END_EXTERN_C
@@ -0,0 +1,22 @@
+/*
+ * Copyright (C) 2021 Yaron Gvili and Gvili Tech Ltd.
+ *
+ * See the accompanying LICENSE.txt file for licensing information.
+ */
+/*! \file include/swifft_neon.h
+ * \brief LibSWIFFT public C API for NEON
+ *
+ * See "include/swifft_iset.inl" for code expanded here with SWIFFT_ISET set to NEON.
+ */
+#ifndef __LIBSWIFFT_SWIFFT_NEON_H_
+#define __LIBSWIFFT_SWIFFT_NEON_H_
+
+#include "swifft_common.h"
+
+#if defined(SWIFFT_HAVE_NEON)
+	#undef SWIFFT_ISET
+        #define SWIFFT_ISET() NEON
+        #include "swifft_iset.inl"
+#endif
+
+#endif /* __LIBSWIFFT_SWIFFT_NEON_H_ */
@@ -43,7 +43,7 @@ typedef struct {
 #undef SWIFFT_ISET
 #include "swifft_object_iset.inl"
 
-#if defined(__AVX__)
+#if defined(SWIFFT_HAVE_AVX)
         #include "swifft_avx.h"
         #undef SWIFFT_ISET
         #define SWIFFT_ISET() AVX
@@ -52,7 +52,7 @@ typedef struct {
         #pragma message "LibSWIFFT API for AVX is disabled"
 #endif
 
-#if defined(__AVX2__)
+#if defined(SWIFFT_HAVE_AVX2)
         #include "swifft_avx2.h"
         #undef SWIFFT_ISET
         #define SWIFFT_ISET() AVX2
@@ -61,7 +61,7 @@ typedef struct {
         #pragma message "LibSWIFFT API for AVX2 is disabled"
 #endif
 
-#if defined(__AVX512F__)
+#if defined(SWIFFT_HAVE_AVX512)
         #include "swifft_avx512.h"
         #undef SWIFFT_ISET
         #define SWIFFT_ISET() AVX512
@@ -70,6 +70,46 @@ typedef struct {
         #pragma message "LibSWIFFT API for AVX512 is disabled"
 #endif
 
+#if defined(SWIFFT_HAVE_AVX512BW)
+        #include "swifft_avx512bw.h"
+        #undef SWIFFT_ISET
+        #define SWIFFT_ISET() AVX512BW
+        #include "swifft_object_iset.inl"
+#else
+        #pragma message "LibSWIFFT API for AVX512BW is disabled"
+#endif
+
+#if defined(SWIFFT_HAVE_NEON)
+        #include "swifft_neon.h"
+        #undef SWIFFT_ISET
+        #define SWIFFT_ISET() NEON
+        #include "swifft_object_iset.inl"
+#endif
+
+#if defined(SWIFFT_HAVE_SVE2)
+        #include "swifft_sve2.h"
+        #undef SWIFFT_ISET
+        #define SWIFFT_ISET() SVE2
+        #include "swifft_object_iset.inl"
+#endif
+
+//! \brief Initializes a SWIFFT object with the best instruction set supported by the running CPU.
+//!
+//! \param[out] swifft the SWIFFT object to initialize.
+void SWIFFT_InitBestObject(swifft_object_t *swifft);
+
+//! \brief Returns the name of the best instruction set supported by the running CPU.
+//!
+//! \returns the instruction-set name, such as "AVX2", used by SWIFFT_InitBestObject.
+const char * SWIFFT_BestInstructionSet(void);
+
+//! \brief Initializes a SWIFFT object with a named instruction set, if built into the library and supported by the running CPU.
+//!
+//! \param[out] swifft the SWIFFT object to initialize.
+//! \param[in] iset the instruction-set name, such as "AVX2".
+//! \returns the instruction-set name, as a static string, or NULL if the instruction set is unavailable.
+const char * SWIFFT_InitObjectByName(swifft_object_t *swifft, const char *iset);
+
 LIBSWIFFT_END_EXTERN_C
 
 #endif /* __LIBSWIFFT_SWIFFT_OBJECT_H__ */
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2021 Yaron Gvili and Gvili Tech Ltd.
+ *
+ * See the accompanying LICENSE.txt file for licensing information.
+ */
+/*! \file include/swifft_pool.h
+ * \brief LibSWIFFT public C API for parallelizing operations on multiple blocks
+ *
+ * Each *Multiple function splits its blocks into ranges of at most a grain of
+ * blocks and runs them using, in order of preference:
+ * - the executor set by SWIFFT_SetExecutor, if any;
+ * - the native pool of persistent work-stealing threads, when SWIFFT_SetThreads
+ *   configured more than one thread;
+ * - OpenMP, when the library was built with it;
+ * - the calling thread alone.
+ *
+ * Operations on at most SWIFFT_BLOCKS_PARALLELIZATION_THRESHOLD blocks, a
+ * build-time setting, always run on the calling thread. The *Multiple functions
+ * of the SWIFFT API belong to classes of operations of similar cost per block,
+ * and each class may instead have its own threshold and grain, e.g. as picked
+ * by SWIFFT_Tune.
+ *
+ * The SWIFFT_ComputeMultiple* functions treat at least SWIFFT_LARGE_BATCH_THRESHOLD
+ * blocks, a build-time setting, as a large batch: its input is prefetched ahead,
+ * its output is stored past the cache, and its ranges span whole pages of output.
+ */
+#ifndef __LIBSWIFFT_SWIFFT_POOL_H__
+#define __LIBSWIFFT_SWIFFT_POOL_H__
+
+#include <stddef.h> // for size_t
+#include "common.h"
+
+LIBSWIFFT_BEGIN_EXTERN_C
+
+//! \brief A function running a task on a range of its blocks.
+//!
+//! \param[in] task the task.
+//! \param[in] begin the index of the first block of the range.
+//! \param[in] end the index past the last block of the range.
+typedef void (*swifft_task_fn)(void *task, size_t begin, size_t end);
+
+//! \brief The classes of operations on multiple blocks, by their cost per block.
+typedef enum {
+	SWIFFT_OP_ARITH = 0, ///< Arithmetic on hash values, such as SWIFFT_AddMultiple and SWIFFT_ConstMulMultiple
+	SWIFFT_OP_COMPACT,   ///< Compaction of hash values, SWIFFT_CompactMultiple
+	SWIFFT_OP_FFT,       ///< The phases of SWIFFT, SWIFFT_fftMultiple and SWIFFT_fftsumMultiple, and SWIFFT_UpdateMultiple
+	SWIFFT_OP_HASH,      ///< Hashing, such as SWIFFT_ComputeMultiple and SWIFFT_EvalMultiple
+	SWIFFT_OP_CLASSES    ///< The number of classes of operations
+} swifft_op_class_t;
+
+//! \brief A function running a task on all its blocks, e.g. using a caller-owned pool of threads.
+//! It must call taskfn on disjoint ranges, each of at most grain blocks, covering
+//! all blocks, and return only after all of these calls returned.
+//!
+//! \param[in] context the context given to SWIFFT_SetExecutor.
+//! \param[in] taskfn the function running the task on a range of blocks.
+//! \param[in] task the task.
+//! \param[in] nblocks the number of blocks of the task.
+//! \param[in] grain the maximum number of blocks per range.
+typedef void (*swifft_executor_fn)(void *context, swifft_task_fn taskfn, void *task, size_t nblocks, int grain);
+
+//! \brief Sets the number of threads of the native pool, including the calling thread.
+//! Waits for running operations to complete. One thread, the default, disables the pool.
+//! The pool is unavailable, and this has no effect, when the library was built without it.
+//!
+//! \param[in] nthreads the number of threads, or 0 for the number of online processors.
+void SWIFFT_SetThreads(int nthreads);
+
+//! \brief Returns the number of threads of the native pool, including the calling thread.
+//!
+//! \returns the number of threads.
+int SWIFFT_GetThreads(void);
+
+//! \brief Sets the maximum number of blocks per range that a thread runs at once.
+//!
+//! \param[in] grain the number of blocks, or 0 for the default.
+void SWIFFT_SetGrain(int grain);
+
+//! \brief Returns the maximum number of blocks per range that a thread runs at once.
+//!
+//! \returns the number of blocks.
+int SWIFFT_GetGrain(void);
+
+//! \brief Sets the maximum number of blocks that operations of a class run on the calling thread alone.
+//!
+//! \param[in] op the class of operations, a swifft_op_class_t.
+//! \param[in] threshold the number of blocks, or SIZE_MAX for always running on the calling thread alone.
+void SWIFFT_SetOpThreshold(int op, size_t threshold);
+
+//! \brief Returns the maximum number of blocks that operations of a class run on the calling thread alone.
+//!
+//! \param[in] op the class of operations, a swifft_op_class_t.
+//! \returns the number of blocks, SWIFFT_BLOCKS_PARALLELIZATION_THRESHOLD unless set.
+size_t SWIFFT_GetOpThreshold(int op);
+
+//! \brief Sets the maximum number of blocks per range that a thread runs at once, for operations of a class.
+//!
+//! \param[in] op the class of operations, a swifft_op_class_t.
+//! \param[in] grain the number of blocks, or 0 for the one of SWIFFT_GetGrain.
+void SWIFFT_SetOpGrain(int op, int grain);
+
+//! \brief Returns the maximum number of blocks per range that a thread runs at once, for operations of a class.
+//!
+//! \param[in] op the class of operations, a swifft_op_class_t.
+//! \returns the number of blocks.
+int SWIFFT_GetOpGrain(int op);
+
+//! \brief Sets an executor to run operations on multiple blocks, instead of the native pool.
+//! Call it while no operations on multiple blocks run.
+//!
+//! \param[in] executor the executor, or NULL to restore the native pool.
+//! \param[in] context the context to pass to the executor.
+void SWIFFT_SetExecutor(swifft_executor_fn executor, void *context);
+
+//! \brief Runs a task on all its blocks, in parallel as configured.
+//!
+//! \param[in] nblocks the number of blocks of the task.
+//! \param[in] taskfn the function running the task on a range of blocks.
+//! \param[in] task the task.
+void SWIFFT_ParallelFor(size_t nblocks, swifft_task_fn taskfn, void *task);
+
+//! \brief Runs a task on all its blocks, in parallel as configured, in ranges that start at multiples of some blocks.
+//! With a number of blocks spanning whole pages, no two threads write the same page, and
+//! the native pool and OpenMP deal out the same run of ranges to each thread for the same
+//! number of blocks and threads, so pages first touched by a thread stay local to its node.
+//!
+//! \param[in] nblocks the number of blocks of the task.
+//! \param[in] align the power of 2 that the first block of each range is a multiple of.
+//! \param[in] taskfn the function running the task on a range of blocks.
+//! \param[in] task the task.
+void SWIFFT_ParallelForAligned(size_t nblocks, int align, swifft_task_fn taskfn, void *task);
+
+//! \brief Runs a task of a class of operations on all its blocks, in parallel as configured for the class.
+//!
+//! \param[in] nblocks the number of blocks of the task.
+//! \param[in] op the class of operations of the task, a swifft_op_class_t.
+//! \param[in] taskfn the function running the task on a range of blocks.
+//! \param[in] task the task.
+void SWIFFT_ParallelForOp(size_t nblocks, int op, swifft_task_fn taskfn, void *task);
+
+//! \brief Runs a task of a class of operations on all its blocks, in parallel as configured for the class,
+//! in ranges that start at multiples of some blocks, as SWIFFT_ParallelForAligned does.
+//!
+//! \param[in] nblocks the number of blocks of the task.
+//! \param[in] op the class of operations of the task, a swifft_op_class_t.
+//! \param[in] align the power of 2 that the first block of each range is a multiple of.
+//! \param[in] taskfn the function running the task on a range of blocks.
+//! \param[in] task the task.
+void SWIFFT_ParallelForAlignedOp(size_t nblocks, int op, int align, swifft_task_fn taskfn, void *task);
+
+LIBSWIFFT_END_EXTERN_C
+
+#endif /* __LIBSWIFFT_SWIFFT_POOL_H__ */
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2021 Yaron Gvili and Gvili Tech Ltd.
+ *
+ * See the accompanying LICENSE.txt file for licensing information.
+ */
+/*! \file include/swifft_queue.h
+ * \brief LibSWIFFT public C API for submitting operations on multiple blocks asynchronously
+ *
+ * A queue runs requests, each an operation on multiple blocks, on its own
+ * persistent worker threads, so the caller may go on reading input while
+ * earlier requests are hashed. A request completes by a call to the callback
+ * of the queue on a worker thread, or without a callback, by entering the
+ * completion ring of the queue, read using SWIFFT_QueuePoll or SWIFFT_QueueWait.
+ * On Linux, the file descriptor given by SWIFFT_QueueFd is readable while the
+ * completion ring is not empty, for use with poll, epoll or an event loop.
+ *
+ * A queue holds at most its depth of requests that were submitted and whose
+ * completions were not yet delivered, so SWIFFT_QueueSubmit fails rather than
+ * blocks when the queue is full. The buffers of a request must stay valid
+ * until it completes.
+ *
+ * When the library was built without SWIFFT_ENABLE_THREAD_POOL, a queue has no
+ * worker threads and SWIFFT_QueueSubmit runs each request and delivers its
+ * completion, on the calling thread, before returning.
+ */
+#ifndef __LIBSWIFFT_SWIFFT_QUEUE_H__
+#define __LIBSWIFFT_SWIFFT_QUEUE_H__
+
+#include <stddef.h> // for size_t
+#include "swifft_common.h"
+
+LIBSWIFFT_BEGIN_EXTERN_C
+
+//! \brief The operations of requests of a queue.
+typedef enum {
+	SWIFFT_REQUEST_COMPUTE = 0,           ///< SWIFFT_ComputeMultiple, or SWIFFT_ComputeMultipleSigned given sign bits
+	SWIFFT_REQUEST_COMPUTE_COMPACT,       ///< SWIFFT_ComputeCompactMultiple
+	SWIFFT_REQUEST_COMPUTE_SIGNED_PACKED, ///< SWIFFT_ComputeMultipleSignedPacked
+	SWIFFT_REQUEST_COMPACT,               ///< SWIFFT_CompactMultiple, whose input is the blocks of hash values
+	SWIFFT_REQUEST_OPS                    ///< The number of operations
+} swifft_request_op_t;
+
+//! \brief A request of a queue, an operation on multiple blocks.
+typedef struct {
+	int op;                   ///< The operation, a swifft_request_op_t
+	size_t nblocks;           ///< The number of blocks to operate on
+	const BitSequence *input; ///< The blocks of input of the operation
+	const BitSequence *sign;  ///< The blocks of sign bits corresponding to the blocks of input, or NULL for unsigned input
+	BitSequence *output;      ///< The resulting blocks of the operation
+	void *userData;           ///< Any data of the caller, returned with the completion
+} swifft_request_t;
+
+//! \brief A function called on a worker thread when a request of a queue completes.
+//! The request no longer counts toward the depth of the queue, so the function may submit another.
+//!
+//! \param[in] context the context given to SWIFFT_QueueCreate.
+//! \param[in] request the completed request.
+typedef void (*swifft_completion_fn)(void *context, const swifft_request_t *request);
+
+//! \brief A queue of requests, opaque to the caller.
+typedef struct swifft_queue_s swifft_queue_t;
+
+//! \brief Creates a queue and its worker threads.
+//!
+//! \param[in] nworkers the number of worker threads, or 0 for the number of online processors.
+//! \param[in] depth the maximum number of requests submitted and not yet delivered, at least 1.
+//! \param[in] callback the function called when a request completes, or NULL for delivering completions to the completion ring.
+//! \param[in] context the context to pass to the callback.
+//! \returns the queue, or NULL if the parameters are invalid or resources are exhausted.
+swifft_queue_t * SWIFFT_QueueCreate(int nworkers, int depth, swifft_completion_fn callback, void * context);
+
+//! \brief Submits a request to a queue, without waiting for it to run.
+//!
+//! \param[in] queue the queue.
+//! \param[in] request the request, copied by the queue.
+//! \returns 0 on success, or -1 if the queue is full or the request is invalid.
+int SWIFFT_QueueSubmit(swifft_queue_t * queue, const swifft_request_t * request);
+
+//! \brief Takes completed requests from the completion ring of a queue, without waiting.
+//!
+//! \param[in] queue the queue.
+//! \param[out] completions the completed requests, in the order they completed.
+//! \param[in] max the maximum number of completed requests to take.
+//! \returns the number of completed requests taken.
+int SWIFFT_QueuePoll(swifft_queue_t * queue, swifft_request_t * completions, int max);
+
+//! \brief Takes a completed request from the completion ring of a queue, waiting for one if none is there.
+//!
+//! \param[in] queue the queue.
+//! \param[out] completion the completed request.
+//! \returns 0 on success, or -1 if no request is in flight to wait for, or the queue has a callback.
+int SWIFFT_QueueWait(swifft_queue_t * queue, swifft_request_t * completion);
+
+//! \brief Returns a file descriptor readable while the completion ring of a queue is not empty.
+//! It is owned by the queue, and the caller only polls it, e.g. using poll or epoll.
+//!
+//! \param[in] queue the queue.
+//! \returns the file descriptor, or -1 if unavailable, e.g. off Linux or with a callback.
+int SWIFFT_QueueFd(const swifft_queue_t * queue);
+
+//! \brief Waits until all requests submitted to a queue have completed.
+//! Completions entering the completion ring stay there.
+//!
+//! \param[in] queue the queue.
+void SWIFFT_QueueDrain(swifft_queue_t * queue);
+
+//! \brief Destroys a queue, after waiting until all requests submitted to it have completed.
+//! Completions not taken from the completion ring are discarded.
+//!
+//! \param[in] queue the queue, or NULL.
+void SWIFFT_QueueDestroy(swifft_queue_t * queue);
+
+LIBSWIFFT_END_EXTERN_C
+
+#endif /* __LIBSWIFFT_SWIFFT_QUEUE_H__ */
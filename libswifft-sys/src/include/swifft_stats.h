@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2021 Yaron Gvili and Gvili Tech Ltd.
+ *
+ * See the accompanying LICENSE.txt file for licensing information.
+ */
+/*! \file include/swifft_stats.h
+ * \brief LibSWIFFT public C API for statistics of operations
+ *
+ * The statistics count, per entry point of the SWIFFT API, its calls, their
+ * blocks and the wall-clock time spent in them. They also count the runs of
+ * operations on multiple blocks, by where they ran, and for those that ran on
+ * the native pool or OpenMP, the blocks and busy time of each thread and by how
+ * much the busiest thread exceeded the mean. All counters only grow, until
+ * SWIFFT_ResetStats, so rates are derived by sampling them.
+ *
+ * The time is per entry point, not per phase of SWIFFT. The entries of
+ * SWIFFT_fft, SWIFFT_fftsum and SWIFFT_Compact time only the calls to those
+ * entry points. The compute functions run the FFT and FFT-sum phases fused
+ * in one pass, and compact within the same kernel, so their time is counted
+ * whole in their own entries.
+ *
+ * Statistics are collected only when the library was built with
+ * SWIFFT_ENABLE_STATS and SWIFFT_SetStatsEnabled enabled them. Otherwise, the
+ * entry points do not read the clock or touch the counters, and a build
+ * without SWIFFT_ENABLE_STATS removes the checks altogether.
+ */
+#ifndef __LIBSWIFFT_SWIFFT_STATS_H__
+#define __LIBSWIFFT_SWIFFT_STATS_H__
+
+#include <stdint.h> // for uint64_t
+#include "common.h"
+
+LIBSWIFFT_BEGIN_EXTERN_C
+
+//! The maximum number of threads whose statistics are kept, by thread index.
+#define SWIFFT_STATS_MAX_THREADS 256
+
+//! \brief The entry points of the SWIFFT API whose calls are counted.
+typedef enum {
+	SWIFFT_STATS_FFT = 0,
+	SWIFFT_STATS_FFTSUM,
+	SWIFFT_STATS_COMPACT,
+	SWIFFT_STATS_CONST_SET,
+	SWIFFT_STATS_CONST_ADD,
+	SWIFFT_STATS_CONST_SUB,
+	SWIFFT_STATS_CONST_MUL,
+	SWIFFT_STATS_SET,
+	SWIFFT_STATS_ADD,
+	SWIFFT_STATS_SUB,
+	SWIFFT_STATS_MUL,
+	SWIFFT_STATS_ACCUMULATOR_INIT,
+	SWIFFT_STATS_ACCUMULATOR_ADD,
+	SWIFFT_STATS_ACCUMULATOR_SUB,
+	SWIFFT_STATS_REDUCE,
+	SWIFFT_STATS_COMPUTE,
+	SWIFFT_STATS_COMPUTE_SIGNED,
+	SWIFFT_STATS_FFT_MULTIPLE,
+	SWIFFT_STATS_FFTSUM_MULTIPLE,
+	SWIFFT_STATS_COMPACT_MULTIPLE,
+	SWIFFT_STATS_CONST_SET_MULTIPLE,
+	SWIFFT_STATS_CONST_ADD_MULTIPLE,
+	SWIFFT_STATS_CONST_SUB_MULTIPLE,
+	SWIFFT_STATS_CONST_MUL_MULTIPLE,
+	SWIFFT_STATS_SET_MULTIPLE,
+	SWIFFT_STATS_ADD_MULTIPLE,
+	SWIFFT_STATS_SUB_MULTIPLE,
+	SWIFFT_STATS_MUL_MULTIPLE,
+	SWIFFT_STATS_SUM_MULTIPLE,
+	SWIFFT_STATS_LINEAR_COMBINATION,
+	SWIFFT_STATS_EVAL_MULTIPLE,
+	SWIFFT_STATS_COMPUTE_MULTIPLE,
+	SWIFFT_STATS_COMPUTE_MULTIPLE_SIGNED,
+	SWIFFT_STATS_COMPUTE_COMPACT_MULTIPLE,
+	SWIFFT_STATS_UPDATE,
+	SWIFFT_STATS_UPDATE_MULTIPLE,
+	SWIFFT_STATS_COMPUTE_KEYED,
+	SWIFFT_STATS_COMPUTE_SIGNED_KEYED,
+	SWIFFT_STATS_COMPUTE_MULTIPLE_KEYED,
+	SWIFFT_STATS_COMPUTE_MULTIPLE_SIGNED_KEYED,
+	SWIFFT_STATS_COMPUTE_SIGNED_PACKED,
+	SWIFFT_STATS_COMPUTE_MULTIPLE_SIGNED_PACKED,
+	SWIFFT_STATS_COMPUTE_MULTI_KEY,
+	SWIFFT_STATS_COMPUTE_SHORT,
+	SWIFFT_STATS_COMPUTE_SIGNED_SHORT,
+	SWIFFT_STATS_COMPUTE_MULTIPLE_SHORT,
+	SWIFFT_STATS_COMPUTE_MULTIPLE_SIGNED_SHORT,
+	SWIFFT_STATS_ENTRIES  ///< The number of entry points
+} swifft_stats_entry_t;
+
+//! \brief The statistics of an entry point of the SWIFFT API.
+typedef struct {
+	uint64_t calls;       ///< The number of calls
+	uint64_t blocks;      ///< The number of blocks operated on by the calls
+	uint64_t nanoseconds; ///< The wall-clock time spent in the calls
+} swifft_entry_stats_t;
+
+//! \brief The statistics of the SWIFFT API.
+typedef struct {
+	int enabled;                                     ///< Whether statistics are being collected
+	const char *iset;                                ///< The name of the instruction set used by the SWIFFT API, such as "AVX2"
+	swifft_entry_stats_t entries[SWIFFT_STATS_ENTRIES]; ///< The statistics per entry point, indexed by swifft_stats_entry_t
+	uint64_t serialRuns;                             ///< The number of runs of operations on multiple blocks on the calling thread alone
+	uint64_t executorRuns;                           ///< The number of runs on the executor set by SWIFFT_SetExecutor
+	uint64_t parallelRuns;                           ///< The number of runs on the native pool or OpenMP
+	uint64_t parallelNanoseconds;                    ///< The wall-clock time of the parallel runs
+	uint64_t imbalanceNanoseconds;                   ///< The sum, over the parallel runs, of the busy time of the busiest thread past the mean
+	uint64_t threadBlocks[SWIFFT_STATS_MAX_THREADS]; ///< The number of blocks run by each thread of the parallel runs, by thread index
+	uint64_t threadNanoseconds[SWIFFT_STATS_MAX_THREADS]; ///< The busy time of each thread of the parallel runs, by thread index
+} swifft_stats_t;
+
+//! \brief Enables or disables collecting statistics. They are disabled at first.
+//!
+//! \param[in] enabled whether to collect statistics.
+//! \returns 0 on success, or -1 if the library was built without SWIFFT_ENABLE_STATS.
+int SWIFFT_SetStatsEnabled(int enabled);
+
+//! \brief Returns a snapshot of the statistics.
+//! Counters updated concurrently may be read at slightly different times.
+//!
+//! \param[out] stats the statistics.
+void SWIFFT_GetStats(swifft_stats_t * stats);
+
+//! \brief Resets all counters of the statistics to zero.
+void SWIFFT_ResetStats(void);
+
+//! \brief Returns the name of an entry point of the SWIFFT API, such as "SWIFFT_Compute".
+//!
+//! \param[in] entry the entry point, a swifft_stats_entry_t.
+//! \returns the name, or NULL if the entry point is invalid.
+const char * SWIFFT_StatsEntryName(int entry);
+
+LIBSWIFFT_END_EXTERN_C
+
+#endif /* __LIBSWIFFT_SWIFFT_STATS_H__ */
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2021 Yaron Gvili and Gvili Tech Ltd.
+ *
+ * See the accompanying LICENSE.txt file for licensing information.
+ */
+/*! \file include/swifft_stream.h
+ * \brief LibSWIFFT public C API for hashing messages of any length
+ *
+ * A stream chains the SWIFFT compression function over a message in the
+ * Merkle-Damgard construction. Each block of input holds the chaining value, a
+ * compacted hash value starting as all zeros, followed by the next
+ * SWIFFT_STREAM_MESSAGE_SIZE bytes of the message. The message is padded with a
+ * 0x80 byte, zeros, and its length in bits as a little-endian 64-bit number.
+ * The digest is the final chaining value.
+ *
+ * Use SWIFFT_StreamInit, then SWIFFT_StreamUpdate any number of times, then
+ * SWIFFT_StreamFinal. A stream may be reused by initializing it again.
+ */
+#ifndef __LIBSWIFFT_SWIFFT_STREAM_H__
+#define __LIBSWIFFT_SWIFFT_STREAM_H__
+
+#include <stddef.h> // for size_t
+#include "swifft_common.h"
+
+LIBSWIFFT_BEGIN_EXTERN_C
+
+//! The number of message bytes in each block of input of a stream.
+#define SWIFFT_STREAM_MESSAGE_SIZE (SWIFFT_INPUT_BLOCK_SIZE - SWIFFT_COMPACT_BLOCK_SIZE)
+
+//! The size in bytes of the digest of a stream.
+#define SWIFFT_STREAM_DIGEST_SIZE SWIFFT_COMPACT_BLOCK_SIZE
+
+//! \brief The state of hashing a message of any length.
+//! Use SWIFFT_ALIGN, or an allocator with the same alignment, on each declaration of this data structure.
+typedef struct {
+	SWIFFT_ALIGN BitSequence chain[SWIFFT_COMPACT_BLOCK_SIZE]; ///< The chaining value
+	SWIFFT_ALIGN BitSequence block[SWIFFT_INPUT_BLOCK_SIZE];   ///< The block of input being filled, after the bytes of the chaining value
+	uint64_t length;                                           ///< The number of message bytes so far
+	size_t buffered;                                           ///< The number of message bytes in the block being filled
+} swifft_stream_t;
+
+//! \brief Initializes a stream for hashing a new message.
+//!
+//! \param[out] stream the stream.
+void SWIFFT_StreamInit(swifft_stream_t * stream);
+
+//! \brief Hashes more bytes of the message of a stream.
+//! Runs of full blocks are computed in parallel as configured, using SWIFFT_ComputeMultiple.
+//!
+//! \param[in,out] stream the stream.
+//! \param[in] data the bytes, of any alignment.
+//! \param[in] size the number of bytes.
+void SWIFFT_StreamUpdate(swifft_stream_t * stream, const BitSequence * data, size_t size);
+
+//! \brief Pads the message of a stream and returns its digest.
+//!
+//! \param[in,out] stream the stream, to be initialized again before further use.
+//! \param[out] digest the digest, of size 64 bytes (512 bit).
+void SWIFFT_StreamFinal(swifft_stream_t * stream, BitSequence digest[SWIFFT_STREAM_DIGEST_SIZE]);
+
+LIBSWIFFT_END_EXTERN_C
+
+#endif /* __LIBSWIFFT_SWIFFT_STREAM_H__ */
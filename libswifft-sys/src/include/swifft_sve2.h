@@ -0,0 +1,22 @@
+/*
+ * Copyright (C) 2021 Yaron Gvili and Gvili Tech Ltd.
+ *
+ * See the accompanying LICENSE.txt file for licensing information.
+ */
+/*! \file include/swifft_sve2.h
+ * \brief LibSWIFFT public C API for SVE2
+ *
+ * See "include/swifft_iset.inl" for code expanded here with SWIFFT_ISET set to SVE2.
+ */
+#ifndef __LIBSWIFFT_SWIFFT_SVE2_H_
+#define __LIBSWIFFT_SWIFFT_SVE2_H_
+
+#include "swifft_common.h"
+
+#if defined(SWIFFT_HAVE_SVE2)
+	#undef SWIFFT_ISET
+        #define SWIFFT_ISET() SVE2
+        #include "swifft_iset.inl"
+#endif
+
+#endif /* __LIBSWIFFT_SWIFFT_SVE2_H_ */
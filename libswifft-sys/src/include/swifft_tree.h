@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2021 Yaron Gvili and Gvili Tech Ltd.
+ *
+ * See the accompanying LICENSE.txt file for licensing information.
+ */
+/*! \file include/swifft_tree.h
+ * \brief LibSWIFFT public C API for hashing large messages in parallel as a tree
+ *
+ * The message is split into leaves of a given size, the last one possibly
+ * shorter, or a single empty leaf for an empty message. The digest of a leaf is
+ * the compacted hash value of its bytes, padded with zeros to a block of input.
+ * Each level of the tree groups consecutive digests, a fan-out at a time, the
+ * last group possibly smaller. The digest of a group is the compacted hash
+ * value of the concatenation of its digests, padded with zeros. Levels follow
+ * until a single digest remains. The digest of the message is the compacted
+ * hash value of that digest followed by the size of the message, the leaf size
+ * and the fan-out, each as a little-endian 64-bit number, padded with zeros.
+ *
+ * Unlike a stream, all nodes of a level are independent, so the tree runs in
+ * parallel as configured even for a single message.
+ */
+#ifndef __LIBSWIFFT_SWIFFT_TREE_H__
+#define __LIBSWIFFT_SWIFFT_TREE_H__
+
+#include <stddef.h> // for size_t
+#include "swifft_common.h"
+
+LIBSWIFFT_BEGIN_EXTERN_C
+
+//! The maximum leaf size of a tree, in bytes.
+#define SWIFFT_TREE_MAX_LEAF_SIZE SWIFFT_INPUT_BLOCK_SIZE
+
+//! The maximum fan-out of a tree.
+#define SWIFFT_TREE_MAX_FANOUT (SWIFFT_INPUT_BLOCK_SIZE / SWIFFT_COMPACT_BLOCK_SIZE)
+
+//! The size in bytes of the digest of a tree.
+#define SWIFFT_TREE_DIGEST_SIZE SWIFFT_COMPACT_BLOCK_SIZE
+
+//! \brief Hashes a message as a tree.
+//!
+//! \param[in] data the message, of any alignment. With leaves of SWIFFT_INPUT_BLOCK_SIZE bytes
+//! and data aligned to SWIFFT_ALIGNMENT, e.g. memory-mapped, its full leaves are hashed in place.
+//! \param[in] size the number of bytes of the message.
+//! \param[in] leafSize the number of bytes per leaf, from 1 to SWIFFT_TREE_MAX_LEAF_SIZE.
+//! \param[in] fanout the number of digests per group, from 2 to SWIFFT_TREE_MAX_FANOUT.
+//! \param[out] digest the digest, of size 64 bytes (512 bit).
+//! \returns 0 on success, or -1 if the parameters are invalid or memory is exhausted.
+int SWIFFT_TreeHash(const BitSequence * data, size_t size, size_t leafSize, int fanout,
+	BitSequence digest[SWIFFT_TREE_DIGEST_SIZE]);
+
+LIBSWIFFT_END_EXTERN_C
+
+#endif /* __LIBSWIFFT_SWIFFT_TREE_H__ */
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2021 Yaron Gvili and Gvili Tech Ltd.
+ *
+ * See the accompanying LICENSE.txt file for licensing information.
+ */
+/*! \file include/swifft_tune.h
+ * \brief LibSWIFFT public C API for tuning operations to the running machine
+ *
+ * A profile holds the instruction set used by the SWIFFT API and, per class of
+ * operations on multiple blocks, the threshold and grain of parallelizing them,
+ * as given by SWIFFT_SetOpThreshold and SWIFFT_SetOpGrain.
+ *
+ * SWIFFT_Tune measures each instruction set built into the library and supported
+ * by the CPU on each class of operations, and the cost of running an operation
+ * in parallel as configured at the time, e.g. by SWIFFT_SetThreads. It applies
+ * the fastest instruction set, the thresholds past which parallel runs pay off,
+ * and grains of about SWIFFT_TUNE_RANGE_NANOSECONDS of work per range.
+ *
+ * A profile is saved as a line of text, such as
+ * "swifft-profile 1 iset=AVX2 threads=4 arith=96/2048 compact=32/512 fft=8/64 hash=4/32",
+ * with the threshold and grain of each class. SWIFFT_Tune saves it in a given file
+ * and loads it from there in later processes, and the library applies the one in
+ * the environment variable SWIFFT_PROFILE when loaded, so later processes start
+ * tuned without measuring.
+ */
+#ifndef __LIBSWIFFT_SWIFFT_TUNE_H__
+#define __LIBSWIFFT_SWIFFT_TUNE_H__
+
+#include <stddef.h> // for size_t
+#include "common.h"
+#include "swifft_pool.h"
+
+LIBSWIFFT_BEGIN_EXTERN_C
+
+//! The environment variable holding the profile to apply when the library is loaded.
+#define SWIFFT_PROFILE_ENV "SWIFFT_PROFILE"
+
+//! The maximum size of the text of a profile, including its terminating null.
+#define SWIFFT_PROFILE_MAX_SIZE 256
+
+//! The size of the name of an instruction set in a profile, including its terminating null.
+#define SWIFFT_PROFILE_ISET_SIZE 16
+
+//! \brief A profile of tuning the SWIFFT API to a machine.
+typedef struct {
+	char iset[SWIFFT_PROFILE_ISET_SIZE]; ///< The name of the instruction set, such as "AVX2"
+	int threads;                         ///< The number of threads of the native pool the profile was measured with
+	size_t threshold[SWIFFT_OP_CLASSES]; ///< The threshold per class of operations, indexed by swifft_op_class_t
+	int grain[SWIFFT_OP_CLASSES];        ///< The grain per class of operations, indexed by swifft_op_class_t
+} swifft_profile_t;
+
+//! \brief Sets the instruction set used by the SWIFFT API.
+//! Call it while no operations run.
+//!
+//! \param[in] iset the instruction-set name, such as "AVX2", or NULL for the best one supported by the CPU.
+//! \returns 0 on success, or -1 if the instruction set is not built into the library or not supported by the CPU.
+int SWIFFT_SetInstructionSet(const char * iset);
+
+//! \brief Returns the name of the instruction set used by the SWIFFT API.
+//!
+//! \returns the instruction-set name, such as "AVX2".
+const char * SWIFFT_GetInstructionSet(void);
+
+//! \brief Returns the profile currently applied to the SWIFFT API.
+//!
+//! \param[out] profile the profile.
+void SWIFFT_GetProfile(swifft_profile_t * profile);
+
+//! \brief Applies a profile to the SWIFFT API.
+//! Call it while no operations run.
+//!
+//! \param[in] profile the profile.
+//! \returns 0 on success, or -1 if its instruction set is unavailable, in which case nothing is applied.
+int SWIFFT_SetProfile(const swifft_profile_t * profile);
+
+//! \brief Formats a profile as a line of text, without a line break.
+//!
+//! \param[in] profile the profile.
+//! \param[out] text the text, of at most size bytes including its terminating null.
+//! \param[in] size the size of text, SWIFFT_PROFILE_MAX_SIZE being enough.
+//! \returns the length of the text, or -1 if it does not fit.
+int SWIFFT_FormatProfile(const swifft_profile_t * profile, char * text, size_t size);
+
+//! \brief Parses a profile from the text given by SWIFFT_FormatProfile.
+//! Classes missing from the text keep the threshold and grain currently applied.
+//!
+//! \param[in] text the text.
+//! \param[out] profile the profile.
+//! \returns 0 on success, or -1 if the text is not a profile.
+int SWIFFT_ParseProfile(const char * text, swifft_profile_t * profile);
+
+//! \brief Tunes the SWIFFT API to the running machine, as configured for parallelism.
+//! Applies the profile saved in the file, if any, when its instruction set is available and it
+//! was measured with as many threads as the native pool has. Otherwise, measures and applies
+//! a profile, and saves it in the file, if any. Measuring takes tens of milliseconds.
+//! Call it while no operations run.
+//!
+//! \param[in] path the file of the profile, or NULL for measuring without saving.
+//! \returns 0 if the saved profile was applied, 1 if a profile was measured and applied,
+//! or -1 if memory for measuring was exhausted or saving the applied profile failed.
+int SWIFFT_Tune(const char * path);
+
+LIBSWIFFT_END_EXTERN_C
+
+#endif /* __LIBSWIFFT_SWIFFT_TUNE_H__ */
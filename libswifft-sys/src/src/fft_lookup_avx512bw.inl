@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2021 Yaron Gvili and Gvili Tech Ltd.
+ *
+ * See the accompanying LICENSE.txt file for licensing information.
+ */
+/*! \file src/fft_lookup_avx512bw.inl
+ * \brief LibSWIFFT internal FFT-table lookup for AVX512BW
+ */
+
+#include <immintrin.h>
+
+LIBSWIFFT_STATIC_ASSERT(sizeof(ZOvec) == sizeof(__m512i), ZOvec_and___m512i_must_have_the_same_size);
+
+//! \brief Assembles a wide SWIFFT vector in a zmm register from four 128-bit table rows.
+//!
+//! \param[in] Tabl the FFT table.
+//! \param[in] i0 the index of the row of the first lane.
+//! \param[in] i1 the index of the row of the second lane.
+//! \param[in] i2 the index of the row of the third lane.
+//! \param[in] i3 the index of the row of the fourth lane.
+//! \returns the assembled rows.
+static inline __m512i SWIFFT_fftRows(const Z1vec * LIBSWIFFT_RESTRICT Tabl, int i0, int i1, int i2, int i3)
+{
+	__m512i r = _mm512_castsi128_si512((__m128i)Tabl[i0]);
+	r = _mm512_inserti32x4(r, (__m128i)Tabl[i1], 1);
+	r = _mm512_inserti32x4(r, (__m128i)Tabl[i2], 2);
+	r = _mm512_inserti32x4(r, (__m128i)Tabl[i3], 3);
+	return r;
+}
+
+//! \brief Looks up the FFT-table entries for 4 8-element chunks of unsigned input.
+//! The entries are multiplied by the FFT multipliers, given in the same layout.
+//!
+//! Each wide SWIFFT vector is assembled in a zmm register from four 128-bit
+//! table rows, avoiding the round trip through memory that composing it
+//! lane-by-lane incurs. This measured faster than a 32-bit-index gather
+//! (vpgatherdd), whose index computation costs more than the inserts.
+//!
+//! \param[in] Tabl the FFT table.
+//! \param[in] Mult the FFT multipliers.
+//! \param[in] t the 4 chunks of 8 input bytes.
+//! \param[out] v the looked up entries, one wide SWIFFT vector per byte of a chunk.
+static inline void SWIFFT_fftLookup(const Z1vec * LIBSWIFFT_RESTRICT Tabl, const Z1vec * LIBSWIFFT_RESTRICT Mult,
+	const BitSequence * LIBSWIFFT_RESTRICT t, ZOvec v[8])
+{
+	int k;
+	for (k=0; k<8; k++) {
+		__m512i r = SWIFFT_fftRows(Tabl, t[k], t[8+k], t[16+k], t[24+k]);
+		if (k > 0) {
+			r = _mm512_mullo_epi16(r, _mm512_broadcast_i32x4((__m128i)Mult[k]));
+		}
+		v[k] = (ZOvec)r;
+	}
+}
+
+//! \brief Looks up the FFT-table entries for 4 8-element chunks of signed input.
+//! The entries are multiplied by the FFT multipliers, given in the same layout.
+//!
+//! The entry of an input byte is the difference of the entries of its positive
+//! bits and of its negative bits, so the unsigned FFT table serves signed input too.
+//!
+//! \param[in] Tabl the FFT table.
+//! \param[in] Mult the FFT multipliers.
+//! \param[in] t the 4 chunks of 8 input bytes.
+//! \param[in] u the 4 chunks of 8 sign bytes corresponding to the input.
+//! \param[in] stride the distance in bytes between consecutive chunks of t, and of u.
+//! \param[out] v the looked up entries, one wide SWIFFT vector per byte of a chunk.
+static inline void SWIFFT_fftLookupSigned(const Z1vec * LIBSWIFFT_RESTRICT Tabl, const Z1vec * LIBSWIFFT_RESTRICT Mult,
+	const BitSequence * LIBSWIFFT_RESTRICT t, const BitSequence * LIBSWIFFT_RESTRICT u, int stride, ZOvec v[8])
+{
+	int k;
+	const BitSequence *t1 = t + stride, *t2 = t + 2*stride, *t3 = t + 3*stride;
+	const BitSequence *u1 = u + stride, *u2 = u + 2*stride, *u3 = u + 3*stride;
+	for (k=0; k<8; k++) {
+		__m512i p = SWIFFT_fftRows(Tabl, t[k] & ~u[k], t1[k] & ~u1[k], t2[k] & ~u2[k], t3[k] & ~u3[k]);
+		__m512i n = SWIFFT_fftRows(Tabl, t[k] & u[k], t1[k] & u1[k], t2[k] & u2[k], t3[k] & u3[k]);
+		__m512i r = (__m512i)SWIFFT_center((ZOvec)_mm512_sub_epi16(p, n));
+		if (k > 0) {
+			r = _mm512_mullo_epi16(r, _mm512_broadcast_i32x4((__m128i)Mult[k]));
+		}
+		v[k] = (ZOvec)r;
+	}
+}
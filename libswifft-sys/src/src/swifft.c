@@ -6,32 +6,101 @@
 /*! \file src/swifft.c
  * \brief LibSWIFFT public C implementation
  *
- * Implementation using the best instruction set available at build time.
+ * Implementation using the best instruction set available at build time, if
+ * one was enabled by the compile flags, or else using the best instruction set
+ * supported by the CPU, selected once when the library is loaded.
  */
 
+#include <stdlib.h> // for getenv
+#include <string.h> // for strcmp
 #include "swifft.h"
+#include "swifft_object.h"
 #include "swifft_avx.h"
 #include "swifft_avx2.h"
 #include "swifft_avx512.h"
+#include "swifft_avx512bw.h"
+#include "swifft_neon.h"
+#include "swifft_sve2.h"
+#include "swifft_stats.inl"
 
-#undef SWIFFT_ISET
-#define SWIFFT_ISET() SWIFFT_INSTRUCTION_SET
 #include "swifft_ops.inl"
 
+#ifdef SWIFFT_INSTRUCTION_SET
+	//! Calls the implementation of the instruction set available at build time
+	#define SWIFFT_DISPATCH(part, name) LIBSWIFFT_CONCAT(LIBSWIFFT_CONCAT(name,_),SWIFFT_INSTRUCTION_SET)
+#else
+	//! Calls the implementation of the instruction set selected at load time
+	#define SWIFFT_DISPATCH(part, name) (SWIFFT_dispatch.part.name)
+#endif
+
 
 LIBSWIFFT_BEGIN_EXTERN_C
 
 SWIFFT_ALIGN const BitSequence SWIFFT_sign0[SWIFFT_INPUT_BLOCK_SIZE] = {0};
 
+#ifndef SWIFFT_INSTRUCTION_SET
+//! \brief The SWIFFT object for the instruction set used by this API, at first the best one supported by the CPU.
+static swifft_object_t SWIFFT_dispatch;
+//! \brief The name of the instruction set of SWIFFT_dispatch.
+static const char *SWIFFT_dispatchIset;
+
+//! \brief Initializes the SWIFFT object used by this API, once when the library is loaded.
+//! The high priority runs this before constructors of the program using the library.
+static void __attribute__((constructor(101))) SWIFFT_InitDispatch(void)
+{
+	SWIFFT_InitBestObject(&SWIFFT_dispatch);
+	SWIFFT_dispatchIset = SWIFFT_BestInstructionSet();
+}
+#endif
+
+//! \brief Applies the profile in the environment variable SWIFFT_PROFILE, if any, when the library is loaded.
+//! This runs after the SWIFFT object used by the API is initialized and before constructors of the program,
+//! and lives here rather than with the tuning code so that static linking always keeps it.
+static void __attribute__((constructor(102))) SWIFFT_InitProfile(void)
+{
+	swifft_profile_t profile;
+	const char *text = getenv(SWIFFT_PROFILE_ENV);
+	if (text != NULL && SWIFFT_ParseProfile(text, &profile) == 0) {
+		SWIFFT_SetProfile(&profile);
+	}
+}
+
+int SWIFFT_SetInstructionSet(const char * iset)
+{
+#ifdef SWIFFT_INSTRUCTION_SET
+	return iset == NULL || strcmp(iset, LIBSWIFFT_QUOTE(SWIFFT_INSTRUCTION_SET)) == 0 ? 0 : -1;
+#else
+	swifft_object_t object;
+	if (iset == NULL) {
+		SWIFFT_InitBestObject(&object);
+		iset = SWIFFT_BestInstructionSet();
+	} else if ((iset = SWIFFT_InitObjectByName(&object, iset)) == NULL) {
+		return -1;
+	}
+	SWIFFT_dispatch = object;
+	SWIFFT_dispatchIset = iset;
+	return 0;
+#endif
+}
+
+const char * SWIFFT_GetInstructionSet(void)
+{
+#ifdef SWIFFT_INSTRUCTION_SET
+	return LIBSWIFFT_QUOTE(SWIFFT_INSTRUCTION_SET);
+#else
+	return SWIFFT_dispatchIset;
+#endif
+}
+
 void SWIFFT_fft(const BitSequence * LIBSWIFFT_RESTRICT input, const BitSequence * LIBSWIFFT_RESTRICT sign, int m, int16_t * LIBSWIFFT_RESTRICT fftout)
 {
-	SWIFFT_ISET_NAME(SWIFFT_fft_)(input, sign, m, fftout);
+	SWIFFT_STATS_CALL(SWIFFT_STATS_FFT, 1, SWIFFT_DISPATCH(fft, SWIFFT_fft)(input, sign, m, fftout));
 }
 
 void SWIFFT_fftsum(const int16_t * LIBSWIFFT_RESTRICT ikey,
 	const int16_t * LIBSWIFFT_RESTRICT ifftout, int m, int16_t * LIBSWIFFT_RESTRICT iout)
 {
-	SWIFFT_ISET_NAME(SWIFFT_fftsum_)(ikey, ifftout, m, iout);
+	SWIFFT_STATS_CALL(SWIFFT_STATS_FFTSUM, 1, SWIFFT_DISPATCH(fft, SWIFFT_fftsum)(ikey, ifftout, m, iout));
 }
 
 //! \brief Converts from base-257 to base-256.
@@ -65,14 +134,14 @@ LIBSWIFFT_STATIC_ASSERT(8 * SWIFFT_W == SWIFFT_N, SWIFFT_N_must_be_8_times_SWIFF
 	#include "transpose_8x8_16_sse2.inl"
 	LIBSWIFFT_STATIC_ASSERT(sizeof(Z1vec) == sizeof(__m128i), Z1vec_and___m128i_must_have_the_same_size);
 	LIBSWIFFT_STATIC_ASSERT(sizeof(BitSequence)*SWIFFT_OUTPUT_BLOCK_SIZE == sizeof(Z1vec)*SWIFFT_OUTPUT_Z1_SIZE, output_and_transposed_arrays_must_have_the_same_size);
+#elif defined(__ARM_NEON)
+	#include <string.h>
+	#include "transpose_8x8_16_neon.inl"
+	LIBSWIFFT_STATIC_ASSERT(sizeof(Z1vec) == sizeof(int16x8_t), Z1vec_and_int16x8_t_must_have_the_same_size);
+	LIBSWIFFT_STATIC_ASSERT(sizeof(BitSequence)*SWIFFT_OUTPUT_BLOCK_SIZE == sizeof(Z1vec)*SWIFFT_OUTPUT_Z1_SIZE, output_and_transposed_arrays_must_have_the_same_size);
 #endif
 
-//! \brief Compacts a hash value of SWIFFT.
-//! The result is not composable with other compacted hash values.
-//!
-//! \param[in] output the hash value of SWIFFT, of size 128 bytes (1024 bit).
-//! \param[out] compact the compacted hash value of SWIFFT, of size 64 bytes (512 bit).
-void SWIFFT_Compact(const BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
+void SWIFFT_compact(const BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
 	BitSequence compact[SWIFFT_COMPACT_BLOCK_SIZE])
 {
 	//
@@ -105,6 +174,29 @@ void SWIFFT_Compact(const BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
 		*cout++ = _mm_packus_epi16(a, b);
 	}
 	// ignore carry
+#elif defined(__ARM_NEON)
+	int16x8_t transposed[SWIFFT_OUTPUT_Z1_SIZE];
+	memcpy(transposed, output, sizeof(BitSequence)*SWIFFT_OUTPUT_BLOCK_SIZE);
+	transpose_8x8_16_neon(transposed);
+	ToBase256((Z1vec *) transposed, SWIFFT_OUTPUT_Z1_SIZE);
+	int16_t * tin = ((int16_t *) transposed) + ((SWIFFT_COMPACT_TRANSPOSE_SIZE - 1) * SWIFFT_COMPACT_TRANSPOSE_SIZE);
+	int carry = 0;
+	int i;
+	for (i=0; i<SWIFFT_OUTPUT_Z1_SIZE; i++,tin++) {
+		// move out carry bit to avoid saturation
+		carry |= ((*tin>>8)<<i);
+		*tin &= 255;
+	}
+	transpose_8x8_16_neon(transposed);
+	int16x8_t * ztin = transposed;
+	uint8x16_t * cout = (uint8x16_t *) compact;
+	for (i=0; i<SWIFFT_OUTPUT_Z1_SIZE/2; i++) {
+		int16x8_t a = *ztin++;
+		int16x8_t b = *ztin++;
+		// compact 16-bit elements to 8-bit ones: saturation is avoided
+		*cout++ = vcombine_u8(vqmovun_s16(a), vqmovun_s16(b));
+	}
+	// ignore carry
 #else
 	Z1vec transposed[SWIFFT_OUTPUT_Z1_SIZE];
 	int16_t *tin = (int16_t *) output;
@@ -139,6 +231,17 @@ void SWIFFT_Compact(const BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
 #endif
 }
 
+//! \brief Compacts a hash value of SWIFFT.
+//! The result is not composable with other compacted hash values.
+//!
+//! \param[in] output the hash value of SWIFFT, of size 128 bytes (1024 bit).
+//! \param[out] compact the compacted hash value of SWIFFT, of size 64 bytes (512 bit).
+void SWIFFT_Compact(const BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
+	BitSequence compact[SWIFFT_COMPACT_BLOCK_SIZE])
+{
+	SWIFFT_STATS_CALL(SWIFFT_STATS_COMPACT, 1, SWIFFT_compact(output, compact));
+}
+
 //! \brief Sets a constant value at each SWIFFT hash value element.
 //!
 //! \param[out] output the hash value of SWIFFT to modify.
@@ -146,7 +249,7 @@ void SWIFFT_Compact(const BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
 void SWIFFT_ConstSet(BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
 	const int16_t operand)
 {
-	SWIFFT_ISET_NAME(SWIFFT_ConstSet_)(output, operand);
+	SWIFFT_STATS_CALL(SWIFFT_STATS_CONST_SET, 1, SWIFFT_DISPATCH(arith, SWIFFT_ConstSet)(output, operand));
 }
 
 //! \brief Adds a constant value to each SWIFFT hash value element.
@@ -156,7 +259,7 @@ void SWIFFT_ConstSet(BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
 void SWIFFT_ConstAdd(BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
 	const int16_t operand)
 {
-	SWIFFT_ISET_NAME(SWIFFT_ConstAdd_)(output, operand);
+	SWIFFT_STATS_CALL(SWIFFT_STATS_CONST_ADD, 1, SWIFFT_DISPATCH(arith, SWIFFT_ConstAdd)(output, operand));
 }
 
 //! \brief Subtracts a constant value from each SWIFFT hash value element.
@@ -166,7 +269,7 @@ void SWIFFT_ConstAdd(BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
 void SWIFFT_ConstSub(BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
 	const int16_t operand)
 {
-	SWIFFT_ISET_NAME(SWIFFT_ConstSub_)(output, operand);
+	SWIFFT_STATS_CALL(SWIFFT_STATS_CONST_SUB, 1, SWIFFT_DISPATCH(arith, SWIFFT_ConstSub)(output, operand));
 }
 
 //! \brief Multiply a constant value into each SWIFFT hash value element.
@@ -176,7 +279,7 @@ void SWIFFT_ConstSub(BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
 void SWIFFT_ConstMul(BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
 	const int16_t operand)
 {
-	SWIFFT_ISET_NAME(SWIFFT_ConstMul_)(output, operand);
+	SWIFFT_STATS_CALL(SWIFFT_STATS_CONST_MUL, 1, SWIFFT_DISPATCH(arith, SWIFFT_ConstMul)(output, operand));
 }
 
 //! \brief Sets a SWIFFT hash value to another, element-wise.
@@ -186,7 +289,7 @@ void SWIFFT_ConstMul(BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
 void SWIFFT_Set(BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
 	const BitSequence operand[SWIFFT_OUTPUT_BLOCK_SIZE])
 {
-	SWIFFT_ISET_NAME(SWIFFT_Set_)(output, operand);
+	SWIFFT_STATS_CALL(SWIFFT_STATS_SET, 1, SWIFFT_DISPATCH(arith, SWIFFT_Set)(output, operand));
 }
 
 //! \brief Adds a SWIFFT hash value to another, element-wise.
@@ -196,7 +299,7 @@ void SWIFFT_Set(BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
 void SWIFFT_Add(BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
 	const BitSequence operand[SWIFFT_OUTPUT_BLOCK_SIZE])
 {
-	SWIFFT_ISET_NAME(SWIFFT_Add_)(output, operand);
+	SWIFFT_STATS_CALL(SWIFFT_STATS_ADD, 1, SWIFFT_DISPATCH(arith, SWIFFT_Add)(output, operand));
 }
 
 //! \brief Subtracts a SWIFFT hash value from another, element-wise.
@@ -206,7 +309,7 @@ void SWIFFT_Add(BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
 void SWIFFT_Sub(BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
 	const BitSequence operand[SWIFFT_OUTPUT_BLOCK_SIZE])
 {
-	SWIFFT_ISET_NAME(SWIFFT_Sub_)(output, operand);
+	SWIFFT_STATS_CALL(SWIFFT_STATS_SUB, 1, SWIFFT_DISPATCH(arith, SWIFFT_Sub)(output, operand));
 }
 
 //! \brief Multiplies a SWIFFT hash value from another, element-wise.
@@ -216,7 +319,48 @@ void SWIFFT_Sub(BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
 void SWIFFT_Mul(BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
 	const BitSequence operand[SWIFFT_OUTPUT_BLOCK_SIZE])
 {
-	SWIFFT_ISET_NAME(SWIFFT_Mul_)(output, operand);
+	SWIFFT_STATS_CALL(SWIFFT_STATS_MUL, 1, SWIFFT_DISPATCH(arith, SWIFFT_Mul)(output, operand));
+}
+
+//! \brief Initializes an accumulator of SWIFFT hash values to zero.
+//!
+//! \param[out] acc the accumulator.
+void SWIFFT_AccumulatorInit(swifft_accumulator_t * acc)
+{
+	SWIFFT_STATS_CALL(SWIFFT_STATS_ACCUMULATOR_INIT, 1, SWIFFT_DISPATCH(arith, SWIFFT_AccumulatorInit)(acc));
+}
+
+//! \brief Adds a SWIFFT hash value to an accumulator, without reducing the sum.
+//! The elements are folded, with a partial reduction, once every SWIFFT_ACCUMULATOR_HEADROOM operations.
+//!
+//! \param[in,out] acc the accumulator.
+//! \param[in] operand the reduced hash value to add.
+void SWIFFT_AccumulatorAdd(swifft_accumulator_t * acc,
+	const BitSequence operand[SWIFFT_OUTPUT_BLOCK_SIZE])
+{
+	SWIFFT_STATS_CALL(SWIFFT_STATS_ACCUMULATOR_ADD, 1, SWIFFT_DISPATCH(arith, SWIFFT_AccumulatorAdd)(acc, operand));
+}
+
+//! \brief Subtracts a SWIFFT hash value from an accumulator, without reducing the difference.
+//! The elements are folded, with a partial reduction, once every SWIFFT_ACCUMULATOR_HEADROOM operations.
+//!
+//! \param[in,out] acc the accumulator.
+//! \param[in] operand the reduced hash value to subtract.
+void SWIFFT_AccumulatorSub(swifft_accumulator_t * acc,
+	const BitSequence operand[SWIFFT_OUTPUT_BLOCK_SIZE])
+{
+	SWIFFT_STATS_CALL(SWIFFT_STATS_ACCUMULATOR_SUB, 1, SWIFFT_DISPATCH(arith, SWIFFT_AccumulatorSub)(acc, operand));
+}
+
+//! \brief Reduces an accumulator of SWIFFT hash values to a hash value.
+//! The result is the same as that of the additions and subtractions of the accumulator done using SWIFFT_Add and SWIFFT_Sub.
+//!
+//! \param[in] acc the accumulator.
+//! \param[out] output the resulting hash value of SWIFFT.
+void SWIFFT_Reduce(const swifft_accumulator_t * acc,
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE])
+{
+	SWIFFT_STATS_CALL(SWIFFT_STATS_REDUCE, 1, SWIFFT_DISPATCH(arith, SWIFFT_Reduce)(acc, output));
 }
 
 //! \brief Computes the result of a SWIFFT operation.
@@ -227,7 +371,7 @@ void SWIFFT_Mul(BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
 void SWIFFT_Compute(const BitSequence input[SWIFFT_INPUT_BLOCK_SIZE],
 	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE])
 {
-	SWIFFT_ISET_NAME(SWIFFT_Compute_)(input, output);
+	SWIFFT_STATS_CALL(SWIFFT_STATS_COMPUTE, 1, SWIFFT_DISPATCH(hash, SWIFFT_Compute)(input, output));
 }
 
 //! \brief Computes the result of a SWIFFT operation.
@@ -240,7 +384,7 @@ void SWIFFT_ComputeSigned(const BitSequence input[SWIFFT_INPUT_BLOCK_SIZE],
 	const BitSequence sign[SWIFFT_INPUT_BLOCK_SIZE],
 	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE])
 {
-	SWIFFT_ISET_NAME(SWIFFT_ComputeSigned_)(input, sign, output);
+	SWIFFT_STATS_CALL(SWIFFT_STATS_COMPUTE_SIGNED, 1, SWIFFT_DISPATCH(hash, SWIFFT_ComputeSigned)(input, sign, output));
 }
 
 //! \brief Computes the FFT phase of SWIFFT for multiple blocks.
@@ -250,9 +394,9 @@ void SWIFFT_ComputeSigned(const BitSequence input[SWIFFT_INPUT_BLOCK_SIZE],
 //! \param[in] sign the blocks of sign bits corresponding to blocks of input of 256 bytes (2048 bits).
 //! \param[in] m number of 8-elements in the input.
 //! \param[out] fftout the blocks of FFT-output elements, totaling N*m.
-void SWIFFT_fftMultiple(int nblocks, const BitSequence * LIBSWIFFT_RESTRICT input, const BitSequence * LIBSWIFFT_RESTRICT sign, int m, int16_t * LIBSWIFFT_RESTRICT fftout)
+void SWIFFT_fftMultiple(size_t nblocks, const BitSequence * LIBSWIFFT_RESTRICT input, const BitSequence * LIBSWIFFT_RESTRICT sign, int m, int16_t * LIBSWIFFT_RESTRICT fftout)
 {
-	SWIFFT_ISET_NAME(SWIFFT_fftMultiple_)(nblocks, input, sign, m, fftout);
+	SWIFFT_STATS_CALL(SWIFFT_STATS_FFT_MULTIPLE, nblocks, SWIFFT_DISPATCH(fft, SWIFFT_fftMultiple)(nblocks, input, sign, m, fftout));
 }
 
 //! \brief Computes the FFT-sum phase of SWIFFT for multiple blocks.
@@ -262,10 +406,10 @@ void SWIFFT_fftMultiple(int nblocks, const BitSequence * LIBSWIFFT_RESTRICT inpu
 //! \param[in] ifftout the blocks of FFT-output elements, totaling N*m
 //! \param[in] m number of 8-elements in the input.
 //! \param[out] iout the blocks of output elements, each of 64 double-bytes (1024 bits).
-void SWIFFT_fftsumMultiple(int nblocks, const int16_t * LIBSWIFFT_RESTRICT ikey,
+void SWIFFT_fftsumMultiple(size_t nblocks, const int16_t * LIBSWIFFT_RESTRICT ikey,
         const int16_t * LIBSWIFFT_RESTRICT ifftout, int m, int16_t * LIBSWIFFT_RESTRICT iout)
 {
-	SWIFFT_ISET_NAME(SWIFFT_fftsumMultiple_)(nblocks, ikey, ifftout, m, iout);
+	SWIFFT_STATS_CALL(SWIFFT_STATS_FFTSUM_MULTIPLE, nblocks, SWIFFT_DISPATCH(fft, SWIFFT_fftsumMultiple)(nblocks, ikey, ifftout, m, iout));
 }
 
 //! \brief Compacts a hash value of SWIFFT for multiple blocks.
@@ -274,10 +418,10 @@ void SWIFFT_fftsumMultiple(int nblocks, const int16_t * LIBSWIFFT_RESTRICT ikey,
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in] output the hash value of SWIFFT, of size 128 bytes (1024 bit).
 //! \param[out] compact the compacted hash value of SWIFFT, of size 64 bytes (512 bit).
-void SWIFFT_CompactMultiple(int nblocks, const BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
+void SWIFFT_CompactMultiple(size_t nblocks, const BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
         BitSequence compact[SWIFFT_COMPACT_BLOCK_SIZE])
 {
-	SWIFFT_ISET_NAME(SWIFFT_CompactMultiple_)(nblocks, output, compact);
+	SWIFFT_STATS_CALL(SWIFFT_STATS_COMPACT_MULTIPLE, nblocks, SWIFFT_DISPATCH(hash, SWIFFT_CompactMultiple)(nblocks, output, compact));
 }
 
 //! \brief Sets a constant value at each SWIFFT hash value element for multiple blocks.
@@ -285,10 +429,10 @@ void SWIFFT_CompactMultiple(int nblocks, const BitSequence output[SWIFFT_OUTPUT_
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[out] output the hash value of SWIFFT to modify, per block.
 //! \param[in] operand the constant value to set, per block.
-void SWIFFT_ConstSetMultiple(int nblocks, BitSequence * output,
+void SWIFFT_ConstSetMultiple(size_t nblocks, BitSequence * output,
         const int16_t * operand)
 {
-	SWIFFT_ISET_NAME(SWIFFT_ConstSetMultiple_)(nblocks, output, operand);
+	SWIFFT_STATS_CALL(SWIFFT_STATS_CONST_SET_MULTIPLE, nblocks, SWIFFT_DISPATCH(arith, SWIFFT_ConstSetMultiple)(nblocks, output, operand));
 }
 
 //! \brief Adds a constant value to each SWIFFT hash value element for multiple blocks.
@@ -296,10 +440,10 @@ void SWIFFT_ConstSetMultiple(int nblocks, BitSequence * output,
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in,out] output the hash value of SWIFFT to modify, per block.
 //! \param[in] operand the constant value to add, per block.
-void SWIFFT_ConstAddMultiple(int nblocks, BitSequence * output,
+void SWIFFT_ConstAddMultiple(size_t nblocks, BitSequence * output,
         const int16_t * operand)
 {
-	SWIFFT_ISET_NAME(SWIFFT_ConstAddMultiple_)(nblocks, output, operand);
+	SWIFFT_STATS_CALL(SWIFFT_STATS_CONST_ADD_MULTIPLE, nblocks, SWIFFT_DISPATCH(arith, SWIFFT_ConstAddMultiple)(nblocks, output, operand));
 }
 
 //! \brief Subtracts a constant value from each SWIFFT hash value element for multiple blocks.
@@ -307,10 +451,10 @@ void SWIFFT_ConstAddMultiple(int nblocks, BitSequence * output,
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in,out] output the hash value of SWIFFT to modify, per block.
 //! \param[in] operand the constant value to subtract, per block.
-void SWIFFT_ConstSubMultiple(int nblocks, BitSequence * output,
+void SWIFFT_ConstSubMultiple(size_t nblocks, BitSequence * output,
         const int16_t * operand)
 {
-	SWIFFT_ISET_NAME(SWIFFT_ConstSubMultiple_)(nblocks, output, operand);
+	SWIFFT_STATS_CALL(SWIFFT_STATS_CONST_SUB_MULTIPLE, nblocks, SWIFFT_DISPATCH(arith, SWIFFT_ConstSubMultiple)(nblocks, output, operand));
 }
 
 //! \brief Multiply a constant value into each SWIFFT hash value element for multiple blocks.
@@ -318,10 +462,10 @@ void SWIFFT_ConstSubMultiple(int nblocks, BitSequence * output,
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in,out] output the hash value of SWIFFT to modify, per block.
 //! \param[in] operand the constant value to multiply by, per block.
-void SWIFFT_ConstMulMultiple(int nblocks, BitSequence * output,
+void SWIFFT_ConstMulMultiple(size_t nblocks, BitSequence * output,
         const int16_t * operand)
 {
-	SWIFFT_ISET_NAME(SWIFFT_ConstMulMultiple_)(nblocks, output, operand);
+	SWIFFT_STATS_CALL(SWIFFT_STATS_CONST_MUL_MULTIPLE, nblocks, SWIFFT_DISPATCH(arith, SWIFFT_ConstMulMultiple)(nblocks, output, operand));
 }
 
 //! \brief Sets a SWIFFT hash value to another, element-wise, for multiple blocks.
@@ -329,10 +473,10 @@ void SWIFFT_ConstMulMultiple(int nblocks, BitSequence * output,
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in,out] output the hash value of SWIFFT to modify, per block.
 //! \param[in] operand the hash value to set to, per block.
-void SWIFFT_SetMultiple(int nblocks, BitSequence * output,
+void SWIFFT_SetMultiple(size_t nblocks, BitSequence * output,
         const BitSequence * operand)
 {
-	SWIFFT_ISET_NAME(SWIFFT_SetMultiple_)(nblocks, output, operand);
+	SWIFFT_STATS_CALL(SWIFFT_STATS_SET_MULTIPLE, nblocks, SWIFFT_DISPATCH(arith, SWIFFT_SetMultiple)(nblocks, output, operand));
 }
 
 //! \brief Adds a SWIFFT hash value to another, element-wise, for multiple blocks.
@@ -340,10 +484,10 @@ void SWIFFT_SetMultiple(int nblocks, BitSequence * output,
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in,out] output the hash value of SWIFFT to modify, per block.
 //! \param[in] operand the hash value to add, per block.
-void SWIFFT_AddMultiple(int nblocks, BitSequence * output,
+void SWIFFT_AddMultiple(size_t nblocks, BitSequence * output,
         const BitSequence * operand)
 {
-	SWIFFT_ISET_NAME(SWIFFT_AddMultiple_)(nblocks, output, operand);
+	SWIFFT_STATS_CALL(SWIFFT_STATS_ADD_MULTIPLE, nblocks, SWIFFT_DISPATCH(arith, SWIFFT_AddMultiple)(nblocks, output, operand));
 }
 
 //! \brief Subtracts a SWIFFT hash value from another, element-wise, for multiple blocks.
@@ -351,10 +495,10 @@ void SWIFFT_AddMultiple(int nblocks, BitSequence * output,
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in,out] output the hash value of SWIFFT to modify, per block.
 //! \param[in] operand the hash value to subtract, per block.
-void SWIFFT_SubMultiple(int nblocks, BitSequence * output,
+void SWIFFT_SubMultiple(size_t nblocks, BitSequence * output,
         const BitSequence * operand)
 {
-	SWIFFT_ISET_NAME(SWIFFT_SubMultiple_)(nblocks, output, operand);
+	SWIFFT_STATS_CALL(SWIFFT_STATS_SUB_MULTIPLE, nblocks, SWIFFT_DISPATCH(arith, SWIFFT_SubMultiple)(nblocks, output, operand));
 }
 
 //! \brief Multiplies a SWIFFT hash value from another, element-wise, for multiple blocks.
@@ -362,10 +506,57 @@ void SWIFFT_SubMultiple(int nblocks, BitSequence * output,
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in,out] output the hash value of SWIFFT to modify, per block.
 //! \param[in] operand the hash value to multiply by, per block.
-void SWIFFT_MulMultiple(int nblocks, BitSequence * output,
+void SWIFFT_MulMultiple(size_t nblocks, BitSequence * output,
         const BitSequence * operand)
 {
-	SWIFFT_ISET_NAME(SWIFFT_MulMultiple_)(nblocks, output, operand);
+	SWIFFT_STATS_CALL(SWIFFT_STATS_MUL_MULTIPLE, nblocks, SWIFFT_DISPATCH(arith, SWIFFT_MulMultiple)(nblocks, output, operand));
+}
+
+//! \brief Sums SWIFFT hash values of multiple blocks, reducing only once per SWIFFT_ACCUMULATOR_HEADROOM blocks.
+//! The result is the same as that of adding the hash values one by one using SWIFFT_Add.
+//!
+//! \param[in] nblocks the number of blocks to sum.
+//! \param[in] operand the reduced hash values to sum, per block.
+//! \param[out] output the resulting hash value of SWIFFT.
+void SWIFFT_SumMultiple(size_t nblocks, const BitSequence * operand,
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE])
+{
+	SWIFFT_STATS_CALL(SWIFFT_STATS_SUM_MULTIPLE, nblocks, SWIFFT_DISPATCH(arith, SWIFFT_SumMultiple)(nblocks, operand, output));
+}
+
+//! \brief Computes a linear combination of SWIFFT hash values of multiple blocks, reducing each product only partially.
+//! The result is the sum of the products of the hash values by their coefficients, mod 257.
+//!
+//! \param[in] nblocks the number of blocks to combine.
+//! \param[in] coeffs the coefficients, per block, in any range of int16_t.
+//! \param[in] operand the reduced hash values to combine, per block.
+//! \param[out] output the resulting hash value of SWIFFT.
+void SWIFFT_LinearCombination(size_t nblocks, const int16_t * coeffs, const BitSequence * operand,
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE])
+{
+	SWIFFT_STATS_CALL(SWIFFT_STATS_LINEAR_COMBINATION, nblocks, SWIFFT_DISPATCH(arith, SWIFFT_LinearCombination)(nblocks, coeffs, operand, output));
+}
+
+//! \brief Evaluates an element-wise expression of SWIFFT hash values for multiple blocks.
+//! The program runs on a stack of hash values for each block, and leaves the result as the
+//! only one on it. The stack of a range of blocks is held in a small buffer local to the
+//! computation, so each operand is read and the output is written once, in a single
+//! parallel run. Each operation reduces its result mod 257, as SWIFFT_Add does.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] program the operations of the expression, in postfix order.
+//! \param[in] nops the number of operations.
+//! \param[in] operands the arrays of reduced hash values of SWIFFT, per block, for SWIFFT_OP_LOAD.
+//! \param[in] noperands the number of arrays of operands.
+//! \param[out] output the resulting hash values of SWIFFT, per block, which may be an array of operands.
+//! \returns 0 on success, or -1 if the program is invalid or needs more than SWIFFT_EVAL_MAX_STACK hash values on the stack.
+int SWIFFT_EvalMultiple(size_t nblocks, const swifft_op_t * program, int nops,
+	const BitSequence * const * operands, int noperands, BitSequence * output)
+{
+	int result;
+	SWIFFT_STATS_CALL(SWIFFT_STATS_EVAL_MULTIPLE, nblocks,
+		result = SWIFFT_DISPATCH(arith, SWIFFT_EvalMultiple)(nblocks, program, nops, operands, noperands, output));
+	return result;
 }
 
 //! \brief Computes the result of multiple SWIFFT operations.
@@ -374,9 +565,9 @@ void SWIFFT_MulMultiple(int nblocks, BitSequence * output,
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in] input the blocks of input, each of 256 bytes (2048 bit).
 //! \param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).
-void SWIFFT_ComputeMultiple(int nblocks, const BitSequence * input, BitSequence * output)
+void SWIFFT_ComputeMultiple(size_t nblocks, const BitSequence * input, BitSequence * output)
 {
-	SWIFFT_ISET_NAME(SWIFFT_ComputeMultiple_)(nblocks, input, output);
+	SWIFFT_STATS_CALL(SWIFFT_STATS_COMPUTE_MULTIPLE, nblocks, SWIFFT_DISPATCH(hash, SWIFFT_ComputeMultiple)(nblocks, input, output));
 }
 
 //! \brief Computes the result of multiple SWIFFT operations.
@@ -386,10 +577,237 @@ void SWIFFT_ComputeMultiple(int nblocks, const BitSequence * input, BitSequence
 //! \param[in] input the blocks of input, each of 256 bytes (2048 bit).
 //! \param[in] sign the blocks of sign bits corresponding to blocks of input of 256 bytes (2048 bit).
 //! \param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).
-void SWIFFT_ComputeMultipleSigned(int nblocks, const BitSequence * input,
+void SWIFFT_ComputeMultipleSigned(size_t nblocks, const BitSequence * input,
+	const BitSequence * sign, BitSequence * output)
+{
+	SWIFFT_STATS_CALL(SWIFFT_STATS_COMPUTE_MULTIPLE_SIGNED, nblocks, SWIFFT_DISPATCH(hash, SWIFFT_ComputeMultipleSigned)(nblocks, input, sign, output));
+}
+
+//! \brief Computes the compacted result of multiple SWIFFT operations.
+//! The result is the same as that of SWIFFT_ComputeMultiple followed by SWIFFT_CompactMultiple.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] input the blocks of input, each of 256 bytes (2048 bit).
+//! \param[out] compact the resulting blocks of compacted hash values of SWIFFT, each of size 64 bytes (512 bit).
+void SWIFFT_ComputeCompactMultiple(size_t nblocks, const BitSequence * input, BitSequence * compact)
+{
+	SWIFFT_STATS_CALL(SWIFFT_STATS_COMPUTE_COMPACT_MULTIPLE, nblocks, SWIFFT_DISPATCH(hash, SWIFFT_ComputeCompactMultiple)(nblocks, input, compact));
+}
+
+//! \brief Updates the result of a SWIFFT operation for a change of one chunk of its input.
+//! The result is the same as that of SWIFFT_Compute on the changed input.
+//!
+//! \param[in,out] output the hash value of SWIFFT to modify, of size 128 bytes (1024 bit).
+//! \param[in] oldChunk the old chunk of 8 bytes.
+//! \param[in] newChunk the new chunk of 8 bytes.
+//! \param[in] chunkIndex the index of the chunk in the input, from 0 to SWIFFT_INPUT_CHUNKS-1.
+void SWIFFT_Update(BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
+	const BitSequence oldChunk[SWIFFT_CHUNK_SIZE], const BitSequence newChunk[SWIFFT_CHUNK_SIZE],
+	int chunkIndex)
+{
+	SWIFFT_STATS_CALL(SWIFFT_STATS_UPDATE, 1, SWIFFT_DISPATCH(hash, SWIFFT_Update)(output, oldChunk, newChunk, chunkIndex));
+}
+
+//! \brief Updates the results of multiple SWIFFT operations, each for a change of one chunk of its input.
+//! The result is the same as that of SWIFFT_ComputeMultiple on the changed inputs.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in,out] output the blocks of hash values of SWIFFT to modify, each of size 128 bytes (1024 bit).
+//! \param[in] oldChunk the old chunks, one per block, each of 8 bytes.
+//! \param[in] newChunk the new chunks, one per block, each of 8 bytes.
+//! \param[in] chunkIndex the indices of the chunks in the inputs, one per block, each from 0 to SWIFFT_INPUT_CHUNKS-1.
+void SWIFFT_UpdateMultiple(size_t nblocks, BitSequence * output,
+	const BitSequence * oldChunk, const BitSequence * newChunk, const int * chunkIndex)
+{
+	SWIFFT_STATS_CALL(SWIFFT_STATS_UPDATE_MULTIPLE, nblocks, SWIFFT_DISPATCH(hash, SWIFFT_UpdateMultiple)(nblocks, output, oldChunk, newChunk, chunkIndex));
+}
+
+//! \brief Initializes a SWIFFT key from elements of Z_{257}.
+//! The elements are given in the layout of FFT-output elements, which is the one
+//! expected by SWIFFT_fftsum, and may be in any range of int16_t.
+//!
+//! \param[out] key the SWIFFT key to initialize.
+//! \param[in] coefficients the elements of the key, of size 2048 double-bytes.
+void SWIFFT_InitKey(swifft_key_t * key, const int16_t coefficients[SWIFFT_KEY_ELEMENTS])
+{
+	int i,k,j;
+	for (i=0; i<SWIFFT_M; i++) {
+		for (k=0; k<SWIFFT_N/SWIFFT_W; k++) {
+			for (j=0; j<SWIFFT_W; j++) {
+				// center the element around 0, as done for the built-in key
+				int16_t x = coefficients[(((i << SWIFFT_LOG2_W) + k) << SWIFFT_LOG2_W) + j] % SWIFFT_P;
+				if (x > SWIFFT_P / 2) {
+					x -= SWIFFT_P;
+				}
+				if (x < SWIFFT_P / -2) {
+					x += SWIFFT_P;
+				}
+				key->elements[(SWIFFT_KEY_INDEX(i,k) << SWIFFT_LOG2_W) + j] = x;
+			}
+		}
+	}
+}
+
+//! \brief Computes the result of a SWIFFT operation using a given key.
+//! The result is composable with other hash values computed using the same key.
+//!
+//! \param[in] key the SWIFFT key.
+//! \param[in] input the input of 256 bytes (2048 bit).
+//! \param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit).
+void SWIFFT_ComputeKeyed(const swifft_key_t * key, const BitSequence input[SWIFFT_INPUT_BLOCK_SIZE],
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE])
+{
+	SWIFFT_STATS_CALL(SWIFFT_STATS_COMPUTE_KEYED, 1, SWIFFT_DISPATCH(hash, SWIFFT_ComputeKeyed)(key, input, output));
+}
+
+//! \brief Computes the result of a SWIFFT operation using a given key.
+//! The result is composable with other hash values computed using the same key.
+//!
+//! \param[in] key the SWIFFT key.
+//! \param[in] input the input of 256 bytes (2048 bit).
+//! \param[in] sign the sign bits corresponding to the input of 256 bytes (2048 bit).
+//! \param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit).
+void SWIFFT_ComputeSignedKeyed(const swifft_key_t * key, const BitSequence input[SWIFFT_INPUT_BLOCK_SIZE],
+	const BitSequence sign[SWIFFT_INPUT_BLOCK_SIZE],
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE])
+{
+	SWIFFT_STATS_CALL(SWIFFT_STATS_COMPUTE_SIGNED_KEYED, 1, SWIFFT_DISPATCH(hash, SWIFFT_ComputeSignedKeyed)(key, input, sign, output));
+}
+
+//! \brief Computes the result of multiple SWIFFT operations using a given key.
+//! The result is composable with other hash values computed using the same key.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] key the SWIFFT key.
+//! \param[in] input the blocks of input, each of 256 bytes (2048 bit).
+//! \param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).
+void SWIFFT_ComputeMultipleKeyed(size_t nblocks, const swifft_key_t * key, const BitSequence * input,
+	BitSequence * output)
+{
+	SWIFFT_STATS_CALL(SWIFFT_STATS_COMPUTE_MULTIPLE_KEYED, nblocks, SWIFFT_DISPATCH(hash, SWIFFT_ComputeMultipleKeyed)(nblocks, key, input, output));
+}
+
+//! \brief Computes the result of multiple SWIFFT operations using a given key.
+//! The result is composable with other hash values computed using the same key.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] key the SWIFFT key.
+//! \param[in] input the blocks of input, each of 256 bytes (2048 bit).
+//! \param[in] sign the blocks of sign bits corresponding to blocks of input of 256 bytes (2048 bit).
+//! \param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).
+void SWIFFT_ComputeMultipleSignedKeyed(size_t nblocks, const swifft_key_t * key, const BitSequence * input,
+	const BitSequence * sign, BitSequence * output)
+{
+	SWIFFT_STATS_CALL(SWIFFT_STATS_COMPUTE_MULTIPLE_SIGNED_KEYED, nblocks, SWIFFT_DISPATCH(hash, SWIFFT_ComputeMultipleSignedKeyed)(nblocks, key, input, sign, output));
+}
+
+//! \brief Computes the result of a SWIFFT operation on packed signed input.
+//! The result is the same as that of SWIFFT_ComputeSigned on the unpacked input and sign bits.
+//!
+//! \param[in] packed the packed signed input of 512 bytes, each chunk of 8 input bytes followed by its 8 sign bytes.
+//! \param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit).
+void SWIFFT_ComputeSignedPacked(const BitSequence packed[SWIFFT_PACKED_BLOCK_SIZE],
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE])
+{
+	SWIFFT_STATS_CALL(SWIFFT_STATS_COMPUTE_SIGNED_PACKED, 1, SWIFFT_DISPATCH(hash, SWIFFT_ComputeSignedPacked)(packed, output));
+}
+
+//! \brief Computes the result of multiple SWIFFT operations on packed signed input.
+//! The result is the same as that of SWIFFT_ComputeMultipleSigned on the unpacked blocks of input and sign bits.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] packed the blocks of packed signed input, each of 512 bytes.
+//! \param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).
+void SWIFFT_ComputeMultipleSignedPacked(size_t nblocks, const BitSequence * packed, BitSequence * output)
+{
+	SWIFFT_STATS_CALL(SWIFFT_STATS_COMPUTE_MULTIPLE_SIGNED_PACKED, nblocks, SWIFFT_DISPATCH(hash, SWIFFT_ComputeMultipleSignedPacked)(nblocks, packed, output));
+}
+
+//! \brief Computes the results of multiple SWIFFT operations under each of several keys.
+//! The result for each key is the same as that of SWIFFT_ComputeMultipleKeyed, or of
+//! SWIFFT_ComputeMultipleSignedKeyed given sign bits, but the FFT phase, which does not
+//! depend on the key, is computed once per block.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] input the blocks of input, each of 256 bytes (2048 bit).
+//! \param[in] sign the blocks of sign bits corresponding to blocks of input of 256 bytes (2048 bit), or NULL for unsigned input.
+//! \param[in] nkeys the number of keys.
+//! \param[in] keys the SWIFFT keys.
+//! \param[out] outputs the resulting blocks of hash values of SWIFFT, per key, each block of size 128 bytes (1024 bit).
+void SWIFFT_ComputeMultiKey(size_t nblocks, const BitSequence * input, const BitSequence * sign,
+	int nkeys, const swifft_key_t * const * keys, BitSequence * const * outputs)
+{
+	SWIFFT_STATS_CALL(SWIFFT_STATS_COMPUTE_MULTI_KEY, nblocks, SWIFFT_DISPATCH(hash, SWIFFT_ComputeMultiKey)(nblocks, input, sign, nkeys, keys, outputs));
+}
+
+//! \brief Computes the result of a SWIFFT operation on short input.
+//! The result is the same as that of SWIFFT_Compute on the input padded with zero bytes to 256 bytes,
+//! but the work is proportional to the number of chunks of input.
+//!
+//! \param[in] m the number of chunks of input, a multiple of SWIFFT_SHORT_CHUNKS_MULTIPLE up to SWIFFT_INPUT_CHUNKS.
+//! \param[in] input the input of m chunks of 8 bytes.
+//! \param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit).
+//! \returns 0 on success, or -1 if m is invalid.
+int SWIFFT_ComputeShort(int m, const BitSequence * input,
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE])
+{
+	int result;
+	SWIFFT_STATS_CALL(SWIFFT_STATS_COMPUTE_SHORT, 1,
+		result = SWIFFT_DISPATCH(hash, SWIFFT_ComputeShort)(m, input, output));
+	return result;
+}
+
+//! \brief Computes the result of a SWIFFT operation on short signed input.
+//! The result is the same as that of SWIFFT_ComputeSigned on the input and sign bits padded with zero bytes to 256 bytes,
+//! but the work is proportional to the number of chunks of input.
+//!
+//! \param[in] m the number of chunks of input, a multiple of SWIFFT_SHORT_CHUNKS_MULTIPLE up to SWIFFT_INPUT_CHUNKS.
+//! \param[in] input the input of m chunks of 8 bytes.
+//! \param[in] sign the sign bits corresponding to the input of m chunks of 8 bytes.
+//! \param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit).
+//! \returns 0 on success, or -1 if m is invalid.
+int SWIFFT_ComputeSignedShort(int m, const BitSequence * input, const BitSequence * sign,
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE])
+{
+	int result;
+	SWIFFT_STATS_CALL(SWIFFT_STATS_COMPUTE_SIGNED_SHORT, 1,
+		result = SWIFFT_DISPATCH(hash, SWIFFT_ComputeSignedShort)(m, input, sign, output));
+	return result;
+}
+
+//! \brief Computes the result of multiple SWIFFT operations on short input.
+//! The result is the same as that of SWIFFT_ComputeMultiple on the blocks of input each padded with zero bytes to 256 bytes.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] m the number of chunks of input per block, a multiple of SWIFFT_SHORT_CHUNKS_MULTIPLE up to SWIFFT_INPUT_CHUNKS.
+//! \param[in] input the blocks of input, each of m chunks of 8 bytes.
+//! \param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).
+//! \returns 0 on success, or -1 if m is invalid.
+int SWIFFT_ComputeMultipleShort(size_t nblocks, int m, const BitSequence * input, BitSequence * output)
+{
+	int result;
+	SWIFFT_STATS_CALL(SWIFFT_STATS_COMPUTE_MULTIPLE_SHORT, nblocks,
+		result = SWIFFT_DISPATCH(hash, SWIFFT_ComputeMultipleShort)(nblocks, m, input, output));
+	return result;
+}
+
+//! \brief Computes the result of multiple SWIFFT operations on short signed input.
+//! The result is the same as that of SWIFFT_ComputeMultipleSigned on the blocks of input and
+//! sign bits each padded with zero bytes to 256 bytes.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] m the number of chunks of input per block, a multiple of SWIFFT_SHORT_CHUNKS_MULTIPLE up to SWIFFT_INPUT_CHUNKS.
+//! \param[in] input the blocks of input, each of m chunks of 8 bytes.
+//! \param[in] sign the blocks of sign bits corresponding to blocks of input, each of m chunks of 8 bytes.
+//! \param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).
+//! \returns 0 on success, or -1 if m is invalid.
+int SWIFFT_ComputeMultipleSignedShort(size_t nblocks, int m, const BitSequence * input,
 	const BitSequence * sign, BitSequence * output)
 {
-	SWIFFT_ISET_NAME(SWIFFT_ComputeMultipleSigned_)(nblocks, input, sign, output);
+	int result;
+	SWIFFT_STATS_CALL(SWIFFT_STATS_COMPUTE_MULTIPLE_SIGNED_SHORT, nblocks,
+		result = SWIFFT_DISPATCH(hash, SWIFFT_ComputeMultipleSignedShort)(nblocks, m, input, sign, output));
+	return result;
 }
 
 LIBSWIFFT_END_EXTERN_C
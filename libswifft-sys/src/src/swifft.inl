@@ -8,69 +8,157 @@
  */
 #include <stddef.h> // for size_t
 #include <string.h> // for memcpy
+#if defined(__x86_64__) || defined(__i386__)
+	#include <immintrin.h> // for non-temporal stores
+#endif
 #include "swifft_iset.inl"
+#include "swifft_pool.h"
 #include "swifft_ops.inl"
+#include "transpose_8x8_16_lanes.inl"
 
-#ifndef SWIFFT_BLOCKS_PARALLELIZATION_THRESHOLD
-	#define SWIFFT_BLOCKS_PARALLELIZATION_THRESHOLD 8
-#endif
+//! \brief The arguments of an operation on multiple blocks, for running it on ranges of blocks.
+typedef struct {
+	const int16_t *key;        ///< The SWIFFT key, if any
+	const BitSequence *input;  ///< The blocks of input, if any
+	const BitSequence *sign;   ///< The blocks of sign bits, if any
+	const void *operand;       ///< The operands, one per block, if any
+	void *output;              ///< The blocks of output
+	int m;                     ///< The number of 8-elements in the input, if any
+	const int *index;          ///< The indices of chunks, one per block, if any
+} SWIFFT_task_t;
 
 LIBSWIFFT_BEGIN_EXTERN_C
 
-//! \brief Computes the FFT phase of SWIFFT.
+#if defined(__AVX512BW__) && (SWIFFT_O == 4)
+	#include "fft_lookup_avx512bw.inl"
+#else
+//! \brief Looks up the FFT-table entries for SWIFFT_O 8-element chunks of unsigned input.
+//! The entries are multiplied by the FFT multipliers, given in the same layout.
 //!
-//! \param[in] input the blocks of input, each of 256 bytes (2048 bits).
-//! \param[in] sign the blocks of sign bits corresponding to blocks of input of 256 bytes (2048 bits).
-//! \param[in] m number of 8-elements in the input.
-//! \param[out] fftout the blocks of FFT-output elements, totaling SWIFFT_N*m.
-void SWIFFT_ISET_NAME(SWIFFT_fft_)(const BitSequence * LIBSWIFFT_RESTRICT input, const BitSequence * LIBSWIFFT_RESTRICT sign, int m, int16_t * LIBSWIFFT_RESTRICT fftout)
+//! \param[in] Tabl the FFT table.
+//! \param[in] Mult the FFT multipliers.
+//! \param[in] t the SWIFFT_O chunks of 8 input bytes.
+//! \param[out] v the looked up entries, one wide SWIFFT vector per byte of a chunk.
+static inline void SWIFFT_fftLookup(const Z1vec * LIBSWIFFT_RESTRICT Tabl, const Z1vec * LIBSWIFFT_RESTRICT Mult,
+	const BitSequence * LIBSWIFFT_RESTRICT t, ZOvec v[8])
 {
-	int i,j,k;
-	Z1vec *out = (Z1vec *) fftout;
-	const Z1vec *Mult = (const Z1vec *) SWIFFT_multipliers;
-	const Z1vec *Tabl = (const Z1vec *) SWIFFT_fftTable;
-
-	const BitSequence *t = input;
-	const BitSequence *u = sign;
-	ZOvec v[8];
+	int j,k;
+	for (j=0; j<SWIFFT_O; j++,t+=8) {
+		// no need for SWIFFT_safeMult because multipliers do not hit an edge case
+		((Z1vec *)&v[0])[j] = Tabl[t[0]];
+		for (k=1; k<8; k++) {
+			((Z1vec *)&v[k])[j] = Tabl[t[k]] * Mult[k];
+		}
+	}
+}
 
-	for (i=0; i<(m>>SWIFFT_LOG2_O); i++) {
-		for (j=0; j<SWIFFT_O; j++,t+=8,u+=8) {
-			// no need for SWIFFT_safeMult because multipliers do not hit an edge case
-			((Z1vec *)&v[0])[j] = Tabl[SWIFFT_INT16(u[0],t[0])];
-			for (k=1; k<8; k++) {
-				((Z1vec *)&v[k])[j] = Tabl[SWIFFT_INT16(u[k],t[k])] * Mult[k];
-			}
+//! \brief Looks up the FFT-table entries for SWIFFT_O 8-element chunks of signed input.
+//! The entries are multiplied by the FFT multipliers, given in the same layout.
+//!
+//! The entry of an input byte is the difference of the entries of its positive
+//! bits and of its negative bits, so the unsigned FFT table serves signed input too.
+//!
+//! \param[in] Tabl the FFT table.
+//! \param[in] Mult the FFT multipliers.
+//! \param[in] t the SWIFFT_O chunks of 8 input bytes.
+//! \param[in] u the SWIFFT_O chunks of 8 sign bytes corresponding to the input.
+//! \param[in] stride the distance in bytes between consecutive chunks of t, and of u.
+//! \param[out] v the looked up entries, one wide SWIFFT vector per byte of a chunk.
+static inline void SWIFFT_fftLookupSigned(const Z1vec * LIBSWIFFT_RESTRICT Tabl, const Z1vec * LIBSWIFFT_RESTRICT Mult,
+	const BitSequence * LIBSWIFFT_RESTRICT t, const BitSequence * LIBSWIFFT_RESTRICT u, int stride, ZOvec v[8])
+{
+	int j,k;
+	ZOvec n[8];
+	for (j=0; j<SWIFFT_O; j++) {
+		for (k=0; k<8; k++) {
+			((Z1vec *)&v[k])[j] = Tabl[t[stride*j+k] & ~u[stride*j+k]];
+			((Z1vec *)&n[k])[j] = Tabl[t[stride*j+k] & u[stride*j+k]];
+		}
+	}
+	for (k=0; k<8; k++) {
+		v[k] = SWIFFT_center(v[k] - n[k]);
+	}
+	for (j=0; j<SWIFFT_O; j++) {
+		// no need for SWIFFT_safeMult because multipliers do not hit an edge case
+		for (k=1; k<8; k++) {
+			((Z1vec *)&v[k])[j] *= Mult[k];
 		}
+	}
+}
+#endif
 
-		SWIFFT_AddSub(v[0],v[1]);
-		SWIFFT_AddSub(v[2],v[3]);
-		SWIFFT_AddSub(v[4],v[5]);
-		SWIFFT_AddSub(v[6],v[7]);
+//! \brief Computes the FFT butterflies of SWIFFT_O 8-element chunks of input, in place.
+//!
+//! \param[in,out] v the looked up entries on input, and the FFT-output elements on output.
+static LIBSWIFFT_INLINE void SWIFFT_fftButterflies(ZOvec v[8])
+{
+	int k;
 
-		v[2] = SWIFFT_qReduce(v[2]);
-		v[3] = SWIFFT_shift(v[3],4);
-		v[6] = SWIFFT_qReduce(v[6]);
-		v[7] = SWIFFT_shift(v[7],4);
+	SWIFFT_AddSub(v[0],v[1]);
+	SWIFFT_AddSub(v[2],v[3]);
+	SWIFFT_AddSub(v[4],v[5]);
+	SWIFFT_AddSub(v[6],v[7]);
 
-		SWIFFT_AddSub(v[0],v[2]);
-		SWIFFT_AddSub(v[1],v[3]);
-		SWIFFT_AddSub(v[4],v[6]);
-		SWIFFT_AddSub(v[5],v[7]);
+	v[2] = SWIFFT_qReduce(v[2]);
+	v[3] = SWIFFT_shift(v[3],4);
+	v[6] = SWIFFT_qReduce(v[6]);
+	v[7] = SWIFFT_shift(v[7],4);
 
-		v[4] = SWIFFT_qReduce(v[4]);
-		v[5] = SWIFFT_shift(v[5],2);
-		v[6] = SWIFFT_shift(v[6],4);
-		v[7] = SWIFFT_shift(v[7],6);
+	SWIFFT_AddSub(v[0],v[2]);
+	SWIFFT_AddSub(v[1],v[3]);
+	SWIFFT_AddSub(v[4],v[6]);
+	SWIFFT_AddSub(v[5],v[7]);
 
-		SWIFFT_AddSub(v[0],v[4]);
-		SWIFFT_AddSub(v[1],v[5]);
-		SWIFFT_AddSub(v[2],v[6]);
-		SWIFFT_AddSub(v[3],v[7]);
+	v[4] = SWIFFT_qReduce(v[4]);
+	v[5] = SWIFFT_shift(v[5],2);
+	v[6] = SWIFFT_shift(v[6],4);
+	v[7] = SWIFFT_shift(v[7],6);
 
-		for (k=0; k<8; k++) {
-			v[k] = SWIFFT_qReduce(v[k]);
-		}
+	SWIFFT_AddSub(v[0],v[4]);
+	SWIFFT_AddSub(v[1],v[5]);
+	SWIFFT_AddSub(v[2],v[6]);
+	SWIFFT_AddSub(v[3],v[7]);
+
+	for (k=0; k<8; k++) {
+		v[k] = SWIFFT_qReduce(v[k]);
+	}
+}
+
+//! \brief Computes the FFT of SWIFFT_O 8-element chunks of input that is unsigned if u is NULL.
+//!
+//! \param[in] t the SWIFFT_O chunks of 8 input bytes.
+//! \param[in] u the SWIFFT_O chunks of 8 sign bytes corresponding to the input, or NULL.
+//! \param[in] stride the distance in bytes between consecutive chunks of signed t, and of u.
+//! \param[out] v the FFT-output elements, one wide SWIFFT vector per byte of a chunk.
+static LIBSWIFFT_INLINE void SWIFFT_fftChunks(const BitSequence * LIBSWIFFT_RESTRICT t,
+	const BitSequence * LIBSWIFFT_RESTRICT u, int stride, ZOvec v[8])
+{
+	const Z1vec *Mult = (const Z1vec *) SWIFFT_multipliers;
+	const Z1vec *Tabl = (const Z1vec *) SWIFFT_fftTable;
+
+	if (u) {
+		SWIFFT_fftLookupSigned(Tabl, Mult, t, u, stride, v);
+	} else {
+		SWIFFT_fftLookup(Tabl, Mult, t, v);
+	}
+	SWIFFT_fftButterflies(v);
+}
+
+//! \brief Computes the FFT phase of SWIFFT on input that is unsigned if sign is NULL.
+//! Being always inlined, each call site with a NULL sign compiles to a kernel that does not read sign bytes.
+//!
+//! \param[in] input the blocks of input, each of 256 bytes (2048 bits).
+//! \param[in] sign the blocks of sign bits corresponding to blocks of input of 256 bytes (2048 bits), or NULL.
+//! \param[in] m number of 8-elements in the input.
+//! \param[out] fftout the blocks of FFT-output elements, totaling SWIFFT_N*m.
+static LIBSWIFFT_INLINE void SWIFFT_fftPhase(const BitSequence * LIBSWIFFT_RESTRICT input, const BitSequence * LIBSWIFFT_RESTRICT sign, int m, int16_t * LIBSWIFFT_RESTRICT fftout)
+{
+	int i,j,k;
+	Z1vec *out = (Z1vec *) fftout;
+	ZOvec v[8];
+
+	for (i=0; i<(m>>SWIFFT_LOG2_O); i++) {
+		SWIFFT_fftChunks(input + i*8*SWIFFT_O, sign ? sign + i*8*SWIFFT_O : NULL, SWIFFT_CHUNK_SIZE, v);
 
 		for (j=0; j<SWIFFT_O; j++,out+=8) {
 			for (k=0; k<8; k++) {
@@ -80,6 +168,21 @@ void SWIFFT_ISET_NAME(SWIFFT_fft_)(const BitSequence * LIBSWIFFT_RESTRICT input,
 	}
 }
 
+//! \brief Computes the FFT phase of SWIFFT.
+//!
+//! \param[in] input the blocks of input, each of 256 bytes (2048 bits).
+//! \param[in] sign the blocks of sign bits corresponding to blocks of input of 256 bytes (2048 bits).
+//! \param[in] m number of 8-elements in the input.
+//! \param[out] fftout the blocks of FFT-output elements, totaling SWIFFT_N*m.
+void SWIFFT_ISET_NAME(SWIFFT_fft_)(const BitSequence * LIBSWIFFT_RESTRICT input, const BitSequence * LIBSWIFFT_RESTRICT sign, int m, int16_t * LIBSWIFFT_RESTRICT fftout)
+{
+	if (sign == SWIFFT_sign0) {
+		SWIFFT_fftPhase(input, NULL, m, fftout);
+	} else {
+		SWIFFT_fftPhase(input, sign, m, fftout);
+	}
+}
+
 void SWIFFT_ISET_NAME(SWIFFT_fftsum_)(const int16_t * LIBSWIFFT_RESTRICT ikey,
 	const int16_t * LIBSWIFFT_RESTRICT ifftout, int m, int16_t * LIBSWIFFT_RESTRICT iout)
 {
@@ -223,20 +326,176 @@ void SWIFFT_ISET_NAME(SWIFFT_Mul_)(BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
 	}
 }
 
+//! \brief Folds the elements of an accumulator to {-127,..,383} if it has no headroom left.
+//!
+//! \param[in,out] acc the accumulator.
+static inline void SWIFFT_accumulatorFold(swifft_accumulator_t * acc)
+{
+	size_t i;
+	ZOvec *zacc = (ZOvec *)acc->elements;
+	size_t size = SWIFFT_OUTPUT_BLOCK_SIZE/sizeof(ZOvec);
+	if (acc->pending < SWIFFT_ACCUMULATOR_HEADROOM) {
+		return;
+	}
+	for (i=0; i<size; i++,zacc++) {
+		*zacc = SWIFFT_qReduce(*zacc);
+	}
+	acc->pending = 0;
+}
+
+//! \brief Initializes an accumulator of SWIFFT hash values to zero.
+//!
+//! \param[out] acc the accumulator.
+void SWIFFT_ISET_NAME(SWIFFT_AccumulatorInit_)(swifft_accumulator_t * acc)
+{
+	memset(acc->elements, 0, sizeof(acc->elements));
+	acc->pending = 0;
+}
+
+//! \brief Adds a SWIFFT hash value to an accumulator, without reducing the sum.
+//! The elements are folded, with a partial reduction, once every SWIFFT_ACCUMULATOR_HEADROOM operations.
+//!
+//! \param[in,out] acc the accumulator.
+//! \param[in] operand the reduced hash value to add.
+void SWIFFT_ISET_NAME(SWIFFT_AccumulatorAdd_)(swifft_accumulator_t * acc,
+	const BitSequence operand[SWIFFT_OUTPUT_BLOCK_SIZE])
+{
+	size_t i;
+	const ZOvec *zoperand = (const ZOvec *)operand;
+	ZOvec *zacc = (ZOvec *)acc->elements;
+	size_t size = SWIFFT_OUTPUT_BLOCK_SIZE/sizeof(ZOvec);
+	SWIFFT_accumulatorFold(acc);
+	for (i=0; i<size; i++,zoperand++,zacc++) {
+		*zacc += *zoperand;
+	}
+	acc->pending++;
+}
+
+//! \brief Subtracts a SWIFFT hash value from an accumulator, without reducing the difference.
+//! The elements are folded, with a partial reduction, once every SWIFFT_ACCUMULATOR_HEADROOM operations.
+//!
+//! \param[in,out] acc the accumulator.
+//! \param[in] operand the reduced hash value to subtract.
+void SWIFFT_ISET_NAME(SWIFFT_AccumulatorSub_)(swifft_accumulator_t * acc,
+	const BitSequence operand[SWIFFT_OUTPUT_BLOCK_SIZE])
+{
+	size_t i;
+	const ZOvec *zoperand = (const ZOvec *)operand;
+	ZOvec *zacc = (ZOvec *)acc->elements;
+	size_t size = SWIFFT_OUTPUT_BLOCK_SIZE/sizeof(ZOvec);
+	SWIFFT_accumulatorFold(acc);
+	for (i=0; i<size; i++,zoperand++,zacc++) {
+		*zacc -= *zoperand;
+	}
+	acc->pending++;
+}
+
+//! \brief Reduces an accumulator of SWIFFT hash values to a hash value.
+//! The result is the same as that of the additions and subtractions of the accumulator done using SWIFFT_Add and SWIFFT_Sub.
+//!
+//! \param[in] acc the accumulator.
+//! \param[out] output the resulting hash value of SWIFFT.
+void SWIFFT_ISET_NAME(SWIFFT_Reduce_)(const swifft_accumulator_t * acc,
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE])
+{
+	size_t i;
+	const ZOvec *zacc = (const ZOvec *)acc->elements;
+	ZOvec *zoutput = (ZOvec *)output;
+	size_t size = SWIFFT_OUTPUT_BLOCK_SIZE/sizeof(ZOvec);
+	for (i=0; i<size; i++,zacc++,zoutput++) {
+		*zoutput = SWIFFT_modP(*zacc);
+	}
+}
+
+//! \brief Sums the accumulated products of the FFT-sum phase of SWIFFT into a hash value.
+//! Each chunk of the accumulators holds a partial sum for the same FFT-output elements.
+//!
+//! \param[in] acc the accumulated products, per FFT-output element.
+//! \param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit).
+static LIBSWIFFT_INLINE void SWIFFT_fftsumFold(const ZOvec acc[8], BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE])
+{
+	int j,k;
+	ZOvec *out = (ZOvec *)output;
+	ZOvec sum[8 >> SWIFFT_LOG2_O];
+	for (k=0; k<8; k++) {
+		Z1vec s = ((const Z1vec *)&acc[k])[0];
+		for (j=1; j<SWIFFT_O; j++) {
+			s += ((const Z1vec *)&acc[k])[j];
+		}
+		((Z1vec *)sum)[k] = s;
+	}
+	for (j=0; j<(8>>SWIFFT_LOG2_O); j++) {
+		out[j] = SWIFFT_modP(sum[j]);
+	}
+}
+
 //! \brief Computes the result of a SWIFFT operation.
-//! The result is composable with other hash values.
+//! The result is composable with other hash values computed using the same key.
+//!
+//! The FFT and FFT-sum phases are fused: the FFT-output elements of each SWIFFT_O
+//! chunks are multiplied by the key and accumulated while still in registers,
+//! instead of being stored to an FFT-output buffer and loaded back. The key is
+//! interleaved so that the key elements matching these registers are contiguous.
+//!
+//! The input and sign chunks are stride bytes apart, so the same kernel reads either
+//! separate input and sign blocks, or a packed block with SWIFFT_PACKED_BLOCK_SIZE.
+//!
+//! \param[in] key the SWIFFT key elements, centered and interleaved as given by SWIFFT_KEY_INDEX.
+//! \param[in] input the input of m chunks of 8 bytes, stride bytes apart.
+//! \param[in] sign the sign bits corresponding to the input, in chunks stride bytes apart, or NULL for unsigned input.
+//! \param[in] stride the distance in bytes between consecutive chunks of signed input, and of sign bits.
+//! \param[in] m the number of chunks of input, a multiple of SWIFFT_O, read against a prefix of the key.
+//! \param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit).
+static LIBSWIFFT_INLINE void SWIFFT_computeStrided(const int16_t * LIBSWIFFT_RESTRICT key,
+	const BitSequence * LIBSWIFFT_RESTRICT input,
+	const BitSequence * LIBSWIFFT_RESTRICT sign,
+	int stride,
+	int m,
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE])
+{
+	int i,k;
+	ZOvec v[8];
+
+	ZOvec acc[8] = {0};
+	for (i=0; i<(m>>SWIFFT_LOG2_O); i++) {
+		if (sign) {
+			SWIFFT_fftChunks(input + i*stride*SWIFFT_O, sign + i*stride*SWIFFT_O, stride, v);
+		} else {
+			SWIFFT_fftChunks(input + i*8*SWIFFT_O, NULL, SWIFFT_CHUNK_SIZE, v);
+		}
+		for (k=0; k<8; k++) {
+			const ZOvec *zkey = (const ZOvec *)(key + SWIFFT_W*SWIFFT_KEY_INDEX(i*SWIFFT_O, k));
+			// reducing FFT output to avoid overflow
+			acc[k] += SWIFFT_qReduce(SWIFFT_safeMult(v[k], *zkey));
+		}
+	}
+	SWIFFT_fftsumFold(acc, output);
+}
+
+//! \brief Computes the FFT and FFT-sum phases of SWIFFT on contiguous input and sign blocks.
 //!
+//! \param[in] key the SWIFFT key elements, centered and interleaved as given by SWIFFT_KEY_INDEX.
 //! \param[in] input the input of 256 bytes (2048 bit).
-//! \param[in] sign the sign bits corresponding to the input of 256 bytes (2048 bit).
+//! \param[in] sign the sign bits corresponding to the input of 256 bytes (2048 bit), or NULL for unsigned input.
 //! \param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit).
-static inline void SWIFFT_compute(const BitSequence input[SWIFFT_INPUT_BLOCK_SIZE],
+static LIBSWIFFT_INLINE void SWIFFT_compute(const int16_t * LIBSWIFFT_RESTRICT key,
+	const BitSequence input[SWIFFT_INPUT_BLOCK_SIZE],
 	const BitSequence sign[SWIFFT_INPUT_BLOCK_SIZE],
 	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE])
 {
-	// do FFT and linear combination of FFT coefficients
-	SWIFFT_ALIGN int16_t fftout[SWIFFT_N*SWIFFT_M];
-	SWIFFT_ISET_NAME(SWIFFT_fft_)(input, sign, SWIFFT_M, fftout);
-	SWIFFT_ISET_NAME(SWIFFT_fftsum_)(SWIFFT_PI_key, fftout, SWIFFT_M, (int16_t *)output);
+	SWIFFT_computeStrided(key, input, sign, SWIFFT_CHUNK_SIZE, SWIFFT_M, output);
+}
+
+//! \brief Computes the FFT and FFT-sum phases of SWIFFT on a packed signed block.
+//!
+//! \param[in] key the SWIFFT key elements, centered and interleaved as given by SWIFFT_KEY_INDEX.
+//! \param[in] packed the packed signed input of 512 bytes, as given by SWIFFT_PACKED_BLOCK_SIZE.
+//! \param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit).
+static LIBSWIFFT_INLINE void SWIFFT_computePacked(const int16_t * LIBSWIFFT_RESTRICT key,
+	const BitSequence packed[SWIFFT_PACKED_BLOCK_SIZE],
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE])
+{
+	SWIFFT_computeStrided(key, packed, packed + SWIFFT_CHUNK_SIZE, 2*SWIFFT_CHUNK_SIZE, SWIFFT_M, output);
 }
 
 //! \brief Computes the result of a SWIFFT operation.
@@ -247,7 +506,7 @@ static inline void SWIFFT_compute(const BitSequence input[SWIFFT_INPUT_BLOCK_SIZ
 void SWIFFT_ISET_NAME(SWIFFT_Compute_)(const BitSequence input[SWIFFT_INPUT_BLOCK_SIZE],
 	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE])
 {
-	SWIFFT_compute(input, SWIFFT_sign0, output);
+	SWIFFT_compute(SWIFFT_PI_keyInterleaved, input, NULL, output);
 }
 
 //! \brief Computes the result of a SWIFFT operation.
@@ -260,7 +519,22 @@ void SWIFFT_ISET_NAME(SWIFFT_ComputeSigned_)(const BitSequence input[SWIFFT_INPU
 	const BitSequence sign[SWIFFT_INPUT_BLOCK_SIZE],
 	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE])
 {
-	SWIFFT_compute(input, sign, output);
+	SWIFFT_compute(SWIFFT_PI_keyInterleaved, input, sign, output);
+}
+
+//! \brief Runs an FFT phase of SWIFFT_fftMultiple on a range of blocks, given a SWIFFT_task_t.
+static void SWIFFT_fftMultipleRange(void *vtask, size_t begin, size_t end)
+{
+	const SWIFFT_task_t *task = (const SWIFFT_task_t *)vtask;
+	size_t i;
+	for (i=begin; i<end; i++) {
+		SWIFFT_ISET_NAME(SWIFFT_fft_)(
+			task->input + i * SWIFFT_INPUT_BLOCK_SIZE,
+			task->sign + i * SWIFFT_INPUT_BLOCK_SIZE,
+			task->m,
+			(int16_t *)task->output + i * SWIFFT_N * SWIFFT_M
+		);
+	}
 }
 
 //! \brief Computes the FFT phase of SWIFFT for multiple blocks.
@@ -270,18 +544,23 @@ void SWIFFT_ISET_NAME(SWIFFT_ComputeSigned_)(const BitSequence input[SWIFFT_INPU
 //! \param[in] sign the blocks of sign bits corresponding to blocks of input of 256 bytes (2048 bits).
 //! \param[in] m number of 8-elements in the input.
 //! \param[out] fftout the blocks of FFT-output elements, totaling nblocks*N*m.
-void SWIFFT_ISET_NAME(SWIFFT_fftMultiple_)(int nblocks, const BitSequence * LIBSWIFFT_RESTRICT input, const BitSequence * LIBSWIFFT_RESTRICT sign, int m, int16_t * LIBSWIFFT_RESTRICT fftout)
+void SWIFFT_ISET_NAME(SWIFFT_fftMultiple_)(size_t nblocks, const BitSequence * LIBSWIFFT_RESTRICT input, const BitSequence * LIBSWIFFT_RESTRICT sign, int m, int16_t * LIBSWIFFT_RESTRICT fftout)
 {
-	int i;
-#ifdef _OPENMP
-	#pragma omp parallel for schedule(static) private(i) if(nblocks > SWIFFT_BLOCKS_PARALLELIZATION_THRESHOLD)
-#endif
-	for (i=0; i<nblocks; i++) {
-		SWIFFT_ISET_NAME(SWIFFT_fft_)(
-			input + i * SWIFFT_INPUT_BLOCK_SIZE,
-			sign + i * SWIFFT_INPUT_BLOCK_SIZE,
-			m,
-			fftout + i * SWIFFT_N * SWIFFT_M
+	SWIFFT_task_t task = { NULL, input, sign, NULL, fftout, m, NULL };
+	SWIFFT_ParallelForOp(nblocks, SWIFFT_OP_FFT, SWIFFT_fftMultipleRange, &task);
+}
+
+//! \brief Runs an FFT-sum phase of SWIFFT_fftsumMultiple on a range of blocks, given a SWIFFT_task_t.
+static void SWIFFT_fftsumMultipleRange(void *vtask, size_t begin, size_t end)
+{
+	const SWIFFT_task_t *task = (const SWIFFT_task_t *)vtask;
+	size_t i;
+	for (i=begin; i<end; i++) {
+		SWIFFT_ISET_NAME(SWIFFT_fftsum_)(
+			task->key,
+			(const int16_t *)task->operand + i * SWIFFT_N * SWIFFT_M,
+			task->m,
+			(int16_t *)task->output + i * (SWIFFT_OUTPUT_BLOCK_SIZE / sizeof(int16_t))
 		);
 	}
 }
@@ -293,19 +572,99 @@ void SWIFFT_ISET_NAME(SWIFFT_fftMultiple_)(int nblocks, const BitSequence * LIBS
 //! \param[in] ifftout the blocks of FFT-output elements, totaling N*m
 //! \param[in] m number of 8-elements in the input.
 //! \param[out] iout the blocks of output elements, each of 64 double-bytes (1024 bits).
-void SWIFFT_ISET_NAME(SWIFFT_fftsumMultiple_)(int nblocks, const int16_t * LIBSWIFFT_RESTRICT ikey,
+void SWIFFT_ISET_NAME(SWIFFT_fftsumMultiple_)(size_t nblocks, const int16_t * LIBSWIFFT_RESTRICT ikey,
         const int16_t * LIBSWIFFT_RESTRICT ifftout, int m, int16_t * LIBSWIFFT_RESTRICT iout)
 {
+	SWIFFT_task_t task = { ikey, NULL, NULL, ifftout, iout, m, NULL };
+	SWIFFT_ParallelForOp(nblocks, SWIFFT_OP_FFT, SWIFFT_fftsumMultipleRange, &task);
+}
+
+//! \brief Converts from base-257 to base-256, for the digits in each element position.
+//!
+//! vals array is assumed to have n digits in base 257.
+//! Assume that most significiant is last.
+//! output in vals is the same n numbers encoded in base 256.
+//!
+//! \param[in,out] vals the vals array.
+//! \param[in] n the length of the vals array.
+static inline void SWIFFT_toBase256(ZOvec * vals, int n)
+{
+	ZOvec ZO_255 = ZOCONST(255), ZO_8 = ZOCONST(8);
 	int i;
-#ifdef _OPENMP
-	#pragma omp parallel for schedule(static) private(i) if(nblocks > SWIFFT_BLOCKS_PARALLELIZATION_THRESHOLD)
+	for (i=n-1; i>0; i--) {
+		int j;
+		for (j=i-1; j<n-1; j++) {
+			ZOvec v = vals[j] + vals[j+1];
+			vals[j] = v & ZO_255;
+			vals[j+1] += (v >> ZO_8);
+		}
+	}
+}
+
+#ifdef SWIFFT_HAVE_TRANSPOSE_LANES
+//! \brief Compacts SWIFFT_O hash values of SWIFFT at once, one per 128-bit lane.
+//! The result is the same as that of SWIFFT_Compact on each hash value.
+//!
+//! \param[in] output the hash values of SWIFFT, of size 128 bytes (1024 bit) per block.
+//! \param[out] compact the compacted hash values of SWIFFT, of size 64 bytes (512 bit) per block.
+static inline void SWIFFT_compactBlocks(const BitSequence * LIBSWIFFT_RESTRICT output,
+	BitSequence * LIBSWIFFT_RESTRICT compact)
+{
+	ZOvec ZO_255 = ZOCONST(255);
+	ZOvec v[8], p[4];
+	int i,j;
+	for (j=0; j<SWIFFT_O; j++) {
+		const Z1vec *zoutput = (const Z1vec *)(output + j * SWIFFT_OUTPUT_BLOCK_SIZE);
+		for (i=0; i<8; i++) {
+			((Z1vec *)&v[i])[j] = zoutput[i];
+		}
+	}
+	SWIFFT_transposeLanes(v);
+	SWIFFT_toBase256(v, 8);
+	// ignore carry bit, to avoid saturation
+	v[7] &= ZO_255;
+	SWIFFT_transposeLanes(v);
+	SWIFFT_packLanes(v, p);
+	for (j=0; j<SWIFFT_O; j++) {
+		Z1vec *zcompact = (Z1vec *)(compact + j * SWIFFT_COMPACT_BLOCK_SIZE);
+		for (i=0; i<4; i++) {
+			zcompact[i] = ((Z1vec *)&p[i])[j];
+		}
+	}
+}
+#else
+//! \brief Compacts SWIFFT_O hash values of SWIFFT, one after the other.
+//!
+//! \param[in] output the hash values of SWIFFT, of size 128 bytes (1024 bit) per block.
+//! \param[out] compact the compacted hash values of SWIFFT, of size 64 bytes (512 bit) per block.
+static inline void SWIFFT_compactBlocks(const BitSequence * LIBSWIFFT_RESTRICT output,
+	BitSequence * LIBSWIFFT_RESTRICT compact)
+{
+	int j;
+	for (j=0; j<SWIFFT_O; j++) {
+		SWIFFT_compact(output + j * SWIFFT_OUTPUT_BLOCK_SIZE, compact + j * SWIFFT_COMPACT_BLOCK_SIZE);
+	}
+}
 #endif
-	for (i=0; i<nblocks; i++) {
-		SWIFFT_ISET_NAME(SWIFFT_fftsum_)(
-			ikey,
-			ifftout + i * SWIFFT_N * SWIFFT_M,
-			m,
-			iout + i * (SWIFFT_OUTPUT_BLOCK_SIZE / sizeof(int16_t))
+
+#include "swifft_soa.inl"
+
+//! \brief Runs a compaction of SWIFFT_CompactMultiple on a range of blocks, given a SWIFFT_task_t.
+static void SWIFFT_CompactMultipleRange(void *vtask, size_t begin, size_t end)
+{
+	const SWIFFT_task_t *task = (const SWIFFT_task_t *)vtask;
+	size_t i;
+	BitSequence *compact = (BitSequence *)task->output;
+	for (i=begin; i+SWIFFT_O<=end; i+=SWIFFT_O) {
+		SWIFFT_compactBlocks(
+			task->input + i * SWIFFT_OUTPUT_BLOCK_SIZE,
+			compact + i * SWIFFT_COMPACT_BLOCK_SIZE
+		);
+	}
+	for (; i<end; i++) {
+		SWIFFT_compact(
+			task->input + i * SWIFFT_OUTPUT_BLOCK_SIZE,
+			compact + i * SWIFFT_COMPACT_BLOCK_SIZE
 		);
 	}
 }
@@ -316,17 +675,22 @@ void SWIFFT_ISET_NAME(SWIFFT_fftsumMultiple_)(int nblocks, const int16_t * LIBSW
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in] output the hash value of SWIFFT, of size 128 bytes (1024 bit) per block.
 //! \param[out] compact the compacted hash value of SWIFFT, of size 64 bytes (512 bit) per block.
-void SWIFFT_ISET_NAME(SWIFFT_CompactMultiple_)(int nblocks, const BitSequence * output,
+void SWIFFT_ISET_NAME(SWIFFT_CompactMultiple_)(size_t nblocks, const BitSequence * output,
         BitSequence * compact)
 {
-	int i;
-#ifdef _OPENMP
-	#pragma omp parallel for schedule(static) private(i) if(nblocks > SWIFFT_BLOCKS_PARALLELIZATION_THRESHOLD)
-#endif
-	for (i=0; i<nblocks; i++) {
-		SWIFFT_Compact(
-			output + i * SWIFFT_OUTPUT_BLOCK_SIZE,
-			compact + i * SWIFFT_COMPACT_BLOCK_SIZE
+	SWIFFT_task_t task = { NULL, output, NULL, NULL, compact, 0, NULL };
+	SWIFFT_ParallelForOp(nblocks, SWIFFT_OP_COMPACT, SWIFFT_CompactMultipleRange, &task);
+}
+
+//! \brief Runs a constant setting of SWIFFT_ConstSetMultiple on a range of blocks, given a SWIFFT_task_t.
+static void SWIFFT_ConstSetMultipleRange(void *vtask, size_t begin, size_t end)
+{
+	const SWIFFT_task_t *task = (const SWIFFT_task_t *)vtask;
+	size_t i;
+	for (i=begin; i<end; i++) {
+		SWIFFT_ISET_NAME(SWIFFT_ConstSet_)(
+			(BitSequence *)task->output + i * SWIFFT_OUTPUT_BLOCK_SIZE,
+			((const int16_t *)task->operand)[i]
 		);
 	}
 }
@@ -336,17 +700,22 @@ void SWIFFT_ISET_NAME(SWIFFT_CompactMultiple_)(int nblocks, const BitSequence *
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[out] output the hash value of SWIFFT to modify, per block.
 //! \param[in] operand the constant value to set, per block.
-void SWIFFT_ISET_NAME(SWIFFT_ConstSetMultiple_)(int nblocks, BitSequence * output,
+void SWIFFT_ISET_NAME(SWIFFT_ConstSetMultiple_)(size_t nblocks, BitSequence * output,
         const int16_t * operand)
 {
-	int i;
-#ifdef _OPENMP
-	#pragma omp parallel for schedule(static) private(i) if(nblocks > SWIFFT_BLOCKS_PARALLELIZATION_THRESHOLD)
-#endif
-	for (i=0; i<nblocks; i++) {
-		SWIFFT_ISET_NAME(SWIFFT_ConstSet_)(
-			output + i * SWIFFT_OUTPUT_BLOCK_SIZE,
-			operand[i]
+	SWIFFT_task_t task = { NULL, NULL, NULL, operand, output, 0, NULL };
+	SWIFFT_ParallelForOp(nblocks, SWIFFT_OP_ARITH, SWIFFT_ConstSetMultipleRange, &task);
+}
+
+//! \brief Runs a constant addition of SWIFFT_ConstAddMultiple on a range of blocks, given a SWIFFT_task_t.
+static void SWIFFT_ConstAddMultipleRange(void *vtask, size_t begin, size_t end)
+{
+	const SWIFFT_task_t *task = (const SWIFFT_task_t *)vtask;
+	size_t i;
+	for (i=begin; i<end; i++) {
+		SWIFFT_ISET_NAME(SWIFFT_ConstAdd_)(
+			(BitSequence *)task->output + i * SWIFFT_OUTPUT_BLOCK_SIZE,
+			((const int16_t *)task->operand)[i]
 		);
 	}
 }
@@ -356,17 +725,22 @@ void SWIFFT_ISET_NAME(SWIFFT_ConstSetMultiple_)(int nblocks, BitSequence * outpu
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in,out] output the hash value of SWIFFT to modify, per block.
 //! \param[in] operand the constant value to add, per block.
-void SWIFFT_ISET_NAME(SWIFFT_ConstAddMultiple_)(int nblocks, BitSequence * output,
+void SWIFFT_ISET_NAME(SWIFFT_ConstAddMultiple_)(size_t nblocks, BitSequence * output,
         const int16_t * operand)
 {
-	int i;
-#ifdef _OPENMP
-	#pragma omp parallel for schedule(static) private(i) if(nblocks > SWIFFT_BLOCKS_PARALLELIZATION_THRESHOLD)
-#endif
-	for (i=0; i<nblocks; i++) {
-		SWIFFT_ISET_NAME(SWIFFT_ConstAdd_)(
-			output + i * SWIFFT_OUTPUT_BLOCK_SIZE,
-			operand[i]
+	SWIFFT_task_t task = { NULL, NULL, NULL, operand, output, 0, NULL };
+	SWIFFT_ParallelForOp(nblocks, SWIFFT_OP_ARITH, SWIFFT_ConstAddMultipleRange, &task);
+}
+
+//! \brief Runs a constant subtraction of SWIFFT_ConstSubMultiple on a range of blocks, given a SWIFFT_task_t.
+static void SWIFFT_ConstSubMultipleRange(void *vtask, size_t begin, size_t end)
+{
+	const SWIFFT_task_t *task = (const SWIFFT_task_t *)vtask;
+	size_t i;
+	for (i=begin; i<end; i++) {
+		SWIFFT_ISET_NAME(SWIFFT_ConstSub_)(
+			(BitSequence *)task->output + i * SWIFFT_OUTPUT_BLOCK_SIZE,
+			((const int16_t *)task->operand)[i]
 		);
 	}
 }
@@ -376,17 +750,22 @@ void SWIFFT_ISET_NAME(SWIFFT_ConstAddMultiple_)(int nblocks, BitSequence * outpu
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in,out] output the hash value of SWIFFT to modify, per block..
 //! \param[in] operand the constant value to subtract, per block.
-void SWIFFT_ISET_NAME(SWIFFT_ConstSubMultiple_)(int nblocks, BitSequence * output,
+void SWIFFT_ISET_NAME(SWIFFT_ConstSubMultiple_)(size_t nblocks, BitSequence * output,
         const int16_t * operand)
 {
-	int i;
-#ifdef _OPENMP
-	#pragma omp parallel for schedule(static) private(i) if(nblocks > SWIFFT_BLOCKS_PARALLELIZATION_THRESHOLD)
-#endif
-	for (i=0; i<nblocks; i++) {
-		SWIFFT_ISET_NAME(SWIFFT_ConstSub_)(
-			output + i * SWIFFT_OUTPUT_BLOCK_SIZE,
-			operand[i]
+	SWIFFT_task_t task = { NULL, NULL, NULL, operand, output, 0, NULL };
+	SWIFFT_ParallelForOp(nblocks, SWIFFT_OP_ARITH, SWIFFT_ConstSubMultipleRange, &task);
+}
+
+//! \brief Runs a constant multiplication of SWIFFT_ConstMulMultiple on a range of blocks, given a SWIFFT_task_t.
+static void SWIFFT_ConstMulMultipleRange(void *vtask, size_t begin, size_t end)
+{
+	const SWIFFT_task_t *task = (const SWIFFT_task_t *)vtask;
+	size_t i;
+	for (i=begin; i<end; i++) {
+		SWIFFT_ISET_NAME(SWIFFT_ConstMul_)(
+			(BitSequence *)task->output + i * SWIFFT_OUTPUT_BLOCK_SIZE,
+			((const int16_t *)task->operand)[i]
 		);
 	}
 }
@@ -396,17 +775,22 @@ void SWIFFT_ISET_NAME(SWIFFT_ConstSubMultiple_)(int nblocks, BitSequence * outpu
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in,out] output the hash value of SWIFFT to modify, per block..
 //! \param[in] operand the constant value to multiply by, per block.
-void SWIFFT_ISET_NAME(SWIFFT_ConstMulMultiple_)(int nblocks, BitSequence * output,
+void SWIFFT_ISET_NAME(SWIFFT_ConstMulMultiple_)(size_t nblocks, BitSequence * output,
         const int16_t * operand)
 {
-	int i;
-#ifdef _OPENMP
-	#pragma omp parallel for schedule(static) private(i) if(nblocks > SWIFFT_BLOCKS_PARALLELIZATION_THRESHOLD)
-#endif
-	for (i=0; i<nblocks; i++) {
-		SWIFFT_ISET_NAME(SWIFFT_ConstMul_)(
-			output + i * SWIFFT_OUTPUT_BLOCK_SIZE,
-			operand[i]
+	SWIFFT_task_t task = { NULL, NULL, NULL, operand, output, 0, NULL };
+	SWIFFT_ParallelForOp(nblocks, SWIFFT_OP_ARITH, SWIFFT_ConstMulMultipleRange, &task);
+}
+
+//! \brief Runs an element-wise setting of SWIFFT_SetMultiple on a range of blocks, given a SWIFFT_task_t.
+static void SWIFFT_SetMultipleRange(void *vtask, size_t begin, size_t end)
+{
+	const SWIFFT_task_t *task = (const SWIFFT_task_t *)vtask;
+	size_t i;
+	for (i=begin; i<end; i++) {
+		SWIFFT_ISET_NAME(SWIFFT_Set_)(
+			(BitSequence *)task->output + i * SWIFFT_OUTPUT_BLOCK_SIZE,
+			(const BitSequence *)task->operand + i * SWIFFT_OUTPUT_BLOCK_SIZE
 		);
 	}
 }
@@ -416,17 +800,22 @@ void SWIFFT_ISET_NAME(SWIFFT_ConstMulMultiple_)(int nblocks, BitSequence * outpu
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in,out] output the hash value of SWIFFT to modify, per block..
 //! \param[in] operand the hash value to set to, per block.
-void SWIFFT_ISET_NAME(SWIFFT_SetMultiple_)(int nblocks, BitSequence * output,
+void SWIFFT_ISET_NAME(SWIFFT_SetMultiple_)(size_t nblocks, BitSequence * output,
         const BitSequence * operand)
 {
-	int i;
-#ifdef _OPENMP
-	#pragma omp parallel for schedule(static) private(i) if(nblocks > SWIFFT_BLOCKS_PARALLELIZATION_THRESHOLD)
-#endif
-	for (i=0; i<nblocks; i++) {
-		SWIFFT_ISET_NAME(SWIFFT_Set_)(
-			output + i * SWIFFT_OUTPUT_BLOCK_SIZE,
-			operand + i * SWIFFT_OUTPUT_BLOCK_SIZE
+	SWIFFT_task_t task = { NULL, NULL, NULL, operand, output, 0, NULL };
+	SWIFFT_ParallelForOp(nblocks, SWIFFT_OP_ARITH, SWIFFT_SetMultipleRange, &task);
+}
+
+//! \brief Runs an element-wise addition of SWIFFT_AddMultiple on a range of blocks, given a SWIFFT_task_t.
+static void SWIFFT_AddMultipleRange(void *vtask, size_t begin, size_t end)
+{
+	const SWIFFT_task_t *task = (const SWIFFT_task_t *)vtask;
+	size_t i;
+	for (i=begin; i<end; i++) {
+		SWIFFT_ISET_NAME(SWIFFT_Add_)(
+			(BitSequence *)task->output + i * SWIFFT_OUTPUT_BLOCK_SIZE,
+			(const BitSequence *)task->operand + i * SWIFFT_OUTPUT_BLOCK_SIZE
 		);
 	}
 }
@@ -436,17 +825,22 @@ void SWIFFT_ISET_NAME(SWIFFT_SetMultiple_)(int nblocks, BitSequence * output,
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in,out] output the hash value of SWIFFT to modify, per block..
 //! \param[in] operand the hash value to add, per block.
-void SWIFFT_ISET_NAME(SWIFFT_AddMultiple_)(int nblocks, BitSequence * output,
+void SWIFFT_ISET_NAME(SWIFFT_AddMultiple_)(size_t nblocks, BitSequence * output,
         const BitSequence * operand)
 {
-	int i;
-#ifdef _OPENMP
-	#pragma omp parallel for schedule(static) private(i) if(nblocks > SWIFFT_BLOCKS_PARALLELIZATION_THRESHOLD)
-#endif
-	for (i=0; i<nblocks; i++) {
-		SWIFFT_ISET_NAME(SWIFFT_Add_)(
-			output + i * SWIFFT_OUTPUT_BLOCK_SIZE,
-			operand + i * SWIFFT_OUTPUT_BLOCK_SIZE
+	SWIFFT_task_t task = { NULL, NULL, NULL, operand, output, 0, NULL };
+	SWIFFT_ParallelForOp(nblocks, SWIFFT_OP_ARITH, SWIFFT_AddMultipleRange, &task);
+}
+
+//! \brief Runs an element-wise subtraction of SWIFFT_SubMultiple on a range of blocks, given a SWIFFT_task_t.
+static void SWIFFT_SubMultipleRange(void *vtask, size_t begin, size_t end)
+{
+	const SWIFFT_task_t *task = (const SWIFFT_task_t *)vtask;
+	size_t i;
+	for (i=begin; i<end; i++) {
+		SWIFFT_ISET_NAME(SWIFFT_Sub_)(
+			(BitSequence *)task->output + i * SWIFFT_OUTPUT_BLOCK_SIZE,
+			(const BitSequence *)task->operand + i * SWIFFT_OUTPUT_BLOCK_SIZE
 		);
 	}
 }
@@ -456,17 +850,22 @@ void SWIFFT_ISET_NAME(SWIFFT_AddMultiple_)(int nblocks, BitSequence * output,
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in,out] output the hash value of SWIFFT to modify, per block..
 //! \param[in] operand the hash value to subtract, per block.
-void SWIFFT_ISET_NAME(SWIFFT_SubMultiple_)(int nblocks, BitSequence * output,
+void SWIFFT_ISET_NAME(SWIFFT_SubMultiple_)(size_t nblocks, BitSequence * output,
         const BitSequence * operand)
 {
-	int i;
-#ifdef _OPENMP
-	#pragma omp parallel for schedule(static) private(i) if(nblocks > SWIFFT_BLOCKS_PARALLELIZATION_THRESHOLD)
-#endif
-	for (i=0; i<nblocks; i++) {
-		SWIFFT_ISET_NAME(SWIFFT_Sub_)(
-			output + i * SWIFFT_OUTPUT_BLOCK_SIZE,
-			operand + i * SWIFFT_OUTPUT_BLOCK_SIZE
+	SWIFFT_task_t task = { NULL, NULL, NULL, operand, output, 0, NULL };
+	SWIFFT_ParallelForOp(nblocks, SWIFFT_OP_ARITH, SWIFFT_SubMultipleRange, &task);
+}
+
+//! \brief Runs an element-wise multiplication of SWIFFT_MulMultiple on a range of blocks, given a SWIFFT_task_t.
+static void SWIFFT_MulMultipleRange(void *vtask, size_t begin, size_t end)
+{
+	const SWIFFT_task_t *task = (const SWIFFT_task_t *)vtask;
+	size_t i;
+	for (i=begin; i<end; i++) {
+		SWIFFT_ISET_NAME(SWIFFT_Mul_)(
+			(BitSequence *)task->output + i * SWIFFT_OUTPUT_BLOCK_SIZE,
+			(const BitSequence *)task->operand + i * SWIFFT_OUTPUT_BLOCK_SIZE
 		);
 	}
 }
@@ -476,17 +875,342 @@ void SWIFFT_ISET_NAME(SWIFFT_SubMultiple_)(int nblocks, BitSequence * output,
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in,out] output the hash value of SWIFFT to modify, per block..
 //! \param[in] operand the hash value to multiply by, per block.
-void SWIFFT_ISET_NAME(SWIFFT_MulMultiple_)(int nblocks, BitSequence * output,
+void SWIFFT_ISET_NAME(SWIFFT_MulMultiple_)(size_t nblocks, BitSequence * output,
         const BitSequence * operand)
 {
-	int i;
-#ifdef _OPENMP
-	#pragma omp parallel for schedule(static) private(i) if(nblocks > SWIFFT_BLOCKS_PARALLELIZATION_THRESHOLD)
+	SWIFFT_task_t task = { NULL, NULL, NULL, operand, output, 0, NULL };
+	SWIFFT_ParallelForOp(nblocks, SWIFFT_OP_ARITH, SWIFFT_MulMultipleRange, &task);
+}
+
+//! \brief Sums SWIFFT hash values of multiple blocks, reducing only once per SWIFFT_ACCUMULATOR_HEADROOM blocks.
+//! The result is the same as that of adding the hash values one by one using SWIFFT_Add.
+//!
+//! \param[in] nblocks the number of blocks to sum.
+//! \param[in] operand the reduced hash values to sum, per block.
+//! \param[out] output the resulting hash value of SWIFFT.
+void SWIFFT_ISET_NAME(SWIFFT_SumMultiple_)(size_t nblocks, const BitSequence * operand,
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE])
+{
+	size_t i;
+	int j,k;
+	const ZOvec *zoperand = (const ZOvec *)operand;
+	ZOvec *zoutput = (ZOvec *)output;
+	ZOvec acc[8 >> SWIFFT_LOG2_O] = {0};
+	for (i=0; i<nblocks; i+=SWIFFT_ACCUMULATOR_HEADROOM) {
+		int n = nblocks - i < SWIFFT_ACCUMULATOR_HEADROOM ? nblocks - i : SWIFFT_ACCUMULATOR_HEADROOM;
+		for (k=0; k<(8>>SWIFFT_LOG2_O); k++) {
+			acc[k] = SWIFFT_qReduce(acc[k]);
+		}
+		for (j=0; j<n; j++,zoperand+=(8>>SWIFFT_LOG2_O)) {
+			for (k=0; k<(8>>SWIFFT_LOG2_O); k++) {
+				acc[k] += zoperand[k];
+			}
+		}
+	}
+	for (k=0; k<(8>>SWIFFT_LOG2_O); k++) {
+		zoutput[k] = SWIFFT_modP(acc[k]);
+	}
+}
+
+//! \brief Computes a linear combination of SWIFFT hash values of multiple blocks, reducing each product only partially.
+//! The result is the sum of the products of the hash values by their coefficients, mod 257.
+//!
+//! \param[in] nblocks the number of blocks to combine.
+//! \param[in] coeffs the coefficients, per block, in any range of int16_t.
+//! \param[in] operand the reduced hash values to combine, per block.
+//! \param[out] output the resulting hash value of SWIFFT.
+void SWIFFT_ISET_NAME(SWIFFT_LinearCombination_)(size_t nblocks, const int16_t * coeffs, const BitSequence * operand,
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE])
+{
+	size_t i;
+	int j,k;
+	const ZOvec *zoperand = (const ZOvec *)operand;
+	ZOvec *zoutput = (ZOvec *)output;
+	ZOvec acc[8 >> SWIFFT_LOG2_O] = {0};
+	for (i=0; i<nblocks; i+=SWIFFT_PRODUCT_HEADROOM) {
+		int n = nblocks - i < SWIFFT_PRODUCT_HEADROOM ? nblocks - i : SWIFFT_PRODUCT_HEADROOM;
+		for (k=0; k<(8>>SWIFFT_LOG2_O); k++) {
+			acc[k] = SWIFFT_qReduce(acc[k]);
+		}
+		for (j=0; j<n; j++,zoperand+=(8>>SWIFFT_LOG2_O)) {
+			// centering the coefficient for SWIFFT_safeMult
+			int16_t c = coeffs[i + j] % SWIFFT_P;
+			c = c > SWIFFT_P/2 ? c - SWIFFT_P : c < -SWIFFT_P/2 ? c + SWIFFT_P : c;
+			const ZOvec zcoeff = ZOCONST(c);
+			for (k=0; k<(8>>SWIFFT_LOG2_O); k++) {
+				acc[k] += SWIFFT_qReduce(SWIFFT_safeMult(zoperand[k], zcoeff));
+			}
+		}
+	}
+	for (k=0; k<(8>>SWIFFT_LOG2_O); k++) {
+		zoutput[k] = SWIFFT_modP(acc[k]);
+	}
+}
+
+//! \brief The arguments of SWIFFT_EvalMultiple, for running it on ranges of blocks.
+typedef struct {
+	const swifft_op_t *program;         ///< The operations of the expression
+	int nops;                           ///< The number of operations
+	const BitSequence * const *operands; ///< The arrays of operands
+	BitSequence *output;                ///< The resulting hash values
+} SWIFFT_evalTask_t;
+
+//! \brief Checks that a program of SWIFFT_EvalMultiple is valid.
+//!
+//! \param[in] program the operations of the expression, in postfix order.
+//! \param[in] nops the number of operations.
+//! \param[in] noperands the number of arrays of operands.
+//! \returns 0 if the program is valid, or -1 otherwise.
+static int SWIFFT_evalCheck(const swifft_op_t * program, int nops, int noperands)
+{
+	int op, depth = 0;
+	for (op=0; op<nops; op++) {
+		switch (program[op].opcode) {
+		case SWIFFT_OP_LOAD:
+			if (program[op].arg < 0 || program[op].arg >= noperands) {
+				return -1;
+			}
+			// fall through
+		case SWIFFT_OP_CONST:
+			if (++depth > SWIFFT_EVAL_MAX_STACK) {
+				return -1;
+			}
+			break;
+		case SWIFFT_OP_ADD:
+		case SWIFFT_OP_SUB:
+		case SWIFFT_OP_MUL:
+			if (--depth < 1) {
+				return -1;
+			}
+			break;
+		default:
+			return -1;
+		}
+	}
+	return depth == 1 ? 0 : -1;
+}
+
+//! \brief Runs an expression of SWIFFT_EvalMultiple on a range of blocks, given a SWIFFT_evalTask_t.
+//! Each operation runs on the stacks of a tile of SWIFFT_EVAL_TILE_BLOCKS blocks at once.
+//! A loaded operand is read in place, and the last operation writes the output.
+static void SWIFFT_EvalMultipleRange(void *vtask, size_t begin, size_t end)
+{
+	const SWIFFT_evalTask_t *task = (const SWIFFT_evalTask_t *)vtask;
+	const int size = SWIFFT_OUTPUT_BLOCK_SIZE/sizeof(ZOvec);
+	const ZOvec ZO_0 = ZOCONST(0), ZO_256 = ZOCONST(256), ZO_257 = ZOCONST(257);
+	ZOvec stack[SWIFFT_EVAL_MAX_STACK][SWIFFT_EVAL_TILE_BLOCKS*(SWIFFT_OUTPUT_BLOCK_SIZE/sizeof(ZOvec))];
+	const ZOvec *top[SWIFFT_EVAL_MAX_STACK] = {0};
+	size_t i;
+	int j,n,op,depth;
+	for (i=begin; i<end; i+=SWIFFT_EVAL_TILE_BLOCKS) {
+		ZOvec *zoutput = (ZOvec *)(task->output + i * SWIFFT_OUTPUT_BLOCK_SIZE);
+		n = (end - i < SWIFFT_EVAL_TILE_BLOCKS ? end - i : SWIFFT_EVAL_TILE_BLOCKS) * size;
+		depth = 0;
+		for (op=0; op<task->nops; op++) {
+			const swifft_op_t *o = task->program + op;
+			ZOvec *c = op + 1 == task->nops ? zoutput : stack[depth > 1 ? depth - 2 : 0];
+			const ZOvec *a = top[depth > 1 ? depth - 2 : 0];
+			const ZOvec *b = top[depth > 0 ? depth - 1 : 0];
+			switch (o->opcode) {
+			case SWIFFT_OP_LOAD:
+				top[depth++] = (const ZOvec *)(task->operands[o->arg] + i * SWIFFT_OUTPUT_BLOCK_SIZE);
+				continue;
+			case SWIFFT_OP_CONST: {
+				ZOvec zoperand = ZOCONST(o->arg);
+				zoperand = SWIFFT_modP(zoperand);
+				c = op + 1 == task->nops ? zoutput : stack[depth];
+				for (j=0; j<n; j++) {
+					c[j] = zoperand;
+				}
+				top[depth++] = c;
+				continue;
+			}
+			case SWIFFT_OP_ADD:
+				// reducing a sum in {0,..,512} by a conditional subtraction
+				for (j=0; j<n; j++) {
+					ZOvec v = a[j] + b[j];
+					c[j] = v - ((v > ZO_256) & ZO_257);
+				}
+				break;
+			case SWIFFT_OP_SUB:
+				// reducing a difference in {-256,..,256} by a conditional addition
+				for (j=0; j<n; j++) {
+					ZOvec v = a[j] - b[j];
+					c[j] = v + ((v < ZO_0) & ZO_257);
+				}
+				break;
+			case SWIFFT_OP_MUL:
+				// centering the factors to keep their product within int16_t
+				for (j=0; j<n; j++) {
+					c[j] = SWIFFT_modP(SWIFFT_center(a[j]) * SWIFFT_center(b[j]));
+				}
+				break;
+			}
+			top[depth-2] = c;
+			depth--;
+		}
+		if (top[0] != zoutput) {
+			for (j=0; j<n; j++) {
+				zoutput[j] = top[0][j];
+			}
+		}
+	}
+}
+
+//! \brief Evaluates an element-wise expression of SWIFFT hash values for multiple blocks.
+//! The program runs on a stack of hash values for each block, and leaves the result as the
+//! only one on it. The stack of a range of blocks is held in a small buffer local to the
+//! computation, so each operand is read and the output is written once, in a single
+//! parallel run. Each operation reduces its result mod 257, as SWIFFT_Add does.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] program the operations of the expression, in postfix order.
+//! \param[in] nops the number of operations.
+//! \param[in] operands the arrays of reduced hash values of SWIFFT, per block, for SWIFFT_OP_LOAD.
+//! \param[in] noperands the number of arrays of operands.
+//! \param[out] output the resulting hash values of SWIFFT, per block, which may be an array of operands.
+//! \returns 0 on success, or -1 if the program is invalid or needs more than SWIFFT_EVAL_MAX_STACK hash values on the stack.
+int SWIFFT_ISET_NAME(SWIFFT_EvalMultiple_)(size_t nblocks, const swifft_op_t * program, int nops,
+	const BitSequence * const * operands, int noperands, BitSequence * output)
+{
+	SWIFFT_evalTask_t task = { program, nops, operands, output };
+	if (SWIFFT_evalCheck(program, nops, noperands)) {
+		return -1;
+	}
+	SWIFFT_ParallelForOp(nblocks, SWIFFT_OP_HASH, SWIFFT_EvalMultipleRange, &task);
+	return 0;
+}
+
+//! \brief Stores a wide SWIFFT vector without bringing its cache line in.
+//!
+//! \param[out] p the aligned destination.
+//! \param[in] x the wide SWIFFT vector.
+static LIBSWIFFT_INLINE void SWIFFT_streamStore(ZOvec *p, ZOvec x)
+{
+#if defined(__aarch64__) && SWIFFT_O == 2
+	__asm__ volatile("stnp %q1, %q2, [%0]" : : "r"(p), "w"(((const int16x8_t *)&x)[0]), "w"(((const int16x8_t *)&x)[1]) : "memory");
+#elif defined(__aarch64__)
+	__asm__ volatile("stnp %d1, %d2, [%0]" : : "r"(p), "w"(vget_low_s16((int16x8_t)x)), "w"(vget_high_s16((int16x8_t)x)) : "memory");
+#elif SWIFFT_O == 4
+	_mm512_stream_si512((__m512i *)p, (__m512i)x);
+#elif SWIFFT_O == 2
+	_mm256_stream_si256((__m256i *)p, (__m256i)x);
+#else
+	_mm_stream_si128((__m128i *)p, (__m128i)x);
 #endif
-	for (i=0; i<nblocks; i++) {
-		SWIFFT_ISET_NAME(SWIFFT_Mul_)(
-			output + i * SWIFFT_OUTPUT_BLOCK_SIZE,
-			operand + i * SWIFFT_OUTPUT_BLOCK_SIZE
+}
+
+//! \brief Runs SWIFFT operations of a large batch on a range of blocks, given a SWIFFT_task_t with an optional sign.
+//! The input of upcoming blocks is prefetched, and the output is streamed to memory, so
+//! a batch larger than the cache does not evict the key or still-needed lines.
+//! Being always inlined, each call site compiles to a kernel for either separate or packed input.
+//!
+//! \param[in] task the task, whose input is packed signed input if packed is nonzero.
+//! \param[in] begin the first block of the range.
+//! \param[in] end the block past the last one of the range.
+//! \param[in] packed whether the input is of blocks of SWIFFT_PACKED_BLOCK_SIZE.
+static LIBSWIFFT_INLINE void SWIFFT_computeLargeRange(const SWIFFT_task_t *task, size_t begin, size_t end, int packed)
+{
+	const size_t blockSize = packed ? SWIFFT_PACKED_BLOCK_SIZE : SWIFFT_INPUT_BLOCK_SIZE;
+	const BitSequence *prefetch;
+	ZOvec *out;
+	size_t i;
+	int j;
+	for (i=begin; i<end; i++) {
+		SWIFFT_ALIGN BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE];
+		if (i + SWIFFT_PREFETCH_BLOCKS < end) {
+			prefetch = task->input + (i + SWIFFT_PREFETCH_BLOCKS) * blockSize;
+			for (j=0; j<(int)blockSize; j+=64) {
+				__builtin_prefetch(prefetch + j, 0, 0);
+			}
+			if (task->sign && !packed) {
+				prefetch = task->sign + (i + SWIFFT_PREFETCH_BLOCKS) * SWIFFT_INPUT_BLOCK_SIZE;
+				for (j=0; j<SWIFFT_INPUT_BLOCK_SIZE; j+=64) {
+					__builtin_prefetch(prefetch + j, 0, 0);
+				}
+			}
+		}
+		if (packed) {
+			SWIFFT_computePacked(task->key, task->input + i * SWIFFT_PACKED_BLOCK_SIZE, output);
+		} else {
+			SWIFFT_compute(
+				task->key,
+				task->input + i * SWIFFT_INPUT_BLOCK_SIZE,
+				task->sign ? task->sign + i * SWIFFT_INPUT_BLOCK_SIZE : NULL,
+				output
+			);
+		}
+		out = (ZOvec *)((BitSequence *)task->output + i * SWIFFT_OUTPUT_BLOCK_SIZE);
+		for (j=0; j<(8>>SWIFFT_LOG2_O); j++) {
+			SWIFFT_streamStore(out + j, ((ZOvec *)output)[j]);
+		}
+	}
+	// the streamed output is ordered before the range is reported done
+#if defined(__aarch64__)
+	__asm__ volatile("dmb ishst" : : : "memory");
+#else
+	_mm_sfence();
+#endif
+}
+
+//! \brief Runs SWIFFT operations of a large batch on a range of blocks, given a SWIFFT_task_t with an optional sign.
+static void SWIFFT_ComputeMultipleLargeRange(void *vtask, size_t begin, size_t end)
+{
+	SWIFFT_computeLargeRange((const SWIFFT_task_t *)vtask, begin, end, 0);
+}
+
+//! \brief Runs SWIFFT operations of a large batch on a range of blocks, given a SWIFFT_task_t with packed signed input.
+static void SWIFFT_ComputeMultiplePackedLargeRange(void *vtask, size_t begin, size_t end)
+{
+	SWIFFT_computeLargeRange((const SWIFFT_task_t *)vtask, begin, end, 1);
+}
+
+//! \brief Runs SWIFFT operations of a batch on a range of blocks with the lane-per-block engine, given a SWIFFT_task_t with an optional sign.
+static void SWIFFT_ComputeMultipleSoaRange(void *vtask, size_t begin, size_t end)
+{
+	SWIFFT_soaComputeRange((const SWIFFT_task_t *)vtask, begin, end, 0, 0);
+}
+
+//! \brief Runs SWIFFT operations of a batch on a range of blocks with the lane-per-block engine, given a SWIFFT_task_t with packed signed input.
+static void SWIFFT_ComputeMultiplePackedSoaRange(void *vtask, size_t begin, size_t end)
+{
+	SWIFFT_soaComputeRange((const SWIFFT_task_t *)vtask, begin, end, 1, 0);
+}
+
+//! \brief Runs SWIFFT operations on multiple blocks, as a large batch above SWIFFT_LARGE_BATCH_THRESHOLD blocks,
+//! and with the lane-per-block engine above a given threshold, which takes precedence since an instruction set
+//! sets one only where the engine was measured faster than large batches too.
+//! The ranges of a large batch span whole pages of output, and those of the lane-per-block engine whole groups of lanes.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] soaThreshold the minimum number of blocks to run with the lane-per-block engine.
+//! \param[in] taskfn the function running the task on a range of blocks, for a small batch.
+//! \param[in] largefn the function running the task on a range of blocks, for a large batch.
+//! \param[in] soafn the function running the task on a range of blocks, for the lane-per-block engine.
+//! \param[in] task the task.
+static void SWIFFT_computeMultiple(size_t nblocks, size_t soaThreshold, swifft_task_fn taskfn, swifft_task_fn largefn, swifft_task_fn soafn,
+	SWIFFT_task_t *task)
+{
+	if (nblocks >= soaThreshold) {
+		SWIFFT_ParallelForAlignedOp(nblocks, SWIFFT_OP_HASH, SWIFFT_SOA_LANES, soafn, task);
+	} else if (nblocks >= SWIFFT_LARGE_BATCH_THRESHOLD) {
+		SWIFFT_ParallelForAlignedOp(nblocks, SWIFFT_OP_HASH, SWIFFT_PAGE_BLOCKS, largefn, task);
+	} else {
+		SWIFFT_ParallelForOp(nblocks, SWIFFT_OP_HASH, taskfn, task);
+	}
+}
+
+//! \brief Runs a SWIFFT operation of SWIFFT_ComputeMultiple on a range of blocks, given a SWIFFT_task_t.
+static void SWIFFT_ComputeMultipleRange(void *vtask, size_t begin, size_t end)
+{
+	const SWIFFT_task_t *task = (const SWIFFT_task_t *)vtask;
+	size_t i;
+	for (i=begin; i<end; i++) {
+		SWIFFT_compute(
+			task->key,
+			task->input + i * SWIFFT_INPUT_BLOCK_SIZE,
+			NULL,
+			(BitSequence *)task->output + i * SWIFFT_OUTPUT_BLOCK_SIZE
 		);
 	}
 }
@@ -497,17 +1221,23 @@ void SWIFFT_ISET_NAME(SWIFFT_MulMultiple_)(int nblocks, BitSequence * output,
 //! \param[in] nblocks the number of blocks to operate on.
 //! \param[in] input the blocks of input, each of 256 bytes (2048 bit).
 //! \param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).
-void SWIFFT_ISET_NAME(SWIFFT_ComputeMultiple_)(int nblocks, const BitSequence * input, BitSequence * output)
+void SWIFFT_ISET_NAME(SWIFFT_ComputeMultiple_)(size_t nblocks, const BitSequence * input, BitSequence * output)
 {
-	int i;
-#ifdef _OPENMP
-	#pragma omp parallel for schedule(static) private(i) if(nblocks > SWIFFT_BLOCKS_PARALLELIZATION_THRESHOLD)
-#endif
-	for (i=0; i<nblocks; i++) {
+	SWIFFT_task_t task = { SWIFFT_PI_keyInterleaved, input, NULL, NULL, output, 0, NULL };
+	SWIFFT_computeMultiple(nblocks, SWIFFT_SOA_UNSIGNED_BATCH_THRESHOLD, SWIFFT_ComputeMultipleRange, SWIFFT_ComputeMultipleLargeRange, SWIFFT_ComputeMultipleSoaRange, &task);
+}
+
+//! \brief Runs a SWIFFT operation of SWIFFT_ComputeMultipleSigned on a range of blocks, given a SWIFFT_task_t.
+static void SWIFFT_ComputeMultipleSignedRange(void *vtask, size_t begin, size_t end)
+{
+	const SWIFFT_task_t *task = (const SWIFFT_task_t *)vtask;
+	size_t i;
+	for (i=begin; i<end; i++) {
 		SWIFFT_compute(
-			input + i * SWIFFT_INPUT_BLOCK_SIZE,
-			SWIFFT_sign0,
-			output + i * SWIFFT_OUTPUT_BLOCK_SIZE
+			task->key,
+			task->input + i * SWIFFT_INPUT_BLOCK_SIZE,
+			task->sign + i * SWIFFT_INPUT_BLOCK_SIZE,
+			(BitSequence *)task->output + i * SWIFFT_OUTPUT_BLOCK_SIZE
 		);
 	}
 }
@@ -519,20 +1249,541 @@ void SWIFFT_ISET_NAME(SWIFFT_ComputeMultiple_)(int nblocks, const BitSequence *
 //! \param[in] input the blocks of input, each of 256 bytes (2048 bit).
 //! \param[in] sign the blocks of sign bits corresponding to blocks of input of 256 bytes (2048 bit).
 //! \param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).
-void SWIFFT_ISET_NAME(SWIFFT_ComputeMultipleSigned_)(int nblocks, const BitSequence * input,
+void SWIFFT_ISET_NAME(SWIFFT_ComputeMultipleSigned_)(size_t nblocks, const BitSequence * input,
 	const BitSequence * sign, BitSequence * output)
 {
-	int i;
-#ifdef _OPENMP
-	#pragma omp parallel for schedule(static) private(i) if(nblocks > SWIFFT_BLOCKS_PARALLELIZATION_THRESHOLD)
-#endif
-	for (i=0; i<nblocks; i++) {
+	SWIFFT_task_t task = { SWIFFT_PI_keyInterleaved, input, sign, NULL, output, 0, NULL };
+	SWIFFT_computeMultiple(nblocks, SWIFFT_SOA_BATCH_THRESHOLD, SWIFFT_ComputeMultipleSignedRange, SWIFFT_ComputeMultipleLargeRange, SWIFFT_ComputeMultipleSoaRange, &task);
+}
+
+//! \brief Runs compacted SWIFFT operations of SWIFFT_ComputeCompactMultiple on a range of blocks with the lane-per-block engine, given a SWIFFT_task_t.
+//! The hash values stay in lanes from the computation through the compaction.
+static void SWIFFT_ComputeCompactMultipleSoaRange(void *vtask, size_t begin, size_t end)
+{
+	SWIFFT_soaComputeRange((const SWIFFT_task_t *)vtask, begin, end, 0, 1);
+}
+
+//! \brief Runs a compacted SWIFFT operation of SWIFFT_ComputeCompactMultiple on a range of blocks, given a SWIFFT_task_t.
+static void SWIFFT_ComputeCompactMultipleRange(void *vtask, size_t begin, size_t end)
+{
+	const SWIFFT_task_t *task = (const SWIFFT_task_t *)vtask;
+	size_t i;
+	int j;
+	BitSequence *compact = (BitSequence *)task->output;
+	for (i=begin; i+SWIFFT_O<=end; i+=SWIFFT_O) {
+		SWIFFT_ALIGN BitSequence output[SWIFFT_O * SWIFFT_OUTPUT_BLOCK_SIZE];
+		for (j=0; j<SWIFFT_O; j++) {
+			SWIFFT_compute(
+				task->key,
+				task->input + (i + j) * SWIFFT_INPUT_BLOCK_SIZE,
+				NULL,
+				output + j * SWIFFT_OUTPUT_BLOCK_SIZE
+			);
+		}
+		SWIFFT_compactBlocks(output, compact + i * SWIFFT_COMPACT_BLOCK_SIZE);
+	}
+	for (; i<end; i++) {
+		SWIFFT_ALIGN BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE];
+		SWIFFT_compute(task->key, task->input + i * SWIFFT_INPUT_BLOCK_SIZE, NULL, output);
+		SWIFFT_compact(output, compact + i * SWIFFT_COMPACT_BLOCK_SIZE);
+	}
+}
+
+//! \brief Computes the compacted result of multiple SWIFFT operations.
+//! The result is the same as that of SWIFFT_ComputeMultiple followed by SWIFFT_CompactMultiple,
+//! but the hash value of each block is only held in a small buffer local to the computation.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] input the blocks of input, each of 256 bytes (2048 bit).
+//! \param[out] compact the resulting blocks of compacted hash values of SWIFFT, each of size 64 bytes (512 bit).
+void SWIFFT_ISET_NAME(SWIFFT_ComputeCompactMultiple_)(size_t nblocks, const BitSequence * input, BitSequence * compact)
+{
+	SWIFFT_task_t task = { SWIFFT_PI_keyInterleaved, input, NULL, NULL, compact, 0, NULL };
+	if (nblocks >= SWIFFT_SOA_UNSIGNED_BATCH_THRESHOLD) {
+		SWIFFT_ParallelForAlignedOp(nblocks, SWIFFT_OP_HASH, SWIFFT_SOA_LANES, SWIFFT_ComputeCompactMultipleSoaRange, &task);
+	} else {
+		SWIFFT_ParallelForOp(nblocks, SWIFFT_OP_HASH, SWIFFT_ComputeCompactMultipleRange, &task);
+	}
+}
+
+//! \brief Updates the hash values of up to SWIFFT_O blocks, each for a change of one chunk of its input.
+//!
+//! The change of a chunk is hashed as signed input, with the bits turning on as
+//! positive and the bits turning off as negative, so a single FFT yields the
+//! difference of the FFT-output elements of the new and old chunks. Multiplied
+//! by the key elements of the chunk, it is the difference of the hash values.
+//!
+//! \param[in] ikey the SWIFFT key elements, centered and in the layout of FFT-output elements.
+//! \param[in,out] output the hash values of SWIFFT to modify, each of size 128 bytes (1024 bit).
+//! \param[in] oldChunk the old chunks, one per block, each of 8 bytes.
+//! \param[in] newChunk the new chunks, one per block, each of 8 bytes.
+//! \param[in] index the indices of the chunks, one per block, each from 0 to SWIFFT_INPUT_CHUNKS-1.
+//! \param[in] count the number of blocks, from 1 to SWIFFT_O.
+static LIBSWIFFT_INLINE void SWIFFT_updateChunks(const int16_t * LIBSWIFFT_RESTRICT ikey,
+	BitSequence * LIBSWIFFT_RESTRICT output,
+	const BitSequence * LIBSWIFFT_RESTRICT oldChunk, const BitSequence * LIBSWIFFT_RESTRICT newChunk,
+	const int * LIBSWIFFT_RESTRICT index, int count)
+{
+	int j,k;
+	const Z1vec *key = (const Z1vec *)ikey;
+	SWIFFT_ALIGN BitSequence t[SWIFFT_O*SWIFFT_CHUNK_SIZE] = {0};
+	SWIFFT_ALIGN BitSequence u[SWIFFT_O*SWIFFT_CHUNK_SIZE] = {0};
+	ZOvec v[8], zkey[8] = {{0}}, out[8] = {{0}};
+
+	for (j=0; j<count*SWIFFT_CHUNK_SIZE; j++) {
+		t[j] = oldChunk[j] ^ newChunk[j];
+		u[j] = oldChunk[j] & ~newChunk[j];
+	}
+	SWIFFT_fftChunks(t, u, SWIFFT_CHUNK_SIZE, v);
+	for (j=0; j<count; j++) {
+		const Z1vec *zoutput = (const Z1vec *)(output + j * SWIFFT_OUTPUT_BLOCK_SIZE);
+		for (k=0; k<8; k++) {
+			((Z1vec *)&zkey[k])[j] = key[index[j]*8 + k];
+			((Z1vec *)&out[k])[j] = zoutput[k];
+		}
+	}
+	for (k=0; k<8; k++) {
+		out[k] = SWIFFT_modP(out[k] + SWIFFT_qReduce(SWIFFT_safeMult(v[k], zkey[k])));
+	}
+	for (j=0; j<count; j++) {
+		Z1vec *zoutput = (Z1vec *)(output + j * SWIFFT_OUTPUT_BLOCK_SIZE);
+		for (k=0; k<8; k++) {
+			zoutput[k] = ((Z1vec *)&out[k])[j];
+		}
+	}
+}
+
+//! \brief Updates the result of a SWIFFT operation for a change of one chunk of its input.
+//! The result is the same as that of SWIFFT_Compute on the changed input.
+//!
+//! \param[in,out] output the hash value of SWIFFT to modify, of size 128 bytes (1024 bit).
+//! \param[in] oldChunk the old chunk of 8 bytes.
+//! \param[in] newChunk the new chunk of 8 bytes.
+//! \param[in] chunkIndex the index of the chunk in the input, from 0 to SWIFFT_INPUT_CHUNKS-1.
+void SWIFFT_ISET_NAME(SWIFFT_Update_)(BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
+	const BitSequence oldChunk[SWIFFT_CHUNK_SIZE], const BitSequence newChunk[SWIFFT_CHUNK_SIZE],
+	int chunkIndex)
+{
+	SWIFFT_updateChunks(SWIFFT_PI_key, output, oldChunk, newChunk, &chunkIndex, 1);
+}
+
+//! \brief Runs an update of SWIFFT_UpdateMultiple on a range of blocks, given a SWIFFT_task_t.
+static void SWIFFT_UpdateMultipleRange(void *vtask, size_t begin, size_t end)
+{
+	const SWIFFT_task_t *task = (const SWIFFT_task_t *)vtask;
+	const BitSequence *newChunk = (const BitSequence *)task->operand;
+	BitSequence *output = (BitSequence *)task->output;
+	size_t i;
+	for (i=begin; i<end; i+=SWIFFT_O) {
+		SWIFFT_updateChunks(
+			task->key,
+			output + i * SWIFFT_OUTPUT_BLOCK_SIZE,
+			task->input + i * SWIFFT_CHUNK_SIZE,
+			newChunk + i * SWIFFT_CHUNK_SIZE,
+			task->index + i,
+			end - i < SWIFFT_O ? end - i : SWIFFT_O
+		);
+	}
+}
+
+//! \brief Updates the results of multiple SWIFFT operations, each for a change of one chunk of its input.
+//! The result is the same as that of SWIFFT_ComputeMultiple on the changed inputs.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in,out] output the blocks of hash values of SWIFFT to modify, each of size 128 bytes (1024 bit).
+//! \param[in] oldChunk the old chunks, one per block, each of 8 bytes.
+//! \param[in] newChunk the new chunks, one per block, each of 8 bytes.
+//! \param[in] chunkIndex the indices of the chunks in the inputs, one per block, each from 0 to SWIFFT_INPUT_CHUNKS-1.
+void SWIFFT_ISET_NAME(SWIFFT_UpdateMultiple_)(size_t nblocks, BitSequence * output,
+	const BitSequence * oldChunk, const BitSequence * newChunk, const int * chunkIndex)
+{
+	SWIFFT_task_t task = { SWIFFT_PI_key, oldChunk, NULL, newChunk, output, 0, chunkIndex };
+	SWIFFT_ParallelForOp(nblocks, SWIFFT_OP_FFT, SWIFFT_UpdateMultipleRange, &task);
+}
+
+//! \brief Computes the result of a SWIFFT operation using a given key.
+//! The result is composable with other hash values computed using the same key.
+//!
+//! \param[in] key the SWIFFT key.
+//! \param[in] input the input of 256 bytes (2048 bit).
+//! \param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit).
+void SWIFFT_ISET_NAME(SWIFFT_ComputeKeyed_)(const swifft_key_t * key, const BitSequence input[SWIFFT_INPUT_BLOCK_SIZE],
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE])
+{
+	SWIFFT_compute(key->elements, input, NULL, output);
+}
+
+//! \brief Computes the result of a SWIFFT operation using a given key.
+//! The result is composable with other hash values computed using the same key.
+//!
+//! \param[in] key the SWIFFT key.
+//! \param[in] input the input of 256 bytes (2048 bit).
+//! \param[in] sign the sign bits corresponding to the input of 256 bytes (2048 bit).
+//! \param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit).
+void SWIFFT_ISET_NAME(SWIFFT_ComputeSignedKeyed_)(const swifft_key_t * key, const BitSequence input[SWIFFT_INPUT_BLOCK_SIZE],
+	const BitSequence sign[SWIFFT_INPUT_BLOCK_SIZE],
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE])
+{
+	SWIFFT_compute(key->elements, input, sign, output);
+}
+
+//! \brief Runs a SWIFFT operation of SWIFFT_ComputeMultipleKeyed on a range of blocks, given a SWIFFT_task_t.
+static void SWIFFT_ComputeMultipleKeyedRange(void *vtask, size_t begin, size_t end)
+{
+	const SWIFFT_task_t *task = (const SWIFFT_task_t *)vtask;
+	size_t i;
+	for (i=begin; i<end; i++) {
 		SWIFFT_compute(
-			input + i * SWIFFT_INPUT_BLOCK_SIZE,
-			sign + i * SWIFFT_INPUT_BLOCK_SIZE,
-			output + i * SWIFFT_OUTPUT_BLOCK_SIZE
+			task->key,
+			task->input + i * SWIFFT_INPUT_BLOCK_SIZE,
+			NULL,
+			(BitSequence *)task->output + i * SWIFFT_OUTPUT_BLOCK_SIZE
+		);
+	}
+}
+
+//! \brief Computes the result of multiple SWIFFT operations using a given key.
+//! The result is composable with other hash values computed using the same key.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] key the SWIFFT key.
+//! \param[in] input the blocks of input, each of 256 bytes (2048 bit).
+//! \param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).
+void SWIFFT_ISET_NAME(SWIFFT_ComputeMultipleKeyed_)(size_t nblocks, const swifft_key_t * key, const BitSequence * input,
+	BitSequence * output)
+{
+	SWIFFT_task_t task = { key->elements, input, NULL, NULL, output, 0, NULL };
+	SWIFFT_computeMultiple(nblocks, SWIFFT_SOA_UNSIGNED_BATCH_THRESHOLD, SWIFFT_ComputeMultipleKeyedRange, SWIFFT_ComputeMultipleLargeRange, SWIFFT_ComputeMultipleSoaRange, &task);
+}
+
+//! \brief Runs a SWIFFT operation of SWIFFT_ComputeMultipleSignedKeyed on a range of blocks, given a SWIFFT_task_t.
+static void SWIFFT_ComputeMultipleSignedKeyedRange(void *vtask, size_t begin, size_t end)
+{
+	const SWIFFT_task_t *task = (const SWIFFT_task_t *)vtask;
+	size_t i;
+	for (i=begin; i<end; i++) {
+		SWIFFT_compute(
+			task->key,
+			task->input + i * SWIFFT_INPUT_BLOCK_SIZE,
+			task->sign + i * SWIFFT_INPUT_BLOCK_SIZE,
+			(BitSequence *)task->output + i * SWIFFT_OUTPUT_BLOCK_SIZE
+		);
+	}
+}
+
+//! \brief Computes the result of multiple SWIFFT operations using a given key.
+//! The result is composable with other hash values computed using the same key.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] key the SWIFFT key.
+//! \param[in] input the blocks of input, each of 256 bytes (2048 bit).
+//! \param[in] sign the blocks of sign bits corresponding to blocks of input of 256 bytes (2048 bit).
+//! \param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).
+void SWIFFT_ISET_NAME(SWIFFT_ComputeMultipleSignedKeyed_)(size_t nblocks, const swifft_key_t * key, const BitSequence * input,
+	const BitSequence * sign, BitSequence * output)
+{
+	SWIFFT_task_t task = { key->elements, input, sign, NULL, output, 0, NULL };
+	SWIFFT_computeMultiple(nblocks, SWIFFT_SOA_BATCH_THRESHOLD, SWIFFT_ComputeMultipleSignedKeyedRange, SWIFFT_ComputeMultipleLargeRange, SWIFFT_ComputeMultipleSoaRange, &task);
+}
+
+//! \brief Computes the result of a SWIFFT operation on packed signed input.
+//! The result is the same as that of SWIFFT_ComputeSigned on the unpacked input and sign bits.
+//!
+//! \param[in] packed the packed signed input of 512 bytes, each chunk of 8 input bytes followed by its 8 sign bytes.
+//! \param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit).
+void SWIFFT_ISET_NAME(SWIFFT_ComputeSignedPacked_)(const BitSequence packed[SWIFFT_PACKED_BLOCK_SIZE],
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE])
+{
+	SWIFFT_computePacked(SWIFFT_PI_keyInterleaved, packed, output);
+}
+
+//! \brief Runs a SWIFFT operation of SWIFFT_ComputeMultipleSignedPacked on a range of blocks, given a SWIFFT_task_t.
+static void SWIFFT_ComputeMultipleSignedPackedRange(void *vtask, size_t begin, size_t end)
+{
+	const SWIFFT_task_t *task = (const SWIFFT_task_t *)vtask;
+	size_t i;
+	for (i=begin; i<end; i++) {
+		SWIFFT_computePacked(
+			task->key,
+			task->input + i * SWIFFT_PACKED_BLOCK_SIZE,
+			(BitSequence *)task->output + i * SWIFFT_OUTPUT_BLOCK_SIZE
 		);
 	}
 }
 
+//! \brief Computes the result of multiple SWIFFT operations on packed signed input.
+//! The result is the same as that of SWIFFT_ComputeMultipleSigned on the unpacked blocks of input and sign bits.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] packed the blocks of packed signed input, each of 512 bytes.
+//! \param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).
+void SWIFFT_ISET_NAME(SWIFFT_ComputeMultipleSignedPacked_)(size_t nblocks, const BitSequence * packed, BitSequence * output)
+{
+	SWIFFT_task_t task = { SWIFFT_PI_keyInterleaved, packed, NULL, NULL, output, 0, NULL };
+	SWIFFT_computeMultiple(nblocks, SWIFFT_SOA_BATCH_THRESHOLD, SWIFFT_ComputeMultipleSignedPackedRange, SWIFFT_ComputeMultiplePackedLargeRange, SWIFFT_ComputeMultiplePackedSoaRange, &task);
+}
+
+
+//! \brief Computes the FFT phase of SWIFFT on a block, keeping the FFT output of each SWIFFT_O chunks as SWIFFT_fftChunks gives it.
+//!
+//! \param[in] input the input of 256 bytes (2048 bit).
+//! \param[in] sign the sign bits corresponding to the input of 256 bytes (2048 bit), or NULL for unsigned input.
+//! \param[out] fftout the FFT output of the block, of size 2048 double-bytes.
+static LIBSWIFFT_INLINE void SWIFFT_fftBlock(const BitSequence * LIBSWIFFT_RESTRICT input,
+	const BitSequence * LIBSWIFFT_RESTRICT sign,
+	ZOvec fftout[SWIFFT_M>>SWIFFT_LOG2_O][8])
+{
+	int i;
+	for (i=0; i<(SWIFFT_M>>SWIFFT_LOG2_O); i++) {
+		SWIFFT_fftChunks(input + i*8*SWIFFT_O, sign ? sign + i*8*SWIFFT_O : NULL, SWIFFT_CHUNK_SIZE, fftout[i]);
+	}
+}
+
+//! \brief Computes the FFT-sum phase of SWIFFT on the FFT output of a block given by SWIFFT_fftBlock.
+//!
+//! \param[in] key the SWIFFT key elements, centered and interleaved as given by SWIFFT_KEY_INDEX.
+//! \param[in] fftout the FFT output of the block.
+//! \param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit).
+static LIBSWIFFT_INLINE void SWIFFT_fftsumBlock(const int16_t * LIBSWIFFT_RESTRICT key,
+	const ZOvec fftout[SWIFFT_M>>SWIFFT_LOG2_O][8],
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE])
+{
+	int i,k;
+	ZOvec acc[8] = {0};
+	for (i=0; i<(SWIFFT_M>>SWIFFT_LOG2_O); i++) {
+		for (k=0; k<8; k++) {
+			const ZOvec *zkey = (const ZOvec *)(key + SWIFFT_W*SWIFFT_KEY_INDEX(i*SWIFFT_O, k));
+			// reducing FFT output to avoid overflow
+			acc[k] += SWIFFT_qReduce(SWIFFT_safeMult(fftout[i][k], *zkey));
+		}
+	}
+	SWIFFT_fftsumFold(acc, output);
+}
+
+//! \brief The arguments of SWIFFT_ComputeMultiKey, for running it on ranges of blocks.
+typedef struct {
+	const BitSequence *input;             ///< The blocks of input
+	const BitSequence *sign;              ///< The blocks of sign bits, if any
+	int nkeys;                            ///< The number of keys
+	const swifft_key_t * const *keys;     ///< The SWIFFT keys
+	BitSequence * const *outputs;         ///< The resulting blocks of hash values, per key
+} SWIFFT_multiKeyTask_t;
+
+//! \brief Runs SWIFFT operations of SWIFFT_ComputeMultiKey on a range of blocks, given a SWIFFT_multiKeyTask_t.
+//! The FFT output of a tile of SWIFFT_MULTIKEY_TILE_BLOCKS blocks is computed once and kept local,
+//! then summed against SWIFFT_MULTIKEY_TILE_KEYS keys at a time, so both stay in the L1 cache.
+static void SWIFFT_ComputeMultiKeyRange(void *vtask, size_t begin, size_t end)
+{
+	const SWIFFT_multiKeyTask_t *task = (const SWIFFT_multiKeyTask_t *)vtask;
+	ZOvec fftout[SWIFFT_MULTIKEY_TILE_BLOCKS][SWIFFT_M>>SWIFFT_LOG2_O][8];
+	size_t i;
+	int b,n,k,key,kend;
+	for (i=begin; i<end; i+=SWIFFT_MULTIKEY_TILE_BLOCKS) {
+		n = end - i < SWIFFT_MULTIKEY_TILE_BLOCKS ? end - i : SWIFFT_MULTIKEY_TILE_BLOCKS;
+		for (b=0; b<n; b++) {
+			SWIFFT_fftBlock(
+				task->input + (i + b) * SWIFFT_INPUT_BLOCK_SIZE,
+				task->sign ? task->sign + (i + b) * SWIFFT_INPUT_BLOCK_SIZE : NULL,
+				fftout[b]
+			);
+		}
+		for (k=0; k<task->nkeys; k+=SWIFFT_MULTIKEY_TILE_KEYS) {
+			kend = task->nkeys - k < SWIFFT_MULTIKEY_TILE_KEYS ? task->nkeys : k + SWIFFT_MULTIKEY_TILE_KEYS;
+			for (b=0; b<n; b++) {
+				for (key=k; key<kend; key++) {
+					SWIFFT_fftsumBlock(
+						task->keys[key]->elements,
+						(const ZOvec (*)[8])fftout[b],
+						task->outputs[key] + (i + b) * SWIFFT_OUTPUT_BLOCK_SIZE
+					);
+				}
+			}
+		}
+	}
+}
+
+//! \brief Computes the results of multiple SWIFFT operations under each of several keys.
+//! The result for each key is the same as that of SWIFFT_ComputeMultipleKeyed, or of
+//! SWIFFT_ComputeMultipleSignedKeyed given sign bits, but the FFT phase, which does not
+//! depend on the key, is computed once per block.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] input the blocks of input, each of 256 bytes (2048 bit).
+//! \param[in] sign the blocks of sign bits corresponding to blocks of input of 256 bytes (2048 bit), or NULL for unsigned input.
+//! \param[in] nkeys the number of keys.
+//! \param[in] keys the SWIFFT keys.
+//! \param[out] outputs the resulting blocks of hash values of SWIFFT, per key, each block of size 128 bytes (1024 bit).
+void SWIFFT_ISET_NAME(SWIFFT_ComputeMultiKey_)(size_t nblocks, const BitSequence * input, const BitSequence * sign,
+	int nkeys, const swifft_key_t * const * keys, BitSequence * const * outputs)
+{
+	SWIFFT_multiKeyTask_t task = { input, sign, nkeys, keys, outputs };
+	SWIFFT_ParallelForOp(nblocks, SWIFFT_OP_HASH, SWIFFT_ComputeMultiKeyRange, &task);
+}
+
+LIBSWIFFT_STATIC_ASSERT(SWIFFT_SHORT_CHUNKS_MULTIPLE % SWIFFT_O == 0, SWIFFT_SHORT_CHUNKS_MULTIPLE_must_be_a_multiple_of_SWIFFT_O);
+
+//! \brief Checks that a number of chunks of short input is supported.
+//!
+//! \param[in] m the number of chunks of input.
+//! \returns whether m is a positive multiple of SWIFFT_SHORT_CHUNKS_MULTIPLE up to SWIFFT_INPUT_CHUNKS.
+static inline int SWIFFT_shortCheck(int m)
+{
+	return m > 0 && m <= SWIFFT_INPUT_CHUNKS && m % SWIFFT_SHORT_CHUNKS_MULTIPLE == 0;
+}
+
+//! \brief Computes the FFT and FFT-sum phases of SWIFFT on short input of m chunks.
+//! The common numbers of chunks are specialized, so that their loops over chunks have constant
+//! trip counts and unroll fully, and no work is done for the chunks beyond the input.
+//! Full input of SWIFFT_INPUT_CHUNKS chunks is left to the callers, which use the full-size operations.
+//!
+//! \param[in] key the SWIFFT key elements, centered and interleaved as given by SWIFFT_KEY_INDEX.
+//! \param[in] input the input of m chunks of 8 bytes.
+//! \param[in] sign the sign bits corresponding to the input of m chunks of 8 bytes, or NULL for unsigned input.
+//! \param[in] m the number of chunks of input, as checked by SWIFFT_shortCheck.
+//! \param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit).
+static LIBSWIFFT_INLINE void SWIFFT_computeShort(const int16_t * LIBSWIFFT_RESTRICT key,
+	const BitSequence * LIBSWIFFT_RESTRICT input,
+	const BitSequence * LIBSWIFFT_RESTRICT sign,
+	int m,
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE])
+{
+	switch (m) {
+	case 8: SWIFFT_computeStrided(key, input, sign, SWIFFT_CHUNK_SIZE, 8, output); break;
+	case 16: SWIFFT_computeStrided(key, input, sign, SWIFFT_CHUNK_SIZE, 16, output); break;
+	default: SWIFFT_computeStrided(key, input, sign, SWIFFT_CHUNK_SIZE, m, output); break;
+	}
+}
+
+//! \brief Computes the result of a SWIFFT operation on short input.
+//! The result is the same as that of SWIFFT_Compute on the input padded with zero bytes to 256 bytes.
+//!
+//! \param[in] m the number of chunks of input, a multiple of SWIFFT_SHORT_CHUNKS_MULTIPLE up to SWIFFT_INPUT_CHUNKS.
+//! \param[in] input the input of m chunks of 8 bytes.
+//! \param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit).
+//! \returns 0 on success, or -1 if m is invalid.
+int SWIFFT_ISET_NAME(SWIFFT_ComputeShort_)(int m, const BitSequence * input,
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE])
+{
+	if (!SWIFFT_shortCheck(m)) {
+		return -1;
+	}
+	if (m == SWIFFT_INPUT_CHUNKS) {
+		SWIFFT_ISET_NAME(SWIFFT_Compute_)(input, output);
+	} else {
+		SWIFFT_computeShort(SWIFFT_PI_keyInterleaved, input, NULL, m, output);
+	}
+	return 0;
+}
+
+//! \brief Computes the result of a SWIFFT operation on short signed input.
+//! The result is the same as that of SWIFFT_ComputeSigned on the input and sign bits padded with zero bytes to 256 bytes.
+//!
+//! \param[in] m the number of chunks of input, a multiple of SWIFFT_SHORT_CHUNKS_MULTIPLE up to SWIFFT_INPUT_CHUNKS.
+//! \param[in] input the input of m chunks of 8 bytes.
+//! \param[in] sign the sign bits corresponding to the input of m chunks of 8 bytes.
+//! \param[out] output the resulting hash value of SWIFFT, of size 128 bytes (1024 bit).
+//! \returns 0 on success, or -1 if m is invalid.
+int SWIFFT_ISET_NAME(SWIFFT_ComputeSignedShort_)(int m, const BitSequence * input, const BitSequence * sign,
+	BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE])
+{
+	if (!SWIFFT_shortCheck(m)) {
+		return -1;
+	}
+	if (m == SWIFFT_INPUT_CHUNKS) {
+		SWIFFT_ISET_NAME(SWIFFT_ComputeSigned_)(input, sign, output);
+	} else {
+		SWIFFT_computeShort(SWIFFT_PI_keyInterleaved, input, sign, m, output);
+	}
+	return 0;
+}
+
+//! \brief Runs SWIFFT operations on a range of blocks of short input of m chunks, given a SWIFFT_task_t.
+//!
+//! \param[in] task the task, whose blocks of input and of sign bits are each of m chunks of 8 bytes.
+//! \param[in] begin the first block of the range.
+//! \param[in] end the block after the last block of the range.
+//! \param[in] m the number of chunks of input.
+//! \param[in] isSigned whether the task has sign bits.
+static LIBSWIFFT_INLINE void SWIFFT_computeShortRange(const SWIFFT_task_t *task, size_t begin, size_t end, int m, int isSigned)
+{
+	size_t i;
+	for (i=begin; i<end; i++) {
+		SWIFFT_computeStrided(
+			task->key,
+			task->input + i * m * SWIFFT_CHUNK_SIZE,
+			isSigned ? task->sign + i * m * SWIFFT_CHUNK_SIZE : NULL,
+			SWIFFT_CHUNK_SIZE,
+			m,
+			(BitSequence *)task->output + i * SWIFFT_OUTPUT_BLOCK_SIZE
+		);
+	}
+}
+
+//! \brief Runs SWIFFT operations of SWIFFT_ComputeMultipleShort or of SWIFFT_ComputeMultipleSignedShort
+//! on a range of blocks, given a SWIFFT_task_t, specialized for the common numbers of chunks as in SWIFFT_computeShort.
+static void SWIFFT_ComputeMultipleShortRange(void *vtask, size_t begin, size_t end)
+{
+	const SWIFFT_task_t *task = (const SWIFFT_task_t *)vtask;
+	if (task->sign) {
+		switch (task->m) {
+		case 8: SWIFFT_computeShortRange(task, begin, end, 8, 1); break;
+		case 16: SWIFFT_computeShortRange(task, begin, end, 16, 1); break;
+		default: SWIFFT_computeShortRange(task, begin, end, task->m, 1); break;
+		}
+	} else {
+		switch (task->m) {
+		case 8: SWIFFT_computeShortRange(task, begin, end, 8, 0); break;
+		case 16: SWIFFT_computeShortRange(task, begin, end, 16, 0); break;
+		default: SWIFFT_computeShortRange(task, begin, end, task->m, 0); break;
+		}
+	}
+}
+
+//! \brief Computes the result of multiple SWIFFT operations on short input.
+//! The result is the same as that of SWIFFT_ComputeMultiple on the blocks of input each padded with zero bytes to 256 bytes.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] m the number of chunks of input per block, a multiple of SWIFFT_SHORT_CHUNKS_MULTIPLE up to SWIFFT_INPUT_CHUNKS.
+//! \param[in] input the blocks of input, each of m chunks of 8 bytes.
+//! \param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).
+//! \returns 0 on success, or -1 if m is invalid.
+int SWIFFT_ISET_NAME(SWIFFT_ComputeMultipleShort_)(size_t nblocks, int m, const BitSequence * input, BitSequence * output)
+{
+	SWIFFT_task_t task = { SWIFFT_PI_keyInterleaved, input, NULL, NULL, output, m, NULL };
+	if (!SWIFFT_shortCheck(m)) {
+		return -1;
+	}
+	if (m == SWIFFT_INPUT_CHUNKS) {
+		SWIFFT_ISET_NAME(SWIFFT_ComputeMultiple_)(nblocks, input, output);
+	} else {
+		SWIFFT_ParallelForOp(nblocks, SWIFFT_OP_HASH, SWIFFT_ComputeMultipleShortRange, &task);
+	}
+	return 0;
+}
+
+//! \brief Computes the result of multiple SWIFFT operations on short signed input.
+//! The result is the same as that of SWIFFT_ComputeMultipleSigned on the blocks of input and
+//! sign bits each padded with zero bytes to 256 bytes.
+//!
+//! \param[in] nblocks the number of blocks to operate on.
+//! \param[in] m the number of chunks of input per block, a multiple of SWIFFT_SHORT_CHUNKS_MULTIPLE up to SWIFFT_INPUT_CHUNKS.
+//! \param[in] input the blocks of input, each of m chunks of 8 bytes.
+//! \param[in] sign the blocks of sign bits corresponding to blocks of input, each of m chunks of 8 bytes.
+//! \param[out] output the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit).
+//! \returns 0 on success, or -1 if m is invalid.
+int SWIFFT_ISET_NAME(SWIFFT_ComputeMultipleSignedShort_)(size_t nblocks, int m, const BitSequence * input,
+	const BitSequence * sign, BitSequence * output)
+{
+	SWIFFT_task_t task = { SWIFFT_PI_keyInterleaved, input, sign, NULL, output, m, NULL };
+	if (!SWIFFT_shortCheck(m)) {
+		return -1;
+	}
+	if (m == SWIFFT_INPUT_CHUNKS) {
+		SWIFFT_ISET_NAME(SWIFFT_ComputeMultipleSigned_)(nblocks, input, sign, output);
+	} else {
+		SWIFFT_ParallelForOp(nblocks, SWIFFT_OP_HASH, SWIFFT_ComputeMultipleShortRange, &task);
+	}
+	return 0;
+}
+
 LIBSWIFFT_END_EXTERN_C
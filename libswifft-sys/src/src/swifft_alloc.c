@@ -0,0 +1,402 @@
+/*
+ * Copyright (C) 2021 Yaron Gvili and Gvili Tech Ltd.
+ *
+ * See the accompanying LICENSE.txt file for licensing information.
+ */
+/*! \file src/swifft_alloc.c
+ * \brief LibSWIFFT public C implementation for allocating arrays of blocks
+ *
+ * Each array is preceded by a header of SWIFFT_ALIGNMENT bytes, so freeing it
+ * finds its size class, or its own mapping, without a lookup. A block pool
+ * carves arrays out of its current arena in turn, and when an array does not
+ * fit in what is left of it, carves the rest into free arrays of smaller
+ * classes before mapping the next arena. Memory is mapped and touched without
+ * holding the lock of the block pool, which guards only its lists and counts.
+ */
+
+#define _GNU_SOURCE // for MAP_HUGETLB, MADV_HUGEPAGE and syscall
+
+#include <stdatomic.h>
+#include <stddef.h> // for NULL, size_t
+#include <stdint.h> // for SIZE_MAX, uintptr_t
+#include <stdlib.h> // for calloc, free, posix_memalign, realloc
+#include <string.h> // for memset
+#include "swifft_alloc.h"
+
+#ifdef __linux__
+	#include <sys/mman.h>
+	#include <sys/syscall.h>
+	#include <unistd.h> // for syscall
+#endif
+
+#define SWIFFT_HEADER_SIZE SWIFFT_ALIGNMENT ///< Size of the header preceding an array
+#define SWIFFT_CLASSES 16                   ///< Number of size classes, from SWIFFT_ALIGNMENT bytes to SWIFFT_ARENA_SIZE
+#define SWIFFT_PAGE_SIZE 4096               ///< Size of the smallest page, the stride of touching a new mapping
+#define SWIFFT_MPOL_PREFERRED 1             ///< The memory policy of preferring a NUMA node, as in numaif.h
+
+LIBSWIFFT_STATIC_ASSERT(((size_t)SWIFFT_ALIGNMENT << (SWIFFT_CLASSES - 1)) == SWIFFT_ARENA_SIZE, the_largest_class_must_span_an_arena);
+
+LIBSWIFFT_BEGIN_EXTERN_C
+
+//! \brief The header preceding an array.
+typedef union swifft_header_u {
+	struct {
+		union swifft_header_u *next; ///< The next free array of the same class, while free
+		size_t size;                 ///< The size of the array and its header, that of its class or of its mapping, or 0 if allocated on the heap
+		int cls;                     ///< The size class of the array, or -1 for an array not carved out of an arena
+	} h;
+	char pad[SWIFFT_HEADER_SIZE]; ///< Keeps the array aligned
+} swifft_header_t;
+
+//! \brief A mapping of a block pool.
+typedef struct {
+	void *base;    ///< The start of the mapping
+	size_t length; ///< The length of the mapping
+} swifft_mapping_t;
+
+struct swifft_block_pool_s {
+	atomic_flag lock;                      ///< Guards the fields below
+	int node;                              ///< The NUMA node preferred, or -1
+	char *arena;                           ///< The current arena, or NULL
+	size_t arenaUsed;                      ///< The number of bytes of the current arena carved out
+	swifft_header_t *free[SWIFFT_CLASSES]; ///< The free arrays per size class
+	swifft_header_t *large;                ///< The free arrays with mappings of their own
+	swifft_mapping_t *mappings;            ///< The mappings, of arenas and of arrays larger than an arena
+	size_t capacity;                       ///< The capacity of the mappings
+	swifft_block_pool_stats_t stats;       ///< The statistics
+};
+
+//! \brief Maps memory aligned to SWIFFT_ARENA_SIZE, on huge pages where available, and touches it.
+//!
+//! \param[in] length the length, a multiple of SWIFFT_ARENA_SIZE.
+//! \param[in] node the NUMA node to prefer, or -1.
+//! \param[out] hugetlb whether the mapping is on explicit huge pages.
+//! \returns the mapping, or NULL if memory is exhausted.
+static void *SWIFFT_map(size_t length, int node, int *hugetlb)
+{
+#ifdef __linux__
+	char *p = (char *)mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+	size_t i;
+	*hugetlb = p != MAP_FAILED;
+	if (p == MAP_FAILED) {
+		// over-map and trim, so transparent huge pages may back the aligned mapping
+		size_t over = length + SWIFFT_ARENA_SIZE;
+		char *q = (char *)mmap(NULL, over, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (q == MAP_FAILED) {
+			return NULL;
+		}
+		p = (char *)(((uintptr_t)q + SWIFFT_ARENA_SIZE - 1) & ~(uintptr_t)(SWIFFT_ARENA_SIZE - 1));
+		if (p > q) {
+			munmap(q, p - q);
+		}
+		if (q + over > p + length) {
+			munmap(p + length, q + over - (p + length));
+		}
+		madvise(p, length, MADV_HUGEPAGE);
+	}
+	if (node >= 0 && node < (int)(8*sizeof(unsigned long))) {
+		unsigned long mask = 1UL << node;
+		// only a preference, so a failure, e.g. off NUMA machines, leaves the default policy
+		(void)syscall(SYS_mbind, p, length, SWIFFT_MPOL_PREFERRED, &mask, 8*sizeof(mask) + 1, 0);
+	}
+	for (i=0; i<length; i+=SWIFFT_PAGE_SIZE) {
+		((volatile char *)p)[i] = 0;
+	}
+	return p;
+#else
+	void *p;
+	(void)node;
+	*hugetlb = 0;
+	if (posix_memalign(&p, SWIFFT_ARENA_SIZE, length) != 0) {
+		return NULL;
+	}
+	memset(p, 0, length);
+	return p;
+#endif
+}
+
+//! \brief Unmaps memory mapped by SWIFFT_map.
+//!
+//! \param[in] p the mapping.
+//! \param[in] length the length of the mapping.
+static void SWIFFT_unmap(void *p, size_t length)
+{
+#ifdef __linux__
+	munmap(p, length);
+#else
+	(void)length;
+	free(p);
+#endif
+}
+
+//! \brief Returns the size of an array of blocks and its header, or 0 on overflow.
+//!
+//! \param[in] nblocks the number of blocks.
+//! \param[in] blockSize the size of a block.
+//! \returns the size.
+static size_t SWIFFT_arraySize(size_t nblocks, size_t blockSize)
+{
+	if (blockSize != 0 && nblocks > (SIZE_MAX - 2*SWIFFT_ARENA_SIZE) / blockSize) {
+		return 0;
+	}
+	return nblocks * blockSize + SWIFFT_HEADER_SIZE;
+}
+
+void * SWIFFT_AllocBlocks(size_t nblocks, size_t blockSize)
+{
+	size_t size = SWIFFT_arraySize(nblocks, blockSize);
+	swifft_header_t *header;
+	int hugetlb = 0;
+	if (size == 0) {
+		return NULL;
+	}
+	if (size >= SWIFFT_ARENA_SIZE) {
+		size = (size + SWIFFT_ARENA_SIZE - 1) & ~(size_t)(SWIFFT_ARENA_SIZE - 1);
+		header = (swifft_header_t *)SWIFFT_map(size, -1, &hugetlb);
+		if (header == NULL) {
+			return NULL;
+		}
+	} else {
+		void *p;
+		size = (size + SWIFFT_ALIGNMENT - 1) & ~(size_t)(SWIFFT_ALIGNMENT - 1);
+		if (posix_memalign(&p, SWIFFT_ALIGNMENT, size) != 0) {
+			return NULL;
+		}
+		memset(p, 0, size);
+		header = (swifft_header_t *)p;
+		size = 0;
+	}
+	header->h.size = size;
+	header->h.cls = -1;
+	return header + 1;
+}
+
+void SWIFFT_FreeBlocks(void * blocks)
+{
+	swifft_header_t *header;
+	if (blocks == NULL) {
+		return;
+	}
+	header = (swifft_header_t *)blocks - 1;
+	if (header->h.size != 0) {
+		SWIFFT_unmap(header, header->h.size);
+	} else {
+		free(header);
+	}
+}
+
+//! \brief Locks a block pool.
+//!
+//! \param[in,out] pool the block pool.
+static void SWIFFT_poolLock(swifft_block_pool_t *pool)
+{
+	while (atomic_flag_test_and_set_explicit(&pool->lock, memory_order_acquire)) {
+	}
+}
+
+//! \brief Unlocks a block pool.
+//!
+//! \param[in,out] pool the block pool.
+static void SWIFFT_poolUnlock(swifft_block_pool_t *pool)
+{
+	atomic_flag_clear_explicit(&pool->lock, memory_order_release);
+}
+
+//! \brief Maps memory for a block pool, while the block pool is not locked, and records the mapping,
+//! taking the lock only for recording it so that other threads do not wait on touching the memory.
+//!
+//! \param[in,out] pool the block pool.
+//! \param[in] length the length, a multiple of SWIFFT_ARENA_SIZE.
+//! \returns the mapping, or NULL if memory is exhausted, with the block pool locked either way.
+static void *SWIFFT_poolMap(swifft_block_pool_t *pool, size_t length)
+{
+	int hugetlb;
+	void *p = SWIFFT_map(length, pool->node, &hugetlb);
+	SWIFFT_poolLock(pool);
+	if (p == NULL) {
+		return NULL;
+	}
+	if (pool->stats.mappings == pool->capacity) {
+		size_t capacity = pool->capacity ? 2*pool->capacity : 16;
+		swifft_mapping_t *mappings = (swifft_mapping_t *)realloc(pool->mappings, capacity * sizeof(swifft_mapping_t));
+		if (mappings == NULL) {
+			SWIFFT_unmap(p, length);
+			return NULL;
+		}
+		pool->mappings = mappings;
+		pool->capacity = capacity;
+	}
+	pool->mappings[pool->stats.mappings].base = p;
+	pool->mappings[pool->stats.mappings].length = length;
+	pool->stats.mappings++;
+	pool->stats.hugetlb += hugetlb;
+	pool->stats.mappedBytes += length;
+	return p;
+}
+
+//! \brief Returns an array to the free arrays of its class, while the block pool is locked.
+//!
+//! \param[in,out] pool the block pool.
+//! \param[in] header the header of the array.
+static void SWIFFT_poolPush(swifft_block_pool_t *pool, swifft_header_t *header)
+{
+	swifft_header_t **list = header->h.cls < 0 ? &pool->large : &pool->free[header->h.cls];
+	header->h.next = *list;
+	*list = header;
+}
+
+//! \brief Carves an array of a class out of the current arena, mapping another if it does not fit,
+//! while the block pool is locked. The lock is released while mapping, and another thread may then
+//! install an arena of its own, so the fit is checked again once the lock is retaken: if the array
+//! now fits, it is carved out of that arena, and the new mapping becomes a free array of the
+//! largest class, which spans a whole arena.
+//!
+//! \param[in,out] pool the block pool.
+//! \param[in] cls the size class.
+//! \returns the header of the array, or NULL if memory is exhausted.
+static swifft_header_t *SWIFFT_poolCarve(swifft_block_pool_t *pool, int cls)
+{
+	size_t size = (size_t)SWIFFT_ALIGNMENT << cls;
+	swifft_header_t *header;
+	if (pool->arena == NULL || pool->arenaUsed + size > SWIFFT_ARENA_SIZE) {
+		int c;
+		char *arena;
+		SWIFFT_poolUnlock(pool);
+		arena = (char *)SWIFFT_poolMap(pool, SWIFFT_ARENA_SIZE);
+		if (arena == NULL) {
+			return NULL;
+		}
+		if (pool->arena != NULL && pool->arenaUsed + size <= SWIFFT_ARENA_SIZE) {
+			swifft_header_t *piece = (swifft_header_t *)arena;
+			piece->h.size = SWIFFT_ARENA_SIZE;
+			piece->h.cls = SWIFFT_CLASSES - 1;
+			SWIFFT_poolPush(pool, piece);
+		} else {
+			// the rest of the current arena becomes free arrays of the classes that fit, largest first
+			for (c=SWIFFT_CLASSES-1; pool->arena != NULL && c>=0; c--) {
+				size_t rest = (size_t)SWIFFT_ALIGNMENT << c;
+				if (pool->arenaUsed + rest <= SWIFFT_ARENA_SIZE) {
+					swifft_header_t *piece = (swifft_header_t *)(pool->arena + pool->arenaUsed);
+					piece->h.size = rest;
+					piece->h.cls = c;
+					SWIFFT_poolPush(pool, piece);
+					pool->arenaUsed += rest;
+				}
+			}
+			pool->arena = arena;
+			pool->arenaUsed = 0;
+		}
+	}
+	header = (swifft_header_t *)(pool->arena + pool->arenaUsed);
+	pool->arenaUsed += size;
+	header->h.size = size;
+	header->h.cls = cls;
+	return header;
+}
+
+//! \brief Takes a free array with a mapping of its own of at least a size, and at most twice it,
+//! while the block pool is locked.
+//!
+//! \param[in,out] pool the block pool.
+//! \param[in] size the size of the array and its header.
+//! \returns the header of the array, or NULL if there is none.
+static swifft_header_t *SWIFFT_poolTakeLarge(swifft_block_pool_t *pool, size_t size)
+{
+	swifft_header_t **link;
+	for (link=&pool->large; *link!=NULL; link=&(*link)->h.next) {
+		swifft_header_t *header = *link;
+		if (header->h.size >= size && header->h.size / 2 <= size) {
+			*link = header->h.next;
+			return header;
+		}
+	}
+	return NULL;
+}
+
+swifft_block_pool_t * SWIFFT_BlockPoolCreate(int node)
+{
+	swifft_block_pool_t *pool = (swifft_block_pool_t *)calloc(1, sizeof(swifft_block_pool_t));
+	if (pool == NULL) {
+		return NULL;
+	}
+	atomic_flag_clear(&pool->lock);
+	pool->node = node;
+	return pool;
+}
+
+void * SWIFFT_BlockPoolAlloc(swifft_block_pool_t * pool, size_t nblocks, size_t blockSize)
+{
+	size_t size = SWIFFT_arraySize(nblocks, blockSize);
+	swifft_header_t *header;
+	int cls = 0;
+	if (size == 0) {
+		return NULL;
+	}
+	SWIFFT_poolLock(pool);
+	if (size > SWIFFT_ARENA_SIZE) {
+		size = (size + SWIFFT_ARENA_SIZE - 1) & ~(size_t)(SWIFFT_ARENA_SIZE - 1);
+		header = SWIFFT_poolTakeLarge(pool, size);
+		if (header != NULL) {
+			pool->stats.reuses++;
+		} else {
+			SWIFFT_poolUnlock(pool);
+			header = (swifft_header_t *)SWIFFT_poolMap(pool, size);
+			if (header != NULL) {
+				header->h.size = size;
+				header->h.cls = -1;
+			}
+		}
+	} else {
+		while (((size_t)SWIFFT_ALIGNMENT << cls) < size) {
+			cls++;
+		}
+		header = pool->free[cls];
+		if (header != NULL) {
+			pool->free[cls] = header->h.next;
+			pool->stats.reuses++;
+		} else {
+			header = SWIFFT_poolCarve(pool, cls);
+		}
+	}
+	if (header != NULL) {
+		pool->stats.allocs++;
+		pool->stats.usedBytes += header->h.size;
+	}
+	SWIFFT_poolUnlock(pool);
+	return header != NULL ? header + 1 : NULL;
+}
+
+void SWIFFT_BlockPoolFree(swifft_block_pool_t * pool, void * blocks)
+{
+	swifft_header_t *header;
+	if (blocks == NULL) {
+		return;
+	}
+	header = (swifft_header_t *)blocks - 1;
+	SWIFFT_poolLock(pool);
+	pool->stats.usedBytes -= header->h.size;
+	SWIFFT_poolPush(pool, header);
+	SWIFFT_poolUnlock(pool);
+}
+
+void SWIFFT_BlockPoolGetStats(swifft_block_pool_t * pool, swifft_block_pool_stats_t * stats)
+{
+	SWIFFT_poolLock(pool);
+	*stats = pool->stats;
+	SWIFFT_poolUnlock(pool);
+}
+
+void SWIFFT_BlockPoolDestroy(swifft_block_pool_t * pool)
+{
+	size_t i;
+	if (pool == NULL) {
+		return;
+	}
+	for (i=0; i<pool->stats.mappings; i++) {
+		SWIFFT_unmap(pool->mappings[i].base, pool->mappings[i].length);
+	}
+	free(pool->mappings);
+	free(pool);
+}
+
+LIBSWIFFT_END_EXTERN_C
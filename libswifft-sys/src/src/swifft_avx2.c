@@ -13,6 +13,13 @@
 #if defined(__AVX2__)
 	#include "swifft_avx2.h"
 	#define SWIFFT_LOG2_O 1
+	// the lane-per-block engine beats the kernels here from 4096 blocks, for signed and unsigned input
+	#ifndef SWIFFT_SOA_BATCH_THRESHOLD
+		#define SWIFFT_SOA_BATCH_THRESHOLD 4096
+	#endif
+	#ifndef SWIFFT_SOA_UNSIGNED_BATCH_THRESHOLD
+		#define SWIFFT_SOA_UNSIGNED_BATCH_THRESHOLD 4096
+	#endif
 	#include "swifft.inl"
 #else
         #pragma message "Disabling generation of LibSWIFFT API for AVX2"
@@ -13,6 +13,11 @@
 #if defined(__AVX512F__)
 	#include "swifft_avx512.h"
 	#define SWIFFT_LOG2_O 2
+	// the lane-per-block engine beats the kernels here from 4096 blocks for signed input only,
+	// since the FFT lookup of the kernels is faster for unsigned input
+	#ifndef SWIFFT_SOA_BATCH_THRESHOLD
+		#define SWIFFT_SOA_BATCH_THRESHOLD 4096
+	#endif
 	#include "swifft.inl"
 #else
 	#pragma message "Disabling generation of LibSWIFFT API for AVX512"
@@ -0,0 +1,24 @@
+/*
+ * Copyright (C) 2021 Yaron Gvili and Gvili Tech Ltd.
+ *
+ * See the accompanying LICENSE.txt file for licensing information.
+ */
+/*! \file src/swifft_avx512bw.c
+ * \brief LibSWIFFT public C implementation for AVX512BW
+ *
+ * See "src/swifft.inl" for code expanded here with SWIFFT_ISET set to AVX512BW.
+ */
+#include "common.h"
+
+#if defined(__AVX512BW__)
+	#include "swifft_avx512bw.h"
+	#define SWIFFT_LOG2_O 2
+	// the lane-per-block engine beats the kernels here from 4096 blocks for signed input only,
+	// since the FFT lookup of the kernels is faster for unsigned input
+	#ifndef SWIFFT_SOA_BATCH_THRESHOLD
+		#define SWIFFT_SOA_BATCH_THRESHOLD 4096
+	#endif
+	#include "swifft.inl"
+#else
+	#pragma message "Disabling generation of LibSWIFFT API for AVX512BW"
+#endif
@@ -0,0 +1,360 @@
+/*
+ * Copyright (C) 2021 Yaron Gvili and Gvili Tech Ltd.
+ *
+ * See the accompanying LICENSE.txt file for licensing information.
+ */
+/*! \file src/swifft_bench.c
+ * \brief LibSWIFFT tool for benchmarking the kernels of each instruction set
+ *
+ * Measures each kernel through the SWIFFT object of each instruction set that
+ * the running CPU supports. Single-block kernels run on the calling thread.
+ * Kernels on multiple blocks sweep batch sizes and, when the native pool is
+ * built in, numbers of threads. Results are printed as JSON, one record per
+ * instruction set, kernel, batch size and number of threads, with the blocks
+ * per second and the cycles of the time-stamp counter per byte of input, or on
+ * AArch64, the ticks of the virtual timer per byte of input.
+ */
+#define _GNU_SOURCE // for clock_gettime
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+	#include <x86intrin.h> // for __rdtsc
+#endif
+#include "swifft.h"
+#include "swifft_object.h"
+
+#define SWIFFT_BENCH_MAX_BLOCKS 4096     ///< Largest batch size of the sweep
+#define SWIFFT_BENCH_FFT_ELEMENTS (SWIFFT_INPUT_CHUNKS*64) ///< Number of FFT-output elements per block
+
+//! \brief The buffers that the kernels run on, each for the largest batch.
+typedef struct {
+	BitSequence *input;   ///< The blocks of input
+	BitSequence *sign;    ///< The blocks of sign bits
+	BitSequence *output;  ///< The hash values, modified by the kernels
+	BitSequence *operand; ///< The hash values of the operands
+	BitSequence *compact; ///< The compacted hash values
+	int16_t *fftout;      ///< The FFT-output elements
+	int16_t *key;         ///< The FFT-sum key
+	int16_t *coeffs;      ///< The coefficients of the arithmetic operations
+} swifft_bench_buffers_t;
+
+//! \brief A function running a kernel once on a batch of blocks.
+typedef void (*swifft_bench_fn)(const swifft_object_t * o, size_t nblocks, const swifft_bench_buffers_t * b);
+
+//! \brief A kernel to benchmark.
+typedef struct {
+	const char *name;    ///< The name of the kernel, as in the API
+	size_t bytes;        ///< The number of bytes of input per block
+	int multiple;        ///< Whether the kernel runs on a batch of blocks
+	swifft_bench_fn fn;  ///< The function running the kernel
+} swifft_bench_kernel_t;
+
+static void SWIFFT_benchFft(const swifft_object_t * o, size_t nblocks, const swifft_bench_buffers_t * b)
+{
+	(void)nblocks;
+	o->fft.SWIFFT_fft(b->input, b->sign, SWIFFT_INPUT_CHUNKS, b->fftout);
+}
+
+static void SWIFFT_benchFftsum(const swifft_object_t * o, size_t nblocks, const swifft_bench_buffers_t * b)
+{
+	(void)nblocks;
+	o->fft.SWIFFT_fftsum(b->key, b->fftout, SWIFFT_INPUT_CHUNKS, (int16_t *)b->output);
+}
+
+static void SWIFFT_benchCompute(const swifft_object_t * o, size_t nblocks, const swifft_bench_buffers_t * b)
+{
+	(void)nblocks;
+	o->hash.SWIFFT_Compute(b->input, b->output);
+}
+
+static void SWIFFT_benchComputeSigned(const swifft_object_t * o, size_t nblocks, const swifft_bench_buffers_t * b)
+{
+	(void)nblocks;
+	o->hash.SWIFFT_ComputeSigned(b->input, b->sign, b->output);
+}
+
+static void SWIFFT_benchCompact(const swifft_object_t * o, size_t nblocks, const swifft_bench_buffers_t * b)
+{
+	(void)nblocks;
+	o->hash.SWIFFT_Compact(b->operand, b->compact);
+}
+
+static void SWIFFT_benchFftMultiple(const swifft_object_t * o, size_t nblocks, const swifft_bench_buffers_t * b)
+{
+	o->fft.SWIFFT_fftMultiple(nblocks, b->input, b->sign, SWIFFT_INPUT_CHUNKS, b->fftout);
+}
+
+static void SWIFFT_benchFftsumMultiple(const swifft_object_t * o, size_t nblocks, const swifft_bench_buffers_t * b)
+{
+	o->fft.SWIFFT_fftsumMultiple(nblocks, b->key, b->fftout, SWIFFT_INPUT_CHUNKS, (int16_t *)b->output);
+}
+
+static void SWIFFT_benchComputeMultiple(const swifft_object_t * o, size_t nblocks, const swifft_bench_buffers_t * b)
+{
+	o->hash.SWIFFT_ComputeMultiple(nblocks, b->input, b->output);
+}
+
+static void SWIFFT_benchComputeMultipleSigned(const swifft_object_t * o, size_t nblocks, const swifft_bench_buffers_t * b)
+{
+	o->hash.SWIFFT_ComputeMultipleSigned(nblocks, b->input, b->sign, b->output);
+}
+
+static void SWIFFT_benchComputeCompactMultiple(const swifft_object_t * o, size_t nblocks, const swifft_bench_buffers_t * b)
+{
+	o->hash.SWIFFT_ComputeCompactMultiple(nblocks, b->input, b->compact);
+}
+
+static void SWIFFT_benchCompactMultiple(const swifft_object_t * o, size_t nblocks, const swifft_bench_buffers_t * b)
+{
+	o->hash.SWIFFT_CompactMultiple(nblocks, b->operand, b->compact);
+}
+
+static void SWIFFT_benchConstSetMultiple(const swifft_object_t * o, size_t nblocks, const swifft_bench_buffers_t * b)
+{
+	o->arith.SWIFFT_ConstSetMultiple(nblocks, b->output, b->coeffs);
+}
+
+static void SWIFFT_benchConstAddMultiple(const swifft_object_t * o, size_t nblocks, const swifft_bench_buffers_t * b)
+{
+	o->arith.SWIFFT_ConstAddMultiple(nblocks, b->output, b->coeffs);
+}
+
+static void SWIFFT_benchConstSubMultiple(const swifft_object_t * o, size_t nblocks, const swifft_bench_buffers_t * b)
+{
+	o->arith.SWIFFT_ConstSubMultiple(nblocks, b->output, b->coeffs);
+}
+
+static void SWIFFT_benchConstMulMultiple(const swifft_object_t * o, size_t nblocks, const swifft_bench_buffers_t * b)
+{
+	o->arith.SWIFFT_ConstMulMultiple(nblocks, b->output, b->coeffs);
+}
+
+static void SWIFFT_benchSetMultiple(const swifft_object_t * o, size_t nblocks, const swifft_bench_buffers_t * b)
+{
+	o->arith.SWIFFT_SetMultiple(nblocks, b->output, b->operand);
+}
+
+static void SWIFFT_benchAddMultiple(const swifft_object_t * o, size_t nblocks, const swifft_bench_buffers_t * b)
+{
+	o->arith.SWIFFT_AddMultiple(nblocks, b->output, b->operand);
+}
+
+static void SWIFFT_benchSubMultiple(const swifft_object_t * o, size_t nblocks, const swifft_bench_buffers_t * b)
+{
+	o->arith.SWIFFT_SubMultiple(nblocks, b->output, b->operand);
+}
+
+static void SWIFFT_benchMulMultiple(const swifft_object_t * o, size_t nblocks, const swifft_bench_buffers_t * b)
+{
+	o->arith.SWIFFT_MulMultiple(nblocks, b->output, b->operand);
+}
+
+static void SWIFFT_benchSumMultiple(const swifft_object_t * o, size_t nblocks, const swifft_bench_buffers_t * b)
+{
+	o->arith.SWIFFT_SumMultiple(nblocks, b->operand, b->output);
+}
+
+static void SWIFFT_benchLinearCombination(const swifft_object_t * o, size_t nblocks, const swifft_bench_buffers_t * b)
+{
+	o->arith.SWIFFT_LinearCombination(nblocks, b->coeffs, b->operand, b->output);
+}
+
+//! \brief The kernels to benchmark.
+static const swifft_bench_kernel_t SWIFFT_benchKernels[] = {
+	{ "fft",                   SWIFFT_INPUT_BLOCK_SIZE,  0, SWIFFT_benchFft },
+	{ "fftsum",                SWIFFT_BENCH_FFT_ELEMENTS*sizeof(int16_t), 0, SWIFFT_benchFftsum },
+	{ "Compute",               SWIFFT_INPUT_BLOCK_SIZE,  0, SWIFFT_benchCompute },
+	{ "ComputeSigned",         SWIFFT_INPUT_BLOCK_SIZE,  0, SWIFFT_benchComputeSigned },
+	{ "Compact",               SWIFFT_OUTPUT_BLOCK_SIZE, 0, SWIFFT_benchCompact },
+	{ "fftMultiple",           SWIFFT_INPUT_BLOCK_SIZE,  1, SWIFFT_benchFftMultiple },
+	{ "fftsumMultiple",        SWIFFT_BENCH_FFT_ELEMENTS*sizeof(int16_t), 1, SWIFFT_benchFftsumMultiple },
+	{ "ComputeMultiple",       SWIFFT_INPUT_BLOCK_SIZE,  1, SWIFFT_benchComputeMultiple },
+	{ "ComputeMultipleSigned", SWIFFT_INPUT_BLOCK_SIZE,  1, SWIFFT_benchComputeMultipleSigned },
+	{ "ComputeCompactMultiple", SWIFFT_INPUT_BLOCK_SIZE, 1, SWIFFT_benchComputeCompactMultiple },
+	{ "CompactMultiple",       SWIFFT_OUTPUT_BLOCK_SIZE, 1, SWIFFT_benchCompactMultiple },
+	{ "ConstSetMultiple",      SWIFFT_OUTPUT_BLOCK_SIZE, 1, SWIFFT_benchConstSetMultiple },
+	{ "ConstAddMultiple",      SWIFFT_OUTPUT_BLOCK_SIZE, 1, SWIFFT_benchConstAddMultiple },
+	{ "ConstSubMultiple",      SWIFFT_OUTPUT_BLOCK_SIZE, 1, SWIFFT_benchConstSubMultiple },
+	{ "ConstMulMultiple",      SWIFFT_OUTPUT_BLOCK_SIZE, 1, SWIFFT_benchConstMulMultiple },
+	{ "SetMultiple",           SWIFFT_OUTPUT_BLOCK_SIZE, 1, SWIFFT_benchSetMultiple },
+	{ "AddMultiple",           SWIFFT_OUTPUT_BLOCK_SIZE, 1, SWIFFT_benchAddMultiple },
+	{ "SubMultiple",           SWIFFT_OUTPUT_BLOCK_SIZE, 1, SWIFFT_benchSubMultiple },
+	{ "MulMultiple",           SWIFFT_OUTPUT_BLOCK_SIZE, 1, SWIFFT_benchMulMultiple },
+	{ "SumMultiple",           SWIFFT_OUTPUT_BLOCK_SIZE, 1, SWIFFT_benchSumMultiple },
+	{ "LinearCombination",     SWIFFT_OUTPUT_BLOCK_SIZE, 1, SWIFFT_benchLinearCombination },
+};
+
+//! \brief The batch sizes of the sweep.
+static const size_t SWIFFT_benchBlocks[] = { 1, 8, 64, 512, SWIFFT_BENCH_MAX_BLOCKS };
+
+//! \brief Returns the time of a monotonic clock.
+//!
+//! \returns the time, in seconds.
+static double SWIFFT_benchNow(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+//! \brief Allocates a zeroed buffer with the alignment of SWIFFT, exiting if memory is exhausted.
+//!
+//! \param[in] size the number of bytes.
+//! \returns the buffer.
+static void *SWIFFT_benchAlloc(size_t size)
+{
+	void *p = NULL;
+	if (posix_memalign(&p, SWIFFT_ALIGNMENT, size) != 0) {
+		fprintf(stderr, "swifft_bench: out of memory\n");
+		exit(1);
+	}
+	memset(p, 0, size);
+	return p;
+}
+
+//! \brief Runs a kernel repeatedly for at least a given time and prints its record.
+//!
+//! \param[in] iset the name of the instruction set.
+//! \param[in] o the SWIFFT object of the instruction set.
+//! \param[in] kernel the kernel.
+//! \param[in] nblocks the batch size.
+//! \param[in] nthreads the number of threads.
+//! \param[in] seconds the minimum time to run.
+//! \param[in] b the buffers.
+//! \param[in] first whether this is the first record.
+//! \brief Returns the count of the cycle counter, or on AArch64, of the virtual timer.
+static unsigned long long SWIFFT_benchTicks(void)
+{
+#if defined(__aarch64__)
+	unsigned long long ticks;
+	__asm__ volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+	return ticks;
+#else
+	return __rdtsc();
+#endif
+}
+
+static void SWIFFT_benchRun(const char * iset, const swifft_object_t * o, const swifft_bench_kernel_t * kernel,
+	size_t nblocks, int nthreads, double seconds, const swifft_bench_buffers_t * b, int first)
+{
+	unsigned long long cycles;
+	double start, elapsed;
+	size_t runs = 0, batch = 1, r;
+	// warming up the caches and the pool
+	kernel->fn(o, nblocks, b);
+	start = SWIFFT_benchNow();
+	cycles = SWIFFT_benchTicks();
+	do {
+		for (r=0; r<batch; r++) {
+			kernel->fn(o, nblocks, b);
+		}
+		runs += batch;
+		batch *= 2;
+		elapsed = SWIFFT_benchNow() - start;
+	} while (elapsed < seconds);
+	cycles = SWIFFT_benchTicks() - cycles;
+	printf("%s    {\"iset\": \"%s\", \"kernel\": \"%s\", \"blocks\": %zu, \"threads\": %d, "
+		"\"blocks_per_second\": %.1f, \"ns_per_block\": %.2f, \"cycles_per_byte\": %.3f}",
+		first ? "" : ",\n", iset, kernel->name, nblocks, nthreads,
+		runs * nblocks / elapsed, elapsed * 1e9 / (runs * nblocks),
+		(double)cycles / ((double)runs * nblocks * kernel->bytes));
+	fflush(stdout);
+}
+
+int main(int argc, char **argv)
+{
+	static const struct {
+		const char *name;                            ///< The name of the instruction set
+		void (*init)(swifft_object_t *swifft);       ///< The function initializing its object
+	} isets[] = {
+#if defined(SWIFFT_HAVE_AVX)
+		{ "AVX", SWIFFT_InitObject_AVX },
+		{ "AVX2", SWIFFT_InitObject_AVX2 },
+		{ "AVX512", SWIFFT_InitObject_AVX512 },
+		{ "AVX512BW", SWIFFT_InitObject_AVX512BW },
+#endif
+#if defined(SWIFFT_HAVE_NEON)
+		{ "NEON", SWIFFT_InitObject_NEON },
+		{ "SVE2", SWIFFT_InitObject_SVE2 },
+#endif
+	};
+	int supported[sizeof(isets)/sizeof(isets[0])];
+	swifft_bench_buffers_t b;
+	swifft_object_t o;
+	double seconds = 0.05;
+	long nprocs = sysconf(_SC_NPROCESSORS_ONLN);
+	int opt, first = 1, t;
+	size_t i, k, n, maxBlocks = SWIFFT_BENCH_MAX_BLOCKS;
+	while ((opt = getopt(argc, argv, "m:")) != -1) {
+		if (opt != 'm') {
+			fprintf(stderr, "Usage: %s [-m milliseconds per measurement]\n", argv[0]);
+			return 2;
+		}
+		seconds = atof(optarg) / 1000;
+	}
+	b.input = (BitSequence *)SWIFFT_benchAlloc(maxBlocks * SWIFFT_INPUT_BLOCK_SIZE);
+	b.sign = (BitSequence *)SWIFFT_benchAlloc(maxBlocks * SWIFFT_INPUT_BLOCK_SIZE);
+	b.output = (BitSequence *)SWIFFT_benchAlloc(maxBlocks * SWIFFT_OUTPUT_BLOCK_SIZE);
+	b.operand = (BitSequence *)SWIFFT_benchAlloc(maxBlocks * SWIFFT_OUTPUT_BLOCK_SIZE);
+	b.compact = (BitSequence *)SWIFFT_benchAlloc(maxBlocks * SWIFFT_COMPACT_BLOCK_SIZE);
+	b.fftout = (int16_t *)SWIFFT_benchAlloc(maxBlocks * SWIFFT_BENCH_FFT_ELEMENTS * sizeof(int16_t));
+	b.key = (int16_t *)SWIFFT_benchAlloc(SWIFFT_KEY_ELEMENTS * sizeof(int16_t));
+	b.coeffs = (int16_t *)SWIFFT_benchAlloc(maxBlocks * sizeof(int16_t));
+	srand(1);
+	for (i=0; i<maxBlocks * SWIFFT_INPUT_BLOCK_SIZE; i++) {
+		b.input[i] = (BitSequence)rand();
+		b.sign[i] = b.input[i] & (BitSequence)rand();
+	}
+	for (i=0; i<maxBlocks * SWIFFT_OUTPUT_BLOCK_SIZE / sizeof(int16_t); i++) {
+		((int16_t *)b.operand)[i] = (int16_t)(rand() % 257);
+	}
+	for (i=0; i<SWIFFT_KEY_ELEMENTS; i++) {
+		b.key[i] = (int16_t)(rand() % 257 - 128);
+	}
+	for (i=0; i<maxBlocks; i++) {
+		b.coeffs[i] = (int16_t)(rand() % 257);
+	}
+#if defined(SWIFFT_HAVE_AVX)
+	__builtin_cpu_init();
+	supported[0] = __builtin_cpu_supports("avx");
+	supported[1] = __builtin_cpu_supports("avx2");
+	supported[2] = __builtin_cpu_supports("avx512f");
+	supported[3] = __builtin_cpu_supports("avx512bw");
+#endif
+#if defined(SWIFFT_HAVE_NEON)
+	supported[0] = 1;
+	supported[1] = strcmp(SWIFFT_BestInstructionSet(), "SVE2") == 0;
+#endif
+	printf("{\n  \"results\": [\n");
+	for (i=0; i<sizeof(isets)/sizeof(isets[0]); i++) {
+		if (!supported[i]) {
+			continue;
+		}
+		isets[i].init(&o);
+		for (k=0; k<sizeof(SWIFFT_benchKernels)/sizeof(SWIFFT_benchKernels[0]); k++) {
+			const swifft_bench_kernel_t *kernel = &SWIFFT_benchKernels[k];
+			if (!kernel->multiple) {
+				SWIFFT_SetThreads(1);
+				SWIFFT_benchRun(isets[i].name, &o, kernel, 1, 1, seconds, &b, first);
+				first = 0;
+				continue;
+			}
+			for (t=1; ; t = 2*t < nprocs ? 2*t : (int)nprocs) {
+				SWIFFT_SetThreads(t);
+				for (n=0; n<sizeof(SWIFFT_benchBlocks)/sizeof(SWIFFT_benchBlocks[0]); n++) {
+					SWIFFT_benchRun(isets[i].name, &o, kernel, SWIFFT_benchBlocks[n], SWIFFT_GetThreads(), seconds, &b, first);
+					first = 0;
+				}
+				if (SWIFFT_GetThreads() != t || t >= nprocs) {
+					break;
+				}
+			}
+		}
+	}
+	printf("\n  ]\n}\n");
+	SWIFFT_SetThreads(1);
+	return 0;
+}
@@ -0,0 +1,249 @@
+/*
+ * Copyright (C) 2021 Yaron Gvili and Gvili Tech Ltd.
+ *
+ * See the accompanying LICENSE.txt file for licensing information.
+ */
+/*! \file src/swifft_hashsum.c
+ * \brief LibSWIFFT tool for printing the digests of files
+ *
+ * Prints the digest of each file, in the format of sha256sum, as given by
+ * SWIFFT_TreeHash with leaves of a block of input and the maximum fan-out. A
+ * directory is hashed file by file, recursively, in sorted order. A regular
+ * file is memory-mapped, so its full blocks are hashed in place and only the
+ * last, partial one is staged. Other inputs, like pipes, are read into memory.
+ * Many files are hashed in parallel with each other, and few files each hash
+ * their own leaves in parallel.
+ */
+#define _GNU_SOURCE // for madvise and scandir
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "swifft.h"
+
+#define SWIFFT_HASHSUM_LEAF_SIZE SWIFFT_INPUT_BLOCK_SIZE ///< Number of bytes per leaf of the tree of a file
+#define SWIFFT_HASHSUM_FANOUT SWIFFT_TREE_MAX_FANOUT     ///< Number of digests per group of the tree of a file
+#define SWIFFT_HASHSUM_READ_SIZE (1 << 20)               ///< Initial number of bytes of the buffer of a read input
+
+//! \brief The files to hash and their digests, for running on ranges of files.
+typedef struct {
+	char **paths;          ///< The paths of the files, "-" for the standard input
+	size_t npaths;         ///< The number of files
+	size_t capacity;       ///< The number of paths allocated
+	BitSequence *digests;  ///< The digests of the files
+	int *errors;           ///< The error number of hashing each file, or 0 on success
+} swifft_hashsum_t;
+
+//! \brief Adds a path to the files to hash.
+//!
+//! \param[in,out] files the files.
+//! \param[in] path the path, copied.
+//! \returns 0 on success, or -1 if memory is exhausted.
+static int SWIFFT_hashsumAdd(swifft_hashsum_t * files, const char * path)
+{
+	if (files->npaths == files->capacity) {
+		size_t capacity = files->capacity ? 2 * files->capacity : 64;
+		char **paths = (char **)realloc(files->paths, capacity * sizeof(char *));
+		if (paths == NULL) {
+			return -1;
+		}
+		files->paths = paths;
+		files->capacity = capacity;
+	}
+	if ((files->paths[files->npaths] = strdup(path)) == NULL) {
+		return -1;
+	}
+	files->npaths++;
+	return 0;
+}
+
+//! \brief Adds a file, or the files of a directory recursively, to the files to hash.
+//! Symbolic links are followed only for the given path, not within directories.
+//!
+//! \param[in,out] files the files.
+//! \param[in] path the path of the file or directory.
+//! \param[in] follow whether to follow a symbolic link at the path.
+//! \returns 0 on success, or -1 on an error, which is reported.
+static int SWIFFT_hashsumCollect(swifft_hashsum_t * files, const char * path, int follow)
+{
+	struct dirent **entries;
+	struct stat st;
+	int n, i, result = 0;
+	if (strcmp(path, "-") == 0 || (follow ? stat(path, &st) : lstat(path, &st)) != 0 || !S_ISDIR(st.st_mode)) {
+		// a missing file is reported when hashing it, in order
+		return SWIFFT_hashsumAdd(files, path);
+	}
+	if ((n = scandir(path, &entries, NULL, alphasort)) < 0) {
+		fprintf(stderr, "swifft_hashsum: %s: %s\n", path, strerror(errno));
+		return -1;
+	}
+	for (i=0; i<n; i++) {
+		const char *name = entries[i]->d_name;
+		if (result == 0 && strcmp(name, ".") != 0 && strcmp(name, "..") != 0) {
+			size_t len = strlen(path);
+			char *child = (char *)malloc(len + strlen(name) + 2);
+			if (child == NULL) {
+				result = -1;
+			} else {
+				sprintf(child, len > 0 && path[len - 1] == '/' ? "%s%s" : "%s/%s", path, name);
+				result = SWIFFT_hashsumCollect(files, child, 0);
+				free(child);
+			}
+		}
+		free(entries[i]);
+	}
+	free(entries);
+	return result;
+}
+
+//! \brief Reads all of an input that cannot be memory-mapped into an aligned buffer.
+//!
+//! \param[in] fd the file descriptor of the input.
+//! \param[out] size the number of bytes read.
+//! \returns the buffer, to free, or NULL on an error, with errno set.
+static BitSequence *SWIFFT_hashsumRead(int fd, size_t * size)
+{
+	size_t capacity = SWIFFT_HASHSUM_READ_SIZE;
+	BitSequence *data = NULL, *grown;
+	ssize_t n;
+	// regular files that do not map, e.g. some special files, are read ahead
+	(void)posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+	*size = 0;
+	if (posix_memalign((void **)&data, SWIFFT_ALIGNMENT, capacity) != 0) {
+		errno = ENOMEM;
+		return NULL;
+	}
+	for (;;) {
+		if (*size == capacity) {
+			if (posix_memalign((void **)&grown, SWIFFT_ALIGNMENT, 2 * capacity) != 0) {
+				free(data);
+				errno = ENOMEM;
+				return NULL;
+			}
+			memcpy(grown, data, *size);
+			free(data);
+			data = grown;
+			capacity *= 2;
+		}
+		n = read(fd, data + *size, capacity - *size);
+		if (n == 0) {
+			return data;
+		}
+		if (n < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			free(data);
+			return NULL;
+		}
+		*size += (size_t)n;
+	}
+}
+
+//! \brief Hashes a file.
+//!
+//! \param[in] path the path of the file, or "-" for the standard input.
+//! \param[out] digest the digest, of size 64 bytes (512 bit).
+//! \returns 0 on success, or an error number.
+static int SWIFFT_hashsumFile(const char * path, BitSequence digest[SWIFFT_TREE_DIGEST_SIZE])
+{
+	static const BitSequence empty[1] = {0};
+	const BitSequence *data = empty;
+	BitSequence *buffer = NULL;
+	void *mapped = MAP_FAILED;
+	struct stat st;
+	size_t size = 0;
+	int fd, error = 0;
+	if (strcmp(path, "-") == 0) {
+		fd = STDIN_FILENO;
+	} else if ((fd = open(path, O_RDONLY)) < 0) {
+		return errno;
+	}
+	if (fstat(fd, &st) != 0) {
+		error = errno;
+	} else if (S_ISDIR(st.st_mode)) {
+		error = EISDIR;
+	} else if (S_ISREG(st.st_mode) && st.st_size > 0) {
+		size = (size_t)st.st_size;
+		mapped = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	}
+	if (error == 0 && mapped != MAP_FAILED) {
+		(void)madvise(mapped, size, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+		// effective where the page cache of the file supports huge pages
+		(void)madvise(mapped, size, MADV_HUGEPAGE);
+#endif
+		data = (const BitSequence *)mapped;
+	} else if (error == 0) {
+		if ((buffer = SWIFFT_hashsumRead(fd, &size)) == NULL) {
+			error = errno;
+		} else {
+			data = buffer;
+		}
+	}
+	if (error == 0 && SWIFFT_TreeHash(data, size, SWIFFT_HASHSUM_LEAF_SIZE, SWIFFT_HASHSUM_FANOUT, digest) != 0) {
+		error = ENOMEM;
+	}
+	if (mapped != MAP_FAILED) {
+		munmap(mapped, size);
+	}
+	free(buffer);
+	if (fd != STDIN_FILENO) {
+		close(fd);
+	}
+	return error;
+}
+
+//! \brief Hashes a range of files, given a swifft_hashsum_t.
+static void SWIFFT_hashsumRange(void *vtask, size_t begin, size_t end)
+{
+	swifft_hashsum_t *files = (swifft_hashsum_t *)vtask;
+	size_t i;
+	for (i=begin; i<end; i++) {
+		files->errors[i] = SWIFFT_hashsumFile(files->paths[i], files->digests + i * SWIFFT_TREE_DIGEST_SIZE);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	swifft_hashsum_t files = { NULL, 0, 0, NULL, NULL };
+	int opt, nthreads = 0, status = 0, i, k;
+	size_t f;
+	while ((opt = getopt(argc, argv, "j:")) != -1) {
+		if (opt != 'j') {
+			fprintf(stderr, "Usage: %s [-j threads] [file or directory]...\n", argv[0]);
+			return 2;
+		}
+		nthreads = atoi(optarg);
+	}
+	for (i=optind; i<argc || (i == optind && i == argc); i++) {
+		if (SWIFFT_hashsumCollect(&files, i < argc ? argv[i] : "-", 1) != 0) {
+			status = 1;
+		}
+	}
+	files.digests = (BitSequence *)malloc(files.npaths * SWIFFT_TREE_DIGEST_SIZE + 1);
+	files.errors = (int *)calloc(files.npaths + 1, sizeof(int));
+	if (files.digests == NULL || files.errors == NULL) {
+		fprintf(stderr, "swifft_hashsum: %s\n", strerror(ENOMEM));
+		return 1;
+	}
+	SWIFFT_SetThreads(nthreads);
+	SWIFFT_ParallelFor(files.npaths, SWIFFT_hashsumRange, &files);
+	for (f=0; f<files.npaths; f++) {
+		if (files.errors[f] != 0) {
+			fprintf(stderr, "swifft_hashsum: %s: %s\n", files.paths[f], strerror(files.errors[f]));
+			status = 1;
+			continue;
+		}
+		for (k=0; k<SWIFFT_TREE_DIGEST_SIZE; k++) {
+			printf("%02x", files.digests[f * SWIFFT_TREE_DIGEST_SIZE + k]);
+		}
+		printf("  %s\n", files.paths[f]);
+	}
+	return status;
+}
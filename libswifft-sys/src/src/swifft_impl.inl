@@ -9,7 +9,10 @@
 
 #include "swifft_common.h"
 
-#if defined(__AVX512F__)
+#if defined(__AVX512BW__)
+        #define SWIFFT_INSTRUCTION_SET AVX512BW
+        #define SWIFFT_VECTOR_LOG2_SIZE 5
+#elif defined(__AVX512F__)
         #define SWIFFT_INSTRUCTION_SET AVX512
         #define SWIFFT_VECTOR_LOG2_SIZE 5
 #elif defined(__AVX2__)
@@ -18,8 +21,17 @@
 #elif defined(__AVX__)
         #define SWIFFT_INSTRUCTION_SET AVX
         #define SWIFFT_VECTOR_LOG2_SIZE 3
+#elif defined(__SSE2__)
+        // no build-time instruction set: the public API selects one at load time
+        #define SWIFFT_VECTOR_LOG2_SIZE 3
+#elif defined(__ARM_FEATURE_SVE2)
+        #define SWIFFT_INSTRUCTION_SET SVE2
+        #define SWIFFT_VECTOR_LOG2_SIZE 4
+#elif defined(__aarch64__)
+        // NEON is always available, so the public API selects NEON or SVE2 at load time
+        #define SWIFFT_VECTOR_LOG2_SIZE 3
 #else
-        #error "AVX, AVX2, or AVX512F must be enabled"
+        #error "SSE2, AVX, AVX2, AVX512F, or AArch64 NEON must be enabled"
 #endif
 #define SWIFFT_VECTOR_SIZE (1 << SWIFFT_VECTOR_LOG2_SIZE)
 
@@ -35,7 +47,30 @@
 #define SWIFFT_V (1<<SWIFFT_LOG2_V)            ///< Number of values in a byte
 
 #define SWIFFT_INT16(high,low) (((high) << SWIFFT_LOG2_V) | (low))   ///< Compose a 16-bit value from two 8-bit ones
+#define SWIFFT_KEY_INDEX(c, k) ((((c) >> 2) << 5) | ((k) << 2) | ((c) & 3)) ///< Index of the 8 key elements of chunk c and FFT-output element k, in the interleaved key layout
 #define SWIFFT_AddSub(a, b) { b = a - b; a += a - b; }               ///< Replace a pair of numbers with their addition and subtraction
+#define SWIFFT_PRODUCT_HEADROOM 84                                  ///< Number of partially reduced products, each in {-127,..,383}, that an unreduced sum in {-127,..,383} may add
+#define SWIFFT_EVAL_TILE_BLOCKS 16                                  ///< Number of blocks whose stacks SWIFFT_EvalMultiple holds at once
+#define SWIFFT_MULTIKEY_TILE_BLOCKS 8                               ///< Number of blocks whose FFT output SWIFFT_ComputeMultiKey holds at once
+#define SWIFFT_MULTIKEY_TILE_KEYS 4                                 ///< Number of keys that SWIFFT_ComputeMultiKey sums a tile of blocks against at once
+#define SWIFFT_PAGE_BLOCKS 32                                       ///< Number of blocks of output per page of 4096 bytes
+#define SWIFFT_PREFETCH_BLOCKS 4                                    ///< Number of blocks ahead that large batches prefetch input
+
+#ifndef SWIFFT_LARGE_BATCH_THRESHOLD
+	//! \brief Minimum number of blocks that SWIFFT_ComputeMultiple* stream through the cache, 16 MB of input
+	#define SWIFFT_LARGE_BATCH_THRESHOLD 65536
+#endif
+#ifndef SWIFFT_SOA_BATCH_THRESHOLD
+	//! \brief Minimum number of blocks that SWIFFT_ComputeMultiple* run with the lane-per-block engine given signed input,
+	//! by default never, unless set by an instruction set where the engine was measured faster
+	#define SWIFFT_SOA_BATCH_THRESHOLD ((size_t)-1)
+#endif
+#ifndef SWIFFT_SOA_UNSIGNED_BATCH_THRESHOLD
+	//! \brief Minimum number of blocks that SWIFFT_ComputeMultiple* and SWIFFT_ComputeCompactMultiple run with the
+	//! lane-per-block engine given unsigned input, by default never, unless set by an instruction set where the engine
+	//! was measured faster
+	#define SWIFFT_SOA_UNSIGNED_BATCH_THRESHOLD ((size_t)-1)
+#endif
 
 
 LIBSWIFFT_BEGIN_EXTERN_C
@@ -43,7 +78,22 @@ LIBSWIFFT_BEGIN_EXTERN_C
 extern const BitSequence SWIFFT_sign0[SWIFFT_INPUT_BLOCK_SIZE];
 
 extern const int16_t SWIFFT_multipliers[SWIFFT_N];
-extern const int16_t SWIFFT_fftTable[SWIFFT_V*SWIFFT_V*SWIFFT_W];
+extern const int16_t SWIFFT_fftTable[SWIFFT_V*SWIFFT_W];
 extern const int16_t SWIFFT_PI_key[SWIFFT_M*SWIFFT_N];
+extern const int16_t SWIFFT_PI_keyInterleaved[SWIFFT_M*SWIFFT_N];
+
+//! \brief Returns whether operations on multiple blocks may run on more than one thread, as configured.
+//!
+//! \returns nonzero if they may.
+int SWIFFT_IsParallel(void);
+
+//! \brief Compacts a hash value of SWIFFT, as SWIFFT_Compact does, without counting it in the statistics.
+//!
+//! \param[in] output the hash value of SWIFFT, of size 128 bytes (1024 bit).
+//! \param[out] compact the compacted hash value of SWIFFT, of size 64 bytes (512 bit).
+void SWIFFT_compact(const BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE],
+	BitSequence compact[SWIFFT_COMPACT_BLOCK_SIZE]);
+
+LIBSWIFFT_STATIC_ASSERT(SWIFFT_KEY_ELEMENTS == SWIFFT_M*SWIFFT_N, SWIFFT_KEY_ELEMENTS_must_be_SWIFFT_M_times_SWIFFT_N);
 
 LIBSWIFFT_END_EXTERN_C
@@ -0,0 +1,577 @@
+/*
+ * Copyright (C) 2021 Yaron Gvili and Gvili Tech Ltd.
+ *
+ * See the accompanying LICENSE.txt file for licensing information.
+ */
+/*! \file src/swifft_index.c
+ * \brief LibSWIFFT public C implementation for indexing compact SWIFFT digests
+ *
+ * The image of an index, in memory or in its file, is a header page followed by
+ * the tags of the slots, their digests and their values, each in an array of its
+ * own, so a group of tags fills a SIMD register and a digest a cache line. A tag
+ * is 0 for an empty slot and has its top bit set for a full one, with the other
+ * bits taken from the hash of the digest. The groups are probed quadratically,
+ * and a probe ends at the first group with an empty slot, since none is emptied,
+ * or after visiting every group, so a damaged image cannot make it loop forever.
+ *
+ * A batch is probed window by window. The groups of the digests of a window are
+ * prefetched first, then the digests of their first slots whose tags match, and
+ * only then are the digests probed for in turn, so the misses of a window overlap.
+ */
+
+#define _GNU_SOURCE // for ftruncate, msync and MAP_POPULATE
+
+#include <errno.h>
+#include <stdint.h> // for SIZE_MAX, uint64_t
+#include <stdlib.h> // for calloc, free
+#include <string.h> // for memcmp, memcpy
+#include "swifft.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+	#define SWIFFT_INDEX_FILES ///< Whether indices may be mapped from files
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+#if defined(__SSE2__)
+	#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+	#include <arm_neon.h>
+#endif
+
+#define SWIFFT_INDEX_MAGIC "SWFTIDX"                   ///< The magic string starting the file of an index
+#define SWIFFT_INDEX_VERSION 1                         ///< The version of the format of an index
+#define SWIFFT_INDEX_BYTE_ORDER 0x0102030405060708ULL  ///< The value recording the byte order of the host
+#define SWIFFT_INDEX_PAGE_SIZE 4096                    ///< The alignment of the arrays of an index, and the size of its header
+#define SWIFFT_INDEX_WINDOW 16                         ///< Number of digests of a batch prefetched before being probed for
+#define SWIFFT_INDEX_TILE_BLOCKS 1024                  ///< Number of blocks computed at once by SWIFFT_IndexComputeInsertMultiple
+
+#if defined(__GNUC__)
+	#define SWIFFT_INDEX_PREFETCH(p) __builtin_prefetch(p)
+#else
+	#define SWIFFT_INDEX_PREFETCH(p) ((void)(p))
+#endif
+
+LIBSWIFFT_BEGIN_EXTERN_C
+
+//! \brief The header of the image of an index, at its start.
+typedef struct {
+	char magic[8];          ///< SWIFFT_INDEX_MAGIC
+	uint64_t byteOrder;     ///< SWIFFT_INDEX_BYTE_ORDER, in the byte order of the host that created the image
+	uint32_t version;       ///< SWIFFT_INDEX_VERSION
+	uint32_t digestSize;    ///< SWIFFT_COMPACT_BLOCK_SIZE
+	uint64_t capacity;      ///< The number of slots, a power of 2 multiple of SWIFFT_INDEX_GROUP_SLOTS
+	uint64_t maxEntries;    ///< The number of entries the index can hold
+	uint64_t count;         ///< The number of entries, as of the last batch inserted
+	uint64_t tagsOffset;    ///< The offset of the tags from the start of the image
+	uint64_t digestsOffset; ///< The offset of the digests from the start of the image
+	uint64_t valuesOffset;  ///< The offset of the values from the start of the image
+	uint64_t size;          ///< The size of the image
+} swifft_index_header_t;
+
+LIBSWIFFT_STATIC_ASSERT(sizeof(swifft_index_header_t) <= SWIFFT_INDEX_PAGE_SIZE, swifft_index_header_t_must_fit_in_a_page);
+
+struct swifft_index_s {
+	swifft_index_header_t *header; ///< The image of the index
+	size_t size;                   ///< The size of the memory or mapping holding the image
+	uint8_t *tags;                 ///< The tags of the slots
+	BitSequence *digests;          ///< The digests of the slots
+	uint64_t *values;              ///< The values of the slots
+	size_t groupMask;              ///< The number of groups minus 1
+	size_t count;                  ///< The number of entries
+	size_t maxEntries;             ///< The number of entries the index can hold
+	int mapped;                    ///< Whether the index is mapped from a file
+	int writable;                  ///< Whether the index may be inserted into
+};
+
+#if defined(__SSE2__)
+	typedef unsigned SWIFFT_indexMask_t;    ///< A mask of the slots of a group, of bits per slot
+	#define SWIFFT_INDEX_MASK_LOG2_BITS 0   ///< The log2 of the number of bits per slot of a mask
+#elif defined(__ARM_NEON)
+	typedef uint64_t SWIFFT_indexMask_t;
+	#define SWIFFT_INDEX_MASK_LOG2_BITS 2
+#else
+	typedef unsigned SWIFFT_indexMask_t;
+	#define SWIFFT_INDEX_MASK_LOG2_BITS 0
+#endif
+
+//! \brief Matches a tag against the tags of a group.
+//!
+//! \param[in] group the tags of the group, aligned to their size.
+//! \param[in] tag the tag, or 0 to match the empty slots.
+//! \returns the mask of the slots whose tags match, with one bit set per slot.
+static inline SWIFFT_indexMask_t SWIFFT_indexMatch(const uint8_t *group, uint8_t tag)
+{
+#if defined(__SSE2__)
+	__m128i tags = _mm_load_si128((const __m128i *)group);
+	return (SWIFFT_indexMask_t)_mm_movemask_epi8(_mm_cmpeq_epi8(tags, _mm_set1_epi8((char)tag)));
+#elif defined(__ARM_NEON)
+	// narrowing the comparison gives a nibble per slot, of which one bit is kept
+	uint8x16_t eq = vceqq_u8(vld1q_u8(group), vdupq_n_u8(tag));
+	uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+	return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & 0x8888888888888888ULL;
+#else
+	SWIFFT_indexMask_t mask = 0;
+	int i;
+	for (i=0; i<SWIFFT_INDEX_GROUP_SLOTS; i++) {
+		mask |= (SWIFFT_indexMask_t)(group[i] == tag) << i;
+	}
+	return mask;
+#endif
+}
+
+//! \brief Returns the first slot of a non-empty mask.
+static inline size_t SWIFFT_indexFirst(SWIFFT_indexMask_t mask)
+{
+#if defined(__GNUC__)
+	return (size_t)__builtin_ctzll(mask) >> SWIFFT_INDEX_MASK_LOG2_BITS;
+#else
+	size_t i = 0;
+	while (!(mask & 1)) {
+		mask >>= 1;
+		i++;
+	}
+	return i >> SWIFFT_INDEX_MASK_LOG2_BITS;
+#endif
+}
+
+//! \brief Hashes a compact digest, mixing all of its words.
+static inline uint64_t SWIFFT_indexHash(const BitSequence *digest)
+{
+	uint64_t w[SWIFFT_COMPACT_BLOCK_SIZE / sizeof(uint64_t)];
+	uint64_t h;
+	memcpy(w, digest, sizeof(w));
+	h = (w[0] ^ w[4]) * 0x9e3779b97f4a7c15ULL + (w[1] ^ w[5]) * 0xc2b2ae3d27d4eb4fULL
+		+ (w[2] ^ w[6]) * 0x165667b19e3779f9ULL + (w[3] ^ w[7]) * 0xd6e8feb86659fd93ULL;
+	return h ^ (h >> 32);
+}
+
+//! \brief Returns the tag of a hash, with its top bit set.
+static inline uint8_t SWIFFT_indexTag(uint64_t h)
+{
+	return (uint8_t)(0x80 | (h >> 57));
+}
+
+//! \brief Probes an index for a digest.
+//!
+//! \param[in] index the index.
+//! \param[in] digest the compact digest.
+//! \param[in] h the hash of the digest.
+//! \param[out] found whether the digest is in the index.
+//! \returns the slot of the digest if found, or else the empty slot it would be inserted at,
+//! or SIZE_MAX if no group has an empty slot.
+static inline size_t SWIFFT_indexFind(const swifft_index_t *index, const BitSequence *digest, uint64_t h, int *found)
+{
+	uint8_t tag = SWIFFT_indexTag(h);
+	size_t g = h & index->groupMask;
+	size_t step;
+	SWIFFT_indexMask_t mask;
+	const uint8_t *group;
+	size_t slot;
+
+	for (step=0; step<=index->groupMask; ) {
+		group = index->tags + g * SWIFFT_INDEX_GROUP_SLOTS;
+		for (mask = SWIFFT_indexMatch(group, tag); mask; mask &= mask - 1) {
+			slot = g * SWIFFT_INDEX_GROUP_SLOTS + SWIFFT_indexFirst(mask);
+			if (memcmp(index->digests + slot * SWIFFT_COMPACT_BLOCK_SIZE, digest, SWIFFT_COMPACT_BLOCK_SIZE) == 0) {
+				*found = 1;
+				return slot;
+			}
+		}
+		mask = SWIFFT_indexMatch(group, 0);
+		if (mask) {
+			*found = 0;
+			return g * SWIFFT_INDEX_GROUP_SLOTS + SWIFFT_indexFirst(mask);
+		}
+		// triangular steps visit every group of a power-of-2 number of groups
+		g = (g + ++step) & index->groupMask;
+	}
+	*found = 0;
+	return SIZE_MAX;
+}
+
+//! \brief Hashes the digests of a window of a batch and prefetches what probing for them reads first.
+//!
+//! \param[in] index the index.
+//! \param[in] n the number of digests of the window, up to SWIFFT_INDEX_WINDOW.
+//! \param[in] compact the compact digests of the window.
+//! \param[out] h the hashes of the digests.
+//! \param[in] values whether to prefetch the values of the slots too.
+static inline void SWIFFT_indexPrefetch(const swifft_index_t *index, size_t n, const BitSequence *compact,
+	uint64_t h[SWIFFT_INDEX_WINDOW], int values)
+{
+	size_t j, slot;
+	SWIFFT_indexMask_t mask;
+	const uint8_t *group;
+
+	for (j=0; j<n; j++) {
+		h[j] = SWIFFT_indexHash(compact + j * SWIFFT_COMPACT_BLOCK_SIZE);
+		SWIFFT_INDEX_PREFETCH(index->tags + (h[j] & index->groupMask) * SWIFFT_INDEX_GROUP_SLOTS);
+	}
+	for (j=0; j<n; j++) {
+		group = index->tags + (h[j] & index->groupMask) * SWIFFT_INDEX_GROUP_SLOTS;
+		mask = SWIFFT_indexMatch(group, SWIFFT_indexTag(h[j]));
+		if (mask) {
+			slot = (h[j] & index->groupMask) * SWIFFT_INDEX_GROUP_SLOTS + SWIFFT_indexFirst(mask);
+			SWIFFT_INDEX_PREFETCH(index->digests + slot * SWIFFT_COMPACT_BLOCK_SIZE);
+			if (values) {
+				SWIFFT_INDEX_PREFETCH(index->values + slot);
+			}
+		}
+	}
+}
+
+//! \brief Computes the number of slots of an index holding a number of entries at a load of up to 7/8.
+//!
+//! \param[in] maxEntries the number of entries.
+//! \returns the number of slots, or 0 if it overflows.
+static size_t SWIFFT_indexCapacity(size_t maxEntries)
+{
+	size_t capacity = SWIFFT_INDEX_GROUP_SLOTS;
+	while (capacity / 8 * 7 < maxEntries) {
+		if (capacity > SIZE_MAX / (4 * SWIFFT_COMPACT_BLOCK_SIZE)) {
+			return 0;
+		}
+		capacity *= 2;
+	}
+	return capacity;
+}
+
+//! \brief Rounds a size up to a multiple of SWIFFT_INDEX_PAGE_SIZE.
+static inline uint64_t SWIFFT_indexPageAlign(uint64_t size)
+{
+	return (size + SWIFFT_INDEX_PAGE_SIZE - 1) & ~(uint64_t)(SWIFFT_INDEX_PAGE_SIZE - 1);
+}
+
+//! \brief Lays out the header of an empty index.
+//!
+//! \param[out] header the header.
+//! \param[in] capacity the number of slots.
+//! \param[in] maxEntries the number of entries the index can hold.
+static void SWIFFT_indexLayout(swifft_index_header_t *header, uint64_t capacity, uint64_t maxEntries)
+{
+	memset(header, 0, sizeof(*header));
+	memcpy(header->magic, SWIFFT_INDEX_MAGIC, sizeof(header->magic));
+	header->byteOrder = SWIFFT_INDEX_BYTE_ORDER;
+	header->version = SWIFFT_INDEX_VERSION;
+	header->digestSize = SWIFFT_COMPACT_BLOCK_SIZE;
+	header->capacity = capacity;
+	header->maxEntries = maxEntries;
+	header->tagsOffset = SWIFFT_INDEX_PAGE_SIZE;
+	header->digestsOffset = SWIFFT_indexPageAlign(header->tagsOffset + capacity);
+	header->valuesOffset = SWIFFT_indexPageAlign(header->digestsOffset + capacity * SWIFFT_COMPACT_BLOCK_SIZE);
+	header->size = SWIFFT_indexPageAlign(header->valuesOffset + capacity * sizeof(uint64_t));
+}
+
+//! \brief Creates the handle of an index given its image.
+//!
+//! \param[in] header the image of the index.
+//! \param[in] size the size of the memory or mapping holding the image.
+//! \param[in] count the number of entries.
+//! \param[in] mapped whether the image is mapped from a file.
+//! \param[in] writable whether the index may be inserted into.
+//! \returns the index, or NULL if memory is exhausted.
+static swifft_index_t *SWIFFT_indexNew(swifft_index_header_t *header, size_t size, size_t count, int mapped, int writable)
+{
+	swifft_index_t *index = (swifft_index_t *)calloc(1, sizeof(swifft_index_t));
+	if (index == NULL) {
+		return NULL;
+	}
+	index->header = header;
+	index->size = size;
+	index->tags = (uint8_t *)header + header->tagsOffset;
+	index->digests = (BitSequence *)header + header->digestsOffset;
+	index->values = (uint64_t *)((char *)header + header->valuesOffset);
+	index->groupMask = header->capacity / SWIFFT_INDEX_GROUP_SLOTS - 1;
+	index->count = count;
+	index->maxEntries = header->maxEntries;
+	index->mapped = mapped;
+	index->writable = writable;
+	return index;
+}
+
+swifft_index_t * SWIFFT_IndexCreate(size_t maxEntries)
+{
+	size_t capacity = SWIFFT_indexCapacity(maxEntries);
+	swifft_index_header_t layout;
+	swifft_index_header_t *header;
+	swifft_index_t *index;
+
+	if (capacity == 0) {
+		return NULL;
+	}
+	SWIFFT_indexLayout(&layout, capacity, maxEntries);
+	header = (swifft_index_header_t *)SWIFFT_AllocBlocks(layout.size / SWIFFT_INDEX_PAGE_SIZE, SWIFFT_INDEX_PAGE_SIZE);
+	if (header == NULL) {
+		return NULL;
+	}
+	*header = layout;
+	if ((index = SWIFFT_indexNew(header, layout.size, 0, 0, 1)) == NULL) {
+		SWIFFT_FreeBlocks(header);
+	}
+	return index;
+}
+
+swifft_index_t * SWIFFT_IndexCreateFile(const char * path, size_t maxEntries)
+{
+#ifdef SWIFFT_INDEX_FILES
+	size_t capacity = SWIFFT_indexCapacity(maxEntries);
+	swifft_index_header_t layout;
+	swifft_index_header_t *header;
+	swifft_index_t *index;
+	int fd, err;
+
+	if (capacity == 0) {
+		errno = ENOMEM;
+		return NULL;
+	}
+	SWIFFT_indexLayout(&layout, capacity, maxEntries);
+	if ((fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0666)) < 0) {
+		return NULL;
+	}
+	// the file is extended with zeros, which are the tags of empty slots
+	if (ftruncate(fd, (off_t)layout.size) != 0) {
+		err = errno;
+		close(fd);
+		errno = err;
+		return NULL;
+	}
+	header = (swifft_index_header_t *)mmap(NULL, layout.size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	err = errno;
+	close(fd);
+	if (header == MAP_FAILED) {
+		errno = err;
+		return NULL;
+	}
+	*header = layout;
+	if ((index = SWIFFT_indexNew(header, layout.size, 0, 1, 1)) == NULL) {
+		munmap(header, layout.size);
+		errno = ENOMEM;
+	}
+	return index;
+#else
+	(void)path;
+	(void)maxEntries;
+	errno = ENOSYS;
+	return NULL;
+#endif
+}
+
+#ifdef SWIFFT_INDEX_FILES
+//! \brief Checks that a header read from a file is of an index in the format of the host.
+//!
+//! \param[in] header the header.
+//! \param[in] fileSize the size of the file.
+//! \returns whether the header is valid.
+static int SWIFFT_indexCheck(const swifft_index_header_t *header, uint64_t fileSize)
+{
+	swifft_index_header_t layout;
+	size_t capacity = SWIFFT_indexCapacity(header->maxEntries);
+	if (memcmp(header->magic, SWIFFT_INDEX_MAGIC, sizeof(header->magic)) != 0
+		|| header->byteOrder != SWIFFT_INDEX_BYTE_ORDER
+		|| header->version != SWIFFT_INDEX_VERSION
+		|| header->digestSize != SWIFFT_COMPACT_BLOCK_SIZE
+		|| header->capacity > SIZE_MAX / (4 * SWIFFT_COMPACT_BLOCK_SIZE)
+		|| capacity == 0 || capacity > header->capacity
+		|| header->capacity < SWIFFT_INDEX_GROUP_SLOTS
+		|| (header->capacity & (header->capacity - 1)) != 0) {
+		return 0;
+	}
+	SWIFFT_indexLayout(&layout, header->capacity, header->maxEntries);
+	return header->tagsOffset == layout.tagsOffset && header->digestsOffset == layout.digestsOffset
+		&& header->valuesOffset == layout.valuesOffset && header->size == layout.size && layout.size <= fileSize;
+}
+#endif
+
+swifft_index_t * SWIFFT_IndexOpenFile(const char * path, int writable)
+{
+#ifdef SWIFFT_INDEX_FILES
+	swifft_index_header_t *header;
+	swifft_index_t *index;
+	struct stat st;
+	size_t size, count, i;
+	uint8_t tag;
+	int fd, err, invalid, flags = MAP_SHARED;
+
+	if ((fd = open(path, writable ? O_RDWR : O_RDONLY)) < 0) {
+		return NULL;
+	}
+	if (fstat(fd, &st) != 0) {
+		err = errno;
+		close(fd);
+		errno = err;
+		return NULL;
+	}
+	if (st.st_size < SWIFFT_INDEX_PAGE_SIZE) {
+		close(fd);
+		errno = EINVAL;
+		return NULL;
+	}
+	size = (size_t)st.st_size;
+#ifdef MAP_POPULATE
+	// faulting the index in when opened keeps the first probes from doing so
+	flags |= MAP_POPULATE;
+#endif
+	header = (swifft_index_header_t *)mmap(NULL, size, PROT_READ | (writable ? PROT_WRITE : 0), flags, fd, 0);
+	err = errno;
+	close(fd);
+	if (header == MAP_FAILED) {
+		errno = err;
+		return NULL;
+	}
+	if (!SWIFFT_indexCheck(header, size)) {
+		munmap(header, size);
+		errno = EINVAL;
+		return NULL;
+	}
+	// the entries are counted from the tags, which are valid even if the count was not written back,
+	// and a tag that is neither empty nor full marks a damaged file
+	count = 0;
+	invalid = 0;
+	for (i=0; i<header->capacity; i++) {
+		tag = ((const uint8_t *)header + header->tagsOffset)[i];
+		count += tag >> 7;
+		invalid |= tag != 0 && !(tag >> 7);
+	}
+	if (invalid || count > header->maxEntries || count >= header->capacity) {
+		munmap(header, size);
+		errno = EINVAL;
+		return NULL;
+	}
+	if ((index = SWIFFT_indexNew(header, size, count, 1, writable)) == NULL) {
+		munmap(header, size);
+		errno = ENOMEM;
+		return NULL;
+	}
+	if (writable) {
+		header->count = count;
+	}
+	return index;
+#else
+	(void)path;
+	(void)writable;
+	errno = ENOSYS;
+	return NULL;
+#endif
+}
+
+int SWIFFT_IndexInsertMultiple(swifft_index_t * index, size_t nblocks, const BitSequence * compact,
+	const uint64_t * values, uint64_t * stored)
+{
+	uint64_t h[SWIFFT_INDEX_WINDOW];
+	const BitSequence *digest;
+	size_t i, j, n, slot;
+	int found, result = 0;
+
+	if (!index->writable) {
+		return -1;
+	}
+	for (i=0; i<nblocks && result == 0; i+=n) {
+		n = nblocks - i < SWIFFT_INDEX_WINDOW ? nblocks - i : SWIFFT_INDEX_WINDOW;
+		SWIFFT_indexPrefetch(index, n, compact + i * SWIFFT_COMPACT_BLOCK_SIZE, h, stored != NULL);
+		for (j=0; j<n; j++) {
+			digest = compact + (i+j) * SWIFFT_COMPACT_BLOCK_SIZE;
+			slot = SWIFFT_indexFind(index, digest, h[j], &found);
+			if (!found) {
+				if (index->count >= index->maxEntries || slot == SIZE_MAX) {
+					result = -1;
+					break;
+				}
+				// the tag is set last, so it never marks a slot whose digest is not there yet
+				memcpy(index->digests + slot * SWIFFT_COMPACT_BLOCK_SIZE, digest, SWIFFT_COMPACT_BLOCK_SIZE);
+				index->values[slot] = values[i+j];
+				index->tags[slot] = SWIFFT_indexTag(h[j]);
+				index->count++;
+			}
+			if (stored) {
+				stored[i+j] = index->values[slot];
+			}
+		}
+	}
+	index->header->count = index->count;
+	return result;
+}
+
+int SWIFFT_IndexComputeInsertMultiple(swifft_index_t * index, size_t nblocks, const BitSequence * input,
+	BitSequence * compact, const uint64_t * values, uint64_t * stored)
+{
+	BitSequence *tile = NULL;
+	BitSequence *digests;
+	size_t i, n;
+	int result = 0;
+
+	if (!index->writable) {
+		return -1;
+	}
+	if (compact == NULL && nblocks > 0) {
+		n = nblocks < SWIFFT_INDEX_TILE_BLOCKS ? nblocks : SWIFFT_INDEX_TILE_BLOCKS;
+		if ((tile = (BitSequence *)SWIFFT_AllocBlocks(n, SWIFFT_COMPACT_BLOCK_SIZE)) == NULL) {
+			return -1;
+		}
+	}
+	for (i=0; i<nblocks && result == 0; i+=n) {
+		n = nblocks - i < SWIFFT_INDEX_TILE_BLOCKS ? nblocks - i : SWIFFT_INDEX_TILE_BLOCKS;
+		digests = compact ? compact + i * SWIFFT_COMPACT_BLOCK_SIZE : tile;
+		SWIFFT_ComputeCompactMultiple(n, input + i * SWIFFT_INPUT_BLOCK_SIZE, digests);
+		result = SWIFFT_IndexInsertMultiple(index, n, digests, values + i, stored ? stored + i : NULL);
+	}
+	SWIFFT_FreeBlocks(tile);
+	return result;
+}
+
+void SWIFFT_IndexLookupMultiple(const swifft_index_t * index, size_t nblocks, const BitSequence * compact,
+	uint64_t * values)
+{
+	uint64_t h[SWIFFT_INDEX_WINDOW];
+	size_t i, j, n, slot;
+	int found;
+
+	for (i=0; i<nblocks; i+=n) {
+		n = nblocks - i < SWIFFT_INDEX_WINDOW ? nblocks - i : SWIFFT_INDEX_WINDOW;
+		SWIFFT_indexPrefetch(index, n, compact + i * SWIFFT_COMPACT_BLOCK_SIZE, h, 1);
+		for (j=0; j<n; j++) {
+			slot = SWIFFT_indexFind(index, compact + (i+j) * SWIFFT_COMPACT_BLOCK_SIZE, h[j], &found);
+			values[i+j] = found ? index->values[slot] : SWIFFT_INDEX_NOT_FOUND;
+		}
+	}
+}
+
+size_t SWIFFT_IndexCount(const swifft_index_t * index)
+{
+	return index->count;
+}
+
+size_t SWIFFT_IndexMaxEntries(const swifft_index_t * index)
+{
+	return index->maxEntries;
+}
+
+int SWIFFT_IndexSync(swifft_index_t * index)
+{
+#ifdef SWIFFT_INDEX_FILES
+	if (index->mapped && index->writable) {
+		return msync(index->header, index->size, MS_SYNC);
+	}
+#endif
+	(void)index;
+	return 0;
+}
+
+void SWIFFT_IndexDestroy(swifft_index_t * index)
+{
+	if (index == NULL) {
+		return;
+	}
+#ifdef SWIFFT_INDEX_FILES
+	if (index->mapped) {
+		munmap(index->header, index->size);
+		free(index);
+		return;
+	}
+#endif
+	SWIFFT_FreeBlocks(index->header);
+	free(index);
+}
+
+LIBSWIFFT_END_EXTERN_C
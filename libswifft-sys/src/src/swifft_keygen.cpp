@@ -18,8 +18,12 @@
 
 //! \brief Multipliers for SWIFFT key.
 static SWIFFT_ALIGN int16_t multipliers[SWIFFT_N];
-//! \brief FFT table for SWIFFT key.
-static SWIFFT_ALIGN int16_t fftTable[SWIFFT_V*SWIFFT_V*SWIFFT_W];
+//! \brief FFT table for SWIFFT key, holding one 8-element row per byte value of unsigned input.
+//! Signed input is served by the difference of the rows of its positive bits and of its negative bits.
+static SWIFFT_ALIGN int16_t fftTable[SWIFFT_V*SWIFFT_W];
+
+//! \brief SWIFFT key, interleaved as given by SWIFFT_KEY_INDEX.
+static SWIFFT_ALIGN int16_t PI_keyInterleaved[SWIFFT_M*SWIFFT_N];
 
 //! \brief SWIFFT key.
 //! The key (A's) we use in SWIFFT shall be random elements of Z_257.
@@ -192,7 +196,7 @@ static int ReverseBits(int input, int numOfBits)
 //! \brief Initializes the key along with the related multipliers and FFT table.
 static void SWIFFT_Initialize()
 {
-	int i, j, k, w, x;
+	int i, j, k, x;
 	// The powers of OMEGA
 	int omegaPowers[2 * SWIFFT_N + 1];
 	int8_t reverseBits[SWIFFT_N];
@@ -219,27 +223,34 @@ static void SWIFFT_Initialize()
 		reverseBits[i] = ReverseBits(i,SWIFFT_W);
 	}
 
-	for (w = 0; w < SWIFFT_V; w++)
+	for (x = 0; x < SWIFFT_V; ++x)
 	{
-		for (x = 0; x < SWIFFT_V; ++x)
+		for (j = 0; j < SWIFFT_N/8; ++j)
 		{
-			for (j = 0; j < SWIFFT_N/8; ++j)
+			int temp = 0;
+			for (k = 0; k < SWIFFT_LOG2_V; ++k)
 			{
-				int temp = 0;
-				for (k = 0; k < SWIFFT_LOG2_V; ++k)
-				{
-					int value = omegaPowers[((SWIFFT_N/8) * (2 * j + 1) * reverseBits[k]) % (2 * SWIFFT_N)] * ((x >> k) & 1);
-					temp += ((w >> k) & 1) == 0 ? value : - value;
-				}
-
-				fftTable[(SWIFFT_INT16(w,x) << SWIFFT_LOG2_W) + j] = Center(temp);
+				temp += omegaPowers[((SWIFFT_N/8) * (2 * j + 1) * reverseBits[k]) % (2 * SWIFFT_N)] * ((x >> k) & 1);
 			}
+
+			fftTable[(x << SWIFFT_LOG2_W) + j] = Center(temp);
 		}
 	}
 
 	for (j=0; j<SWIFFT_N*SWIFFT_M; j++) {
 		PI_key[j] = Center(PI_key[j]);
 	}
+
+	for (i = 0; i < SWIFFT_M; ++i)
+	{
+		for (k = 0; k < SWIFFT_N/SWIFFT_W; ++k)
+		{
+			for (j = 0; j < SWIFFT_W; ++j)
+			{
+				PI_keyInterleaved[(SWIFFT_KEY_INDEX(i,k) << SWIFFT_LOG2_W) + j] = PI_key[(((i << SWIFFT_LOG2_W) + k) << SWIFFT_LOG2_W) + j];
+			}
+		}
+	}
 }
 
 
@@ -281,8 +292,10 @@ int main(int argc, char **argv)
 	out << std::endl;
 	writeArray(out, multipliers, SWIFFT_N, "multipliers[SWIFFT_N]");
 	out << std::endl;
-	writeArray(out, fftTable, SWIFFT_V*SWIFFT_V*SWIFFT_W, "fftTable[SWIFFT_V*SWIFFT_V*SWIFFT_W]");
+	writeArray(out, fftTable, SWIFFT_V*SWIFFT_W, "fftTable[SWIFFT_V*SWIFFT_W]");
 	out << std::endl;
 	writeArray(out, PI_key, SWIFFT_M*SWIFFT_N, "PI_key[SWIFFT_M*SWIFFT_N]");
+	out << std::endl;
+	writeArray(out, PI_keyInterleaved, SWIFFT_M*SWIFFT_N, "PI_keyInterleaved[SWIFFT_M*SWIFFT_N]");
 	return 0;
 }
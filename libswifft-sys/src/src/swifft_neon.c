@@ -0,0 +1,19 @@
+/*
+ * Copyright (C) 2021 Yaron Gvili and Gvili Tech Ltd.
+ *
+ * See the accompanying LICENSE.txt file for licensing information.
+ */
+/*! \file src/swifft_neon.c
+ * \brief LibSWIFFT public C implementation for NEON
+ *
+ * See "src/swifft.inl" for code expanded here with SWIFFT_ISET set to NEON.
+ */
+#include "common.h"
+
+#if defined(__ARM_NEON)
+	#include "swifft_neon.h"
+	#define SWIFFT_LOG2_O 0
+	#include "swifft.inl"
+#elif defined(__aarch64__)
+        #pragma message "Disabling generation of LibSWIFFT API for NEON"
+#endif
@@ -6,16 +6,17 @@
 /*! \file src/swifft_object.c
  * \brief LibSWIFFT object public C implementation
  *
- * Implementation using the best instruction set available at build time.
+ * Implementation of objects for each instruction set built into the library.
  */
 
 #include "swifft_object.h"
 #include "swifft.h"
+#include "swifft_impl.inl"
 
 #undef SWIFFT_ISET
 #include "swifft_object.inl"
 
-#if defined(__AVX__)
+#if defined(SWIFFT_HAVE_AVX)
 	#include "swifft_avx.h"
         #define SWIFFT_ISET() AVX
         #include "swifft_object.inl"
@@ -24,7 +25,7 @@
         #pragma message "LibSWIFFT API for AVX is disabled"
 #endif
 
-#if defined(__AVX2__)
+#if defined(SWIFFT_HAVE_AVX2)
 	#include "swifft_avx2.h"
         #define SWIFFT_ISET() AVX2
         #include "swifft_object.inl"
@@ -33,7 +34,7 @@
         #pragma message "LibSWIFFT API for AVX2 is disabled"
 #endif
 
-#if defined(__AVX512F__)
+#if defined(SWIFFT_HAVE_AVX512)
 	#include "swifft_avx512.h"
         #define SWIFFT_ISET() AVX512
         #include "swifft_object.inl"
@@ -41,3 +42,160 @@
 #else
         #pragma message "LibSWIFFT API for AVX512 is disabled"
 #endif
+
+#if defined(SWIFFT_HAVE_AVX512BW)
+	#include "swifft_avx512bw.h"
+        #define SWIFFT_ISET() AVX512BW
+        #include "swifft_object.inl"
+        #undef SWIFFT_ISET
+#else
+        #pragma message "LibSWIFFT API for AVX512BW is disabled"
+#endif
+
+#if defined(SWIFFT_HAVE_NEON)
+	#include "swifft_neon.h"
+        #define SWIFFT_ISET() NEON
+        #include "swifft_object.inl"
+        #undef SWIFFT_ISET
+#endif
+
+#if defined(SWIFFT_HAVE_SVE2)
+	#include "swifft_sve2.h"
+        #define SWIFFT_ISET() SVE2
+        #include "swifft_object.inl"
+        #undef SWIFFT_ISET
+#endif
+
+#include <string.h> // for strcmp
+
+#if defined(SWIFFT_HAVE_SVE2)
+	#include <sys/auxv.h> // for getauxval
+	#ifndef HWCAP2_SVE2
+		#define HWCAP2_SVE2 (1 << 1)
+	#endif
+#endif
+
+LIBSWIFFT_BEGIN_EXTERN_C
+
+//! \brief Returns the name of the best instruction set supported by the running CPU.
+//! AVX512 without AVX512BW splits 16-bit vector operations and is slower than
+//! AVX2, so it is preferred only over AVX. AVX is the minimum requirement of
+//! the library, so it is the fallback. On AArch64, SVE2 is preferred when the
+//! kernel reports it, and NEON, which every AArch64 CPU has, is the fallback.
+//!
+//! \returns the instruction-set name.
+const char * SWIFFT_BestInstructionSet(void)
+{
+#if defined(SWIFFT_HAVE_SVE2)
+	if (getauxval(AT_HWCAP2) & HWCAP2_SVE2) {
+		return "SVE2";
+	}
+#endif
+#if defined(SWIFFT_HAVE_NEON)
+	return "NEON";
+#else
+	__builtin_cpu_init();
+#if defined(SWIFFT_HAVE_AVX512BW)
+	if (__builtin_cpu_supports("avx512bw")) {
+		return "AVX512BW";
+	}
+#endif
+#if defined(SWIFFT_HAVE_AVX2)
+	if (__builtin_cpu_supports("avx2")) {
+		return "AVX2";
+	}
+#endif
+#if defined(SWIFFT_HAVE_AVX512)
+	if (__builtin_cpu_supports("avx512f")) {
+		return "AVX512";
+	}
+#endif
+	return "AVX";
+#endif
+}
+
+//! \brief Initializes a SWIFFT object with the best instruction set supported by the running CPU.
+//!
+//! \param[out] swifft the SWIFFT object to initialize.
+void SWIFFT_InitBestObject(swifft_object_t *swifft)
+{
+#if defined(SWIFFT_HAVE_SVE2)
+	if (getauxval(AT_HWCAP2) & HWCAP2_SVE2) {
+		SWIFFT_InitObject_SVE2(swifft);
+		return;
+	}
+#endif
+#if defined(SWIFFT_HAVE_NEON)
+	SWIFFT_InitObject_NEON(swifft);
+#else
+	__builtin_cpu_init();
+#if defined(SWIFFT_HAVE_AVX512BW)
+	if (__builtin_cpu_supports("avx512bw")) {
+		SWIFFT_InitObject_AVX512BW(swifft);
+		return;
+	}
+#endif
+#if defined(SWIFFT_HAVE_AVX2)
+	if (__builtin_cpu_supports("avx2")) {
+		SWIFFT_InitObject_AVX2(swifft);
+		return;
+	}
+#endif
+#if defined(SWIFFT_HAVE_AVX512)
+	if (__builtin_cpu_supports("avx512f")) {
+		SWIFFT_InitObject_AVX512(swifft);
+		return;
+	}
+#endif
+	SWIFFT_InitObject_AVX(swifft);
+#endif
+}
+
+//! \brief Initializes a SWIFFT object with a named instruction set, if built into the library and supported by the running CPU.
+//!
+//! \param[out] swifft the SWIFFT object to initialize.
+//! \param[in] iset the instruction-set name, such as "AVX2".
+//! \returns the instruction-set name, as a static string, or NULL if the instruction set is unavailable.
+const char * SWIFFT_InitObjectByName(swifft_object_t *swifft, const char *iset)
+{
+#if defined(SWIFFT_HAVE_SVE2)
+	if (strcmp(iset, "SVE2") == 0 && (getauxval(AT_HWCAP2) & HWCAP2_SVE2)) {
+		SWIFFT_InitObject_SVE2(swifft);
+		return "SVE2";
+	}
+#endif
+#if defined(SWIFFT_HAVE_NEON)
+	if (strcmp(iset, "NEON") == 0) {
+		SWIFFT_InitObject_NEON(swifft);
+		return "NEON";
+	}
+#else
+	__builtin_cpu_init();
+#if defined(SWIFFT_HAVE_AVX512BW)
+	if (strcmp(iset, "AVX512BW") == 0 && __builtin_cpu_supports("avx512bw")) {
+		SWIFFT_InitObject_AVX512BW(swifft);
+		return "AVX512BW";
+	}
+#endif
+#if defined(SWIFFT_HAVE_AVX2)
+	if (strcmp(iset, "AVX2") == 0 && __builtin_cpu_supports("avx2")) {
+		SWIFFT_InitObject_AVX2(swifft);
+		return "AVX2";
+	}
+#endif
+#if defined(SWIFFT_HAVE_AVX512)
+	if (strcmp(iset, "AVX512") == 0 && __builtin_cpu_supports("avx512f")) {
+		SWIFFT_InitObject_AVX512(swifft);
+		return "AVX512";
+	}
+#endif
+	if (strcmp(iset, "AVX") == 0 && __builtin_cpu_supports("avx")) {
+		SWIFFT_InitObject_AVX(swifft);
+		return "AVX";
+	}
+#endif
+	(void)swifft;
+	return NULL;
+}
+
+LIBSWIFFT_END_EXTERN_C
@@ -13,10 +13,13 @@
 
 #undef SWIFFT_SUFFIX
 #undef SWIFFT_ISET_NAME
+#undef SWIFFT_COMPACT_NAME
 #ifndef SWIFFT_ISET
 	#define SWIFFT_SUFFIX()
+	#define SWIFFT_COMPACT_NAME SWIFFT_Compact ///< The compaction of the public API, counted in the statistics
 #else
 	#define SWIFFT_SUFFIX() LIBSWIFFT_CONCAT(_,SWIFFT_ISET())
+	#define SWIFFT_COMPACT_NAME SWIFFT_compact ///< The compaction shared by the instruction sets
 #endif
 #define SWIFFT_ISET_NAME(name) LIBSWIFFT_CONCAT(name,SWIFFT_SUFFIX()) ///< Adds a suffix based on SWIFFT_ISET, a macro which must be defined prior to including
 
@@ -41,6 +44,10 @@ void SWIFFT_ISET_NAME(SWIFFT_InitArithObject)(swifft_arith_object_t *swifft_arit
 	swifft_arith->SWIFFT_Add = SWIFFT_ISET_NAME(SWIFFT_Add);
 	swifft_arith->SWIFFT_Sub = SWIFFT_ISET_NAME(SWIFFT_Sub);
 	swifft_arith->SWIFFT_Mul = SWIFFT_ISET_NAME(SWIFFT_Mul);
+	swifft_arith->SWIFFT_AccumulatorInit = SWIFFT_ISET_NAME(SWIFFT_AccumulatorInit);
+	swifft_arith->SWIFFT_AccumulatorAdd = SWIFFT_ISET_NAME(SWIFFT_AccumulatorAdd);
+	swifft_arith->SWIFFT_AccumulatorSub = SWIFFT_ISET_NAME(SWIFFT_AccumulatorSub);
+	swifft_arith->SWIFFT_Reduce = SWIFFT_ISET_NAME(SWIFFT_Reduce);
 	swifft_arith->SWIFFT_ConstSetMultiple = SWIFFT_ISET_NAME(SWIFFT_ConstSetMultiple);
 	swifft_arith->SWIFFT_ConstAddMultiple = SWIFFT_ISET_NAME(SWIFFT_ConstAddMultiple);
 	swifft_arith->SWIFFT_ConstSubMultiple = SWIFFT_ISET_NAME(SWIFFT_ConstSubMultiple);
@@ -49,16 +56,34 @@ void SWIFFT_ISET_NAME(SWIFFT_InitArithObject)(swifft_arith_object_t *swifft_arit
 	swifft_arith->SWIFFT_AddMultiple = SWIFFT_ISET_NAME(SWIFFT_AddMultiple);
 	swifft_arith->SWIFFT_SubMultiple = SWIFFT_ISET_NAME(SWIFFT_SubMultiple);
 	swifft_arith->SWIFFT_MulMultiple = SWIFFT_ISET_NAME(SWIFFT_MulMultiple);
+	swifft_arith->SWIFFT_SumMultiple = SWIFFT_ISET_NAME(SWIFFT_SumMultiple);
+	swifft_arith->SWIFFT_LinearCombination = SWIFFT_ISET_NAME(SWIFFT_LinearCombination);
+	swifft_arith->SWIFFT_EvalMultiple = SWIFFT_ISET_NAME(SWIFFT_EvalMultiple);
 }
 
 void SWIFFT_ISET_NAME(SWIFFT_InitHashObject)(swifft_hash_object_t *swifft_hash)
 {
-	swifft_hash->SWIFFT_Compact = SWIFFT_Compact;
+	swifft_hash->SWIFFT_Compact = SWIFFT_COMPACT_NAME;
 	swifft_hash->SWIFFT_Compute = SWIFFT_ISET_NAME(SWIFFT_Compute);
 	swifft_hash->SWIFFT_ComputeSigned = SWIFFT_ISET_NAME(SWIFFT_ComputeSigned);
 	swifft_hash->SWIFFT_CompactMultiple = SWIFFT_ISET_NAME(SWIFFT_CompactMultiple);
 	swifft_hash->SWIFFT_ComputeMultiple = SWIFFT_ISET_NAME(SWIFFT_ComputeMultiple);
 	swifft_hash->SWIFFT_ComputeMultipleSigned = SWIFFT_ISET_NAME(SWIFFT_ComputeMultipleSigned);
+	swifft_hash->SWIFFT_ComputeCompactMultiple = SWIFFT_ISET_NAME(SWIFFT_ComputeCompactMultiple);
+	swifft_hash->SWIFFT_Update = SWIFFT_ISET_NAME(SWIFFT_Update);
+	swifft_hash->SWIFFT_UpdateMultiple = SWIFFT_ISET_NAME(SWIFFT_UpdateMultiple);
+	swifft_hash->SWIFFT_InitKey = SWIFFT_InitKey;
+	swifft_hash->SWIFFT_ComputeKeyed = SWIFFT_ISET_NAME(SWIFFT_ComputeKeyed);
+	swifft_hash->SWIFFT_ComputeSignedKeyed = SWIFFT_ISET_NAME(SWIFFT_ComputeSignedKeyed);
+	swifft_hash->SWIFFT_ComputeMultipleKeyed = SWIFFT_ISET_NAME(SWIFFT_ComputeMultipleKeyed);
+	swifft_hash->SWIFFT_ComputeMultipleSignedKeyed = SWIFFT_ISET_NAME(SWIFFT_ComputeMultipleSignedKeyed);
+	swifft_hash->SWIFFT_ComputeSignedPacked = SWIFFT_ISET_NAME(SWIFFT_ComputeSignedPacked);
+	swifft_hash->SWIFFT_ComputeMultipleSignedPacked = SWIFFT_ISET_NAME(SWIFFT_ComputeMultipleSignedPacked);
+	swifft_hash->SWIFFT_ComputeMultiKey = SWIFFT_ISET_NAME(SWIFFT_ComputeMultiKey);
+	swifft_hash->SWIFFT_ComputeShort = SWIFFT_ISET_NAME(SWIFFT_ComputeShort);
+	swifft_hash->SWIFFT_ComputeSignedShort = SWIFFT_ISET_NAME(SWIFFT_ComputeSignedShort);
+	swifft_hash->SWIFFT_ComputeMultipleShort = SWIFFT_ISET_NAME(SWIFFT_ComputeMultipleShort);
+	swifft_hash->SWIFFT_ComputeMultipleSignedShort = SWIFFT_ISET_NAME(SWIFFT_ComputeMultipleSignedShort);
 }
 
 void SWIFFT_ISET_NAME(SWIFFT_InitObject)(swifft_object_t *swifft)
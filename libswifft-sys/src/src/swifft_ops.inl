@@ -64,6 +64,15 @@ static inline ZOvec SWIFFT_qReduce(ZOvec x) // (x mod 256) - floor(x/256)
 	return (x & ZO_255) - (x >> ZO_8);
 }
 
+//! \brief Centers a SWIFFT vector element-wise mod-257 from the range {-2*128,..,2*128} to {-128,..,128}
+//! \param[in] x the SWIFFT vector.
+//! \returns the centered SWIFFT vector.
+static inline ZOvec SWIFFT_center(ZOvec x)
+{
+	ZOvec ZO_128 = ZOCONST(128), ZO_M128 = ZOCONST(-128), ZO_257 = ZOCONST(257);
+	return x - ((x > ZO_128) & ZO_257) + ((x < ZO_M128) & ZO_257); // inequality returns ~0
+}
+
 //! \brief Reduces a SWIFFT vector element-wise mod-257 to the range {0,..,SWIFFT_P-1}
 //! \param[in] x the SWIFFT vector.
 //! \returns the reduced SWIFFT vector.
@@ -0,0 +1,505 @@
+/*
+ * Copyright (C) 2021 Yaron Gvili and Gvili Tech Ltd.
+ *
+ * See the accompanying LICENSE.txt file for licensing information.
+ */
+/*! \file src/swifft_pool.c
+ * \brief LibSWIFFT public C implementation for parallelizing operations on multiple blocks
+ *
+ * The native pool keeps its worker threads alive between operations. An
+ * operation splits its blocks into chunks of a grain of blocks and deals out
+ * contiguous runs of chunks, one per thread, including the calling thread.
+ * Each thread claims chunks from its own run first and then steals chunks from
+ * the runs of other threads, so a preempted or slow thread does not stall the
+ * operation the way a static schedule does.
+ */
+
+#include <stddef.h> // for NULL, size_t
+#include <stdint.h> // for intptr_t
+#include "swifft_pool.h"
+#include "swifft_stats.inl"
+
+#ifdef SWIFFT_ENABLE_THREAD_POOL
+	#include <pthread.h>
+	#include <stdatomic.h>
+	#include <stdlib.h> // for malloc
+	#include <unistd.h> // for sysconf
+#endif
+
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
+
+#ifndef SWIFFT_BLOCKS_PARALLELIZATION_THRESHOLD
+	//! \brief Maximum number of blocks that operations run on the calling thread alone
+	#define SWIFFT_BLOCKS_PARALLELIZATION_THRESHOLD 8
+#endif
+
+#define SWIFFT_DEFAULT_GRAIN 64    ///< Default maximum number of blocks per range
+#define SWIFFT_GROUP_BLOCKS 4      ///< Number of blocks of a group for the widest instruction set
+#define SWIFFT_MAX_THREADS 256     ///< Maximum number of threads of the native pool
+
+
+LIBSWIFFT_BEGIN_EXTERN_C
+
+#if defined(SWIFFT_ENABLE_THREAD_POOL) || defined(_OPENMP)
+//! \brief Returns the number of blocks per range for running a task on threads, at most the grain.
+//! Tasks of few blocks get shorter ranges, so each thread still gets a few to balance.
+//!
+//! \param[in] nblocks the number of blocks of the task.
+//! \param[in] grain the maximum number of blocks per range.
+//! \param[in] nthreads the number of threads.
+//! \param[in] align the power of 2 that the shortened number of blocks per range is a multiple of.
+//! \returns the number of blocks per range.
+static int SWIFFT_rangeBlocks(size_t nblocks, int grain, int nthreads, int align)
+{
+	size_t blocks = (nblocks + 4*nthreads - 1) / (4*nthreads);
+	blocks = (blocks + align - 1) & ~(size_t)(align - 1);
+	return blocks < (size_t)grain ? (int)blocks : grain;
+}
+#endif
+
+//! \brief Runs a task on all its blocks on the calling thread alone.
+//!
+//! \param[in] nblocks the number of blocks of the task.
+//! \param[in] taskfn the function running the task on a range of blocks.
+//! \param[in] task the task.
+static void SWIFFT_runSerial(size_t nblocks, swifft_task_fn taskfn, void *task)
+{
+	if (SWIFFT_STATS_ON()) {
+		SWIFFT_statsRun(SWIFFT_STATS_RUN_SERIAL, 0, 0, 0, 0);
+	}
+	taskfn(task, 0, nblocks);
+}
+
+#ifdef SWIFFT_ENABLE_THREAD_POOL
+//! \brief A run of chunks dealt out to a thread, on its own cache line.
+typedef struct {
+	_Alignas(64) atomic_size_t next; ///< The next chunk to claim
+	size_t end;                      ///< The chunk past the last one of the run
+	uint64_t busy;                   ///< The busy time of the thread of the run, when statistics are being collected
+} swifft_run_t;
+
+//! \brief The native pool of threads and its current operation.
+static struct {
+	pthread_mutex_t mutex;       ///< Guards the operation and shutdown fields below
+	pthread_cond_t wake;         ///< Signals the workers that an operation or a shutdown started
+	pthread_cond_t done;         ///< Signals the calling thread that the workers are done
+	pthread_mutex_t busy;        ///< Held while an operation runs or the pool is resized
+	pthread_t *workers;          ///< The worker threads
+	int nthreads;                ///< The number of threads, including the calling thread
+	int shutdown;                ///< Whether the workers should exit
+	unsigned generation;         ///< The number of operations started so far
+	unsigned spawned;            ///< The number of operations started before the workers were
+	int pending;                 ///< The number of workers not yet done with the operation
+	swifft_task_fn taskfn;       ///< The function of the operation
+	void *task;                  ///< The task of the operation
+	size_t nblocks;              ///< The number of blocks of the operation
+	int grain;                   ///< The number of blocks per chunk of the operation
+	int stats;                   ///< Whether statistics are being collected for the operation
+	swifft_run_t runs[SWIFFT_MAX_THREADS]; ///< The runs of chunks of the operation, one per thread
+} SWIFFT_pool = {
+	.mutex = PTHREAD_MUTEX_INITIALIZER,
+	.wake = PTHREAD_COND_INITIALIZER,
+	.done = PTHREAD_COND_INITIALIZER,
+	.busy = PTHREAD_MUTEX_INITIALIZER,
+	.nthreads = 1,
+};
+
+//! \brief Runs the chunks of the current operation, own run first and then stealing from others.
+//!
+//! \param[in] self the index of the running thread.
+static void SWIFFT_runChunks(int self)
+{
+	int nthreads = SWIFFT_pool.nthreads;
+	size_t nblocks = SWIFFT_pool.nblocks;
+	int grain = SWIFFT_pool.grain;
+	int stats = SWIFFT_pool.stats;
+	uint64_t start = stats ? SWIFFT_statsNow() : 0;
+	size_t blocks = 0;
+	int t;
+	for (t=0; t<nthreads; t++) {
+		swifft_run_t *run = &SWIFFT_pool.runs[(self + t) % nthreads];
+		size_t c;
+		while ((c = atomic_fetch_add_explicit(&run->next, 1, memory_order_relaxed)) < run->end) {
+			size_t begin = c * grain;
+			size_t end = begin + grain < nblocks ? begin + grain : nblocks;
+			SWIFFT_pool.taskfn(SWIFFT_pool.task, begin, end);
+			blocks += end - begin;
+		}
+	}
+	if (stats) {
+		// read by the calling thread once the operation is done
+		SWIFFT_pool.runs[self].busy = SWIFFT_statsNow() - start;
+		SWIFFT_statsThread(self, blocks, SWIFFT_pool.runs[self].busy);
+	}
+}
+
+//! \brief Runs the operations of the native pool on a worker thread until shutdown.
+//!
+//! \param[in] arg the index of the worker thread, from 1.
+//! \returns NULL.
+static void *SWIFFT_worker(void *arg)
+{
+	int self = (int)(intptr_t)arg;
+	unsigned seen;
+	pthread_mutex_lock(&SWIFFT_pool.mutex);
+	// a worker may first run after operations it should take part in started
+	seen = SWIFFT_pool.spawned;
+	for (;;) {
+		while (!SWIFFT_pool.shutdown && SWIFFT_pool.generation == seen) {
+			pthread_cond_wait(&SWIFFT_pool.wake, &SWIFFT_pool.mutex);
+		}
+		if (SWIFFT_pool.shutdown) {
+			break;
+		}
+		seen = SWIFFT_pool.generation;
+		pthread_mutex_unlock(&SWIFFT_pool.mutex);
+		SWIFFT_runChunks(self);
+		pthread_mutex_lock(&SWIFFT_pool.mutex);
+		if (--SWIFFT_pool.pending == 0) {
+			pthread_cond_signal(&SWIFFT_pool.done);
+		}
+	}
+	pthread_mutex_unlock(&SWIFFT_pool.mutex);
+	return NULL;
+}
+
+//! \brief Stops and joins the worker threads of the native pool. The busy mutex must be held.
+static void SWIFFT_stopWorkers(void)
+{
+	int nworkers = SWIFFT_pool.nthreads - 1;
+	int t;
+	pthread_mutex_lock(&SWIFFT_pool.mutex);
+	SWIFFT_pool.shutdown = 1;
+	pthread_cond_broadcast(&SWIFFT_pool.wake);
+	pthread_mutex_unlock(&SWIFFT_pool.mutex);
+	for (t=0; t<nworkers; t++) {
+		pthread_join(SWIFFT_pool.workers[t], NULL);
+	}
+	free(SWIFFT_pool.workers);
+	SWIFFT_pool.workers = NULL;
+	__atomic_store_n(&SWIFFT_pool.nthreads, 1, __ATOMIC_RELAXED);
+	SWIFFT_pool.shutdown = 0;
+}
+
+//! \brief Runs a task on the native pool, or on the calling thread alone if the pool is in use.
+//!
+//! \param[in] nblocks the number of blocks of the task.
+//! \param[in] grain the maximum number of blocks per range.
+//! \param[in] align the power of 2 that the number of blocks per range is a multiple of.
+//! \param[in] taskfn the function running the task on a range of blocks.
+//! \param[in] task the task.
+static void SWIFFT_poolRun(size_t nblocks, int grain, int align, swifft_task_fn taskfn, void *task)
+{
+	size_t nchunks;
+	uint64_t start = 0, maxBusy = 0, totalBusy = 0;
+	int nthreads, t;
+	// a nested or concurrent operation does not wait for the pool
+	if (pthread_mutex_trylock(&SWIFFT_pool.busy) != 0) {
+		SWIFFT_runSerial(nblocks, taskfn, task);
+		return;
+	}
+	nthreads = SWIFFT_pool.nthreads;
+	if (nthreads <= 1) {
+		pthread_mutex_unlock(&SWIFFT_pool.busy);
+		SWIFFT_runSerial(nblocks, taskfn, task);
+		return;
+	}
+	grain = SWIFFT_rangeBlocks(nblocks, grain, nthreads, align);
+	nchunks = (nblocks + grain - 1) / grain;
+	for (t=0; t<nthreads; t++) {
+		atomic_store_explicit(&SWIFFT_pool.runs[t].next, t * nchunks / nthreads, memory_order_relaxed);
+		SWIFFT_pool.runs[t].end = (t + 1) * nchunks / nthreads;
+	}
+	pthread_mutex_lock(&SWIFFT_pool.mutex);
+	SWIFFT_pool.taskfn = taskfn;
+	SWIFFT_pool.task = task;
+	SWIFFT_pool.nblocks = nblocks;
+	SWIFFT_pool.grain = grain;
+	SWIFFT_pool.stats = SWIFFT_STATS_ON();
+	if (SWIFFT_pool.stats) {
+		start = SWIFFT_statsNow();
+	}
+	SWIFFT_pool.pending = nthreads - 1;
+	SWIFFT_pool.generation++;
+	pthread_cond_broadcast(&SWIFFT_pool.wake);
+	pthread_mutex_unlock(&SWIFFT_pool.mutex);
+
+	SWIFFT_runChunks(0);
+
+	pthread_mutex_lock(&SWIFFT_pool.mutex);
+	while (SWIFFT_pool.pending > 0) {
+		pthread_cond_wait(&SWIFFT_pool.done, &SWIFFT_pool.mutex);
+	}
+	pthread_mutex_unlock(&SWIFFT_pool.mutex);
+	if (SWIFFT_pool.stats) {
+		for (t=0; t<nthreads; t++) {
+			uint64_t busy = SWIFFT_pool.runs[t].busy;
+			maxBusy = busy > maxBusy ? busy : maxBusy;
+			totalBusy += busy;
+		}
+		SWIFFT_statsRun(SWIFFT_STATS_RUN_PARALLEL, SWIFFT_statsNow() - start, maxBusy, totalBusy, nthreads);
+	}
+	pthread_mutex_unlock(&SWIFFT_pool.busy);
+}
+
+//! \brief Stops the native pool when the library is unloaded.
+static void __attribute__((destructor)) SWIFFT_FiniPool(void)
+{
+	SWIFFT_SetThreads(1);
+}
+#endif
+
+//! \brief The maximum number of blocks per range, or 0 for the default.
+static int SWIFFT_grain = 0;
+//! \brief The maximum number of blocks that operations of each class run on the calling thread alone.
+static size_t SWIFFT_opThreshold[SWIFFT_OP_CLASSES] = {
+	SWIFFT_BLOCKS_PARALLELIZATION_THRESHOLD,
+	SWIFFT_BLOCKS_PARALLELIZATION_THRESHOLD,
+	SWIFFT_BLOCKS_PARALLELIZATION_THRESHOLD,
+	SWIFFT_BLOCKS_PARALLELIZATION_THRESHOLD,
+};
+//! \brief The maximum number of blocks per range of operations of each class, or 0 for the one of SWIFFT_GetGrain.
+static int SWIFFT_opGrain[SWIFFT_OP_CLASSES] = {0};
+//! \brief The executor set by the caller, if any.
+static swifft_executor_fn SWIFFT_executor = NULL;
+//! \brief The context to pass to the executor.
+static void *SWIFFT_executorContext = NULL;
+
+void SWIFFT_SetThreads(int nthreads)
+{
+#ifdef SWIFFT_ENABLE_THREAD_POOL
+	int t;
+	if (nthreads <= 0) {
+		long nprocs = sysconf(_SC_NPROCESSORS_ONLN);
+		nthreads = nprocs > 0 ? (int)nprocs : 1;
+	}
+	if (nthreads > SWIFFT_MAX_THREADS) {
+		nthreads = SWIFFT_MAX_THREADS;
+	}
+	pthread_mutex_lock(&SWIFFT_pool.busy);
+	if (nthreads != SWIFFT_pool.nthreads) {
+		SWIFFT_stopWorkers();
+		if (nthreads > 1) {
+			SWIFFT_pool.spawned = SWIFFT_pool.generation;
+			SWIFFT_pool.workers = (pthread_t *)malloc((nthreads - 1) * sizeof(pthread_t));
+			for (t=0; SWIFFT_pool.workers != NULL && t<nthreads-1; t++) {
+				if (pthread_create(&SWIFFT_pool.workers[t], NULL, SWIFFT_worker, (void *)(intptr_t)(t + 1)) != 0) {
+					break;
+				}
+				__atomic_store_n(&SWIFFT_pool.nthreads, t + 2, __ATOMIC_RELAXED);
+			}
+		}
+	}
+	pthread_mutex_unlock(&SWIFFT_pool.busy);
+#else
+	(void)nthreads;
+#endif
+}
+
+int SWIFFT_GetThreads(void)
+{
+#ifdef SWIFFT_ENABLE_THREAD_POOL
+	return __atomic_load_n(&SWIFFT_pool.nthreads, __ATOMIC_RELAXED);
+#else
+	return 1;
+#endif
+}
+
+void SWIFFT_SetGrain(int grain)
+{
+	__atomic_store_n(&SWIFFT_grain, grain > 0 ? grain : 0, __ATOMIC_RELAXED);
+}
+
+int SWIFFT_GetGrain(void)
+{
+	int grain = __atomic_load_n(&SWIFFT_grain, __ATOMIC_RELAXED);
+	return grain > 0 ? grain : SWIFFT_DEFAULT_GRAIN;
+}
+
+void SWIFFT_SetOpThreshold(int op, size_t threshold)
+{
+	if (op >= 0 && op < SWIFFT_OP_CLASSES) {
+		__atomic_store_n(&SWIFFT_opThreshold[op], threshold, __ATOMIC_RELAXED);
+	}
+}
+
+size_t SWIFFT_GetOpThreshold(int op)
+{
+	if (op < 0 || op >= SWIFFT_OP_CLASSES) {
+		return SWIFFT_BLOCKS_PARALLELIZATION_THRESHOLD;
+	}
+	return __atomic_load_n(&SWIFFT_opThreshold[op], __ATOMIC_RELAXED);
+}
+
+void SWIFFT_SetOpGrain(int op, int grain)
+{
+	if (op >= 0 && op < SWIFFT_OP_CLASSES) {
+		__atomic_store_n(&SWIFFT_opGrain[op], grain > 0 ? grain : 0, __ATOMIC_RELAXED);
+	}
+}
+
+int SWIFFT_GetOpGrain(int op)
+{
+	int grain = op >= 0 && op < SWIFFT_OP_CLASSES ? __atomic_load_n(&SWIFFT_opGrain[op], __ATOMIC_RELAXED) : 0;
+	return grain > 0 ? grain : SWIFFT_GetGrain();
+}
+
+void SWIFFT_SetExecutor(swifft_executor_fn executor, void *context)
+{
+	// the context is published before the executor that uses it
+	__atomic_store_n(&SWIFFT_executorContext, context, __ATOMIC_RELAXED);
+	__atomic_store_n(&SWIFFT_executor, executor, __ATOMIC_RELEASE);
+}
+
+int SWIFFT_IsParallel(void)
+{
+	if (__atomic_load_n(&SWIFFT_executor, __ATOMIC_RELAXED) != NULL) {
+		return 1;
+	}
+#ifdef SWIFFT_ENABLE_THREAD_POOL
+	if (__atomic_load_n(&SWIFFT_pool.nthreads, __ATOMIC_RELAXED) > 1) {
+		return 1;
+	}
+#endif
+#ifdef _OPENMP
+	return omp_get_max_threads() > 1;
+#else
+	return 0;
+#endif
+}
+
+#ifdef _OPENMP
+//! \brief Runs a task on all its blocks using OpenMP, counting the work of each thread in the statistics.
+//!
+//! \param[in] nblocks the number of blocks of the task.
+//! \param[in] grain the number of blocks per chunk.
+//! \param[in] nchunks the number of chunks.
+//! \param[in] taskfn the function running the task on a range of blocks.
+//! \param[in] task the task.
+static void SWIFFT_runOpenMPStats(size_t nblocks, int grain, size_t nchunks, swifft_task_fn taskfn, void *task)
+{
+	uint64_t start = SWIFFT_statsNow(), maxBusy = 0, totalBusy = 0;
+	int nthreads = 1;
+	#pragma omp parallel reduction(max:maxBusy) reduction(+:totalBusy)
+	{
+		uint64_t begun = SWIFFT_statsNow(), busy;
+		size_t blocks = 0, c;
+		#pragma omp for schedule(static) nowait
+		for (c=0; c<nchunks; c++) {
+			size_t begin = c * grain;
+			size_t end = begin + grain < nblocks ? begin + grain : nblocks;
+			taskfn(task, begin, end);
+			blocks += end - begin;
+		}
+		busy = SWIFFT_statsNow() - begun;
+		SWIFFT_statsThread(omp_get_thread_num(), blocks, busy);
+		maxBusy = busy > maxBusy ? busy : maxBusy;
+		totalBusy += busy;
+		#pragma omp single nowait
+		nthreads = omp_get_num_threads();
+	}
+	SWIFFT_statsRun(SWIFFT_STATS_RUN_PARALLEL, SWIFFT_statsNow() - start, maxBusy, totalBusy, nthreads);
+}
+#endif
+
+//! \brief Runs a task on all its blocks, in parallel as configured.
+//!
+//! \param[in] nblocks the number of blocks of the task.
+//! \param[in] threshold the maximum number of blocks to run on the calling thread alone.
+//! \param[in] grain the maximum number of blocks per range.
+//! \param[in] align the power of 2 that the number of blocks per range is a multiple of, when it is shortened.
+//! \param[in] taskfn the function running the task on a range of blocks.
+//! \param[in] task the task.
+static void SWIFFT_parallelFor(size_t nblocks, size_t threshold, int grain, int align, swifft_task_fn taskfn, void *task)
+{
+	swifft_executor_fn executor;
+	if (nblocks <= threshold) {
+		if (nblocks > 0) {
+			SWIFFT_runSerial(nblocks, taskfn, task);
+		}
+		return;
+	}
+	executor = __atomic_load_n(&SWIFFT_executor, __ATOMIC_ACQUIRE);
+	if (executor != NULL) {
+		if (SWIFFT_STATS_ON()) {
+			SWIFFT_statsRun(SWIFFT_STATS_RUN_EXECUTOR, 0, 0, 0, 0);
+		}
+		executor(__atomic_load_n(&SWIFFT_executorContext, __ATOMIC_RELAXED), taskfn, task, nblocks, grain);
+		return;
+	}
+#ifdef SWIFFT_ENABLE_THREAD_POOL
+	if (__atomic_load_n(&SWIFFT_pool.nthreads, __ATOMIC_RELAXED) > 1) {
+		SWIFFT_poolRun(nblocks, grain, align, taskfn, task);
+		return;
+	}
+#endif
+#ifdef _OPENMP
+	{
+		size_t nchunks, c;
+		int nthreads = omp_get_max_threads();
+		grain = SWIFFT_rangeBlocks(nblocks, grain, nthreads, align);
+		nchunks = (nblocks + grain - 1) / grain;
+		if (nthreads > 1 && SWIFFT_STATS_ON()) {
+			SWIFFT_runOpenMPStats(nblocks, grain, nchunks, taskfn, task);
+			return;
+		}
+		if (nthreads <= 1) {
+			SWIFFT_runSerial(nblocks, taskfn, task);
+			return;
+		}
+		#pragma omp parallel for schedule(static) private(c)
+		for (c=0; c<nchunks; c++) {
+			size_t begin = c * grain;
+			taskfn(task, begin, begin + grain < nblocks ? begin + grain : nblocks);
+		}
+	}
+#else
+	(void)align;
+	SWIFFT_runSerial(nblocks, taskfn, task);
+#endif
+}
+
+//! \brief Runs a task on all its blocks, in parallel as configured, in ranges that start at multiples of some blocks.
+//!
+//! \param[in] nblocks the number of blocks of the task.
+//! \param[in] threshold the maximum number of blocks to run on the calling thread alone.
+//! \param[in] grain the maximum number of blocks per range, before rounding it up to a multiple of align.
+//! \param[in] align the power of 2 that the first block of each range is a multiple of.
+//! \param[in] taskfn the function running the task on a range of blocks.
+//! \param[in] task the task.
+static void SWIFFT_parallelForAligned(size_t nblocks, size_t threshold, int grain, int align,
+	swifft_task_fn taskfn, void *task)
+{
+	if (align < SWIFFT_GROUP_BLOCKS) {
+		align = SWIFFT_GROUP_BLOCKS;
+	}
+	SWIFFT_parallelFor(nblocks, threshold, (grain + align - 1) & ~(align - 1), align, taskfn, task);
+}
+
+void SWIFFT_ParallelFor(size_t nblocks, swifft_task_fn taskfn, void *task)
+{
+	SWIFFT_parallelFor(nblocks, SWIFFT_BLOCKS_PARALLELIZATION_THRESHOLD, SWIFFT_GetGrain(), SWIFFT_GROUP_BLOCKS,
+		taskfn, task);
+}
+
+void SWIFFT_ParallelForAligned(size_t nblocks, int align, swifft_task_fn taskfn, void *task)
+{
+	SWIFFT_parallelForAligned(nblocks, SWIFFT_BLOCKS_PARALLELIZATION_THRESHOLD, SWIFFT_GetGrain(), align,
+		taskfn, task);
+}
+
+void SWIFFT_ParallelForOp(size_t nblocks, int op, swifft_task_fn taskfn, void *task)
+{
+	SWIFFT_parallelFor(nblocks, SWIFFT_GetOpThreshold(op), SWIFFT_GetOpGrain(op), SWIFFT_GROUP_BLOCKS,
+		taskfn, task);
+}
+
+void SWIFFT_ParallelForAlignedOp(size_t nblocks, int op, int align, swifft_task_fn taskfn, void *task)
+{
+	SWIFFT_parallelForAligned(nblocks, SWIFFT_GetOpThreshold(op), SWIFFT_GetOpGrain(op), align,
+		taskfn, task);
+}
+
+LIBSWIFFT_END_EXTERN_C
@@ -0,0 +1,369 @@
+/*
+ * Copyright (C) 2021 Yaron Gvili and Gvili Tech Ltd.
+ *
+ * See the accompanying LICENSE.txt file for licensing information.
+ */
+/*! \file src/swifft_queue.c
+ * \brief LibSWIFFT public C implementation for submitting operations on multiple blocks asynchronously
+ *
+ * A queue keeps submitted requests and delivered completions in two rings of
+ * its depth, which never overflow since at most its depth of requests are
+ * outstanding. Its workers run requests using the operations on multiple
+ * blocks of the SWIFFT API, so each runs the kernels of the instruction set in
+ * use. A request large enough to parallelize runs on the native pool while it
+ * is free, and on its worker alone otherwise, so workers never wait for one
+ * another.
+ */
+
+#include <stddef.h> // for NULL, size_t
+#include <stdlib.h> // for calloc, free
+#include "swifft.h"
+
+#ifdef SWIFFT_ENABLE_THREAD_POOL
+	#include <pthread.h>
+	#include <unistd.h> // for sysconf
+#endif
+
+#ifdef __linux__
+	#include <stdint.h> // for uint64_t
+	#include <sys/eventfd.h>
+	#include <unistd.h> // for close, read, write
+#endif
+
+#define SWIFFT_QUEUE_MAX_WORKERS 256 ///< Maximum number of worker threads of a queue
+
+LIBSWIFFT_BEGIN_EXTERN_C
+
+//! \brief A ring of requests, of the capacity of the depth of its queue.
+typedef struct {
+	swifft_request_t *requests; ///< The requests, by index modulo the capacity
+	int head;                   ///< The index of the first request
+	int count;                  ///< The number of requests
+} swifft_ring_t;
+
+struct swifft_queue_s {
+#ifdef SWIFFT_ENABLE_THREAD_POOL
+	pthread_mutex_t mutex;         ///< Guards the fields below
+	pthread_cond_t work;           ///< Signals the workers that a request was submitted or a shutdown started
+	pthread_cond_t done;           ///< Signals waiting callers that a request completed
+	pthread_t *workers;            ///< The worker threads
+	int nworkers;                  ///< The number of worker threads
+	int shutdown;                  ///< Whether the workers should exit
+#endif
+	int depth;                     ///< The maximum number of outstanding requests
+	int outstanding;               ///< The number of requests submitted and not yet delivered
+	int inflight;                  ///< The number of requests submitted and not yet completed
+	swifft_ring_t submitted;       ///< The requests submitted and not yet taken by a worker
+	swifft_ring_t completed;       ///< The completions not yet taken by the caller
+	swifft_completion_fn callback; ///< The function called for completions, or NULL
+	void *context;                 ///< The context to pass to the callback
+	int fd;                        ///< The eventfd readable while completions are in the ring, or -1
+};
+
+//! \brief Appends a request to a ring, which must have room for it.
+//!
+//! \param[in,out] queue the queue of the ring.
+//! \param[in,out] ring the ring.
+//! \param[in] request the request.
+static void SWIFFT_ringPush(const swifft_queue_t *queue, swifft_ring_t *ring, const swifft_request_t *request)
+{
+	ring->requests[(ring->head + ring->count) % queue->depth] = *request;
+	ring->count++;
+}
+
+//! \brief Takes the first request from a ring, which must not be empty.
+//!
+//! \param[in,out] queue the queue of the ring.
+//! \param[in,out] ring the ring.
+//! \param[out] request the request.
+static void SWIFFT_ringPop(const swifft_queue_t *queue, swifft_ring_t *ring, swifft_request_t *request)
+{
+	*request = ring->requests[ring->head];
+	ring->head = (ring->head + 1) % queue->depth;
+	ring->count--;
+}
+
+//! \brief Runs the operation of a request.
+//!
+//! \param[in] request the request.
+static void SWIFFT_queueRun(const swifft_request_t *request)
+{
+	switch (request->op) {
+	case SWIFFT_REQUEST_COMPUTE:
+		if (request->sign != NULL) {
+			SWIFFT_ComputeMultipleSigned(request->nblocks, request->input, request->sign, request->output);
+		} else {
+			SWIFFT_ComputeMultiple(request->nblocks, request->input, request->output);
+		}
+		break;
+	case SWIFFT_REQUEST_COMPUTE_COMPACT:
+		SWIFFT_ComputeCompactMultiple(request->nblocks, request->input, request->output);
+		break;
+	case SWIFFT_REQUEST_COMPUTE_SIGNED_PACKED:
+		SWIFFT_ComputeMultipleSignedPacked(request->nblocks, request->input, request->output);
+		break;
+	case SWIFFT_REQUEST_COMPACT:
+		SWIFFT_CompactMultiple(request->nblocks, request->input, request->output);
+		break;
+	}
+}
+
+//! \brief Enters a completion into the completion ring of a queue, while its mutex is held, if any.
+//!
+//! \param[in,out] queue the queue.
+//! \param[in] request the completed request.
+static void SWIFFT_queueComplete(swifft_queue_t *queue, const swifft_request_t *request)
+{
+	SWIFFT_ringPush(queue, &queue->completed, request);
+#ifdef __linux__
+	if (queue->fd >= 0 && queue->completed.count == 1) {
+		uint64_t one = 1;
+		// the counter is far from overflowing, as the caller clears it when emptying the ring
+		(void)!write(queue->fd, &one, sizeof(one));
+	}
+#endif
+}
+
+//! \brief Clears the eventfd of a queue once its completion ring is empty, while its mutex is held, if any.
+//!
+//! \param[in,out] queue the queue.
+static void SWIFFT_queueClearFd(swifft_queue_t *queue)
+{
+#ifdef __linux__
+	if (queue->fd >= 0 && queue->completed.count == 0) {
+		uint64_t count;
+		(void)!read(queue->fd, &count, sizeof(count));
+	}
+#else
+	(void)queue;
+#endif
+}
+
+#ifdef SWIFFT_ENABLE_THREAD_POOL
+//! \brief Runs the requests of a queue on a worker thread until shutdown.
+//!
+//! \param[in] arg the queue.
+//! \returns NULL.
+static void *SWIFFT_queueWorker(void *arg)
+{
+	swifft_queue_t *queue = (swifft_queue_t *)arg;
+	swifft_request_t request;
+	pthread_mutex_lock(&queue->mutex);
+	for (;;) {
+		while (!queue->shutdown && queue->submitted.count == 0) {
+			pthread_cond_wait(&queue->work, &queue->mutex);
+		}
+		if (queue->submitted.count == 0) {
+			break;
+		}
+		SWIFFT_ringPop(queue, &queue->submitted, &request);
+		pthread_mutex_unlock(&queue->mutex);
+		SWIFFT_queueRun(&request);
+		pthread_mutex_lock(&queue->mutex);
+		if (queue->callback != NULL) {
+			// the callback may submit, or wake a caller that waits for room to submit
+			queue->outstanding--;
+			pthread_mutex_unlock(&queue->mutex);
+			queue->callback(queue->context, &request);
+			pthread_mutex_lock(&queue->mutex);
+		} else {
+			SWIFFT_queueComplete(queue, &request);
+		}
+		queue->inflight--;
+		pthread_cond_broadcast(&queue->done);
+	}
+	pthread_mutex_unlock(&queue->mutex);
+	return NULL;
+}
+
+//! \brief Stops and joins the first worker threads of a queue.
+//!
+//! \param[in,out] queue the queue.
+//! \param[in] nworkers the number of worker threads to join.
+static void SWIFFT_queueStop(swifft_queue_t *queue, int nworkers)
+{
+	int t;
+	pthread_mutex_lock(&queue->mutex);
+	queue->shutdown = 1;
+	pthread_cond_broadcast(&queue->work);
+	pthread_mutex_unlock(&queue->mutex);
+	for (t=0; t<nworkers; t++) {
+		pthread_join(queue->workers[t], NULL);
+	}
+}
+#endif
+
+//! \brief Frees the resources of a queue whose worker threads are not running.
+//!
+//! \param[in] queue the queue.
+static void SWIFFT_queueFree(swifft_queue_t *queue)
+{
+#ifdef SWIFFT_ENABLE_THREAD_POOL
+	pthread_cond_destroy(&queue->done);
+	pthread_cond_destroy(&queue->work);
+	pthread_mutex_destroy(&queue->mutex);
+	free(queue->workers);
+#endif
+#ifdef __linux__
+	if (queue->fd >= 0) {
+		close(queue->fd);
+	}
+#endif
+	free(queue->submitted.requests);
+	free(queue->completed.requests);
+	free(queue);
+}
+
+swifft_queue_t * SWIFFT_QueueCreate(int nworkers, int depth, swifft_completion_fn callback, void * context)
+{
+	swifft_queue_t *queue;
+	if (nworkers < 0 || depth < 1) {
+		return NULL;
+	}
+	queue = (swifft_queue_t *)calloc(1, sizeof(swifft_queue_t));
+	if (queue == NULL) {
+		return NULL;
+	}
+	queue->depth = depth;
+	queue->callback = callback;
+	queue->context = context;
+	queue->fd = -1;
+	queue->submitted.requests = (swifft_request_t *)calloc(depth, sizeof(swifft_request_t));
+	queue->completed.requests = (swifft_request_t *)calloc(depth, sizeof(swifft_request_t));
+#ifdef SWIFFT_ENABLE_THREAD_POOL
+	pthread_mutex_init(&queue->mutex, NULL);
+	pthread_cond_init(&queue->work, NULL);
+	pthread_cond_init(&queue->done, NULL);
+	if (nworkers == 0) {
+		long online = sysconf(_SC_NPROCESSORS_ONLN);
+		nworkers = online > 0 ? (int)online : 1;
+	}
+	nworkers = nworkers < SWIFFT_QUEUE_MAX_WORKERS ? nworkers : SWIFFT_QUEUE_MAX_WORKERS;
+	queue->workers = (pthread_t *)calloc(nworkers, sizeof(pthread_t));
+#endif
+	if (queue->submitted.requests == NULL || queue->completed.requests == NULL
+#ifdef SWIFFT_ENABLE_THREAD_POOL
+		|| queue->workers == NULL
+#endif
+	) {
+		SWIFFT_queueFree(queue);
+		return NULL;
+	}
+#ifdef __linux__
+	if (callback == NULL) {
+		queue->fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	}
+#endif
+#ifdef SWIFFT_ENABLE_THREAD_POOL
+	for (; queue->nworkers<nworkers; queue->nworkers++) {
+		if (pthread_create(&queue->workers[queue->nworkers], NULL, SWIFFT_queueWorker, queue) != 0) {
+			SWIFFT_queueStop(queue, queue->nworkers);
+			SWIFFT_queueFree(queue);
+			return NULL;
+		}
+	}
+#else
+	(void)nworkers;
+#endif
+	return queue;
+}
+
+int SWIFFT_QueueSubmit(swifft_queue_t * queue, const swifft_request_t * request)
+{
+	if (request->op < 0 || request->op >= SWIFFT_REQUEST_OPS
+		|| (request->sign != NULL && request->op != SWIFFT_REQUEST_COMPUTE)
+		|| (request->nblocks > 0 && (request->input == NULL || request->output == NULL))) {
+		return -1;
+	}
+#ifdef SWIFFT_ENABLE_THREAD_POOL
+	pthread_mutex_lock(&queue->mutex);
+	if (queue->outstanding >= queue->depth) {
+		pthread_mutex_unlock(&queue->mutex);
+		return -1;
+	}
+	queue->outstanding++;
+	queue->inflight++;
+	SWIFFT_ringPush(queue, &queue->submitted, request);
+	pthread_cond_signal(&queue->work);
+	pthread_mutex_unlock(&queue->mutex);
+#else
+	if (queue->outstanding >= queue->depth) {
+		return -1;
+	}
+	SWIFFT_queueRun(request);
+	if (queue->callback != NULL) {
+		queue->callback(queue->context, request);
+	} else {
+		queue->outstanding++;
+		SWIFFT_queueComplete(queue, request);
+	}
+#endif
+	return 0;
+}
+
+int SWIFFT_QueuePoll(swifft_queue_t * queue, swifft_request_t * completions, int max)
+{
+	int n;
+#ifdef SWIFFT_ENABLE_THREAD_POOL
+	pthread_mutex_lock(&queue->mutex);
+#endif
+	for (n=0; n<max && queue->completed.count > 0; n++) {
+		SWIFFT_ringPop(queue, &queue->completed, &completions[n]);
+	}
+	queue->outstanding -= n;
+	if (n > 0) {
+		SWIFFT_queueClearFd(queue);
+	}
+#ifdef SWIFFT_ENABLE_THREAD_POOL
+	pthread_mutex_unlock(&queue->mutex);
+#endif
+	return n;
+}
+
+int SWIFFT_QueueWait(swifft_queue_t * queue, swifft_request_t * completion)
+{
+	if (queue->callback != NULL) {
+		return -1;
+	}
+#ifdef SWIFFT_ENABLE_THREAD_POOL
+	pthread_mutex_lock(&queue->mutex);
+	while (queue->completed.count == 0 && queue->inflight > 0) {
+		pthread_cond_wait(&queue->done, &queue->mutex);
+	}
+	pthread_mutex_unlock(&queue->mutex);
+#endif
+	// only the caller takes completions, so the one waited for is still there
+	return SWIFFT_QueuePoll(queue, completion, 1) == 1 ? 0 : -1;
+}
+
+int SWIFFT_QueueFd(const swifft_queue_t * queue)
+{
+	return queue->fd;
+}
+
+void SWIFFT_QueueDrain(swifft_queue_t * queue)
+{
+#ifdef SWIFFT_ENABLE_THREAD_POOL
+	pthread_mutex_lock(&queue->mutex);
+	while (queue->inflight > 0) {
+		pthread_cond_wait(&queue->done, &queue->mutex);
+	}
+	pthread_mutex_unlock(&queue->mutex);
+#else
+	(void)queue;
+#endif
+}
+
+void SWIFFT_QueueDestroy(swifft_queue_t * queue)
+{
+	if (queue == NULL) {
+		return;
+	}
+	SWIFFT_QueueDrain(queue);
+#ifdef SWIFFT_ENABLE_THREAD_POOL
+	SWIFFT_queueStop(queue, queue->nworkers);
+#endif
+	SWIFFT_queueFree(queue);
+}
+
+LIBSWIFFT_END_EXTERN_C
@@ -0,0 +1,317 @@
+/*
+ * Copyright (C) 2021 Yaron Gvili and Gvili Tech Ltd.
+ *
+ * See the accompanying LICENSE.txt file for licensing information.
+ */
+/*! \file src/swifft_soa.inl
+ * \brief LibSWIFFT internal C code for the lane-per-block engine of large batches
+ *
+ * The kernels of swifft.inl vectorize within a block, with a wide SWIFFT vector
+ * holding 8 FFT-output elements of SWIFFT_O chunks. The lane-per-block engine instead
+ * holds one block per lane, so each operation on a wide SWIFFT vector works on the
+ * same element of SWIFFT_SOA_LANES blocks:
+ *
+ * - the input is transposed into lanes a chunk at a time, from the usual layout of
+ *   consecutive blocks;
+ * - the FFT-table entries of an input byte, which are its bits in bit-reversed order
+ *   evaluated at the odd powers of 2, are computed by an 8-point FFT whose twiddle
+ *   factors are shifts, rather than looked up;
+ * - the base change of the compaction runs vertically over the digits of the blocks,
+ *   with no transposes.
+ *
+ * Each lane goes through the same values as the kernels of swifft.inl do for its block,
+ * so the results are identical.
+ */
+
+#define SWIFFT_SOA_LANES (SWIFFT_O*SWIFFT_W) ///< Number of blocks, one per lane, that the lane-per-block engine operates on at once
+
+//! \brief Transposes 16 bytes at the same offset of each of SWIFFT_SOA_LANES blocks into lanes, as 8 16-bit elements.
+//! Blocks 8*o to 8*o+7 are transposed in the 128-bit lane o, so lane l holds block l.
+//!
+//! \param[in] p the 16 bytes of the first block.
+//! \param[in] blockSize the distance in bytes between consecutive blocks.
+//! \param[out] x the 16-bit elements, one wide SWIFFT vector per element, one block per lane.
+static LIBSWIFFT_INLINE void SWIFFT_soaLoadRows(const BitSequence * LIBSWIFFT_RESTRICT p, size_t blockSize, ZOvec x[8])
+{
+	int j,l;
+#ifdef SWIFFT_HAVE_TRANSPOSE_LANES
+	for (l=0; l<SWIFFT_SOA_LANES; l++,p+=blockSize) {
+		memcpy((Z1vec *)&x[l & 7] + (l >> 3), p, sizeof(Z1vec));
+	}
+	SWIFFT_transposeLanes(x);
+	(void)j;
+#else
+	for (l=0; l<SWIFFT_SOA_LANES; l++,p+=blockSize) {
+		for (j=0; j<8; j++) {
+			((int16_t *)&x[j])[l] = ((const int16_t *)p)[j];
+		}
+	}
+#endif
+}
+
+//! \brief Transposes 8 16-bit elements of each of SWIFFT_SOA_LANES blocks out of lanes, to 16 bytes at the same offset of each block.
+//!
+//! \param[in] x the 16-bit elements, one wide SWIFFT vector per element, one block per lane, which are modified.
+//! \param[out] p the 16 bytes of the first block.
+//! \param[in] blockSize the distance in bytes between consecutive blocks.
+static LIBSWIFFT_INLINE void SWIFFT_soaStoreRows(ZOvec x[8], BitSequence * LIBSWIFFT_RESTRICT p, size_t blockSize)
+{
+	int j,l;
+#ifdef SWIFFT_HAVE_TRANSPOSE_LANES
+	SWIFFT_transposeLanes(x);
+	for (l=0; l<SWIFFT_SOA_LANES; l++,p+=blockSize) {
+		memcpy(p, (const Z1vec *)&x[l & 7] + (l >> 3), sizeof(Z1vec));
+	}
+	(void)j;
+#else
+	for (l=0; l<SWIFFT_SOA_LANES; l++,p+=blockSize) {
+		for (j=0; j<8; j++) {
+			((int16_t *)p)[j] = ((const int16_t *)&x[j])[l];
+		}
+	}
+#endif
+}
+
+//! \brief Transposes 16 bytes at the same offset of each of SWIFFT_SOA_LANES blocks into lanes.
+//!
+//! \param[in] p the 16 bytes of the first block.
+//! \param[in] blockSize the distance in bytes between consecutive blocks.
+//! \param[out] t the bytes, one wide SWIFFT vector per byte, one block per lane.
+static LIBSWIFFT_INLINE void SWIFFT_soaLoadBytes(const BitSequence * LIBSWIFFT_RESTRICT p, size_t blockSize, ZOvec t[16])
+{
+	const ZOvec ZO_255 = ZOCONST(255), ZO_8 = ZOCONST(8);
+	ZOvec x[8];
+	int j;
+	SWIFFT_soaLoadRows(p, blockSize, x);
+	for (j=0; j<8; j++) {
+		t[2*j] = x[j] & ZO_255;
+		t[2*j+1] = (x[j] >> ZO_8) & ZO_255;
+	}
+}
+
+//! \brief Places the bits of input bytes, in bit-reversed order, at ascending bit positions.
+//! Bit v of the result is bit (v reversed in 3 bits) of the input byte, so the result,
+//! as a vector of 8 elements of a single bit each, is the input to SWIFFT_soaFftBits.
+//!
+//! \param[in] t the input bytes, one per lane.
+//! \param[out] c the placed bits, one wide SWIFFT vector per bit position.
+static LIBSWIFFT_INLINE void SWIFFT_soaBits(ZOvec t, ZOvec c[8])
+{
+	const ZOvec ZO_1 = ZOCONST(1), ZO_2 = ZOCONST(2), ZO_3 = ZOCONST(3), ZO_4 = ZOCONST(4);
+	const ZOvec ZO_8 = ZOCONST(8), ZO_16 = ZOCONST(16), ZO_32 = ZOCONST(32), ZO_64 = ZOCONST(64), ZO_128 = ZOCONST(128);
+	c[0] = t & ZO_1;
+	c[1] = (t >> ZO_3) & ZO_2;
+	c[2] = t & ZO_4;
+	c[3] = (t >> ZO_3) & ZO_8;
+	c[4] = (t << ZO_3) & ZO_16;
+	c[5] = t & ZO_32;
+	c[6] = (t << ZO_3) & ZO_64;
+	c[7] = t & ZO_128;
+}
+
+//! \brief Computes the FFT-table entries of input bytes from their placed bits.
+//! Entry k is the sum of c[v]*4^{kv}, i.e., the bits at the odd power 2^{2k+1}, which an
+//! 8-point FFT computes with shifts as twiddle factors. The entries are reduced to
+//! {-128,..,128}, the range of SWIFFT_fftTable, so they equal the looked up ones.
+//!
+//! \param[in] c the placed bits, as given by SWIFFT_soaBits, or their differences for signed input.
+//! \param[out] x the FFT-table entries, one wide SWIFFT vector per element of an entry.
+static LIBSWIFFT_INLINE void SWIFFT_soaFftBits(const ZOvec c[8], ZOvec x[8])
+{
+	const ZOvec ZO_128 = ZOCONST(128), ZO_257 = ZOCONST(257);
+	ZOvec e[4], o[4], s;
+	int k;
+
+	// 4-point FFTs of the even and of the odd bit positions, with twiddle factor 16
+	e[0] = c[0] + c[4]; e[1] = c[0] - c[4];
+	e[2] = c[2] + c[6]; e[3] = c[2] - c[6];
+	o[0] = c[1] + c[5]; o[1] = c[1] - c[5];
+	o[2] = c[3] + c[7]; o[3] = c[3] - c[7];
+	SWIFFT_AddSub(e[0], e[2]);
+	s = SWIFFT_shift(e[3], 4); e[3] = e[1] - s; e[1] += s;
+	SWIFFT_AddSub(o[0], o[2]);
+	s = SWIFFT_shift(o[3], 4); o[3] = o[1] - s; o[1] += s;
+
+	// combining them, with twiddle factors 1,4,16,64
+	x[0] = e[0] + o[0]; x[4] = e[0] - o[0];
+	s = SWIFFT_shift(o[1], 2); x[1] = e[1] + s; x[5] = e[1] - s;
+	s = SWIFFT_shift(o[2], 4); x[2] = e[2] + s; x[6] = e[2] - s;
+	s = SWIFFT_shift(o[3], 6); x[3] = e[3] + s; x[7] = e[3] - s;
+
+	// reducing from {-1039,..,1039} to {-4,..,260}, and then to {-128,..,128}
+	for (k=0; k<8; k++) {
+		s = SWIFFT_qReduce(x[k]);
+		x[k] = s - ((s > ZO_128) & ZO_257);
+	}
+}
+
+//! \brief Computes the FFT and FFT-sum phases of SWIFFT on a chunk of SWIFFT_SOA_LANES blocks, one block per lane.
+//!
+//! \param[in] key the SWIFFT key elements, centered and interleaved as given by SWIFFT_KEY_INDEX.
+//! \param[in] i the index of the chunk in the input.
+//! \param[in] t the bytes of the chunk, one wide SWIFFT vector per byte.
+//! \param[in] u the sign bytes corresponding to the chunk, or NULL for unsigned input.
+//! \param[in,out] acc the accumulated products, one wide SWIFFT vector per element of a hash value.
+static LIBSWIFFT_INLINE void SWIFFT_soaChunk(const int16_t * LIBSWIFFT_RESTRICT key, int i,
+	const ZOvec t[8], const ZOvec *u, ZOvec acc[SWIFFT_N])
+{
+	ZOvec x[8][8], v[8], c[8], n[8];
+	int j,k;
+
+	for (j=0; j<8; j++) {
+		if (u) {
+			// the FFT-table entry of a signed byte is that of its positive bits less that of its negative bits
+			SWIFFT_soaBits(t[j] & ~u[j], c);
+			SWIFFT_soaBits(t[j] & u[j], n);
+			for (k=0; k<8; k++) {
+				c[k] -= n[k];
+			}
+		} else {
+			SWIFFT_soaBits(t[j], c);
+		}
+		SWIFFT_soaFftBits(c, x[j]);
+	}
+	for (k=0; k<8; k++) {
+		v[0] = x[0][k];
+		for (j=1; j<8; j++) {
+			// no need for SWIFFT_safeMult because multipliers do not hit an edge case
+			const ZOvec zmult = ZOCONST(SWIFFT_multipliers[j*SWIFFT_W + k]);
+			v[j] = x[j][k] * zmult;
+		}
+		SWIFFT_fftButterflies(v);
+		for (j=0; j<8; j++) {
+			const ZOvec zkey = ZOCONST(key[SWIFFT_W*SWIFFT_KEY_INDEX(i, j) + k]);
+			// reducing FFT output to avoid overflow
+			acc[j*SWIFFT_W + k] += SWIFFT_qReduce(SWIFFT_safeMult(v[j], zkey));
+		}
+	}
+}
+
+//! \brief Computes the hash values of SWIFFT_SOA_LANES blocks, one block per lane.
+//! The input is transposed into lanes 16 bytes at a time, which are two chunks of
+//! separate input or sign bits, or a chunk of packed signed input.
+//!
+//! \param[in] key the SWIFFT key elements, centered and interleaved as given by SWIFFT_KEY_INDEX.
+//! \param[in] input the input of the first block.
+//! \param[in] sign the sign bits corresponding to the input of the first block, or NULL for unsigned or packed input.
+//! \param[in] blockSize the distance in bytes between consecutive blocks of input, and of sign bits.
+//! \param[in] packed whether the input is of blocks of SWIFFT_PACKED_BLOCK_SIZE.
+//! \param[out] out the resulting hash values, one wide SWIFFT vector per element of a hash value.
+static LIBSWIFFT_INLINE void SWIFFT_soaCompute(const int16_t * LIBSWIFFT_RESTRICT key,
+	const BitSequence * LIBSWIFFT_RESTRICT input,
+	const BitSequence * LIBSWIFFT_RESTRICT sign,
+	size_t blockSize, int packed,
+	ZOvec out[SWIFFT_N])
+{
+	ZOvec acc[SWIFFT_N] = {0};
+	ZOvec t[16], u[16];
+	int i,j;
+
+	for (i=0; i<SWIFFT_M; i+=2) {
+		if (packed) {
+			SWIFFT_soaLoadBytes(input + i*2*SWIFFT_CHUNK_SIZE, blockSize, t);
+			SWIFFT_soaLoadBytes(input + (i+1)*2*SWIFFT_CHUNK_SIZE, blockSize, u);
+			SWIFFT_soaChunk(key, i, t, t + 8, acc);
+			SWIFFT_soaChunk(key, i+1, u, u + 8, acc);
+		} else {
+			SWIFFT_soaLoadBytes(input + i*SWIFFT_CHUNK_SIZE, blockSize, t);
+			if (sign) {
+				SWIFFT_soaLoadBytes(sign + i*SWIFFT_CHUNK_SIZE, blockSize, u);
+			}
+			SWIFFT_soaChunk(key, i, t, sign ? u : NULL, acc);
+			SWIFFT_soaChunk(key, i+1, t + 8, sign ? u + 8 : NULL, acc);
+		}
+	}
+	for (j=0; j<SWIFFT_N; j++) {
+		out[j] = SWIFFT_modP(acc[j]);
+	}
+}
+
+//! \brief Transposes the hash values of SWIFFT_SOA_LANES blocks out of lanes.
+//!
+//! \param[in] out the hash values, one wide SWIFFT vector per element of a hash value, which are modified.
+//! \param[out] output the hash values of the blocks, each of size 128 bytes (1024 bit).
+static LIBSWIFFT_INLINE void SWIFFT_soaStore(ZOvec out[SWIFFT_N], BitSequence * LIBSWIFFT_RESTRICT output)
+{
+	int j;
+	for (j=0; j<SWIFFT_N; j+=8) {
+		SWIFFT_soaStoreRows(out + j, output + j*sizeof(int16_t), SWIFFT_OUTPUT_BLOCK_SIZE);
+	}
+}
+
+//! \brief Compacts the hash values of SWIFFT_SOA_LANES blocks, one block per lane.
+//! The result is the same as that of SWIFFT_Compact on each hash value.
+//! Each 8 consecutive elements of a hash value are the base-257 digits of a number,
+//! whose base change runs on the digits of all lanes at once.
+//!
+//! \param[in,out] out the hash values, one wide SWIFFT vector per element of a hash value, which are modified.
+//! \param[out] compact the compacted hash values of the blocks, each of size 64 bytes (512 bit).
+static LIBSWIFFT_INLINE void SWIFFT_soaCompact(ZOvec out[SWIFFT_N], BitSequence * LIBSWIFFT_RESTRICT compact)
+{
+	const ZOvec ZO_255 = ZOCONST(255);
+	int j,l;
+	for (j=0; j<SWIFFT_N; j+=8) {
+		SWIFFT_toBase256(out + j, 8);
+		// ignore carry bit, to avoid saturation
+		out[j + 7] &= ZO_255;
+	}
+#ifdef SWIFFT_HAVE_TRANSPOSE_LANES
+	for (j=0; j<SWIFFT_N; j+=8) {
+		ZOvec p[4];
+		SWIFFT_transposeLanes(out + j);
+		SWIFFT_packLanes(out + j, p);
+		for (l=0; l<SWIFFT_SOA_LANES; l++) {
+			// the bytes of blocks 2*i and 2*i+1 of each group of 8 are in the halves of the 128-bit lane of p[i]
+			memcpy(compact + l*SWIFFT_COMPACT_BLOCK_SIZE + j,
+				(const BitSequence *)((const Z1vec *)&p[(l & 7) >> 1] + (l >> 3)) + (l & 1)*8, 8);
+		}
+	}
+#else
+	for (l=0; l<SWIFFT_SOA_LANES; l++,compact+=SWIFFT_COMPACT_BLOCK_SIZE) {
+		for (j=0; j<SWIFFT_N; j++) {
+			compact[j] = (BitSequence)((const int16_t *)&out[j])[l];
+		}
+	}
+#endif
+}
+
+//! \brief Runs SWIFFT operations of a batch on a range of blocks with the lane-per-block engine, given a SWIFFT_task_t.
+//! The blocks past the last whole group of SWIFFT_SOA_LANES blocks run with the kernels of swifft.inl.
+//! Being always inlined, each call site compiles to a kernel for its kind of input and output.
+//!
+//! \param[in] task the task, whose input is packed signed input if packed is nonzero.
+//! \param[in] begin the first block of the range.
+//! \param[in] end the block past the last one of the range.
+//! \param[in] packed whether the input is of blocks of SWIFFT_PACKED_BLOCK_SIZE.
+//! \param[in] compact whether the output is of compacted hash values.
+static LIBSWIFFT_INLINE void SWIFFT_soaComputeRange(const SWIFFT_task_t *task, size_t begin, size_t end,
+	int packed, int compact)
+{
+	const size_t blockSize = packed ? SWIFFT_PACKED_BLOCK_SIZE : SWIFFT_INPUT_BLOCK_SIZE;
+	const size_t outputSize = compact ? SWIFFT_COMPACT_BLOCK_SIZE : SWIFFT_OUTPUT_BLOCK_SIZE;
+	const BitSequence *sign = packed ? NULL : task->sign;
+	BitSequence *output = (BitSequence *)task->output;
+	size_t i;
+	for (i=begin; i+SWIFFT_SOA_LANES<=end; i+=SWIFFT_SOA_LANES) {
+		ZOvec out[SWIFFT_N];
+		SWIFFT_soaCompute(task->key, task->input + i * blockSize, sign ? sign + i * blockSize : NULL,
+			blockSize, packed, out);
+		if (compact) {
+			SWIFFT_soaCompact(out, output + i * outputSize);
+		} else {
+			SWIFFT_soaStore(out, output + i * outputSize);
+		}
+	}
+	for (; i<end; i++) {
+		SWIFFT_ALIGN BitSequence block[SWIFFT_OUTPUT_BLOCK_SIZE];
+		BitSequence *o = compact ? block : output + i * outputSize;
+		if (packed) {
+			SWIFFT_computePacked(task->key, task->input + i * blockSize, o);
+		} else {
+			SWIFFT_compute(task->key, task->input + i * blockSize, sign ? sign + i * blockSize : NULL, o);
+		}
+		if (compact) {
+			SWIFFT_compact(block, output + i * outputSize);
+		}
+	}
+}
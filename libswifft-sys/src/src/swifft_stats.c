@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2021 Yaron Gvili and Gvili Tech Ltd.
+ *
+ * See the accompanying LICENSE.txt file for licensing information.
+ */
+/*! \file src/swifft_stats.c
+ * \brief LibSWIFFT public C implementation for statistics of operations
+ *
+ * The counters are updated using relaxed atomic additions. Those of each entry
+ * point, and those of each thread, are on their own cache line, so threads
+ * running different operations, or different ranges of one, do not contend.
+ */
+
+#include <string.h> // for memset
+#include <time.h>   // for clock_gettime
+#include "swifft.h"
+#include "swifft_object.h"
+#include "swifft_impl.inl"
+#include "swifft_stats.inl"
+
+LIBSWIFFT_BEGIN_EXTERN_C
+
+//! \brief The counters of an entry point, on their own cache line.
+typedef struct {
+	_Alignas(64) uint64_t calls; ///< The number of calls
+	uint64_t blocks;             ///< The number of blocks
+	uint64_t nanoseconds;        ///< The wall-clock time
+} swifft_stats_entry_counters_t;
+
+//! \brief The counters of a thread, on their own cache line.
+typedef struct {
+	_Alignas(64) uint64_t blocks; ///< The number of blocks
+	uint64_t nanoseconds;         ///< The busy time
+} swifft_stats_thread_counters_t;
+
+int SWIFFT_statsEnabled = 0;
+
+//! \brief The counters of the statistics.
+static struct {
+	swifft_stats_entry_counters_t entries[SWIFFT_STATS_ENTRIES];    ///< The counters per entry point
+	swifft_stats_thread_counters_t threads[SWIFFT_STATS_MAX_THREADS]; ///< The counters per thread index
+	_Alignas(64) uint64_t runs[SWIFFT_STATS_RUN_PARALLEL + 1];      ///< The number of runs, by where they ran
+	uint64_t parallelNanoseconds;                                   ///< The wall-clock time of the parallel runs
+	uint64_t imbalanceNanoseconds;                                  ///< The busy time of the busiest threads past the mean
+} SWIFFT_stats;
+
+//! \brief The names of the entry points, indexed by swifft_stats_entry_t.
+static const char * const SWIFFT_statsEntryNames[SWIFFT_STATS_ENTRIES] = {
+	"SWIFFT_fft",
+	"SWIFFT_fftsum",
+	"SWIFFT_Compact",
+	"SWIFFT_ConstSet",
+	"SWIFFT_ConstAdd",
+	"SWIFFT_ConstSub",
+	"SWIFFT_ConstMul",
+	"SWIFFT_Set",
+	"SWIFFT_Add",
+	"SWIFFT_Sub",
+	"SWIFFT_Mul",
+	"SWIFFT_AccumulatorInit",
+	"SWIFFT_AccumulatorAdd",
+	"SWIFFT_AccumulatorSub",
+	"SWIFFT_Reduce",
+	"SWIFFT_Compute",
+	"SWIFFT_ComputeSigned",
+	"SWIFFT_fftMultiple",
+	"SWIFFT_fftsumMultiple",
+	"SWIFFT_CompactMultiple",
+	"SWIFFT_ConstSetMultiple",
+	"SWIFFT_ConstAddMultiple",
+	"SWIFFT_ConstSubMultiple",
+	"SWIFFT_ConstMulMultiple",
+	"SWIFFT_SetMultiple",
+	"SWIFFT_AddMultiple",
+	"SWIFFT_SubMultiple",
+	"SWIFFT_MulMultiple",
+	"SWIFFT_SumMultiple",
+	"SWIFFT_LinearCombination",
+	"SWIFFT_EvalMultiple",
+	"SWIFFT_ComputeMultiple",
+	"SWIFFT_ComputeMultipleSigned",
+	"SWIFFT_ComputeCompactMultiple",
+	"SWIFFT_Update",
+	"SWIFFT_UpdateMultiple",
+	"SWIFFT_ComputeKeyed",
+	"SWIFFT_ComputeSignedKeyed",
+	"SWIFFT_ComputeMultipleKeyed",
+	"SWIFFT_ComputeMultipleSignedKeyed",
+	"SWIFFT_ComputeSignedPacked",
+	"SWIFFT_ComputeMultipleSignedPacked",
+	"SWIFFT_ComputeMultiKey",
+	"SWIFFT_ComputeShort",
+	"SWIFFT_ComputeSignedShort",
+	"SWIFFT_ComputeMultipleShort",
+	"SWIFFT_ComputeMultipleSignedShort",
+};
+
+uint64_t SWIFFT_statsNow(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+void SWIFFT_statsCall(int entry, size_t nblocks, uint64_t nanoseconds)
+{
+	swifft_stats_entry_counters_t *counters = &SWIFFT_stats.entries[entry];
+	__atomic_fetch_add(&counters->calls, 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&counters->blocks, (uint64_t)nblocks, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&counters->nanoseconds, nanoseconds, __ATOMIC_RELAXED);
+}
+
+void SWIFFT_statsRun(int run, uint64_t nanoseconds, uint64_t maxBusy, uint64_t totalBusy, int nthreads)
+{
+	__atomic_fetch_add(&SWIFFT_stats.runs[run], 1, __ATOMIC_RELAXED);
+	if (run == SWIFFT_STATS_RUN_PARALLEL && nthreads > 0) {
+		uint64_t mean = totalBusy / (uint64_t)nthreads;
+		__atomic_fetch_add(&SWIFFT_stats.parallelNanoseconds, nanoseconds, __ATOMIC_RELAXED);
+		__atomic_fetch_add(&SWIFFT_stats.imbalanceNanoseconds, maxBusy > mean ? maxBusy - mean : 0, __ATOMIC_RELAXED);
+	}
+}
+
+void SWIFFT_statsThread(int thread, size_t nblocks, uint64_t nanoseconds)
+{
+	swifft_stats_thread_counters_t *counters;
+	if (thread < 0 || thread >= SWIFFT_STATS_MAX_THREADS) {
+		return;
+	}
+	counters = &SWIFFT_stats.threads[thread];
+	__atomic_fetch_add(&counters->blocks, (uint64_t)nblocks, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&counters->nanoseconds, nanoseconds, __ATOMIC_RELAXED);
+}
+
+int SWIFFT_SetStatsEnabled(int enabled)
+{
+#ifdef SWIFFT_ENABLE_STATS
+	__atomic_store_n(&SWIFFT_statsEnabled, enabled != 0, __ATOMIC_RELAXED);
+	return 0;
+#else
+	(void)enabled;
+	return -1;
+#endif
+}
+
+void SWIFFT_GetStats(swifft_stats_t * stats)
+{
+	int i;
+	memset(stats, 0, sizeof(*stats));
+	stats->enabled = SWIFFT_STATS_ON();
+	stats->iset = SWIFFT_GetInstructionSet();
+	for (i=0; i<SWIFFT_STATS_ENTRIES; i++) {
+		stats->entries[i].calls = __atomic_load_n(&SWIFFT_stats.entries[i].calls, __ATOMIC_RELAXED);
+		stats->entries[i].blocks = __atomic_load_n(&SWIFFT_stats.entries[i].blocks, __ATOMIC_RELAXED);
+		stats->entries[i].nanoseconds = __atomic_load_n(&SWIFFT_stats.entries[i].nanoseconds, __ATOMIC_RELAXED);
+	}
+	stats->serialRuns = __atomic_load_n(&SWIFFT_stats.runs[SWIFFT_STATS_RUN_SERIAL], __ATOMIC_RELAXED);
+	stats->executorRuns = __atomic_load_n(&SWIFFT_stats.runs[SWIFFT_STATS_RUN_EXECUTOR], __ATOMIC_RELAXED);
+	stats->parallelRuns = __atomic_load_n(&SWIFFT_stats.runs[SWIFFT_STATS_RUN_PARALLEL], __ATOMIC_RELAXED);
+	stats->parallelNanoseconds = __atomic_load_n(&SWIFFT_stats.parallelNanoseconds, __ATOMIC_RELAXED);
+	stats->imbalanceNanoseconds = __atomic_load_n(&SWIFFT_stats.imbalanceNanoseconds, __ATOMIC_RELAXED);
+	for (i=0; i<SWIFFT_STATS_MAX_THREADS; i++) {
+		stats->threadBlocks[i] = __atomic_load_n(&SWIFFT_stats.threads[i].blocks, __ATOMIC_RELAXED);
+		stats->threadNanoseconds[i] = __atomic_load_n(&SWIFFT_stats.threads[i].nanoseconds, __ATOMIC_RELAXED);
+	}
+}
+
+void SWIFFT_ResetStats(void)
+{
+	int i;
+	for (i=0; i<SWIFFT_STATS_ENTRIES; i++) {
+		__atomic_store_n(&SWIFFT_stats.entries[i].calls, 0, __ATOMIC_RELAXED);
+		__atomic_store_n(&SWIFFT_stats.entries[i].blocks, 0, __ATOMIC_RELAXED);
+		__atomic_store_n(&SWIFFT_stats.entries[i].nanoseconds, 0, __ATOMIC_RELAXED);
+	}
+	for (i=0; i<=SWIFFT_STATS_RUN_PARALLEL; i++) {
+		__atomic_store_n(&SWIFFT_stats.runs[i], 0, __ATOMIC_RELAXED);
+	}
+	__atomic_store_n(&SWIFFT_stats.parallelNanoseconds, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&SWIFFT_stats.imbalanceNanoseconds, 0, __ATOMIC_RELAXED);
+	for (i=0; i<SWIFFT_STATS_MAX_THREADS; i++) {
+		__atomic_store_n(&SWIFFT_stats.threads[i].blocks, 0, __ATOMIC_RELAXED);
+		__atomic_store_n(&SWIFFT_stats.threads[i].nanoseconds, 0, __ATOMIC_RELAXED);
+	}
+}
+
+const char * SWIFFT_StatsEntryName(int entry)
+{
+	return entry >= 0 && entry < SWIFFT_STATS_ENTRIES ? SWIFFT_statsEntryNames[entry] : NULL;
+}
+
+LIBSWIFFT_END_EXTERN_C
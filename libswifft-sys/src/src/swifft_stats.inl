@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2021 Yaron Gvili and Gvili Tech Ltd.
+ *
+ * See the accompanying LICENSE.txt file for licensing information.
+ */
+/*! \file src/swifft_stats.inl
+ * \brief LibSWIFFT internal C definitions for collecting statistics of operations
+ */
+
+#include <stddef.h> // for size_t
+#include <stdint.h> // for uint64_t
+#include "swifft_stats.h"
+
+LIBSWIFFT_BEGIN_EXTERN_C
+
+//! \brief Where a run of an operation on multiple blocks ran.
+typedef enum {
+	SWIFFT_STATS_RUN_SERIAL,   ///< On the calling thread alone
+	SWIFFT_STATS_RUN_EXECUTOR, ///< On the executor set by SWIFFT_SetExecutor
+	SWIFFT_STATS_RUN_PARALLEL  ///< On the native pool or OpenMP
+} swifft_stats_run_t;
+
+//! \brief Whether statistics are being collected.
+extern int SWIFFT_statsEnabled;
+
+#ifdef SWIFFT_ENABLE_STATS
+	//! Whether statistics are being collected
+	#define SWIFFT_STATS_ON() __atomic_load_n(&SWIFFT_statsEnabled, __ATOMIC_RELAXED)
+#else
+	//! Statistics are never collected, so the code collecting them is removed
+	#define SWIFFT_STATS_ON() 0
+#endif
+
+//! \brief Makes a call to an entry point of the SWIFFT API, counting it when statistics are being collected.
+#define SWIFFT_STATS_CALL(entry, nblocks, call) \
+	do { \
+		if (SWIFFT_STATS_ON()) { \
+			uint64_t swifft_stats_start = SWIFFT_statsNow(); \
+			call; \
+			SWIFFT_statsCall(entry, nblocks, SWIFFT_statsNow() - swifft_stats_start); \
+		} else { \
+			call; \
+		} \
+	} while (0)
+
+//! \brief Returns the time of a monotonic clock.
+//!
+//! \returns the time, in nanoseconds.
+uint64_t SWIFFT_statsNow(void);
+
+//! \brief Counts a call to an entry point of the SWIFFT API.
+//!
+//! \param[in] entry the entry point, a swifft_stats_entry_t.
+//! \param[in] nblocks the number of blocks operated on by the call.
+//! \param[in] nanoseconds the wall-clock time spent in the call.
+void SWIFFT_statsCall(int entry, size_t nblocks, uint64_t nanoseconds);
+
+//! \brief Counts a run of an operation on multiple blocks.
+//!
+//! \param[in] run where the run ran, a swifft_stats_run_t.
+//! \param[in] nanoseconds the wall-clock time of the run, for a parallel run.
+//! \param[in] maxBusy the busy time of the busiest thread, for a parallel run.
+//! \param[in] totalBusy the busy time of all threads, for a parallel run.
+//! \param[in] nthreads the number of threads, for a parallel run.
+void SWIFFT_statsRun(int run, uint64_t nanoseconds, uint64_t maxBusy, uint64_t totalBusy, int nthreads);
+
+//! \brief Counts the work of a thread in a parallel run.
+//!
+//! \param[in] thread the index of the thread.
+//! \param[in] nblocks the number of blocks run by the thread.
+//! \param[in] nanoseconds the busy time of the thread.
+void SWIFFT_statsThread(int thread, size_t nblocks, uint64_t nanoseconds);
+
+LIBSWIFFT_END_EXTERN_C
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2021 Yaron Gvili and Gvili Tech Ltd.
+ *
+ * See the accompanying LICENSE.txt file for licensing information.
+ */
+/*! \file src/swifft_stream.c
+ * \brief LibSWIFFT public C implementation for hashing messages of any length
+ *
+ * SWIFFT is linear, so the hash value of a block of input is the sum of the
+ * hash value of its message bytes, with zeros in place of the chaining value,
+ * and the hash value of its chaining value, with zeros in place of the message
+ * bytes. The former does not depend on the chain, so when operations on
+ * multiple blocks run in parallel, runs of blocks compute it at once using
+ * SWIFFT_ComputeMultiple. Only the latter, covering a quarter of the input, is
+ * then computed block after block.
+ */
+
+#include <string.h> // for memcpy, memset
+#include "swifft.h"
+#include "swifft_impl.inl"
+
+#define SWIFFT_STREAM_BATCH_BLOCKS 32                       ///< Maximum number of blocks computed at once
+#define SWIFFT_STREAM_CHAIN_M (SWIFFT_COMPACT_BLOCK_SIZE/8) ///< Number of 8-elements in the chaining value
+
+LIBSWIFFT_BEGIN_EXTERN_C
+
+//! \brief Chains blocks of input into the chaining value of a stream.
+//! On a single thread, each block is computed whole, with its chaining value in place.
+//! Otherwise, the message bytes of all blocks are computed in parallel first.
+//!
+//! \param[in,out] chain the chaining value.
+//! \param[in] nblocks the number of blocks, at most SWIFFT_STREAM_BATCH_BLOCKS.
+//! \param[in,out] input the blocks of input, each with zeros in place of the chaining value, which may be overwritten.
+static void SWIFFT_streamBlocks(BitSequence chain[SWIFFT_COMPACT_BLOCK_SIZE], int nblocks, BitSequence * input)
+{
+	SWIFFT_ALIGN BitSequence output[SWIFFT_STREAM_BATCH_BLOCKS*SWIFFT_OUTPUT_BLOCK_SIZE];
+	SWIFFT_ALIGN BitSequence chainout[SWIFFT_OUTPUT_BLOCK_SIZE];
+	SWIFFT_ALIGN int16_t fftout[SWIFFT_N*SWIFFT_STREAM_CHAIN_M];
+	int i;
+	if (nblocks <= 1 || !SWIFFT_IsParallel()) {
+		for (i=0; i<nblocks; i++) {
+			BitSequence *block = input + i * SWIFFT_INPUT_BLOCK_SIZE;
+			memcpy(block, chain, SWIFFT_COMPACT_BLOCK_SIZE);
+			SWIFFT_Compute(block, output);
+			SWIFFT_Compact(output, chain);
+		}
+		return;
+	}
+	SWIFFT_ComputeMultiple(nblocks, input, output);
+	for (i=0; i<nblocks; i++) {
+		SWIFFT_fft(chain, SWIFFT_sign0, SWIFFT_STREAM_CHAIN_M, fftout);
+		SWIFFT_fftsum(SWIFFT_PI_key, fftout, SWIFFT_STREAM_CHAIN_M, (int16_t *)chainout);
+		SWIFFT_Add(output + i * SWIFFT_OUTPUT_BLOCK_SIZE, chainout);
+		SWIFFT_Compact(output + i * SWIFFT_OUTPUT_BLOCK_SIZE, chain);
+	}
+}
+
+void SWIFFT_StreamInit(swifft_stream_t * stream)
+{
+	memset(stream, 0, sizeof(swifft_stream_t));
+}
+
+void SWIFFT_StreamUpdate(swifft_stream_t * stream, const BitSequence * data, size_t size)
+{
+	SWIFFT_ALIGN BitSequence input[SWIFFT_STREAM_BATCH_BLOCKS*SWIFFT_INPUT_BLOCK_SIZE];
+	BitSequence *message = stream->block + SWIFFT_COMPACT_BLOCK_SIZE;
+	int nblocks, i;
+	stream->length += size;
+	if (stream->buffered > 0) {
+		size_t n = SWIFFT_STREAM_MESSAGE_SIZE - stream->buffered;
+		if (n > size) {
+			n = size;
+		}
+		memcpy(message + stream->buffered, data, n);
+		stream->buffered += n;
+		data += n;
+		size -= n;
+		if (stream->buffered < SWIFFT_STREAM_MESSAGE_SIZE) {
+			return;
+		}
+		SWIFFT_streamBlocks(stream->chain, 1, stream->block);
+		stream->buffered = 0;
+	}
+	while (size >= SWIFFT_STREAM_MESSAGE_SIZE) {
+		nblocks = size / SWIFFT_STREAM_MESSAGE_SIZE < SWIFFT_STREAM_BATCH_BLOCKS ?
+			(int)(size / SWIFFT_STREAM_MESSAGE_SIZE) : SWIFFT_STREAM_BATCH_BLOCKS;
+		for (i=0; i<nblocks; i++) {
+			BitSequence *block = input + i * SWIFFT_INPUT_BLOCK_SIZE;
+			memset(block, 0, SWIFFT_COMPACT_BLOCK_SIZE);
+			memcpy(block + SWIFFT_COMPACT_BLOCK_SIZE, data + i * SWIFFT_STREAM_MESSAGE_SIZE, SWIFFT_STREAM_MESSAGE_SIZE);
+		}
+		SWIFFT_streamBlocks(stream->chain, nblocks, input);
+		data += nblocks * SWIFFT_STREAM_MESSAGE_SIZE;
+		size -= nblocks * SWIFFT_STREAM_MESSAGE_SIZE;
+	}
+	memcpy(message, data, size);
+	stream->buffered = size;
+}
+
+void SWIFFT_StreamFinal(swifft_stream_t * stream, BitSequence digest[SWIFFT_STREAM_DIGEST_SIZE])
+{
+	BitSequence *message = stream->block + SWIFFT_COMPACT_BLOCK_SIZE;
+	uint64_t bits = stream->length * 8;
+	int i;
+	message[stream->buffered++] = 0x80;
+	memset(message + stream->buffered, 0, SWIFFT_STREAM_MESSAGE_SIZE - stream->buffered);
+	// the length goes in the last 8 message bytes, of an extra block if these are taken
+	if (stream->buffered > SWIFFT_STREAM_MESSAGE_SIZE - 8) {
+		SWIFFT_streamBlocks(stream->chain, 1, stream->block);
+		memset(message, 0, SWIFFT_STREAM_MESSAGE_SIZE);
+	}
+	for (i=0; i<8; i++) {
+		message[SWIFFT_STREAM_MESSAGE_SIZE - 8 + i] = (BitSequence)(bits >> (8*i));
+	}
+	SWIFFT_streamBlocks(stream->chain, 1, stream->block);
+	memcpy(digest, stream->chain, SWIFFT_STREAM_DIGEST_SIZE);
+}
+
+LIBSWIFFT_END_EXTERN_C
@@ -0,0 +1,24 @@
+/*
+ * Copyright (C) 2021 Yaron Gvili and Gvili Tech Ltd.
+ *
+ * See the accompanying LICENSE.txt file for licensing information.
+ */
+/*! \file src/swifft_sve2.c
+ * \brief LibSWIFFT public C implementation for SVE2
+ *
+ * See "src/swifft.inl" for code expanded here with SWIFFT_ISET set to SVE2.
+ *
+ * The kernels operate on vectors of a fixed size, so rather than scaling with
+ * the vector length, this variant computes two chunks per step, as AVX2 does,
+ * keeping more independent operations in flight on the SIMD pipelines of
+ * SVE2 cores, and lets the compiler use SVE2 instructions where they help.
+ */
+#include "common.h"
+
+#if defined(__ARM_FEATURE_SVE2)
+	#include "swifft_sve2.h"
+	#define SWIFFT_LOG2_O 1
+	#include "swifft.inl"
+#elif defined(__aarch64__)
+        #pragma message "Disabling generation of LibSWIFFT API for SVE2"
+#endif
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2021 Yaron Gvili and Gvili Tech Ltd.
+ *
+ * See the accompanying LICENSE.txt file for licensing information.
+ */
+/*! \file src/swifft_tree.c
+ * \brief LibSWIFFT public C implementation for hashing large messages in parallel as a tree
+ *
+ * The lower levels are computed by subtrees of at least SWIFFT_TREE_SUBTREE_LEAVES
+ * leaves, each reduced to a single digest in a small buffer local to one
+ * thread, so the digests of the leaves are never materialized for the whole
+ * message. The subtrees run in parallel, and then each of the upper levels does.
+ */
+
+#include <stdlib.h> // for malloc, free
+#include <string.h> // for memcpy, memset
+#include "swifft.h"
+
+#define SWIFFT_TREE_SUBTREE_LEAVES 16 ///< Minimum number of leaves of a subtree
+#define SWIFFT_TREE_STAGE_BLOCKS 8    ///< Number of blocks of input staged at once
+
+LIBSWIFFT_BEGIN_EXTERN_C
+
+//! \brief The arguments of hashing the subtrees of a tree, for running it on ranges of subtrees.
+typedef struct {
+	const BitSequence *data; ///< The message
+	size_t size;             ///< The number of bytes of the message
+	size_t leafSize;         ///< The number of bytes per leaf
+	int fanout;              ///< The number of digests per group
+	int levels;              ///< The number of levels of each subtree, or -1 if all the leaves are in one
+	size_t subtreeLeaves;    ///< The number of leaves of a full subtree
+	size_t nleaves;          ///< The number of leaves
+	const BitSequence *children; ///< The digests of the level below, when computing an upper level
+	size_t nchildren;        ///< The number of digests of the level below
+	BitSequence *digests;    ///< The resulting digests, one per subtree or per group
+} swifft_tree_task_t;
+
+//! \brief Computes the digests of groups of digests of a level.
+//! The children may be the parents, when computing all the groups of the level at once.
+//!
+//! \param[in] children the digests of the level.
+//! \param[in] nchildren the number of digests of the level.
+//! \param[in] fanout the number of digests per group.
+//! \param[in] begin the index of the first group.
+//! \param[in] end the index past the last group.
+//! \param[out] parents the digests of the groups, indexed from 0 for the first group.
+static void SWIFFT_treeGroups(const BitSequence * children, size_t nchildren, int fanout,
+	size_t begin, size_t end, BitSequence * parents)
+{
+	SWIFFT_ALIGN BitSequence input[SWIFFT_TREE_STAGE_BLOCKS*SWIFFT_INPUT_BLOCK_SIZE];
+	SWIFFT_ALIGN BitSequence compact[SWIFFT_TREE_STAGE_BLOCKS*SWIFFT_COMPACT_BLOCK_SIZE];
+	size_t j,k;
+	for (j=begin; j<end; j+=SWIFFT_TREE_STAGE_BLOCKS) {
+		size_t count = end - j < SWIFFT_TREE_STAGE_BLOCKS ? end - j : SWIFFT_TREE_STAGE_BLOCKS;
+		memset(input, 0, count * SWIFFT_INPUT_BLOCK_SIZE);
+		for (k=0; k<count; k++) {
+			size_t first = (j + k) * fanout;
+			size_t n = nchildren - first < (size_t)fanout ? nchildren - first : (size_t)fanout;
+			memcpy(input + k * SWIFFT_INPUT_BLOCK_SIZE, children + first * SWIFFT_COMPACT_BLOCK_SIZE, n * SWIFFT_COMPACT_BLOCK_SIZE);
+		}
+		SWIFFT_ComputeCompactMultiple(count, input, compact);
+		memcpy(parents + (j - begin) * SWIFFT_COMPACT_BLOCK_SIZE, compact, count * SWIFFT_COMPACT_BLOCK_SIZE);
+	}
+}
+
+//! \brief Computes the digests of leaves of a tree.
+//!
+//! \param[in] task the tree, as a swifft_tree_task_t.
+//! \param[in] begin the index of the first leaf.
+//! \param[in] end the index past the last leaf.
+//! \param[out] digests the digests of the leaves, indexed from 0 for the first leaf.
+static void SWIFFT_treeLeaves(const swifft_tree_task_t * task, size_t begin, size_t end, BitSequence * digests)
+{
+	SWIFFT_ALIGN BitSequence input[SWIFFT_TREE_STAGE_BLOCKS*SWIFFT_INPUT_BLOCK_SIZE];
+	size_t i = begin, k;
+	// full leaves of aligned data are already blocks of input, so they are hashed in place
+	if (task->leafSize == SWIFFT_INPUT_BLOCK_SIZE && (uintptr_t)task->data % SWIFFT_ALIGNMENT == 0) {
+		size_t full = task->size / SWIFFT_INPUT_BLOCK_SIZE < end ? task->size / SWIFFT_INPUT_BLOCK_SIZE : end;
+		if (full > begin) {
+			SWIFFT_ComputeCompactMultiple(full - begin, task->data + begin * SWIFFT_INPUT_BLOCK_SIZE, digests);
+			i = full;
+		}
+	}
+	for (; i<end; i+=SWIFFT_TREE_STAGE_BLOCKS) {
+		size_t count = end - i < SWIFFT_TREE_STAGE_BLOCKS ? end - i : SWIFFT_TREE_STAGE_BLOCKS;
+		memset(input, 0, count * SWIFFT_INPUT_BLOCK_SIZE);
+		for (k=0; k<count; k++) {
+			size_t offset = (i + k) * task->leafSize;
+			size_t n = task->size - offset < task->leafSize ? task->size - offset : task->leafSize;
+			memcpy(input + k * SWIFFT_INPUT_BLOCK_SIZE, task->data + offset, n);
+		}
+		SWIFFT_ComputeCompactMultiple(count, input, digests + (i - begin) * SWIFFT_COMPACT_BLOCK_SIZE);
+	}
+}
+
+//! \brief Reduces subtrees of a tree to their digests, on a range of subtrees, given a swifft_tree_task_t.
+static void SWIFFT_treeSubtrees(void *vtask, size_t begin, size_t end)
+{
+	const swifft_tree_task_t *task = (const swifft_tree_task_t *)vtask;
+	SWIFFT_ALIGN BitSequence digests[SWIFFT_TREE_MAX_FANOUT*SWIFFT_TREE_SUBTREE_LEAVES*SWIFFT_COMPACT_BLOCK_SIZE];
+	size_t s;
+	int l;
+	for (s=begin; s<end; s++) {
+		size_t first = s * task->subtreeLeaves;
+		size_t n = task->nleaves - first < task->subtreeLeaves ? task->nleaves - first : task->subtreeLeaves;
+		SWIFFT_treeLeaves(task, first, first + n, digests);
+		for (l=0; task->levels < 0 ? n > 1 : l < task->levels; l++) {
+			size_t ngroups = (n + task->fanout - 1) / task->fanout;
+			SWIFFT_treeGroups(digests, n, task->fanout, 0, ngroups, digests);
+			n = ngroups;
+		}
+		memcpy(task->digests + s * SWIFFT_COMPACT_BLOCK_SIZE, digests, SWIFFT_COMPACT_BLOCK_SIZE);
+	}
+}
+
+//! \brief Computes the digests of groups of an upper level of a tree, on a range of groups, given a swifft_tree_task_t.
+static void SWIFFT_treeUpperGroups(void *vtask, size_t begin, size_t end)
+{
+	const swifft_tree_task_t *task = (const swifft_tree_task_t *)vtask;
+	SWIFFT_treeGroups(task->children, task->nchildren, task->fanout, begin, end,
+		task->digests + (size_t)begin * SWIFFT_COMPACT_BLOCK_SIZE);
+}
+
+int SWIFFT_TreeHash(const BitSequence * data, size_t size, size_t leafSize, int fanout,
+	BitSequence digest[SWIFFT_TREE_DIGEST_SIZE])
+{
+	SWIFFT_ALIGN BitSequence root[SWIFFT_INPUT_BLOCK_SIZE];
+	SWIFFT_ALIGN BitSequence output[SWIFFT_OUTPUT_BLOCK_SIZE];
+	swifft_tree_task_t task;
+	uint64_t params[3];
+	BitSequence *digests, *parents;
+	size_t nsubtrees, n;
+	int i;
+	if (leafSize < 1 || leafSize > SWIFFT_TREE_MAX_LEAF_SIZE || fanout < 2 || fanout > SWIFFT_TREE_MAX_FANOUT) {
+		return -1;
+	}
+	task.data = data;
+	task.size = size;
+	task.leafSize = leafSize;
+	task.fanout = fanout;
+	task.nleaves = size == 0 ? 1 : (size + leafSize - 1) / leafSize;
+	task.levels = 0;
+	for (task.subtreeLeaves = 1; task.subtreeLeaves < SWIFFT_TREE_SUBTREE_LEAVES; task.subtreeLeaves *= fanout) {
+		task.levels++;
+	}
+	nsubtrees = (task.nleaves + task.subtreeLeaves - 1) / task.subtreeLeaves;
+	if (nsubtrees == 1) {
+		task.levels = -1;
+	}
+	digests = (BitSequence *)malloc(2 * nsubtrees * SWIFFT_COMPACT_BLOCK_SIZE);
+	if (digests == NULL) {
+		return -1;
+	}
+	task.digests = digests;
+	SWIFFT_ParallelFor(nsubtrees, SWIFFT_treeSubtrees, &task);
+
+	// the digests of a level and of the level above alternate between two halves of the buffer
+	parents = digests + nsubtrees * SWIFFT_COMPACT_BLOCK_SIZE;
+	for (n=nsubtrees; n>1; n=(n + fanout - 1) / fanout) {
+		task.children = digests;
+		task.nchildren = n;
+		task.digests = parents;
+		SWIFFT_ParallelFor((n + fanout - 1) / fanout, SWIFFT_treeUpperGroups, &task);
+		parents = digests;
+		digests = task.digests;
+	}
+
+	params[0] = size;
+	params[1] = leafSize;
+	params[2] = fanout;
+	memset(root, 0, SWIFFT_INPUT_BLOCK_SIZE);
+	memcpy(root, digests, SWIFFT_COMPACT_BLOCK_SIZE);
+	for (i=0; i<3*8; i++) {
+		root[SWIFFT_COMPACT_BLOCK_SIZE + i] = (BitSequence)(params[i / 8] >> (8 * (i % 8)));
+	}
+	SWIFFT_Compute(root, output);
+	SWIFFT_Compact(output, digest);
+	free(digests < parents ? digests : parents);
+	return 0;
+}
+
+LIBSWIFFT_END_EXTERN_C
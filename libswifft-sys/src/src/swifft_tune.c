@@ -0,0 +1,356 @@
+/*
+ * Copyright (C) 2021 Yaron Gvili and Gvili Tech Ltd.
+ *
+ * See the accompanying LICENSE.txt file for licensing information.
+ */
+/*! \file src/swifft_tune.c
+ * \brief LibSWIFFT public C implementation for tuning operations to the running machine
+ *
+ * Each class of operations is measured on one representative operation, on a
+ * batch of blocks that fits in the cache, on the calling thread alone, taking
+ * the fastest of a few runs. The cost of a parallel run is measured on a task
+ * doing nothing. An operation of n blocks, each costing c, then pays off in
+ * parallel on p threads once n*c*(1-1/p) exceeds that cost.
+ */
+
+#include <stdint.h> // for SIZE_MAX
+#include <stdio.h>  // for FILE, fopen, snprintf
+#include <stdlib.h> // for posix_memalign, strtoull
+#include <string.h> // for memcpy, memset, strcmp, strcspn, strlen, strncmp, strncpy
+#include "swifft.h"
+#include "swifft_object.h"
+#include "swifft_impl.inl"
+#include "swifft_stats.inl"
+
+#define SWIFFT_TUNE_VERSION 1                 ///< The version of the text of a profile
+#define SWIFFT_TUNE_BLOCKS 256                ///< Number of blocks of a measured batch
+#define SWIFFT_TUNE_RUNS 5                    ///< Number of runs of a measured batch, of which the fastest counts
+#define SWIFFT_TUNE_PARALLEL_RUNS 32          ///< Number of parallel runs of a task doing nothing, of which the fastest counts
+#define SWIFFT_TUNE_RANGE_NANOSECONDS 16000   ///< Work per range that a grain aims at, long enough to amortize claiming it
+#define SWIFFT_TUNE_MIN_BLOCKS 4              ///< Minimum threshold and grain, a group of blocks for the widest instruction set
+#define SWIFFT_TUNE_MAX_THRESHOLD (1 << 20)   ///< Maximum threshold
+#define SWIFFT_TUNE_MAX_GRAIN 4096            ///< Maximum grain
+
+
+LIBSWIFFT_BEGIN_EXTERN_C
+
+//! \brief The names of the classes of operations in the text of a profile, indexed by swifft_op_class_t.
+static const char * const SWIFFT_tuneClassNames[SWIFFT_OP_CLASSES] = { "arith", "compact", "fft", "hash" };
+
+//! \brief The names of the instruction sets that may be built into the library.
+static const char * const SWIFFT_tuneIsets[] = { "AVX", "AVX2", "AVX512", "AVX512BW", "NEON", "SVE2" };
+
+//! \brief The buffers of measured batches.
+typedef struct {
+	BitSequence *input;  ///< The blocks of input
+	BitSequence *output; ///< The blocks of hash values
+	BitSequence *compact;///< The blocks of compacted hash values
+	int16_t *fftout;     ///< The blocks of FFT-output elements
+} SWIFFT_tuneBuffers_t;
+
+void SWIFFT_GetProfile(swifft_profile_t * profile)
+{
+	int op;
+	memset(profile, 0, sizeof(*profile));
+	strncpy(profile->iset, SWIFFT_GetInstructionSet(), SWIFFT_PROFILE_ISET_SIZE - 1);
+	profile->threads = SWIFFT_GetThreads();
+	for (op=0; op<SWIFFT_OP_CLASSES; op++) {
+		profile->threshold[op] = SWIFFT_GetOpThreshold(op);
+		profile->grain[op] = SWIFFT_GetOpGrain(op);
+	}
+}
+
+int SWIFFT_SetProfile(const swifft_profile_t * profile)
+{
+	int op;
+	if (SWIFFT_SetInstructionSet(profile->iset) != 0) {
+		return -1;
+	}
+	for (op=0; op<SWIFFT_OP_CLASSES; op++) {
+		SWIFFT_SetOpThreshold(op, profile->threshold[op]);
+		SWIFFT_SetOpGrain(op, profile->grain[op]);
+	}
+	return 0;
+}
+
+int SWIFFT_FormatProfile(const swifft_profile_t * profile, char * text, size_t size)
+{
+	size_t length;
+	int n, op;
+	n = snprintf(text, size, "swifft-profile %d iset=%s threads=%d", SWIFFT_TUNE_VERSION, profile->iset, profile->threads);
+	if (n < 0 || (size_t)n >= size) {
+		return -1;
+	}
+	length = n;
+	for (op=0; op<SWIFFT_OP_CLASSES; op++) {
+		n = snprintf(text + length, size - length, " %s=%zu/%d", SWIFFT_tuneClassNames[op],
+			profile->threshold[op], profile->grain[op]);
+		if (n < 0 || (size_t)n >= size - length) {
+			return -1;
+		}
+		length += n;
+	}
+	return (int)length;
+}
+
+int SWIFFT_ParseProfile(const char * text, swifft_profile_t * profile)
+{
+	const char *p = text;
+	char *end;
+	int op;
+	SWIFFT_GetProfile(profile);
+	if (strncmp(p, "swifft-profile ", 15) != 0 || strtol(p + 15, &end, 10) != SWIFFT_TUNE_VERSION) {
+		return -1;
+	}
+	for (p=end; *p == ' '; ) {
+		size_t length;
+		p++;
+		if (strncmp(p, "iset=", 5) == 0) {
+			p += 5;
+			length = strcspn(p, " \n");
+			if (length == 0 || length >= SWIFFT_PROFILE_ISET_SIZE) {
+				return -1;
+			}
+			memcpy(profile->iset, p, length);
+			profile->iset[length] = '\0';
+			p += length;
+			continue;
+		}
+		if (strncmp(p, "threads=", 8) == 0) {
+			profile->threads = (int)strtol(p + 8, &end, 10);
+			p = end;
+			continue;
+		}
+		for (op=0; op<SWIFFT_OP_CLASSES; op++) {
+			length = strlen(SWIFFT_tuneClassNames[op]);
+			if (strncmp(p, SWIFFT_tuneClassNames[op], length) == 0 && p[length] == '=') {
+				break;
+			}
+		}
+		if (op == SWIFFT_OP_CLASSES) {
+			return -1;
+		}
+		profile->threshold[op] = (size_t)strtoull(p + length + 1, &end, 10);
+		if (*end != '/') {
+			return -1;
+		}
+		profile->grain[op] = (int)strtol(end + 1, &end, 10);
+		if (profile->grain[op] <= 0) {
+			return -1;
+		}
+		p = end;
+	}
+	return *p == '\0' || *p == '\n' ? 0 : -1;
+}
+
+//! \brief Returns the time of the fastest of a few runs of the representative operation of a class.
+//!
+//! \param[in] o the SWIFFT object of the instruction set.
+//! \param[in] op the class of operations.
+//! \param[in] b the buffers.
+//! \returns the time per block, in nanoseconds.
+static double SWIFFT_tuneClass(const swifft_object_t *o, int op, const SWIFFT_tuneBuffers_t *b)
+{
+	uint64_t best = UINT64_MAX;
+	int r;
+	for (r=0; r<SWIFFT_TUNE_RUNS; r++) {
+		uint64_t start = SWIFFT_statsNow(), elapsed;
+		switch (op) {
+		case SWIFFT_OP_ARITH:
+			o->arith.SWIFFT_AddMultiple(SWIFFT_TUNE_BLOCKS, b->output, b->output);
+			break;
+		case SWIFFT_OP_COMPACT:
+			o->hash.SWIFFT_CompactMultiple(SWIFFT_TUNE_BLOCKS, b->output, b->compact);
+			break;
+		case SWIFFT_OP_FFT:
+			o->fft.SWIFFT_fftMultiple(SWIFFT_TUNE_BLOCKS, b->input, SWIFFT_sign0, SWIFFT_INPUT_CHUNKS, b->fftout);
+			break;
+		default:
+			o->hash.SWIFFT_ComputeMultiple(SWIFFT_TUNE_BLOCKS, b->input, b->output);
+			break;
+		}
+		elapsed = SWIFFT_statsNow() - start;
+		best = elapsed < best ? elapsed : best;
+	}
+	return (double)best / SWIFFT_TUNE_BLOCKS;
+}
+
+//! \brief Runs a task doing nothing.
+static void SWIFFT_tuneNothing(void *task, size_t begin, size_t end)
+{
+	(void)task;
+	(void)begin;
+	(void)end;
+}
+
+//! \brief Returns the time of the fastest of a few parallel runs of a task doing nothing.
+//!
+//! \returns the time, in nanoseconds.
+static double SWIFFT_tuneParallel(void)
+{
+	uint64_t best = UINT64_MAX;
+	int r;
+	SWIFFT_SetOpThreshold(SWIFFT_OP_HASH, 0);
+	for (r=0; r<SWIFFT_TUNE_PARALLEL_RUNS; r++) {
+		uint64_t start = SWIFFT_statsNow(), elapsed;
+		SWIFFT_ParallelForOp(SWIFFT_TUNE_BLOCKS, SWIFFT_OP_HASH, SWIFFT_tuneNothing, NULL);
+		elapsed = SWIFFT_statsNow() - start;
+		best = elapsed < best ? elapsed : best;
+	}
+	return (double)best;
+}
+
+//! \brief Clamps a number of blocks, rounding it up to a multiple of SWIFFT_TUNE_MIN_BLOCKS.
+//!
+//! \param[in] blocks the number of blocks.
+//! \param[in] max the maximum number of blocks.
+//! \returns the clamped number of blocks.
+static size_t SWIFFT_tuneClamp(double blocks, size_t max)
+{
+	size_t n = blocks < (double)max ? (size_t)blocks + 1 : max;
+	n = (n + SWIFFT_TUNE_MIN_BLOCKS - 1) & ~(size_t)(SWIFFT_TUNE_MIN_BLOCKS - 1);
+	return n < SWIFFT_TUNE_MIN_BLOCKS ? SWIFFT_TUNE_MIN_BLOCKS : n > max ? max : n;
+}
+
+//! \brief Measures a profile of the SWIFFT API on the running machine.
+//!
+//! \param[out] profile the profile.
+//! \returns 0 on success, or -1 if memory is exhausted.
+static int SWIFFT_tuneMeasure(swifft_profile_t * profile)
+{
+	SWIFFT_tuneBuffers_t b;
+	swifft_profile_t saved;
+	double cost[SWIFFT_OP_CLASSES], bestTotal = 0, overhead, parallelShare;
+	void *p[4] = { NULL, NULL, NULL, NULL };
+	size_t i;
+	int op, nthreads;
+
+	if (posix_memalign(&p[0], SWIFFT_ALIGNMENT, SWIFFT_TUNE_BLOCKS * SWIFFT_INPUT_BLOCK_SIZE) != 0 ||
+		posix_memalign(&p[1], SWIFFT_ALIGNMENT, SWIFFT_TUNE_BLOCKS * SWIFFT_OUTPUT_BLOCK_SIZE) != 0 ||
+		posix_memalign(&p[2], SWIFFT_ALIGNMENT, SWIFFT_TUNE_BLOCKS * SWIFFT_COMPACT_BLOCK_SIZE) != 0 ||
+		posix_memalign(&p[3], SWIFFT_ALIGNMENT, SWIFFT_TUNE_BLOCKS * SWIFFT_N * SWIFFT_INPUT_CHUNKS * sizeof(int16_t)) != 0) {
+		for (i=0; i<4; i++) {
+			free(p[i]);
+		}
+		return -1;
+	}
+	b.input = (BitSequence *)p[0];
+	b.output = (BitSequence *)p[1];
+	b.compact = (BitSequence *)p[2];
+	b.fftout = (int16_t *)p[3];
+	for (i=0; i<SWIFFT_TUNE_BLOCKS * SWIFFT_INPUT_BLOCK_SIZE; i++) {
+		b.input[i] = (BitSequence)(i * 0x9e3779b1u >> 24);
+	}
+	memset(b.output, 0, SWIFFT_TUNE_BLOCKS * SWIFFT_OUTPUT_BLOCK_SIZE);
+
+	// measure on the calling thread alone
+	SWIFFT_GetProfile(&saved);
+	*profile = saved;
+	for (op=0; op<SWIFFT_OP_CLASSES; op++) {
+		SWIFFT_SetOpThreshold(op, SIZE_MAX);
+	}
+	for (i=0; i<sizeof(SWIFFT_tuneIsets)/sizeof(SWIFFT_tuneIsets[0]); i++) {
+		swifft_object_t o;
+		double c[SWIFFT_OP_CLASSES], total = 0;
+		const char *iset = SWIFFT_InitObjectByName(&o, SWIFFT_tuneIsets[i]);
+#ifdef SWIFFT_INSTRUCTION_SET
+		// the SWIFFT API uses the instruction set available at build time only
+		if (iset != NULL && strcmp(iset, LIBSWIFFT_QUOTE(SWIFFT_INSTRUCTION_SET)) != 0) {
+			iset = NULL;
+		}
+#endif
+		if (iset == NULL) {
+			continue;
+		}
+		for (op=0; op<SWIFFT_OP_CLASSES; op++) {
+			c[op] = SWIFFT_tuneClass(&o, op, &b);
+			total += c[op];
+		}
+		// the fastest instruction set over all classes, whose total hashing dominates
+		if (bestTotal == 0 || total < bestTotal) {
+			bestTotal = total;
+			strncpy(profile->iset, iset, SWIFFT_PROFILE_ISET_SIZE - 1);
+			memcpy(cost, c, sizeof(cost));
+		}
+	}
+	overhead = SWIFFT_IsParallel() ? SWIFFT_tuneParallel() : 0;
+	for (op=0; op<SWIFFT_OP_CLASSES; op++) {
+		SWIFFT_SetOpThreshold(op, saved.threshold[op]);
+	}
+	for (i=0; i<4; i++) {
+		free(p[i]);
+	}
+	if (bestTotal == 0) {
+		return 0;
+	}
+
+	// an executor or OpenMP may run on any number of threads, so assume the least
+	nthreads = SWIFFT_GetThreads();
+	parallelShare = 1.0 - 1.0 / (nthreads > 1 ? nthreads : 2);
+	profile->threads = nthreads;
+	for (op=0; op<SWIFFT_OP_CLASSES; op++) {
+		double c = cost[op] > 0 ? cost[op] : 1;
+		profile->threshold[op] = SWIFFT_tuneClamp(overhead / (c * parallelShare), SWIFFT_TUNE_MAX_THRESHOLD);
+		profile->grain[op] = (int)SWIFFT_tuneClamp(SWIFFT_TUNE_RANGE_NANOSECONDS / c, SWIFFT_TUNE_MAX_GRAIN);
+	}
+	return 0;
+}
+
+//! \brief Loads a profile from a file.
+//!
+//! \param[in] path the file.
+//! \param[out] profile the profile.
+//! \returns 0 on success, or -1 if the file is missing or does not hold a profile.
+static int SWIFFT_tuneLoad(const char * path, swifft_profile_t * profile)
+{
+	char text[SWIFFT_PROFILE_MAX_SIZE];
+	FILE *file = fopen(path, "r");
+	int result = -1;
+	if (file == NULL) {
+		return -1;
+	}
+	if (fgets(text, sizeof(text), file) != NULL) {
+		result = SWIFFT_ParseProfile(text, profile);
+	}
+	fclose(file);
+	return result;
+}
+
+//! \brief Saves a profile in a file.
+//!
+//! \param[in] path the file.
+//! \param[in] profile the profile.
+//! \returns 0 on success, or -1 on failure.
+static int SWIFFT_tuneSave(const char * path, const swifft_profile_t * profile)
+{
+	char text[SWIFFT_PROFILE_MAX_SIZE];
+	FILE *file;
+	int result;
+	if (SWIFFT_FormatProfile(profile, text, sizeof(text)) < 0 || (file = fopen(path, "w")) == NULL) {
+		return -1;
+	}
+	result = fprintf(file, "%s\n", text) < 0 ? -1 : 0;
+	if (fclose(file) != 0) {
+		result = -1;
+	}
+	return result;
+}
+
+int SWIFFT_Tune(const char * path)
+{
+	swifft_profile_t profile;
+	if (path != NULL && SWIFFT_tuneLoad(path, &profile) == 0 && profile.threads == SWIFFT_GetThreads() &&
+		SWIFFT_SetProfile(&profile) == 0) {
+		return 0;
+	}
+	if (SWIFFT_tuneMeasure(&profile) != 0) {
+		return -1;
+	}
+	SWIFFT_SetProfile(&profile);
+	if (path != NULL && SWIFFT_tuneSave(path, &profile) != 0) {
+		return -1;
+	}
+	return 1;
+}
+
+LIBSWIFFT_END_EXTERN_C
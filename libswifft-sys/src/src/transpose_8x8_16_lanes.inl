@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2021 Yaron Gvili and Gvili Tech Ltd.
+ *
+ * See the accompanying LICENSE.txt file for licensing information.
+ */
+/*! \file src/transpose_8x8_16_lanes.inl
+ * \brief LibSWIFFT internal 8x8 16-bit transposes within the 128-bit lanes of a wide SWIFFT vector
+ *
+ * The unpack instructions of SSE2, AVX2 and AVX512BW operate within 128-bit
+ * lanes, so the same sequence that transposes one 8x8 matrix of 16-bit elements
+ * held in 8 128-bit registers transposes SWIFFT_O such matrices, one per lane,
+ * held in 8 wide registers. The zip instructions of NEON are applied to each
+ * 128-bit lane in turn, to the same effect.
+ */
+
+#if defined(__x86_64__) || defined(__i386__)
+	#include <immintrin.h>
+#elif defined(__ARM_NEON)
+	#include <arm_neon.h>
+#endif
+
+#if SWIFFT_O == 4 && defined(__AVX512BW__)
+	typedef __m512i SWIFFT_lanes_t;                        ///< Register type of a wide SWIFFT vector
+	#define SWIFFT_UNPACKLO_EPI16(a,b) _mm512_unpacklo_epi16(a,b) ///< Interleaves low 16-bit elements per lane
+	#define SWIFFT_UNPACKHI_EPI16(a,b) _mm512_unpackhi_epi16(a,b) ///< Interleaves high 16-bit elements per lane
+	#define SWIFFT_UNPACKLO_EPI32(a,b) _mm512_unpacklo_epi32(a,b) ///< Interleaves low 32-bit elements per lane
+	#define SWIFFT_UNPACKHI_EPI32(a,b) _mm512_unpackhi_epi32(a,b) ///< Interleaves high 32-bit elements per lane
+	#define SWIFFT_UNPACKLO_EPI64(a,b) _mm512_unpacklo_epi64(a,b) ///< Interleaves low 64-bit elements per lane
+	#define SWIFFT_UNPACKHI_EPI64(a,b) _mm512_unpackhi_epi64(a,b) ///< Interleaves high 64-bit elements per lane
+	#define SWIFFT_PACKUS_EPI16(a,b) _mm512_packus_epi16(a,b)     ///< Packs 16-bit elements to 8-bit ones per lane
+	#define SWIFFT_HAVE_TRANSPOSE_LANES                            ///< Transposes within lanes are available
+#elif SWIFFT_O == 2 && defined(__AVX2__)
+	typedef __m256i SWIFFT_lanes_t;
+	#define SWIFFT_UNPACKLO_EPI16(a,b) _mm256_unpacklo_epi16(a,b)
+	#define SWIFFT_UNPACKHI_EPI16(a,b) _mm256_unpackhi_epi16(a,b)
+	#define SWIFFT_UNPACKLO_EPI32(a,b) _mm256_unpacklo_epi32(a,b)
+	#define SWIFFT_UNPACKHI_EPI32(a,b) _mm256_unpackhi_epi32(a,b)
+	#define SWIFFT_UNPACKLO_EPI64(a,b) _mm256_unpacklo_epi64(a,b)
+	#define SWIFFT_UNPACKHI_EPI64(a,b) _mm256_unpackhi_epi64(a,b)
+	#define SWIFFT_PACKUS_EPI16(a,b) _mm256_packus_epi16(a,b)
+	#define SWIFFT_HAVE_TRANSPOSE_LANES
+#elif SWIFFT_O == 1 && defined(__SSE2__)
+	typedef __m128i SWIFFT_lanes_t;
+	#define SWIFFT_UNPACKLO_EPI16(a,b) _mm_unpacklo_epi16(a,b)
+	#define SWIFFT_UNPACKHI_EPI16(a,b) _mm_unpackhi_epi16(a,b)
+	#define SWIFFT_UNPACKLO_EPI32(a,b) _mm_unpacklo_epi32(a,b)
+	#define SWIFFT_UNPACKHI_EPI32(a,b) _mm_unpackhi_epi32(a,b)
+	#define SWIFFT_UNPACKLO_EPI64(a,b) _mm_unpacklo_epi64(a,b)
+	#define SWIFFT_UNPACKHI_EPI64(a,b) _mm_unpackhi_epi64(a,b)
+	#define SWIFFT_PACKUS_EPI16(a,b) _mm_packus_epi16(a,b)
+	#define SWIFFT_HAVE_TRANSPOSE_LANES
+#elif SWIFFT_O <= 2 && defined(__ARM_NEON)
+	typedef ZOvec SWIFFT_lanes_t;
+
+	//! \brief Defines a function applying a NEON operation on x and y to each 128-bit lane of a and b.
+	#define SWIFFT_NEON_LANES(name, op) \
+		static LIBSWIFFT_INLINE SWIFFT_lanes_t name(SWIFFT_lanes_t a, SWIFFT_lanes_t b) \
+		{ \
+			SWIFFT_lanes_t r; \
+			int j; \
+			for (j=0; j<SWIFFT_O; j++) { \
+				int16x8_t x = ((const int16x8_t *)&a)[j], y = ((const int16x8_t *)&b)[j]; \
+				((int16x8_t *)&r)[j] = (op); \
+			} \
+			return r; \
+		}
+	SWIFFT_NEON_LANES(SWIFFT_zip1Lanes16, vzip1q_s16(x, y))
+	SWIFFT_NEON_LANES(SWIFFT_zip2Lanes16, vzip2q_s16(x, y))
+	SWIFFT_NEON_LANES(SWIFFT_zip1Lanes32, vreinterpretq_s16_s32(vzip1q_s32(vreinterpretq_s32_s16(x), vreinterpretq_s32_s16(y))))
+	SWIFFT_NEON_LANES(SWIFFT_zip2Lanes32, vreinterpretq_s16_s32(vzip2q_s32(vreinterpretq_s32_s16(x), vreinterpretq_s32_s16(y))))
+	SWIFFT_NEON_LANES(SWIFFT_zip1Lanes64, vreinterpretq_s16_s64(vzip1q_s64(vreinterpretq_s64_s16(x), vreinterpretq_s64_s16(y))))
+	SWIFFT_NEON_LANES(SWIFFT_zip2Lanes64, vreinterpretq_s16_s64(vzip2q_s64(vreinterpretq_s64_s16(x), vreinterpretq_s64_s16(y))))
+	SWIFFT_NEON_LANES(SWIFFT_packusLanes16, vreinterpretq_s16_u8(vcombine_u8(vqmovun_s16(x), vqmovun_s16(y))))
+	#undef SWIFFT_NEON_LANES
+
+	#define SWIFFT_UNPACKLO_EPI16(a,b) SWIFFT_zip1Lanes16(a,b)
+	#define SWIFFT_UNPACKHI_EPI16(a,b) SWIFFT_zip2Lanes16(a,b)
+	#define SWIFFT_UNPACKLO_EPI32(a,b) SWIFFT_zip1Lanes32(a,b)
+	#define SWIFFT_UNPACKHI_EPI32(a,b) SWIFFT_zip2Lanes32(a,b)
+	#define SWIFFT_UNPACKLO_EPI64(a,b) SWIFFT_zip1Lanes64(a,b)
+	#define SWIFFT_UNPACKHI_EPI64(a,b) SWIFFT_zip2Lanes64(a,b)
+	#define SWIFFT_PACKUS_EPI16(a,b) SWIFFT_packusLanes16(a,b)
+	#define SWIFFT_HAVE_TRANSPOSE_LANES
+#endif
+
+#ifdef SWIFFT_HAVE_TRANSPOSE_LANES
+LIBSWIFFT_STATIC_ASSERT(sizeof(ZOvec) == sizeof(SWIFFT_lanes_t), ZOvec_and_SWIFFT_lanes_t_must_have_the_same_size);
+
+//! \brief Transposes the 8x8 matrices of 16-bit elements held in each 128-bit lane, in place.
+//!
+//! \param[in,out] v the 8 rows of the matrices, one wide SWIFFT vector per row.
+static inline void SWIFFT_transposeLanes(ZOvec v[8])
+{
+	SWIFFT_lanes_t *x = (SWIFFT_lanes_t *)v;
+
+	SWIFFT_lanes_t a03b03 = SWIFFT_UNPACKLO_EPI16(x[0], x[1]);
+	SWIFFT_lanes_t c03d03 = SWIFFT_UNPACKLO_EPI16(x[2], x[3]);
+	SWIFFT_lanes_t e03f03 = SWIFFT_UNPACKLO_EPI16(x[4], x[5]);
+	SWIFFT_lanes_t g03h03 = SWIFFT_UNPACKLO_EPI16(x[6], x[7]);
+	SWIFFT_lanes_t a47b47 = SWIFFT_UNPACKHI_EPI16(x[0], x[1]);
+	SWIFFT_lanes_t c47d47 = SWIFFT_UNPACKHI_EPI16(x[2], x[3]);
+	SWIFFT_lanes_t e47f47 = SWIFFT_UNPACKHI_EPI16(x[4], x[5]);
+	SWIFFT_lanes_t g47h47 = SWIFFT_UNPACKHI_EPI16(x[6], x[7]);
+
+	SWIFFT_lanes_t a01b01c01d01 = SWIFFT_UNPACKLO_EPI32(a03b03, c03d03);
+	SWIFFT_lanes_t a23b23c23d23 = SWIFFT_UNPACKHI_EPI32(a03b03, c03d03);
+	SWIFFT_lanes_t e01f01g01h01 = SWIFFT_UNPACKLO_EPI32(e03f03, g03h03);
+	SWIFFT_lanes_t e23f23g23h23 = SWIFFT_UNPACKHI_EPI32(e03f03, g03h03);
+	SWIFFT_lanes_t a45b45c45d45 = SWIFFT_UNPACKLO_EPI32(a47b47, c47d47);
+	SWIFFT_lanes_t a67b67c67d67 = SWIFFT_UNPACKHI_EPI32(a47b47, c47d47);
+	SWIFFT_lanes_t e45f45g45h45 = SWIFFT_UNPACKLO_EPI32(e47f47, g47h47);
+	SWIFFT_lanes_t e67f67g67h67 = SWIFFT_UNPACKHI_EPI32(e47f47, g47h47);
+
+	x[0] = SWIFFT_UNPACKLO_EPI64(a01b01c01d01, e01f01g01h01);
+	x[1] = SWIFFT_UNPACKHI_EPI64(a01b01c01d01, e01f01g01h01);
+	x[2] = SWIFFT_UNPACKLO_EPI64(a23b23c23d23, e23f23g23h23);
+	x[3] = SWIFFT_UNPACKHI_EPI64(a23b23c23d23, e23f23g23h23);
+	x[4] = SWIFFT_UNPACKLO_EPI64(a45b45c45d45, e45f45g45h45);
+	x[5] = SWIFFT_UNPACKHI_EPI64(a45b45c45d45, e45f45g45h45);
+	x[6] = SWIFFT_UNPACKLO_EPI64(a67b67c67d67, e67f67g67h67);
+	x[7] = SWIFFT_UNPACKHI_EPI64(a67b67c67d67, e67f67g67h67);
+}
+
+//! \brief Packs pairs of rows of 16-bit elements in the range {0,..,255} to rows of 8-bit elements, per 128-bit lane.
+//!
+//! \param[in] v the 8 rows, one wide SWIFFT vector per row.
+//! \param[out] p the 4 packed pairs of rows, each holding the 16 bytes of each lane in the same lane.
+static inline void SWIFFT_packLanes(const ZOvec v[8], ZOvec p[4])
+{
+	const SWIFFT_lanes_t *x = (const SWIFFT_lanes_t *)v;
+	SWIFFT_lanes_t *y = (SWIFFT_lanes_t *)p;
+	int i;
+	for (i=0; i<4; i++) {
+		y[i] = SWIFFT_PACKUS_EPI16(x[2*i], x[2*i+1]);
+	}
+}
+#endif
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2021 Yaron Gvili and Gvili Tech Ltd.
+ *
+ * See the accompanying LICENSE.txt file for licensing information.
+ */
+/*! \file src/transpose_8x8_16_neon.inl
+ * \brief LibSWIFFT internal C code for transposing an 8x8 matrix of 16-bit elements using NEON
+ *
+ * The sequence of zips mirrors the unpacks of transpose_8x8_16_sse2.
+ */
+
+#include <arm_neon.h>
+
+//! \brief Returns the interleaved low 32-bit elements of a and b.
+#define SWIFFT_NEON_ZIP1_32(a,b) vreinterpretq_s16_s32(vzip1q_s32(vreinterpretq_s32_s16(a), vreinterpretq_s32_s16(b)))
+//! \brief Returns the interleaved high 32-bit elements of a and b.
+#define SWIFFT_NEON_ZIP2_32(a,b) vreinterpretq_s16_s32(vzip2q_s32(vreinterpretq_s32_s16(a), vreinterpretq_s32_s16(b)))
+//! \brief Returns the interleaved low 64-bit elements of a and b.
+#define SWIFFT_NEON_ZIP1_64(a,b) vreinterpretq_s16_s64(vzip1q_s64(vreinterpretq_s64_s16(a), vreinterpretq_s64_s16(b)))
+//! \brief Returns the interleaved high 64-bit elements of a and b.
+#define SWIFFT_NEON_ZIP2_64(a,b) vreinterpretq_s16_s64(vzip2q_s64(vreinterpretq_s64_s16(a), vreinterpretq_s64_s16(b)))
+
+static inline void transpose_8x8_16_neon(int16x8_t * array)
+{
+	int16x8_t a = array[0];
+	int16x8_t b = array[1];
+	int16x8_t c = array[2];
+	int16x8_t d = array[3];
+	int16x8_t e = array[4];
+	int16x8_t f = array[5];
+	int16x8_t g = array[6];
+	int16x8_t h = array[7];
+
+	int16x8_t a03b03 = vzip1q_s16(a, b);
+	int16x8_t c03d03 = vzip1q_s16(c, d);
+	int16x8_t e03f03 = vzip1q_s16(e, f);
+	int16x8_t g03h03 = vzip1q_s16(g, h);
+	int16x8_t a47b47 = vzip2q_s16(a, b);
+	int16x8_t c47d47 = vzip2q_s16(c, d);
+	int16x8_t e47f47 = vzip2q_s16(e, f);
+	int16x8_t g47h47 = vzip2q_s16(g, h);
+
+	int16x8_t a01b01c01d01 = SWIFFT_NEON_ZIP1_32(a03b03, c03d03);
+	int16x8_t a23b23c23d23 = SWIFFT_NEON_ZIP2_32(a03b03, c03d03);
+	int16x8_t e01f01g01h01 = SWIFFT_NEON_ZIP1_32(e03f03, g03h03);
+	int16x8_t e23f23g23h23 = SWIFFT_NEON_ZIP2_32(e03f03, g03h03);
+	int16x8_t a45b45c45d45 = SWIFFT_NEON_ZIP1_32(a47b47, c47d47);
+	int16x8_t a67b67c67d67 = SWIFFT_NEON_ZIP2_32(a47b47, c47d47);
+	int16x8_t e45f45g45h45 = SWIFFT_NEON_ZIP1_32(e47f47, g47h47);
+	int16x8_t e67f67g67h67 = SWIFFT_NEON_ZIP2_32(e47f47, g47h47);
+
+	array[0] = SWIFFT_NEON_ZIP1_64(a01b01c01d01, e01f01g01h01);
+	array[1] = SWIFFT_NEON_ZIP2_64(a01b01c01d01, e01f01g01h01);
+	array[2] = SWIFFT_NEON_ZIP1_64(a23b23c23d23, e23f23g23h23);
+	array[3] = SWIFFT_NEON_ZIP2_64(a23b23c23d23, e23f23g23h23);
+	array[4] = SWIFFT_NEON_ZIP1_64(a45b45c45d45, e45f45g45h45);
+	array[5] = SWIFFT_NEON_ZIP2_64(a45b45c45d45, e45f45g45h45);
+	array[6] = SWIFFT_NEON_ZIP1_64(a67b67c67d67, e67f67g67h67);
+	array[7] = SWIFFT_NEON_ZIP2_64(a67b67c67d67, e67f67g67h67);
+}
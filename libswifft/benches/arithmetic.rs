@@ -0,0 +1,73 @@
+//! Benchmarks of the arithmetic of LibSWIFFT hash values, on one block and on
+//! batches of blocks for each number of threads of the native pool.
+
+use criterion::{black_box, criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+use libswifft::arithmetic::*;
+use libswifft::buffer::*;
+use libswifft::constant::OUTPUT_BLOCK_SIZE;
+use libswifft::pool::set_threads;
+
+/// Returns the numbers of threads to benchmark batches with: 1 and the number of processors.
+fn thread_counts() -> Vec<usize> {
+    let max = std::thread::available_parallelism().map_or(1, |n| n.get());
+    if max > 1 { vec![1, max] } else { vec![1] }
+}
+
+fn bench_single(c: &mut Criterion) {
+    let operand = Output::new(0x21);
+    let mut output = Output::new(0x03);
+    let mut group = c.benchmark_group("arithmetic");
+    group.throughput(Throughput::Bytes(OUTPUT_BLOCK_SIZE as u64));
+    group.bench_function("set", |b| b.iter(|| set(&mut output, black_box(&operand))));
+    group.bench_function("add", |b| b.iter(|| add(&mut output, black_box(&operand))));
+    group.bench_function("sub", |b| b.iter(|| sub(&mut output, black_box(&operand))));
+    group.bench_function("mul", |b| b.iter(|| mul(&mut output, black_box(&operand))));
+    group.bench_function("const_set", |b| b.iter(|| const_set(&mut output, black_box(3))));
+    group.bench_function("const_add", |b| b.iter(|| const_add(&mut output, black_box(3))));
+    group.bench_function("const_sub", |b| b.iter(|| const_sub(&mut output, black_box(3))));
+    group.bench_function("const_mul", |b| b.iter(|| const_mul(&mut output, black_box(3))));
+    group.finish();
+}
+
+macro_rules! bench_multiple {
+    ($c:expr, $threads:expr, $($n:literal),*) => {$({
+        let operand = Outputs::<$n>::new(0x21);
+        let constants = [3i16; $n];
+        let mut output = Outputs::<$n>::new(0x03);
+        let mut sum = Output::default();
+        let mut group = $c.benchmark_group(format!("arithmetic/threads={}", $threads));
+        group.throughput(Throughput::Bytes(($n * OUTPUT_BLOCK_SIZE) as u64));
+        group.bench_with_input(BenchmarkId::new("set_multiple", $n), &operand,
+            |b, operand| b.iter(|| set_multiple(&mut output, black_box(operand))));
+        group.bench_with_input(BenchmarkId::new("add_multiple", $n), &operand,
+            |b, operand| b.iter(|| add_multiple(&mut output, black_box(operand))));
+        group.bench_with_input(BenchmarkId::new("sub_multiple", $n), &operand,
+            |b, operand| b.iter(|| sub_multiple(&mut output, black_box(operand))));
+        group.bench_with_input(BenchmarkId::new("mul_multiple", $n), &operand,
+            |b, operand| b.iter(|| mul_multiple(&mut output, black_box(operand))));
+        group.bench_with_input(BenchmarkId::new("const_set_multiple", $n), &constants,
+            |b, constants| b.iter(|| const_set_multiple(&mut output, black_box(constants))));
+        group.bench_with_input(BenchmarkId::new("const_add_multiple", $n), &constants,
+            |b, constants| b.iter(|| const_add_multiple(&mut output, black_box(constants))));
+        group.bench_with_input(BenchmarkId::new("const_sub_multiple", $n), &constants,
+            |b, constants| b.iter(|| const_sub_multiple(&mut output, black_box(constants))));
+        group.bench_with_input(BenchmarkId::new("const_mul_multiple", $n), &constants,
+            |b, constants| b.iter(|| const_mul_multiple(&mut output, black_box(constants))));
+        group.bench_with_input(BenchmarkId::new("sum_multiple", $n), &operand,
+            |b, operand| b.iter(|| sum_multiple(black_box(operand), &mut sum)));
+        group.bench_with_input(BenchmarkId::new("linear_combination", $n), &operand,
+            |b, operand| b.iter(|| linear_combination(black_box(&constants), black_box(operand), &mut sum)));
+        group.finish();
+    })*};
+}
+
+fn bench_multiple(c: &mut Criterion) {
+    for threads in thread_counts() {
+        set_threads(threads);
+        bench_multiple!(c, threads, 1, 8, 64, 256);
+    }
+    set_threads(1);
+}
+
+criterion_group!(benches, bench_single, bench_multiple);
+criterion_main!(benches);
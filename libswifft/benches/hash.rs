@@ -0,0 +1,76 @@
+//! Benchmarks of the hash functions of LibSWIFFT, on one block and on batches
+//! of blocks for each number of threads of the native pool, and on large batches
+//! of a length known at runtime.
+
+use criterion::{black_box, criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+use libswifft::batch::*;
+use libswifft::buffer::*;
+use libswifft::constant::{INPUT_BLOCK_SIZE, OUTPUT_BLOCK_SIZE};
+use libswifft::hash::*;
+use libswifft::pool::set_threads;
+
+/// Returns the numbers of threads to benchmark batches with: 1 and the number of processors.
+fn thread_counts() -> Vec<usize> {
+    let max = std::thread::available_parallelism().map_or(1, |n| n.get());
+    if max > 1 { vec![1, max] } else { vec![1] }
+}
+
+fn bench_single(c: &mut Criterion) {
+    let input = Input::new(0x5a);
+    let sign_input = SignInput::new(0x12);
+    let mut output = Output::default();
+    let mut compact_output = CompactOutput::default();
+    let mut group = c.benchmark_group("hash");
+    group.throughput(Throughput::Bytes(INPUT_BLOCK_SIZE as u64));
+    group.bench_function("compute", |b| b.iter(|| compute(black_box(&input), &mut output)));
+    group.bench_function("compute_signed", |b| b.iter(|| compute_signed(black_box(&input), black_box(&sign_input), &mut output)));
+    group.throughput(Throughput::Bytes(OUTPUT_BLOCK_SIZE as u64));
+    group.bench_function("compact", |b| b.iter(|| compact(black_box(&output), &mut compact_output)));
+    group.finish();
+}
+
+macro_rules! bench_multiple {
+    ($c:expr, $threads:expr, $($n:literal),*) => {$({
+        let input = Inputs::<$n>::new(0x5a);
+        let sign_input = SignInputs::<$n>::new(0x12);
+        let mut output = Outputs::<$n>::default();
+        let mut compact_output = CompactOutputs::<$n>::default();
+        let mut group = $c.benchmark_group(format!("hash/threads={}", $threads));
+        group.throughput(Throughput::Bytes(($n * INPUT_BLOCK_SIZE) as u64));
+        group.bench_with_input(BenchmarkId::new("compute_multiple", $n), &input,
+            |b, input| b.iter(|| compute_multiple(black_box(input), &mut output)));
+        group.bench_with_input(BenchmarkId::new("compute_multiple_signed", $n), &input,
+            |b, input| b.iter(|| compute_multiple_signed(black_box(input), black_box(&sign_input), &mut output)));
+        group.throughput(Throughput::Bytes(($n * OUTPUT_BLOCK_SIZE) as u64));
+        group.bench_with_input(BenchmarkId::new("compact_multiple", $n), &output,
+            |b, output| b.iter(|| compact_multiple(black_box(output), &mut compact_output)));
+        group.finish();
+    })*};
+}
+
+fn bench_multiple(c: &mut Criterion) {
+    for threads in thread_counts() {
+        set_threads(threads);
+        bench_multiple!(c, threads, 1, 8, 64, 256);
+    }
+    set_threads(1);
+}
+
+fn bench_batch(c: &mut Criterion) {
+    const NUM_BLOCKS: usize = 1 << 16;
+    let input = InputBatch::new(NUM_BLOCKS);
+    let mut output = OutputBatch::new(NUM_BLOCKS);
+    // one byte off the alignment of the batches, as a network buffer may be
+    let unaligned_input = vec![0u8; NUM_BLOCKS * INPUT_BLOCK_SIZE + 1];
+    let mut unaligned_output = vec![0u8; NUM_BLOCKS * OUTPUT_BLOCK_SIZE + 1];
+    let mut group = c.benchmark_group("hash/batch");
+    group.throughput(Throughput::Bytes((NUM_BLOCKS * INPUT_BLOCK_SIZE) as u64));
+    group.bench_with_input(BenchmarkId::new("compute_slice", NUM_BLOCKS), &input[..],
+        |b, input| b.iter(|| compute_slice(black_box(input), &mut output)));
+    group.bench_with_input(BenchmarkId::new("compute_bytes_unaligned", NUM_BLOCKS), &unaligned_input[1..],
+        |b, input| b.iter(|| compute_bytes(black_box(input), &mut unaligned_output[1..])));
+    group.finish();
+}
+
+criterion_group!(benches, bench_single, bench_multiple, bench_batch);
+criterion_main!(benches);
@@ -1,12 +1,16 @@
 //! Parameters: n=64, m=32, q=257
 
 use crate::sys::{
-    SWIFFT_Set, SWIFFT_SetMultiple, SWIFFT_Add, SWIFFT_AddMultiple, SWIFFT_ConstAdd,
+    swifft_accumulator_t, swifft_op_t, swifft_opcode_t_SWIFFT_OP_ADD, swifft_opcode_t_SWIFFT_OP_CONST,
+    swifft_opcode_t_SWIFFT_OP_LOAD, swifft_opcode_t_SWIFFT_OP_MUL, swifft_opcode_t_SWIFFT_OP_SUB,
+    SWIFFT_EvalMultiple, SWIFFT_AccumulatorAdd, SWIFFT_AccumulatorInit, SWIFFT_AccumulatorSub,
+    SWIFFT_LinearCombination, SWIFFT_Reduce, SWIFFT_SumMultiple, SWIFFT_Set, SWIFFT_SetMultiple, SWIFFT_Add, SWIFFT_AddMultiple, SWIFFT_ConstAdd,
     SWIFFT_ConstAddMultiple, SWIFFT_ConstMul, SWIFFT_ConstMulMultiple, SWIFFT_ConstSet,
     SWIFFT_ConstSetMultiple, SWIFFT_ConstSub, SWIFFT_ConstSubMultiple, SWIFFT_Mul,
     SWIFFT_MulMultiple, SWIFFT_Sub, SWIFFT_SubMultiple
 };
 use crate::buffer::{Output, Outputs};
+use std::os::raw::c_int;
 
 /// Sets a SWIFFT hash value to another, element-wise.
 /// 
@@ -27,7 +31,7 @@ pub fn set(output: &mut Output, operand: &Output) {
 /// * `operand` - the hash value to set to
 pub fn set_multiple<const NUM_BLOCKS: usize>(output: &mut Outputs<NUM_BLOCKS>, operand: &Outputs<NUM_BLOCKS>) {
     unsafe {
-        SWIFFT_SetMultiple(NUM_BLOCKS.try_into().unwrap(), output.0[0].as_mut_ptr(), operand.0[0].as_ptr())
+        SWIFFT_SetMultiple(NUM_BLOCKS, output.0[0].as_mut_ptr(), operand.0[0].as_ptr())
     }
 }
 
@@ -50,7 +54,7 @@ pub fn add(output: &mut Output, operand: &Output) {
 /// * `operand` - the hash value to add
 pub fn add_multiple<const NUM_BLOCKS: usize>(output: &mut Outputs<NUM_BLOCKS>, operand: &Outputs<NUM_BLOCKS>) {
     unsafe {
-        SWIFFT_AddMultiple(NUM_BLOCKS.try_into().unwrap(), output.0[0].as_mut_ptr(), operand.0[0].as_ptr())
+        SWIFFT_AddMultiple(NUM_BLOCKS, output.0[0].as_mut_ptr(), operand.0[0].as_ptr())
     }
 }
 
@@ -72,7 +76,7 @@ pub fn sub(output: &mut Output, operand: &Output) {
 /// * `operand` - the hash value to subtract
 pub fn sub_multiple<const NUM_BLOCKS: usize>(output: &mut Outputs<NUM_BLOCKS>, operand: &Outputs<NUM_BLOCKS>) {
     unsafe {
-        SWIFFT_SubMultiple(NUM_BLOCKS.try_into().unwrap(), output.0[0].as_mut_ptr(), operand.0[0].as_ptr())
+        SWIFFT_SubMultiple(NUM_BLOCKS, output.0[0].as_mut_ptr(), operand.0[0].as_ptr())
     }
 }
 
@@ -95,7 +99,7 @@ pub fn mul(output: &mut Output, operand: &Output) {
 /// * `operand` - the hash value to multiply by
 pub fn mul_multiple<const NUM_BLOCKS: usize>(output: &mut Outputs<NUM_BLOCKS>, operand: &Outputs<NUM_BLOCKS>) {
     unsafe {
-        SWIFFT_MulMultiple(NUM_BLOCKS.try_into().unwrap(), output.0[0].as_mut_ptr(), operand.0[0].as_ptr())
+        SWIFFT_MulMultiple(NUM_BLOCKS, output.0[0].as_mut_ptr(), operand.0[0].as_ptr())
     }
 }
 
@@ -118,7 +122,7 @@ pub fn const_set(output: &mut Output, operand: i16) {
 /// * `operand` - the constant value to set, per block
 pub fn const_set_multiple<const NUM_BLOCKS: usize>(output: &mut Outputs<NUM_BLOCKS>, operand: &[i16; NUM_BLOCKS]) {
     unsafe {
-        SWIFFT_ConstSetMultiple(NUM_BLOCKS.try_into().unwrap(), 
+        SWIFFT_ConstSetMultiple(NUM_BLOCKS, 
             output.0[0].as_mut_ptr(), operand.map(|i| { i.rem_euclid(257) }).as_ptr())
     }
 }
@@ -142,7 +146,7 @@ pub fn const_add(output: &mut Output, operand: i16) {
 /// * `operand` - the constant value to add, per block
 pub fn const_add_multiple<const NUM_BLOCKS: usize>(output: &mut Outputs<NUM_BLOCKS>, operand: &[i16; NUM_BLOCKS]) {
     unsafe {
-        SWIFFT_ConstAddMultiple(NUM_BLOCKS.try_into().unwrap(), 
+        SWIFFT_ConstAddMultiple(NUM_BLOCKS, 
             output.0[0].as_mut_ptr(), operand.map(|i| { i.rem_euclid(257) }).as_ptr())
     }
 }
@@ -166,7 +170,7 @@ pub fn const_sub(output: &mut Output, operand: i16) {
 /// * `operand` - the constant value to subtract, per block
 pub fn const_sub_multiple<const NUM_BLOCKS: usize>(output: &mut Outputs<NUM_BLOCKS>, operand: &[i16; NUM_BLOCKS]) {
     unsafe {
-        SWIFFT_ConstSubMultiple(NUM_BLOCKS.try_into().unwrap(), 
+        SWIFFT_ConstSubMultiple(NUM_BLOCKS, 
             output.0[0].as_mut_ptr(), operand.map(|i| { i.rem_euclid(257) }).as_ptr())
     }
 }
@@ -190,7 +194,248 @@ pub fn const_mul(output: &mut Output, operand: i16) {
 /// * `operand` - the constant value to multiply by, per block
 pub fn const_mul_multiple<const NUM_BLOCKS: usize>(output: &mut Outputs<NUM_BLOCKS>, operand: &[i16; NUM_BLOCKS]) {
     unsafe {
-        SWIFFT_ConstMulMultiple(NUM_BLOCKS.try_into().unwrap(), 
+        SWIFFT_ConstMulMultiple(NUM_BLOCKS, 
             output.0[0].as_mut_ptr(), operand.map(|i| { i.rem_euclid(257) }).as_ptr())
     }
-}
\ No newline at end of file
+}
+
+/// An unreduced sum of SWIFFT hash values, for adding up many of them with a single reduction.
+pub struct Accumulator(swifft_accumulator_t);
+
+impl Accumulator {
+    /// Creates an accumulator of value zero.
+    pub fn new() -> Self {
+        let mut acc = Self(unsafe { std::mem::zeroed() });
+        unsafe {
+            SWIFFT_AccumulatorInit(&mut acc.0)
+        }
+        acc
+    }
+
+    /// Adds a SWIFFT hash value, without reducing the sum.
+    ///
+    /// # Arguments
+    /// * `operand` - the reduced hash value to add
+    pub fn add(&mut self, operand: &Output) {
+        unsafe {
+            SWIFFT_AccumulatorAdd(&mut self.0, operand.0[0].as_ptr())
+        }
+    }
+
+    /// Subtracts a SWIFFT hash value, without reducing the difference.
+    ///
+    /// # Arguments
+    /// * `operand` - the reduced hash value to subtract
+    pub fn sub(&mut self, operand: &Output) {
+        unsafe {
+            SWIFFT_AccumulatorSub(&mut self.0, operand.0[0].as_ptr())
+        }
+    }
+
+    /// Reduces the accumulated sum to a SWIFFT hash value.
+    ///
+    /// # Arguments
+    /// * `output` - the resulting hash value of SWIFFT
+    pub fn reduce(&self, output: &mut Output) {
+        unsafe {
+            SWIFFT_Reduce(&self.0, output.0[0].as_mut_ptr())
+        }
+    }
+}
+
+impl Default for Accumulator {
+    /// Creates an accumulator of value zero
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+/// Sums SWIFFT hash values of multiple blocks, reducing only once per many blocks.
+///
+/// # Arguments
+/// * `NUM_BLOCKS` - the number of blocks to sum
+/// * `operand` - the reduced hash values to sum, per block
+/// * `output` - the resulting hash value of SWIFFT
+pub fn sum_multiple<const NUM_BLOCKS: usize>(operand: &Outputs<NUM_BLOCKS>, output: &mut Output) {
+    unsafe {
+        SWIFFT_SumMultiple(NUM_BLOCKS, operand.0[0].as_ptr(), output.0[0].as_mut_ptr())
+    }
+}
+
+/// Computes a linear combination of SWIFFT hash values of multiple blocks, reducing each product only partially.
+///
+/// # Arguments
+/// * `NUM_BLOCKS` - the number of blocks to combine
+/// * `coeffs` - the coefficients, per block
+/// * `operand` - the reduced hash values to combine, per block
+/// * `output` - the resulting hash value of SWIFFT
+pub fn linear_combination<const NUM_BLOCKS: usize>(coeffs: &[i16; NUM_BLOCKS], operand: &Outputs<NUM_BLOCKS>, output: &mut Output) {
+    unsafe {
+        SWIFFT_LinearCombination(NUM_BLOCKS, coeffs.as_ptr(), operand.0[0].as_ptr(),
+            output.0[0].as_mut_ptr())
+    }
+}
+
+/// An operation of an element-wise expression of SWIFFT hash values, which runs on a stack of them.
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub enum Op {
+    /// Pushes the hash value of the block in the operand with the given index
+    Load(usize),
+    /// Pushes a hash value with each element equal to the given constant, mod 257
+    Const(i16),
+    /// Pops b, pops a, and pushes a + b
+    Add,
+    /// Pops b, pops a, and pushes a - b
+    Sub,
+    /// Pops b, pops a, and pushes a * b
+    Mul,
+}
+
+/// Evaluates an element-wise expression of SWIFFT hash values for multiple blocks, in one pass over them.
+/// Returns whether the program is valid, leaving exactly one hash value on a stack of at most 8.
+///
+/// # Arguments
+/// * `NUM_BLOCKS` - the number of blocks to operate on
+/// * `program` - the operations of the expression, in postfix order
+/// * `operands` - the reduced hash values of SWIFFT for `Op::Load`, per block
+/// * `output` - the resulting hash value of SWIFFT, per block
+pub fn eval_multiple<const NUM_BLOCKS: usize>(program: &[Op], operands: &[&Outputs<NUM_BLOCKS>],
+                                              output: &mut Outputs<NUM_BLOCKS>) -> bool {
+    let mut ops = Vec::with_capacity(program.len());
+    for op in program {
+        let (opcode, arg) = match *op {
+            Op::Load(index) => match index.try_into() {
+                Ok(index) => (swifft_opcode_t_SWIFFT_OP_LOAD, index),
+                Err(_) => return false,
+            },
+            Op::Const(value) => (swifft_opcode_t_SWIFFT_OP_CONST, value),
+            Op::Add => (swifft_opcode_t_SWIFFT_OP_ADD, 0),
+            Op::Sub => (swifft_opcode_t_SWIFFT_OP_SUB, 0),
+            Op::Mul => (swifft_opcode_t_SWIFFT_OP_MUL, 0),
+        };
+        ops.push(swifft_op_t { opcode: opcode as i16, arg });
+    }
+    let operands: Vec<_> = operands.iter().map(|operand| operand.0[0].as_ptr()).collect();
+    unsafe {
+        SWIFFT_EvalMultiple(NUM_BLOCKS, ops.as_ptr(), ops.len() as c_int,
+            operands.as_ptr(), operands.len() as c_int, output.0[0].as_mut_ptr()) == 0
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::constant::OUTPUT_BLOCK_SIZE;
+    use crate::sys::SWIFFT_ACCUMULATOR_HEADROOM;
+
+    /// More hash values than fit in the headroom of an accumulator, several times over
+    const NUM_BLOCKS: usize = 4 * SWIFFT_ACCUMULATOR_HEADROOM as usize + 3;
+
+    const NUM_ELEMENTS: usize = OUTPUT_BLOCK_SIZE / 2;
+
+    fn elements<const NUM_BLOCKS: usize>(outputs: &Outputs<NUM_BLOCKS>, block: usize) -> [i16; NUM_ELEMENTS] {
+        std::array::from_fn(|i| i16::from_ne_bytes([outputs.0[block][2 * i], outputs.0[block][2 * i + 1]]))
+    }
+
+    fn set_elements<const NUM_BLOCKS: usize>(outputs: &mut Outputs<NUM_BLOCKS>, block: usize, elements: &[i16; NUM_ELEMENTS]) {
+        for (i, element) in elements.iter().enumerate() {
+            outputs.0[block][2 * i..2 * i + 2].copy_from_slice(&element.to_ne_bytes())
+        }
+    }
+
+    /// Reduced hash values of pseudo-random elements, with the first `extremes` blocks at the
+    /// largest element 256 to use up the headroom of the unreduced sums fastest
+    fn operands(extremes: usize) -> Box<Outputs<NUM_BLOCKS>> {
+        let mut operands = Box::new(Outputs::<NUM_BLOCKS>::default());
+        let mut state: u32 = 0x2545_f491;
+        for block in 0..NUM_BLOCKS {
+            let elements = std::array::from_fn(|_| {
+                state ^= state << 13; state ^= state >> 17; state ^= state << 5;
+                if block < extremes { 256 } else { (state % 257) as i16 }
+            });
+            set_elements(&mut operands, block, &elements)
+        }
+        operands
+    }
+
+    /// The sum of the products of the hash values by their coefficients, reduced mod 257 element by element
+    fn reference(operands: &Outputs<NUM_BLOCKS>, coeffs: &[i16; NUM_BLOCKS]) -> [i16; NUM_ELEMENTS] {
+        let mut sums = [0i64; NUM_ELEMENTS];
+        for block in 0..NUM_BLOCKS {
+            for (sum, element) in sums.iter_mut().zip(elements(operands, block)) {
+                *sum += coeffs[block] as i64 * element as i64
+            }
+        }
+        sums.map(|sum| sum.rem_euclid(257) as i16)
+    }
+
+    fn check(output: &Output, expected: &[i16; NUM_ELEMENTS]) {
+        let actual = elements(output, 0);
+        for i in 0..NUM_ELEMENTS {
+            assert_eq!(actual[i], expected[i], "element {}", i)
+        }
+    }
+
+    #[test]
+    fn accumulator_add() {
+        for extremes in [0, NUM_BLOCKS] {
+            let operands = operands(extremes);
+            let mut acc = Accumulator::new();
+            let mut operand = Output::default();
+            for block in 0..NUM_BLOCKS {
+                set_elements(&mut operand, 0, &elements(&operands, block));
+                acc.add(&operand)
+            }
+            let mut output = Output::default();
+            acc.reduce(&mut output);
+            check(&output, &reference(&operands, &[1; NUM_BLOCKS]))
+        }
+    }
+
+    #[test]
+    fn accumulator_add_and_sub() {
+        for extremes in [0, NUM_BLOCKS] {
+            let operands = operands(extremes);
+            // subtract a run of more than the headroom in a row, then alternate
+            let coeffs: [i16; NUM_BLOCKS] = std::array::from_fn(|block| {
+                if block < 2 * SWIFFT_ACCUMULATOR_HEADROOM as usize { -1 } else if block % 2 == 0 { 1 } else { -1 }
+            });
+            let mut acc = Accumulator::new();
+            let mut operand = Output::default();
+            for block in 0..NUM_BLOCKS {
+                set_elements(&mut operand, 0, &elements(&operands, block));
+                if coeffs[block] > 0 { acc.add(&operand) } else { acc.sub(&operand) }
+            }
+            let mut output = Output::default();
+            acc.reduce(&mut output);
+            check(&output, &reference(&operands, &coeffs))
+        }
+    }
+
+    #[test]
+    fn sum_multiple_blocks() {
+        for extremes in [0, NUM_BLOCKS] {
+            let operands = operands(extremes);
+            let mut output = Output::default();
+            sum_multiple(&operands, &mut output);
+            check(&output, &reference(&operands, &[1; NUM_BLOCKS]))
+        }
+    }
+
+    #[test]
+    fn linear_combination_blocks() {
+        let mut state: u32 = 0x6c07_8965;
+        let random: [i16; NUM_BLOCKS] = std::array::from_fn(|_| {
+            state ^= state << 13; state ^= state >> 17; state ^= state << 5;
+            state as i16
+        });
+        for coeffs in [random, [i16::MIN; NUM_BLOCKS], [i16::MAX; NUM_BLOCKS], [256; NUM_BLOCKS], [-128; NUM_BLOCKS]] {
+            for extremes in [0, NUM_BLOCKS] {
+                let operands = operands(extremes);
+                let mut output = Output::default();
+                linear_combination(&coeffs, &operands, &mut output);
+                check(&output, &reference(&operands, &coeffs))
+            }
+        }
+    }
+}
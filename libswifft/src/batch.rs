@@ -0,0 +1,369 @@
+//! Batches of blocks of a length known at runtime
+//!
+//! The `*_multiple` functions of `hash` operate on arrays of blocks whose number
+//! is fixed at compile time. The functions here operate on slices of blocks, e.g.
+//! of a `Batch` allocated on the heap, or on byte slices, e.g. network buffers,
+//! which are used in place when aligned to `ALIGNMENT` and staged otherwise.
+
+use crate::sys::{
+    SWIFFT_CompactMultiple, SWIFFT_ComputeMultiple, SWIFFT_ComputeMultipleShort, SWIFFT_ComputeMultipleSigned,
+    SWIFFT_ComputeMultipleSignedPacked, SWIFFT_ComputeMultipleSignedShort
+};
+use crate::constant::{
+    CHUNK_SIZE, COMPACT_OUTPUT_BLOCK_SIZE, INPUT_BLOCK_SIZE, M, OUTPUT_BLOCK_SIZE, PACKED_BLOCK_SIZE,
+    SHORT_CHUNKS_MULTIPLE
+};
+use crate::buffer::{
+    AlignedBuffer, CompactOutput, Input, Output, PackedSignedInput, SignInput, ALIGNMENT
+};
+use std::ops::{Deref, DerefMut};
+
+/// The number of blocks staged at once by the byte-slice functions for unaligned buffers
+const STAGE_BLOCKS: usize = 256;
+
+/// The number of blocks per parallel item of the `par_*` functions
+#[cfg(feature = "rayon")]
+pub const PAR_CHUNK_BLOCKS: usize = 1024;
+
+/// A batch of blocks on the heap, each aligned as an `AlignedBuffer`,
+/// dereferencing to a slice of blocks
+pub struct Batch<const BLOCK_SIZE: usize>(Vec<AlignedBuffer<BLOCK_SIZE, 1>>);
+
+/// A batch of inputs
+pub type InputBatch = Batch<INPUT_BLOCK_SIZE>;
+
+/// A batch of sign inputs
+pub type SignInputBatch = InputBatch;
+
+/// A batch of packed signed inputs
+pub type PackedSignedInputBatch = Batch<PACKED_BLOCK_SIZE>;
+
+/// A batch of outputs
+pub type OutputBatch = Batch<OUTPUT_BLOCK_SIZE>;
+
+/// A batch of compact outputs
+pub type CompactOutputBatch = Batch<COMPACT_OUTPUT_BLOCK_SIZE>;
+
+impl<const BLOCK_SIZE: usize> Batch<BLOCK_SIZE> {
+    /// Creates a zero-initialized `Batch`
+    ///
+    /// # Arguments
+    /// * `num_blocks` - the number of blocks
+    pub fn new(num_blocks: usize) -> Self {
+        Self((0..num_blocks).map(|_| AlignedBuffer::default()).collect())
+    }
+
+    /// Returns the blocks of the batch as bytes
+    pub fn as_bytes(&self) -> &[u8] {
+        // blocks are contiguous, since their size is a multiple of their alignment
+        unsafe { std::slice::from_raw_parts(self.0.as_ptr() as *const u8, self.0.len() * BLOCK_SIZE) }
+    }
+
+    /// Returns the blocks of the batch as mutable bytes
+    pub fn as_bytes_mut(&mut self) -> &mut [u8] {
+        unsafe { std::slice::from_raw_parts_mut(self.0.as_mut_ptr() as *mut u8, self.0.len() * BLOCK_SIZE) }
+    }
+}
+
+impl<const BLOCK_SIZE: usize> Deref for Batch<BLOCK_SIZE> {
+    type Target = [AlignedBuffer<BLOCK_SIZE, 1>];
+
+    fn deref(&self) -> &Self::Target {
+        &self.0
+    }
+}
+
+impl<const BLOCK_SIZE: usize> DerefMut for Batch<BLOCK_SIZE> {
+    fn deref_mut(&mut self) -> &mut Self::Target {
+        &mut self.0
+    }
+}
+
+/// Returns whether a pointer is aligned as an `AlignedBuffer`.
+fn is_aligned(ptr: *const u8) -> bool {
+    ptr as usize % ALIGNMENT == 0
+}
+
+/// Returns the blocks of a byte slice, without copying, or `None` if it is not aligned
+/// to `ALIGNMENT` or its length is not a multiple of the block size.
+///
+/// # Arguments
+/// * `bytes` - the bytes of the blocks
+pub fn blocks<const BLOCK_SIZE: usize>(bytes: &[u8]) -> Option<&[AlignedBuffer<BLOCK_SIZE, 1>]> {
+    if !is_aligned(bytes.as_ptr()) || bytes.len() % BLOCK_SIZE != 0 {
+        return None;
+    }
+    Some(unsafe {
+        std::slice::from_raw_parts(bytes.as_ptr() as *const AlignedBuffer<BLOCK_SIZE, 1>, bytes.len() / BLOCK_SIZE)
+    })
+}
+
+/// Returns the mutable blocks of a byte slice, without copying, or `None` if it is not aligned
+/// to `ALIGNMENT` or its length is not a multiple of the block size.
+///
+/// # Arguments
+/// * `bytes` - the bytes of the blocks
+pub fn blocks_mut<const BLOCK_SIZE: usize>(bytes: &mut [u8]) -> Option<&mut [AlignedBuffer<BLOCK_SIZE, 1>]> {
+    if !is_aligned(bytes.as_ptr()) || bytes.len() % BLOCK_SIZE != 0 {
+        return None;
+    }
+    Some(unsafe {
+        std::slice::from_raw_parts_mut(bytes.as_mut_ptr() as *mut AlignedBuffer<BLOCK_SIZE, 1>, bytes.len() / BLOCK_SIZE)
+    })
+}
+
+/// Computes the result of multiple SWIFFT operations.
+/// The result is composable with other hash values.
+/// Panics if the numbers of blocks differ.
+///
+/// # Arguments
+/// * `input` - the blocks of input, each of 256 bytes (2048 bit)
+/// * `output` - the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit)
+pub fn compute_slice(input: &[Input], output: &mut [Output]) {
+    assert_eq!(input.len(), output.len(), "numbers of blocks differ");
+    unsafe {
+        SWIFFT_ComputeMultiple(output.len(), input.as_ptr() as *const u8, output.as_mut_ptr() as *mut u8)
+    }
+}
+
+/// Computes the result of multiple SWIFFT operations.
+/// The result is composable with other hash values.
+/// Panics if the numbers of blocks differ.
+///
+/// # Arguments
+/// * `input` - the blocks of input, each of 256 bytes (2048 bit)
+/// * `sign_input` - the blocks of sign bits corresponding to blocks of input of 256 bytes (2048 bit)
+/// * `output` - the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit)
+pub fn compute_signed_slice(input: &[Input], sign_input: &[SignInput], output: &mut [Output]) {
+    assert_eq!(input.len(), output.len(), "numbers of blocks differ");
+    assert_eq!(sign_input.len(), output.len(), "numbers of blocks differ");
+    unsafe {
+        SWIFFT_ComputeMultipleSigned(output.len(), input.as_ptr() as *const u8, sign_input.as_ptr() as *const u8,
+                                     output.as_mut_ptr() as *mut u8)
+    }
+}
+
+/// Computes the result of multiple SWIFFT operations on packed signed input.
+/// The result is the same as that of `compute_signed_slice` on the unpacked blocks of input and sign bits.
+/// Panics if the numbers of blocks differ.
+///
+/// # Arguments
+/// * `packed_input` - the blocks of packed signed input, each of 512 bytes
+/// * `output` - the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit)
+pub fn compute_signed_packed_slice(packed_input: &[PackedSignedInput], output: &mut [Output]) {
+    assert_eq!(packed_input.len(), output.len(), "numbers of blocks differ");
+    unsafe {
+        SWIFFT_ComputeMultipleSignedPacked(output.len(), packed_input.as_ptr() as *const u8, output.as_mut_ptr() as *mut u8)
+    }
+}
+
+/// Computes the result of multiple SWIFFT operations on short input, which need not be aligned.
+/// The result is the same as that of `compute_slice` on the blocks of input each padded with zero bytes
+/// to 256 bytes, but the work is proportional to the number of chunks of input.
+/// Panics if `m` is not a multiple of `SHORT_CHUNKS_MULTIPLE` from it up to `M`, or if the numbers of blocks differ.
+///
+/// # Arguments
+/// * `m` - the number of chunks of input per block
+/// * `input` - the blocks of input, each of `m` chunks of 8 bytes
+/// * `output` - the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit)
+pub fn compute_short_slice(m: usize, input: &[u8], output: &mut [Output]) {
+    assert!(0 < m && m <= M && m % SHORT_CHUNKS_MULTIPLE == 0, "invalid number of chunks");
+    assert_eq!(input.len(), output.len() * m * CHUNK_SIZE, "numbers of blocks differ");
+    unsafe {
+        SWIFFT_ComputeMultipleShort(output.len(), m as i32, input.as_ptr(), output.as_mut_ptr() as *mut u8);
+    }
+}
+
+/// Computes the result of multiple SWIFFT operations on short signed input, which need not be aligned.
+/// The result is the same as that of `compute_signed_slice` on the blocks of input and sign bits each
+/// padded with zero bytes to 256 bytes, but the work is proportional to the number of chunks of input.
+/// Panics if `m` is not a multiple of `SHORT_CHUNKS_MULTIPLE` from it up to `M`, or if the numbers of blocks differ.
+///
+/// # Arguments
+/// * `m` - the number of chunks of input per block
+/// * `input` - the blocks of input, each of `m` chunks of 8 bytes
+/// * `sign_input` - the blocks of sign bits corresponding to blocks of input, each of `m` chunks of 8 bytes
+/// * `output` - the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit)
+pub fn compute_signed_short_slice(m: usize, input: &[u8], sign_input: &[u8], output: &mut [Output]) {
+    assert!(0 < m && m <= M && m % SHORT_CHUNKS_MULTIPLE == 0, "invalid number of chunks");
+    assert_eq!(input.len(), output.len() * m * CHUNK_SIZE, "numbers of blocks differ");
+    assert_eq!(sign_input.len(), input.len(), "numbers of blocks differ");
+    unsafe {
+        SWIFFT_ComputeMultipleSignedShort(output.len(), m as i32, input.as_ptr(), sign_input.as_ptr(),
+                                          output.as_mut_ptr() as *mut u8);
+    }
+}
+
+/// Compacts multiple hash values of SWIFFT.
+/// The result is not composable with other compacted hash values.
+/// Panics if the numbers of blocks differ.
+///
+/// # Arguments
+/// * `output` - the blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit)
+/// * `compact_output` - the resulting blocks of compacted hash values of SWIFFT, each of size 64 bytes (512 bit)
+pub fn compact_slice(output: &[Output], compact_output: &mut [CompactOutput]) {
+    assert_eq!(output.len(), compact_output.len(), "numbers of blocks differ");
+    unsafe {
+        SWIFFT_CompactMultiple(compact_output.len(), output.as_ptr() as *const u8, compact_output.as_mut_ptr() as *mut u8)
+    }
+}
+
+/// Runs an operation on multiple blocks given as byte slices, each of blocks of `IN` bytes except
+/// for the output of blocks of `OUT` bytes. Aligned slices are used in place, and unaligned ones
+/// are copied through aligned buffers of `STAGE_BLOCKS` blocks. Panics if the numbers of blocks
+/// differ or a length is not a multiple of its block size.
+fn run_bytes<const IN: usize, const OUT: usize, const N: usize>(inputs: [&[u8]; N], output: &mut [u8],
+                                                               op: fn(usize, [*const u8; N], *mut u8)) {
+    assert_eq!(output.len() % OUT, 0, "output length is not a multiple of the block size");
+    let num_blocks = output.len() / OUT;
+    for input in inputs.iter() {
+        assert_eq!(input.len(), num_blocks * IN, "numbers of blocks differ");
+    }
+    let inputs_aligned = inputs.map(|input| is_aligned(input.as_ptr()));
+    let output_aligned = is_aligned(output.as_ptr());
+    if inputs_aligned.iter().all(|&aligned| aligned) && output_aligned {
+        op(num_blocks, inputs.map(|input| input.as_ptr()), output.as_mut_ptr());
+        return;
+    }
+    let stage_blocks = num_blocks.min(STAGE_BLOCKS);
+    let mut stage_inputs = inputs_aligned.map(|aligned| Batch::<IN>::new(if aligned { 0 } else { stage_blocks }));
+    let mut stage_output = Batch::<OUT>::new(if output_aligned { 0 } else { stage_blocks });
+    let mut begin = 0;
+    while begin < num_blocks {
+        let end = (begin + stage_blocks).min(num_blocks);
+        let mut ptrs = [std::ptr::null(); N];
+        for k in 0..N {
+            let bytes = &inputs[k][begin * IN..end * IN];
+            ptrs[k] = if inputs_aligned[k] {
+                bytes.as_ptr()
+            } else {
+                stage_inputs[k].as_bytes_mut()[..bytes.len()].copy_from_slice(bytes);
+                stage_inputs[k].as_bytes().as_ptr()
+            };
+        }
+        let out = &mut output[begin * OUT..end * OUT];
+        if output_aligned {
+            op(end - begin, ptrs, out.as_mut_ptr());
+        } else {
+            op(end - begin, ptrs, stage_output.as_bytes_mut().as_mut_ptr());
+            out.copy_from_slice(&stage_output.as_bytes()[..out.len()]);
+        }
+        begin = end;
+    }
+}
+
+/// Computes the result of multiple SWIFFT operations on byte slices, which need not be aligned.
+/// The result is composable with other hash values.
+/// Panics if the numbers of blocks differ or a length is not a multiple of its block size.
+///
+/// # Arguments
+/// * `input` - the blocks of input, each of 256 bytes (2048 bit)
+/// * `output` - the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit)
+pub fn compute_bytes(input: &[u8], output: &mut [u8]) {
+    run_bytes::<INPUT_BLOCK_SIZE, OUTPUT_BLOCK_SIZE, 1>([input], output, |n, [input], output| unsafe {
+        SWIFFT_ComputeMultiple(n, input, output)
+    })
+}
+
+/// Computes the result of multiple SWIFFT operations on byte slices, which need not be aligned.
+/// The result is composable with other hash values.
+/// Panics if the numbers of blocks differ or a length is not a multiple of its block size.
+///
+/// # Arguments
+/// * `input` - the blocks of input, each of 256 bytes (2048 bit)
+/// * `sign_input` - the blocks of sign bits corresponding to blocks of input of 256 bytes (2048 bit)
+/// * `output` - the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit)
+pub fn compute_signed_bytes(input: &[u8], sign_input: &[u8], output: &mut [u8]) {
+    run_bytes::<INPUT_BLOCK_SIZE, OUTPUT_BLOCK_SIZE, 2>([input, sign_input], output, |n, [input, sign], output| unsafe {
+        SWIFFT_ComputeMultipleSigned(n, input, sign, output)
+    })
+}
+
+/// Computes the result of multiple SWIFFT operations on packed signed input in byte slices, which need not be aligned.
+/// The result is the same as that of `compute_signed_bytes` on the unpacked blocks of input and sign bits.
+/// Panics if the numbers of blocks differ or a length is not a multiple of its block size.
+///
+/// # Arguments
+/// * `packed_input` - the blocks of packed signed input, each of 512 bytes
+/// * `output` - the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit)
+pub fn compute_signed_packed_bytes(packed_input: &[u8], output: &mut [u8]) {
+    run_bytes::<PACKED_BLOCK_SIZE, OUTPUT_BLOCK_SIZE, 1>([packed_input], output, |n, [packed], output| unsafe {
+        SWIFFT_ComputeMultipleSignedPacked(n, packed, output)
+    })
+}
+
+/// Compacts multiple hash values of SWIFFT in byte slices, which need not be aligned.
+/// The result is not composable with other compacted hash values.
+/// Panics if the numbers of blocks differ or a length is not a multiple of its block size.
+///
+/// # Arguments
+/// * `output` - the blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit)
+/// * `compact_output` - the resulting blocks of compacted hash values of SWIFFT, each of size 64 bytes (512 bit)
+pub fn compact_bytes(output: &[u8], compact_output: &mut [u8]) {
+    run_bytes::<OUTPUT_BLOCK_SIZE, COMPACT_OUTPUT_BLOCK_SIZE, 1>([output], compact_output, |n, [output], compact| unsafe {
+        SWIFFT_CompactMultiple(n, output, compact)
+    })
+}
+
+/// Computes the result of multiple SWIFFT operations, in parallel items of `PAR_CHUNK_BLOCKS` blocks on rayon.
+/// The result is the same as that of `compute_slice`.
+/// Panics if the numbers of blocks differ.
+///
+/// # Arguments
+/// * `input` - the blocks of input, each of 256 bytes (2048 bit)
+/// * `output` - the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit)
+#[cfg(feature = "rayon")]
+pub fn par_compute_slice(input: &[Input], output: &mut [Output]) {
+    use rayon::prelude::*;
+    assert_eq!(input.len(), output.len(), "numbers of blocks differ");
+    input.par_chunks(PAR_CHUNK_BLOCKS).zip(output.par_chunks_mut(PAR_CHUNK_BLOCKS))
+        .for_each(|(input, output)| compute_slice(input, output));
+}
+
+/// Computes the result of multiple SWIFFT operations, in parallel items of `PAR_CHUNK_BLOCKS` blocks on rayon.
+/// The result is the same as that of `compute_signed_slice`.
+/// Panics if the numbers of blocks differ.
+///
+/// # Arguments
+/// * `input` - the blocks of input, each of 256 bytes (2048 bit)
+/// * `sign_input` - the blocks of sign bits corresponding to blocks of input of 256 bytes (2048 bit)
+/// * `output` - the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit)
+#[cfg(feature = "rayon")]
+pub fn par_compute_signed_slice(input: &[Input], sign_input: &[SignInput], output: &mut [Output]) {
+    use rayon::prelude::*;
+    assert_eq!(input.len(), output.len(), "numbers of blocks differ");
+    assert_eq!(sign_input.len(), output.len(), "numbers of blocks differ");
+    input.par_chunks(PAR_CHUNK_BLOCKS).zip(sign_input.par_chunks(PAR_CHUNK_BLOCKS))
+        .zip(output.par_chunks_mut(PAR_CHUNK_BLOCKS))
+        .for_each(|((input, sign_input), output)| compute_signed_slice(input, sign_input, output));
+}
+
+/// Computes the result of multiple SWIFFT operations on packed signed input, in parallel items of
+/// `PAR_CHUNK_BLOCKS` blocks on rayon. The result is the same as that of `compute_signed_packed_slice`.
+/// Panics if the numbers of blocks differ.
+///
+/// # Arguments
+/// * `packed_input` - the blocks of packed signed input, each of 512 bytes
+/// * `output` - the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit)
+#[cfg(feature = "rayon")]
+pub fn par_compute_signed_packed_slice(packed_input: &[PackedSignedInput], output: &mut [Output]) {
+    use rayon::prelude::*;
+    assert_eq!(packed_input.len(), output.len(), "numbers of blocks differ");
+    packed_input.par_chunks(PAR_CHUNK_BLOCKS).zip(output.par_chunks_mut(PAR_CHUNK_BLOCKS))
+        .for_each(|(packed_input, output)| compute_signed_packed_slice(packed_input, output));
+}
+
+/// Compacts multiple hash values of SWIFFT, in parallel items of `PAR_CHUNK_BLOCKS` blocks on rayon.
+/// The result is the same as that of `compact_slice`.
+/// Panics if the numbers of blocks differ.
+///
+/// # Arguments
+/// * `output` - the blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit)
+/// * `compact_output` - the resulting blocks of compacted hash values of SWIFFT, each of size 64 bytes (512 bit)
+#[cfg(feature = "rayon")]
+pub fn par_compact_slice(output: &[Output], compact_output: &mut [CompactOutput]) {
+    use rayon::prelude::*;
+    assert_eq!(output.len(), compact_output.len(), "numbers of blocks differ");
+    output.par_chunks(PAR_CHUNK_BLOCKS).zip(compact_output.par_chunks_mut(PAR_CHUNK_BLOCKS))
+        .for_each(|(output, compact_output)| compact_slice(output, compact_output));
+}
@@ -0,0 +1,189 @@
+//! Arrays of blocks allocated by LibSWIFFT
+//!
+//! `Blocks::new` allocates an array of blocks using LibSWIFFT, on huge pages when it
+//! spans an arena at least. A `BlockPool` gives out arrays carved out of arenas on huge
+//! pages, optionally preferring the memory of a NUMA node, and a `Blocks` array taken
+//! from it returns to it when dropped, for reuse without page faults. Either way, the
+//! array dereferences to a slice of blocks, for the `*_slice` functions of `batch`.
+
+use crate::sys::{
+    swifft_block_pool_t, SWIFFT_AllocBlocks, SWIFFT_BlockPoolAlloc, SWIFFT_BlockPoolCreate,
+    SWIFFT_BlockPoolDestroy, SWIFFT_BlockPoolFree, SWIFFT_BlockPoolGetStats, SWIFFT_FreeBlocks
+};
+use crate::constant::{COMPACT_OUTPUT_BLOCK_SIZE, INPUT_BLOCK_SIZE, OUTPUT_BLOCK_SIZE, PACKED_BLOCK_SIZE};
+use crate::buffer::{AlignedBuffer, ALIGNMENT};
+use std::alloc::{handle_alloc_error, Layout};
+use std::io;
+use std::ops::{Deref, DerefMut};
+use std::os::raw::c_int;
+use std::ptr::NonNull;
+use std::sync::Arc;
+
+/// The statistics of a `BlockPool`
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct BlockPoolStats {
+    /// The number of mappings, of arenas and of arrays larger than an arena
+    pub mappings: usize,
+    /// The number of mappings on explicit huge pages, the others relying on transparent ones
+    pub hugetlb: usize,
+    /// The number of bytes mapped
+    pub mapped_bytes: usize,
+    /// The number of bytes of arrays given out and not yet dropped, rounded up to their size classes
+    pub used_bytes: usize,
+    /// The number of arrays given out
+    pub allocs: usize,
+    /// The number of arrays given out that were recycled
+    pub reuses: usize,
+}
+
+/// The block pool of LibSWIFFT, destroyed once neither its handles nor its arrays remain
+struct RawPool(*mut swifft_block_pool_t);
+
+// the block pool of LibSWIFFT is thread-safe
+unsafe impl Send for RawPool {}
+unsafe impl Sync for RawPool {}
+
+impl Drop for RawPool {
+    fn drop(&mut self) {
+        unsafe {
+            SWIFFT_BlockPoolDestroy(self.0)
+        }
+    }
+}
+
+/// A pool recycling arrays of blocks, shared by its clones
+#[derive(Clone)]
+pub struct BlockPool(Arc<RawPool>);
+
+impl BlockPool {
+    /// Creates a `BlockPool`, with no arenas until arrays are taken from it
+    pub fn new() -> io::Result<Self> {
+        Self::create(-1)
+    }
+
+    /// Creates a `BlockPool` whose arenas prefer the memory of a NUMA node
+    ///
+    /// # Arguments
+    /// * `node` - the NUMA node
+    pub fn with_node(node: usize) -> io::Result<Self> {
+        Self::create(c_int::try_from(node).map_err(|_| io::Error::new(io::ErrorKind::InvalidInput, "invalid node"))?)
+    }
+
+    fn create(node: c_int) -> io::Result<Self> {
+        let raw = unsafe { SWIFFT_BlockPoolCreate(node) };
+        if raw.is_null() {
+            return Err(io::Error::new(io::ErrorKind::OutOfMemory, "memory exhausted"));
+        }
+        Ok(Self(Arc::new(RawPool(raw))))
+    }
+
+    /// Takes an array of blocks from the pool, which it returns to when dropped.
+    /// It is zero-initialized when new, and holds what its previous user left in it when recycled.
+    /// Calls `handle_alloc_error` if memory is exhausted.
+    ///
+    /// # Arguments
+    /// * `num_blocks` - the number of blocks
+    pub fn alloc<const BLOCK_SIZE: usize>(&self, num_blocks: usize) -> Blocks<BLOCK_SIZE> {
+        let ptr = unsafe { SWIFFT_BlockPoolAlloc(self.0.0, num_blocks, BLOCK_SIZE) };
+        Blocks::from_raw(ptr, num_blocks, Some(self.0.clone()))
+    }
+
+    /// Returns the statistics of the pool
+    pub fn stats(&self) -> BlockPoolStats {
+        let mut raw = unsafe { std::mem::zeroed() };
+        unsafe {
+            SWIFFT_BlockPoolGetStats(self.0.0, &mut raw)
+        }
+        BlockPoolStats {
+            mappings: raw.mappings,
+            hugetlb: raw.hugetlb,
+            mapped_bytes: raw.mappedBytes,
+            used_bytes: raw.usedBytes,
+            allocs: raw.allocs,
+            reuses: raw.reuses,
+        }
+    }
+}
+
+/// An array of blocks allocated by LibSWIFFT, each aligned as an `AlignedBuffer`,
+/// dereferencing to a slice of blocks
+pub struct Blocks<const BLOCK_SIZE: usize> {
+    ptr: NonNull<AlignedBuffer<BLOCK_SIZE, 1>>,
+    len: usize,
+    pool: Option<Arc<RawPool>>,
+}
+
+// the array is owned as a `Vec` is
+unsafe impl<const BLOCK_SIZE: usize> Send for Blocks<BLOCK_SIZE> {}
+unsafe impl<const BLOCK_SIZE: usize> Sync for Blocks<BLOCK_SIZE> {}
+
+/// An array of inputs
+pub type InputBlocks = Blocks<INPUT_BLOCK_SIZE>;
+
+/// An array of sign inputs
+pub type SignInputBlocks = InputBlocks;
+
+/// An array of packed signed inputs
+pub type PackedSignedInputBlocks = Blocks<PACKED_BLOCK_SIZE>;
+
+/// An array of outputs
+pub type OutputBlocks = Blocks<OUTPUT_BLOCK_SIZE>;
+
+/// An array of compact outputs
+pub type CompactOutputBlocks = Blocks<COMPACT_OUTPUT_BLOCK_SIZE>;
+
+impl<const BLOCK_SIZE: usize> Blocks<BLOCK_SIZE> {
+    /// Allocates a zero-initialized array of blocks, not from a pool.
+    /// Calls `handle_alloc_error` if memory is exhausted.
+    ///
+    /// # Arguments
+    /// * `num_blocks` - the number of blocks
+    pub fn new(num_blocks: usize) -> Self {
+        let ptr = unsafe { SWIFFT_AllocBlocks(num_blocks, BLOCK_SIZE) };
+        Self::from_raw(ptr, num_blocks, None)
+    }
+
+    fn from_raw(ptr: *mut std::os::raw::c_void, len: usize, pool: Option<Arc<RawPool>>) -> Self {
+        match NonNull::new(ptr as *mut AlignedBuffer<BLOCK_SIZE, 1>) {
+            Some(ptr) => Self { ptr, len, pool },
+            None => handle_alloc_error(
+                Layout::from_size_align(len.saturating_mul(BLOCK_SIZE), ALIGNMENT).unwrap_or(Layout::new::<u8>())
+            ),
+        }
+    }
+
+    /// Returns the blocks of the array as bytes
+    pub fn as_bytes(&self) -> &[u8] {
+        unsafe { std::slice::from_raw_parts(self.ptr.as_ptr() as *const u8, self.len * BLOCK_SIZE) }
+    }
+
+    /// Returns the blocks of the array as mutable bytes
+    pub fn as_bytes_mut(&mut self) -> &mut [u8] {
+        unsafe { std::slice::from_raw_parts_mut(self.ptr.as_ptr() as *mut u8, self.len * BLOCK_SIZE) }
+    }
+}
+
+impl<const BLOCK_SIZE: usize> Deref for Blocks<BLOCK_SIZE> {
+    type Target = [AlignedBuffer<BLOCK_SIZE, 1>];
+
+    fn deref(&self) -> &Self::Target {
+        // the memory of LibSWIFFT arrays is always initialized
+        unsafe { std::slice::from_raw_parts(self.ptr.as_ptr(), self.len) }
+    }
+}
+
+impl<const BLOCK_SIZE: usize> DerefMut for Blocks<BLOCK_SIZE> {
+    fn deref_mut(&mut self) -> &mut Self::Target {
+        unsafe { std::slice::from_raw_parts_mut(self.ptr.as_ptr(), self.len) }
+    }
+}
+
+impl<const BLOCK_SIZE: usize> Drop for Blocks<BLOCK_SIZE> {
+    fn drop(&mut self) {
+        let ptr = self.ptr.as_ptr() as *mut std::os::raw::c_void;
+        match &self.pool {
+            Some(pool) => unsafe { SWIFFT_BlockPoolFree(pool.0, ptr) },
+            None => unsafe { SWIFFT_FreeBlocks(ptr) },
+        }
+    }
+}
@@ -1,6 +1,9 @@
 //! Parameters: n=64, m=32, q=257
 
-use crate::constant::{INPUT_BLOCK_SIZE, OUTPUT_BLOCK_SIZE, COMPACT_OUTPUT_BLOCK_SIZE};
+use crate::constant::{INPUT_BLOCK_SIZE, OUTPUT_BLOCK_SIZE, COMPACT_OUTPUT_BLOCK_SIZE, PACKED_BLOCK_SIZE};
+
+/// The alignment in bytes of an `AlignedBuffer`, as required by LibSWIFFT of its buffers
+pub const ALIGNMENT: usize = 64;
 
 #[repr(C, align(64))]
 pub struct AlignedBuffer<const CHUNK_SIZE: usize, const NUM_CHUNKS: usize>(pub [[u8; CHUNK_SIZE]; NUM_CHUNKS]);
@@ -23,6 +26,14 @@ pub type SignInput = SignInputs<1>;
 /// An array of sign inputs
 pub type SignInputs<const NUM_INPUTS: usize> = Inputs<NUM_INPUTS>;
 
+/// An input buffer and its sign buffer, packed into one buffer,
+/// where each chunk of `8` input bytes is followed by its `8` sign bytes.
+/// Allows for an input domain of `{-1, 0, 1}` read as one stream
+pub type PackedSignedInput = PackedSignedInputs<1>;
+
+/// An array of packed signed inputs
+pub type PackedSignedInputs<const NUM_INPUTS: usize> = AlignedBuffer<PACKED_BLOCK_SIZE, NUM_INPUTS>;
+
 /// An output vector in `Z_{257}^{64}`,
 /// where each element in the vector takes `16` bits
 pub type Output = Outputs<1>;
@@ -3,5 +3,8 @@ pub const M: usize = 32;
 pub const Q: usize = 257;
 pub const INPUT_SIZE: usize = N * M;
 pub const INPUT_BLOCK_SIZE: usize = INPUT_SIZE / u8::BITS as usize;
+pub const CHUNK_SIZE: usize = INPUT_BLOCK_SIZE / M;
+pub const SHORT_CHUNKS_MULTIPLE: usize = 4;
+pub const PACKED_BLOCK_SIZE: usize = 2*INPUT_BLOCK_SIZE;
 pub const OUTPUT_BLOCK_SIZE: usize = 2*N;
 pub const COMPACT_OUTPUT_BLOCK_SIZE: usize = 512 / u8::BITS as usize;
@@ -4,12 +4,17 @@
 //! 0th pos = 0th power of polynomial
 //! 0th pos = 0th power of 257
 
+use std::io::{self, Write};
 use crate::sys::{
-    SWIFFT_Compact, SWIFFT_CompactMultiple, SWIFFT_Compute, SWIFFT_ComputeMultiple,
-    SWIFFT_ComputeMultipleSigned, SWIFFT_ComputeSigned
+    swifft_stream_t, SWIFFT_Compact, SWIFFT_CompactMultiple, SWIFFT_Compute, SWIFFT_ComputeMultiple,
+    SWIFFT_ComputeMultipleSigned, SWIFFT_ComputeMultipleSignedPacked, SWIFFT_ComputeShort,
+    SWIFFT_ComputeSigned, SWIFFT_ComputeSignedPacked, SWIFFT_ComputeSignedShort, SWIFFT_StreamFinal,
+    SWIFFT_StreamInit, SWIFFT_StreamUpdate, SWIFFT_TreeHash, SWIFFT_Update, SWIFFT_UpdateMultiple
 };
+use crate::constant::{CHUNK_SIZE, M, SHORT_CHUNKS_MULTIPLE};
 use crate::buffer::{
-    CompactOutput, CompactOutputs, Input, Inputs, Output, Outputs, SignInput, SignInputs
+    CompactOutput, CompactOutputs, Input, Inputs, Output, Outputs, PackedSignedInput,
+    PackedSignedInputs, SignInput, SignInputs
 };
 
 /// Computes the result of a SWIFFT operation.
@@ -34,7 +39,7 @@ pub fn compute(input: &Input, output: &mut Output) {
 pub fn compute_multiple<const NUM_BLOCKS: usize>(input: &Inputs<NUM_BLOCKS>,
                                                  output: &mut Outputs<NUM_BLOCKS>) {
     unsafe {
-        SWIFFT_ComputeMultiple(NUM_BLOCKS.try_into().unwrap(), input.0[0].as_ptr(), output.0[0].as_mut_ptr())
+        SWIFFT_ComputeMultiple(NUM_BLOCKS, input.0[0].as_ptr(), output.0[0].as_mut_ptr())
     }
 }
 
@@ -61,7 +66,67 @@ pub fn compute_signed(input: &Input, sign_input: &SignInput, output: &mut Output
 /// * `output` - the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit)
 pub fn compute_multiple_signed<const NUM_BLOCKS: usize>(input: &Inputs<NUM_BLOCKS>, sign_input: &SignInputs<NUM_BLOCKS>, output: &mut Outputs<NUM_BLOCKS>) {
     unsafe {
-        SWIFFT_ComputeMultipleSigned(NUM_BLOCKS.try_into().unwrap(), input.0[0].as_ptr(), sign_input.0[0].as_ptr(), output.0[0].as_mut_ptr())
+        SWIFFT_ComputeMultipleSigned(NUM_BLOCKS, input.0[0].as_ptr(), sign_input.0[0].as_ptr(), output.0[0].as_mut_ptr())
+    }
+}
+
+/// Computes the result of a SWIFFT operation on packed signed input.
+/// The result is the same as that of `compute_signed` on the unpacked input and sign bits.
+/// 
+/// # Arguments
+/// * `packed_input` - the packed signed input of 512 bytes, each chunk of 8 input bytes followed by its 8 sign bytes
+/// * `output` - the resulting hash value of SWIFFT, of size 128 bytes (1024 bit)
+pub fn compute_signed_packed(packed_input: &PackedSignedInput, output: &mut Output) {
+    unsafe {
+        SWIFFT_ComputeSignedPacked(packed_input.0[0].as_ptr(), output.0[0].as_mut_ptr())
+    }
+}
+
+/// Computes the result of multiple SWIFFT operations on packed signed input.
+/// The result is the same as that of `compute_multiple_signed` on the unpacked blocks of input and sign bits.
+/// 
+/// # Arguments
+/// * `NUM_BLOCKS` - the number of blocks to operate on
+/// * `packed_input` - the blocks of packed signed input, each of 512 bytes
+/// * `output` - the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit)
+pub fn compute_multiple_signed_packed<const NUM_BLOCKS: usize>(packed_input: &PackedSignedInputs<NUM_BLOCKS>, output: &mut Outputs<NUM_BLOCKS>) {
+    unsafe {
+        SWIFFT_ComputeMultipleSignedPacked(NUM_BLOCKS, packed_input.0[0].as_ptr(), output.0[0].as_mut_ptr())
+    }
+}
+
+/// Computes the result of a SWIFFT operation on short input.
+/// The result is the same as that of `compute` on the input padded with zero bytes to 256 bytes,
+/// but the work is proportional to the number of chunks of input.
+/// Panics if `M_CHUNKS` is not a multiple of `SHORT_CHUNKS_MULTIPLE` from it up to `M`.
+///
+/// # Arguments
+/// * `M_CHUNKS` - the number of chunks of input
+/// * `input` - the input of `M_CHUNKS` chunks of 8 bytes
+/// * `output` - the resulting hash value of SWIFFT, of size 128 bytes (1024 bit)
+pub fn compute_short<const M_CHUNKS: usize>(input: &[[u8; CHUNK_SIZE]; M_CHUNKS], output: &mut Output) {
+    assert!(0 < M_CHUNKS && M_CHUNKS <= M && M_CHUNKS % SHORT_CHUNKS_MULTIPLE == 0);
+    unsafe {
+        SWIFFT_ComputeShort(M_CHUNKS as i32, input.as_ptr() as *const u8, output.0[0].as_mut_ptr());
+    }
+}
+
+/// Computes the result of a SWIFFT operation on short signed input.
+/// The result is the same as that of `compute_signed` on the input and sign bits padded with zero bytes
+/// to 256 bytes, but the work is proportional to the number of chunks of input.
+/// Panics if `M_CHUNKS` is not a multiple of `SHORT_CHUNKS_MULTIPLE` from it up to `M`.
+///
+/// # Arguments
+/// * `M_CHUNKS` - the number of chunks of input
+/// * `input` - the input of `M_CHUNKS` chunks of 8 bytes
+/// * `sign_input` - the sign bits corresponding to the input of `M_CHUNKS` chunks of 8 bytes
+/// * `output` - the resulting hash value of SWIFFT, of size 128 bytes (1024 bit)
+pub fn compute_signed_short<const M_CHUNKS: usize>(input: &[[u8; CHUNK_SIZE]; M_CHUNKS],
+                                                   sign_input: &[[u8; CHUNK_SIZE]; M_CHUNKS], output: &mut Output) {
+    assert!(0 < M_CHUNKS && M_CHUNKS <= M && M_CHUNKS % SHORT_CHUNKS_MULTIPLE == 0);
+    unsafe {
+        SWIFFT_ComputeSignedShort(M_CHUNKS as i32, input.as_ptr() as *const u8, sign_input.as_ptr() as *const u8,
+                                  output.0[0].as_mut_ptr());
     }
 }
 
@@ -86,6 +151,108 @@ pub fn compact(output: &Output, compact_output: &mut CompactOutput) {
 /// * `compact_output` - the compacted hash value of SWIFFT, of size 64 bytes (512 bit)
 pub fn compact_multiple<const NUM_BLOCKS: usize>(output: &Outputs<NUM_BLOCKS>, compact_output: &mut CompactOutputs<NUM_BLOCKS>) {
     unsafe {
-        SWIFFT_CompactMultiple(NUM_BLOCKS.try_into().unwrap(), output.0[0].as_ptr(), compact_output.0[0].as_mut_ptr())
+        SWIFFT_CompactMultiple(NUM_BLOCKS, output.0[0].as_ptr(), compact_output.0[0].as_mut_ptr())
+    }
+}
+
+/// Updates the result of a SWIFFT operation for a change of one chunk of its input.
+/// The result is the same as that of `compute` on the changed input.
+///
+/// # Arguments
+/// * `output` - the hash value of SWIFFT to modify, of size 128 bytes (1024 bit)
+/// * `old_chunk` - the old chunk of 8 bytes
+/// * `new_chunk` - the new chunk of 8 bytes
+/// * `chunk_index` - the index of the chunk in the input, less than 32
+pub fn update(output: &mut Output, old_chunk: &[u8; CHUNK_SIZE], new_chunk: &[u8; CHUNK_SIZE], chunk_index: usize) {
+    assert!(chunk_index < M);
+    unsafe {
+        SWIFFT_Update(output.0[0].as_mut_ptr(), old_chunk.as_ptr(), new_chunk.as_ptr(), chunk_index as i32)
+    }
+}
+
+/// Updates the results of multiple SWIFFT operations, each for a change of one chunk of its input.
+/// The result is the same as that of `compute_multiple` on the changed inputs.
+///
+/// # Arguments
+/// * `NUM_BLOCKS` - the number of blocks to operate on
+/// * `output` - the hash value of SWIFFT to modify, per block
+/// * `old_chunk` - the old chunk of 8 bytes, per block
+/// * `new_chunk` - the new chunk of 8 bytes, per block
+/// * `chunk_index` - the index of the chunk in the input, less than 32, per block
+pub fn update_multiple<const NUM_BLOCKS: usize>(output: &mut Outputs<NUM_BLOCKS>, old_chunk: &[[u8; CHUNK_SIZE]; NUM_BLOCKS],
+                                               new_chunk: &[[u8; CHUNK_SIZE]; NUM_BLOCKS], chunk_index: &[i32; NUM_BLOCKS]) {
+    assert!(chunk_index.iter().all(|&i| 0 <= i && (i as usize) < M));
+    unsafe {
+        SWIFFT_UpdateMultiple(NUM_BLOCKS, output.0[0].as_mut_ptr(),
+            old_chunk[0].as_ptr(), new_chunk[0].as_ptr(), chunk_index.as_ptr())
+    }
+}
+
+/// Hashes a message of any length incrementally, by chaining SWIFFT over its blocks.
+/// Writing to it hashes more bytes of the message, so it can hash the contents of a
+/// reader using `std::io::copy` without staging them.
+pub struct Stream(swifft_stream_t);
+
+impl Stream {
+    /// Creates a stream for hashing a new message.
+    pub fn new() -> Self {
+        let mut stream = Self(unsafe { std::mem::zeroed() });
+        unsafe {
+            SWIFFT_StreamInit(&mut stream.0)
+        }
+        stream
+    }
+
+    /// Hashes more bytes of the message.
+    ///
+    /// # Arguments
+    /// * `data` - the bytes
+    pub fn update(&mut self, data: &[u8]) {
+        unsafe {
+            SWIFFT_StreamUpdate(&mut self.0, data.as_ptr(), data.len())
+        }
     }
-}
\ No newline at end of file
+
+    /// Pads the message and returns its digest, of size 64 bytes (512 bit).
+    pub fn finalize(mut self) -> CompactOutput {
+        let mut digest = CompactOutput::default();
+        unsafe {
+            SWIFFT_StreamFinal(&mut self.0, digest.0[0].as_mut_ptr())
+        }
+        digest
+    }
+}
+
+impl Default for Stream {
+    /// Creates a stream for hashing a new message
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl Write for Stream {
+    fn write(&mut self, buf: &[u8]) -> io::Result<usize> {
+        self.update(buf);
+        Ok(buf.len())
+    }
+
+    fn flush(&mut self) -> io::Result<()> {
+        Ok(())
+    }
+}
+
+/// Hashes a message as a tree, computing the nodes of each level in parallel as configured.
+/// Returns the digest, of size 64 bytes (512 bit), or `None` if the parameters are invalid.
+///
+/// # Arguments
+/// * `data` - the message
+/// * `leaf_size` - the number of bytes per leaf, from 1 to 256
+/// * `fanout` - the number of digests per group, from 2 to 4
+pub fn tree_hash(data: &[u8], leaf_size: usize, fanout: usize) -> Option<CompactOutput> {
+    let fanout = fanout.try_into().ok()?;
+    let mut digest = CompactOutput::default();
+    let result = unsafe {
+        SWIFFT_TreeHash(data.as_ptr(), data.len(), leaf_size, fanout, digest.0[0].as_mut_ptr())
+    };
+    if result == 0 { Some(digest) } else { None }
+}
@@ -0,0 +1,378 @@
+//! An index of compact hash values of SWIFFT
+//!
+//! An `Index` maps compact hash values, as given by `compact_slice`, to 64-bit values, such as
+//! offsets of deduplicated content. It probes batches of hash values, matching tags of whole
+//! groups of slots using SIMD instructions. It either lives in memory or is mapped from a file,
+//! which `Index::open_file` reopens in place, without rebuilding it.
+
+use crate::sys::{
+    swifft_index_t, SWIFFT_IndexComputeInsertMultiple, SWIFFT_IndexCount, SWIFFT_IndexCreate,
+    SWIFFT_IndexCreateFile, SWIFFT_IndexDestroy, SWIFFT_IndexInsertMultiple, SWIFFT_IndexLookupMultiple,
+    SWIFFT_IndexMaxEntries, SWIFFT_IndexOpenFile, SWIFFT_IndexSync, SWIFFT_INDEX_NOT_FOUND
+};
+use crate::buffer::{CompactOutput, Input};
+use std::ffi::CString;
+use std::io;
+use std::path::Path;
+use std::ptr::NonNull;
+
+/// The value looked up for a hash value not in the index, which may not be inserted
+pub const NOT_FOUND: u64 = SWIFFT_INDEX_NOT_FOUND;
+
+/// An index of compact hash values of SWIFFT, mapping each to a 64-bit value.
+/// Its entries are never removed.
+pub struct Index(NonNull<swifft_index_t>);
+
+// the index of LibSWIFFT may be probed from multiple threads at once, and is inserted into
+// only through `&mut self`
+unsafe impl Send for Index {}
+unsafe impl Sync for Index {}
+
+fn c_path(path: &Path) -> io::Result<CString> {
+    #[cfg(unix)]
+    let bytes = {
+        use std::os::unix::ffi::OsStrExt;
+        path.as_os_str().as_bytes()
+    };
+    #[cfg(not(unix))]
+    let bytes = path.to_str().ok_or_else(|| io::Error::new(io::ErrorKind::InvalidInput, "invalid path"))?.as_bytes();
+    CString::new(bytes).map_err(|_| io::Error::new(io::ErrorKind::InvalidInput, "invalid path"))
+}
+
+fn full_error() -> io::Error {
+    io::Error::new(io::ErrorKind::Other, "index full or not writable")
+}
+
+impl Index {
+    /// Creates an empty index in memory, on huge pages where available
+    ///
+    /// # Arguments
+    /// * `max_entries` - the number of entries the index can hold
+    pub fn new(max_entries: usize) -> io::Result<Self> {
+        let raw = unsafe { SWIFFT_IndexCreate(max_entries) };
+        NonNull::new(raw).map(Self).ok_or_else(|| io::Error::new(io::ErrorKind::OutOfMemory, "memory exhausted"))
+    }
+
+    /// Creates an empty index mapped from a file, which is created or truncated
+    ///
+    /// # Arguments
+    /// * `path` - the path of the file
+    /// * `max_entries` - the number of entries the index can hold
+    pub fn create_file<P: AsRef<Path>>(path: P, max_entries: usize) -> io::Result<Self> {
+        let path = c_path(path.as_ref())?;
+        let raw = unsafe { SWIFFT_IndexCreateFile(path.as_ptr(), max_entries) };
+        NonNull::new(raw).map(Self).ok_or_else(io::Error::last_os_error)
+    }
+
+    /// Opens an index mapped from a file created by `Index::create_file`, in place.
+    /// Fails with `InvalidInput` if the file is not an index in the format of the host.
+    ///
+    /// # Arguments
+    /// * `path` - the path of the file
+    /// * `writable` - whether to allow inserting into the index
+    pub fn open_file<P: AsRef<Path>>(path: P, writable: bool) -> io::Result<Self> {
+        let path = c_path(path.as_ref())?;
+        let raw = unsafe { SWIFFT_IndexOpenFile(path.as_ptr(), writable as _) };
+        NonNull::new(raw).map(Self).ok_or_else(io::Error::last_os_error)
+    }
+
+    /// Inserts multiple compact hash values, each unless it is already in the index.
+    /// A hash value repeated within the slice is inserted once, with the value of its first occurrence.
+    /// Fails if the index is full or not writable, in which case only the hash values before the
+    /// first that did not fit are inserted and have their stored values given.
+    /// Panics if the numbers of blocks differ.
+    ///
+    /// # Arguments
+    /// * `compact` - the compact hash values, each of size 64 bytes (512 bit)
+    /// * `values` - the values of the hash values, other than `NOT_FOUND`
+    /// * `stored` - the resulting values that the index holds for the hash values, which equal
+    /// their values for those inserted and are those inserted before for the others
+    pub fn insert_slice(&mut self, compact: &[CompactOutput], values: &[u64], stored: &mut [u64]) -> io::Result<()> {
+        assert_eq!(compact.len(), values.len(), "numbers of blocks differ");
+        assert_eq!(compact.len(), stored.len(), "numbers of blocks differ");
+        let rc = unsafe {
+            SWIFFT_IndexInsertMultiple(self.0.as_ptr(), compact.len(), compact.as_ptr() as *const u8,
+                values.as_ptr(), stored.as_mut_ptr())
+        };
+        if rc != 0 { Err(full_error()) } else { Ok(()) }
+    }
+
+    /// Computes the compact hash values of multiple blocks of input and inserts them, as
+    /// `compute_slice` and `compact_slice` followed by `insert_slice` do, tile by tile so that
+    /// the hash values are inserted while they are in cache.
+    /// Panics if the numbers of blocks differ.
+    ///
+    /// # Arguments
+    /// * `input` - the blocks of input, each of size 256 bytes (2048 bit)
+    /// * `compact` - the resulting compact hash values, each of size 64 bytes (512 bit), if needed
+    /// * `values` - the values of the hash values, other than `NOT_FOUND`
+    /// * `stored` - the resulting values that the index holds for the hash values, as given by `insert_slice`
+    pub fn compute_insert_slice(&mut self, input: &[Input], compact: Option<&mut [CompactOutput]>, values: &[u64],
+            stored: &mut [u64]) -> io::Result<()> {
+        assert_eq!(input.len(), values.len(), "numbers of blocks differ");
+        assert_eq!(input.len(), stored.len(), "numbers of blocks differ");
+        let compact = match compact {
+            Some(compact) => {
+                assert_eq!(input.len(), compact.len(), "numbers of blocks differ");
+                compact.as_mut_ptr() as *mut u8
+            }
+            None => std::ptr::null_mut(),
+        };
+        let rc = unsafe {
+            SWIFFT_IndexComputeInsertMultiple(self.0.as_ptr(), input.len(), input.as_ptr() as *const u8, compact,
+                values.as_ptr(), stored.as_mut_ptr())
+        };
+        if rc != 0 { Err(full_error()) } else { Ok(()) }
+    }
+
+    /// Looks up multiple compact hash values.
+    /// Panics if the numbers of blocks differ.
+    ///
+    /// # Arguments
+    /// * `compact` - the compact hash values, each of size 64 bytes (512 bit)
+    /// * `values` - the resulting values of the hash values, or `NOT_FOUND` for those not in the index
+    pub fn lookup_slice(&self, compact: &[CompactOutput], values: &mut [u64]) {
+        assert_eq!(compact.len(), values.len(), "numbers of blocks differ");
+        unsafe {
+            SWIFFT_IndexLookupMultiple(self.0.as_ptr(), compact.len(), compact.as_ptr() as *const u8,
+                values.as_mut_ptr())
+        }
+    }
+
+    /// Returns the number of entries of the index
+    pub fn len(&self) -> usize {
+        unsafe { SWIFFT_IndexCount(self.0.as_ptr()) }
+    }
+
+    /// Returns whether the index has no entries
+    pub fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+
+    /// Returns the number of entries the index can hold
+    pub fn max_entries(&self) -> usize {
+        unsafe { SWIFFT_IndexMaxEntries(self.0.as_ptr()) }
+    }
+
+    /// Writes an index mapped from a file back to the file, waiting for the writes to complete.
+    /// An index in memory always succeeds.
+    pub fn sync(&mut self) -> io::Result<()> {
+        let rc = unsafe { SWIFFT_IndexSync(self.0.as_ptr()) };
+        if rc != 0 { Err(io::Error::last_os_error()) } else { Ok(()) }
+    }
+}
+
+impl Drop for Index {
+    fn drop(&mut self) {
+        unsafe {
+            SWIFFT_IndexDestroy(self.0.as_ptr())
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::batch::{compact_slice, compute_slice};
+    use crate::buffer::{AlignedBuffer, Output};
+    use std::fs::OpenOptions;
+    use std::io::{Seek, SeekFrom, Write};
+    use std::path::PathBuf;
+
+    /// The offset of the tags in the file of an index, after its header page
+    const TAGS_OFFSET: u64 = 4096;
+
+    fn digests(n: usize, seed: u8) -> Vec<CompactOutput> {
+        (0..n).map(|i| {
+            let mut digest = CompactOutput::new(seed);
+            digest.0[0][..8].copy_from_slice(&(i as u64).to_le_bytes());
+            digest
+        }).collect()
+    }
+
+    fn temp_path(name: &str) -> PathBuf {
+        std::env::temp_dir().join(format!("libswifft-index-{}-{}", std::process::id(), name))
+    }
+
+    fn create_file_with(path: &Path, n: usize) -> Vec<CompactOutput> {
+        let compact = digests(n, 1);
+        let values: Vec<u64> = (0..n as u64).collect();
+        let mut stored = vec![0; n];
+        let mut index = Index::create_file(path, 2 * n).unwrap();
+        index.insert_slice(&compact, &values, &mut stored).unwrap();
+        index.sync().unwrap();
+        compact
+    }
+
+    #[test]
+    fn insert_and_lookup() {
+        let compact = digests(1000, 0);
+        let values: Vec<u64> = (0..1000).map(|i| i * 3).collect();
+        let mut stored = vec![0; 1000];
+        let mut index = Index::new(2000).unwrap();
+        assert!(index.is_empty());
+        index.insert_slice(&compact, &values, &mut stored).unwrap();
+        assert_eq!(index.len(), 1000);
+        assert_eq!(stored, values);
+
+        let mut found = vec![0; 1000];
+        index.lookup_slice(&compact, &mut found);
+        assert_eq!(found, values);
+        index.lookup_slice(&digests(1000, 2), &mut found);
+        assert!(found.iter().all(|&value| value == NOT_FOUND));
+    }
+
+    #[test]
+    fn insert_duplicates_within_batch() {
+        // every digest occurs three times, at i, i+10 and i+20, and is inserted at its first occurrence
+        let unique = digests(10, 0);
+        let compact: Vec<CompactOutput> = (0..30).map(|i| AlignedBuffer(unique[i % 10].0)).collect();
+        let values: Vec<u64> = (100..130).collect();
+        let mut stored = vec![0; 30];
+        let mut index = Index::new(100).unwrap();
+        index.insert_slice(&compact, &values, &mut stored).unwrap();
+        assert_eq!(index.len(), 10);
+        for i in 0..30 {
+            assert_eq!(stored[i], 100 + (i % 10) as u64);
+        }
+
+        // digests already in the index keep their values
+        index.insert_slice(&compact[..10], &values[20..], &mut stored[..10]).unwrap();
+        assert_eq!(index.len(), 10);
+        assert_eq!(&stored[..10], &values[..10]);
+    }
+
+    #[test]
+    fn insert_into_full_index() {
+        let compact = digests(20, 0);
+        let values: Vec<u64> = (0..20).collect();
+        let mut stored = vec![NOT_FOUND; 20];
+        let mut index = Index::new(8).unwrap();
+        assert_eq!(index.max_entries(), 8);
+        assert!(index.insert_slice(&compact, &values, &mut stored).is_err());
+        assert_eq!(index.len(), 8);
+        assert_eq!(&stored[..8], &values[..8]);
+
+        // digests already in a full index are still found
+        let mut again = vec![0; 8];
+        index.insert_slice(&compact[..8], &values[..8], &mut again).unwrap();
+        assert_eq!(&again, &values[..8]);
+        let mut found = vec![0; 20];
+        index.lookup_slice(&compact, &mut found);
+        assert_eq!(&found[..8], &values[..8]);
+        assert!(found[8..].iter().all(|&value| value == NOT_FOUND));
+    }
+
+    #[test]
+    fn compute_insert_matches_compact() {
+        let n = 3000;
+        let input: Vec<Input> = (0..n).map(|i| {
+            let mut input = Input::new(0);
+            input.0[0][..8].copy_from_slice(&((i % 2000) as u64).to_le_bytes());
+            input
+        }).collect();
+        let values: Vec<u64> = (0..n as u64).collect();
+        let mut compact: Vec<CompactOutput> = (0..n).map(|_| CompactOutput::new(0)).collect();
+        let mut stored = vec![0; n];
+        let mut index = Index::new(n).unwrap();
+        index.compute_insert_slice(&input, Some(&mut compact), &values, &mut stored).unwrap();
+        assert_eq!(index.len(), 2000);
+        for i in 0..n {
+            assert_eq!(stored[i], (i % 2000) as u64);
+        }
+
+        let mut output: Vec<Output> = (0..n).map(|_| Output::new(0)).collect();
+        let mut expected: Vec<CompactOutput> = (0..n).map(|_| CompactOutput::new(0)).collect();
+        compute_slice(&input, &mut output);
+        compact_slice(&output, &mut expected);
+        for i in 0..n {
+            assert_eq!(compact[i].0, expected[i].0);
+        }
+        let mut found = vec![0; n];
+        index.lookup_slice(&expected, &mut found);
+        assert_eq!(found, stored);
+    }
+
+    #[test]
+    fn reopen_after_sync() {
+        let path = temp_path("reopen");
+        let compact = create_file_with(&path, 500);
+        let mut found = vec![0; 500];
+        {
+            let index = Index::open_file(&path, false).unwrap();
+            assert_eq!(index.len(), 500);
+            assert_eq!(index.max_entries(), 1000);
+            index.lookup_slice(&compact, &mut found);
+            assert!(found.iter().enumerate().all(|(i, &value)| value == i as u64));
+        }
+        {
+            let mut index = Index::open_file(&path, false).unwrap();
+            let mut stored = vec![0; 1];
+            assert!(index.insert_slice(&digests(1, 2), &[7], &mut stored).is_err());
+        }
+        {
+            let mut index = Index::open_file(&path, true).unwrap();
+            let more = digests(100, 2);
+            let values: Vec<u64> = (500..600).collect();
+            let mut stored = vec![0; 100];
+            index.insert_slice(&more, &values, &mut stored).unwrap();
+            index.sync().unwrap();
+        }
+        let index = Index::open_file(&path, false).unwrap();
+        assert_eq!(index.len(), 600);
+        index.lookup_slice(&compact, &mut found);
+        assert!(found.iter().enumerate().all(|(i, &value)| value == i as u64));
+        std::fs::remove_file(&path).unwrap();
+    }
+
+    #[test]
+    fn reject_missing_file() {
+        let err = Index::open_file(temp_path("missing"), false).err().unwrap();
+        assert_eq!(err.kind(), io::ErrorKind::NotFound);
+    }
+
+    #[test]
+    fn reject_truncated_file() {
+        let path = temp_path("truncated");
+        create_file_with(&path, 100);
+        let len = std::fs::metadata(&path).unwrap().len();
+        for size in [len - 4096, 4096, 100, 0] {
+            OpenOptions::new().write(true).open(&path).unwrap().set_len(size).unwrap();
+            let err = Index::open_file(&path, false).err().unwrap();
+            assert_eq!(err.kind(), io::ErrorKind::InvalidInput, "size {}", size);
+        }
+        std::fs::remove_file(&path).unwrap();
+    }
+
+    #[test]
+    fn reject_corrupted_file() {
+        let path = temp_path("corrupted");
+        // each case overwrites some bytes at an offset of a valid file
+        let cases: [(u64, &[u8]); 4] = [
+            (0, b"NOTANIDX"),
+            (8, &0x0807060504030201u64.to_ne_bytes()),
+            (TAGS_OFFSET + 3, &[0x01]),
+            (TAGS_OFFSET, &[0x01; 64]),
+        ];
+        for (offset, bytes) in cases.iter() {
+            create_file_with(&path, 100);
+            let mut file = OpenOptions::new().write(true).open(&path).unwrap();
+            file.seek(SeekFrom::Start(*offset)).unwrap();
+            file.write_all(bytes).unwrap();
+            drop(file);
+            let err = Index::open_file(&path, true).err().unwrap();
+            assert_eq!(err.kind(), io::ErrorKind::InvalidInput, "offset {}", offset);
+        }
+
+        // tags without their top bit everywhere leave no empty slot, which probing would never end on;
+        // the 256 tags of an index of 200 entries are within the page after the header
+        create_file_with(&path, 100);
+        let mut file = OpenOptions::new().write(true).open(&path).unwrap();
+        file.seek(SeekFrom::Start(TAGS_OFFSET)).unwrap();
+        file.write_all(&[0x01; 4096]).unwrap();
+        drop(file);
+        let err = Index::open_file(&path, true).err().unwrap();
+        assert_eq!(err.kind(), io::ErrorKind::InvalidInput);
+        std::fs::remove_file(&path).unwrap();
+    }
+}
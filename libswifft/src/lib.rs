@@ -1,5 +1,12 @@
 pub use libswifft_sys as sys;
 pub mod buffer;
+pub mod batch;
+pub mod blocks;
+pub mod index;
 pub mod hash;
 pub mod arithmetic;
-pub mod constant;
\ No newline at end of file
+pub mod constant;
+pub mod pool;
+pub mod queue;
+pub mod stats;
+pub mod tune;
\ No newline at end of file
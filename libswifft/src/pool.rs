@@ -0,0 +1,137 @@
+//! Parallelism of SWIFFT operations on multiple blocks
+//!
+//! The `*_multiple` functions run on the calling thread alone by default. Either
+//! configure the native pool of LibSWIFFT using `set_threads`, or, with the
+//! `rayon` feature, run them on a rayon thread pool using `use_rayon`.
+
+use crate::sys::{
+    swifft_op_class_t_SWIFFT_OP_ARITH, swifft_op_class_t_SWIFFT_OP_COMPACT, swifft_op_class_t_SWIFFT_OP_FFT,
+    swifft_op_class_t_SWIFFT_OP_HASH, SWIFFT_GetGrain, SWIFFT_GetOpGrain, SWIFFT_GetOpThreshold, SWIFFT_GetThreads,
+    SWIFFT_SetExecutor, SWIFFT_SetGrain, SWIFFT_SetOpGrain, SWIFFT_SetOpThreshold, SWIFFT_SetThreads
+};
+#[cfg(feature = "rayon")]
+use crate::sys::swifft_task_fn;
+#[cfg(feature = "rayon")]
+use std::os::raw::{c_int, c_void};
+
+/// Sets the number of threads of the native pool, including the calling thread.
+/// Waits for running operations to complete. One thread, the default, disables the pool.
+///
+/// # Arguments
+/// * `num_threads` - the number of threads, or 0 for the number of online processors
+pub fn set_threads(num_threads: usize) {
+    unsafe {
+        SWIFFT_SetThreads(num_threads.try_into().unwrap())
+    }
+}
+
+/// Returns the number of threads of the native pool, including the calling thread.
+pub fn threads() -> usize {
+    unsafe {
+        SWIFFT_GetThreads() as usize
+    }
+}
+
+/// Sets the maximum number of blocks per range that a thread runs at once.
+///
+/// # Arguments
+/// * `grain` - the number of blocks, or 0 for the default
+pub fn set_grain(grain: usize) {
+    unsafe {
+        SWIFFT_SetGrain(grain.try_into().unwrap())
+    }
+}
+
+/// Returns the maximum number of blocks per range that a thread runs at once.
+pub fn grain() -> usize {
+    unsafe {
+        SWIFFT_GetGrain() as usize
+    }
+}
+
+/// The classes of operations on multiple blocks, by their cost per block.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum OpClass {
+    /// Arithmetic on hash values, such as `add_multiple`
+    Arith = swifft_op_class_t_SWIFFT_OP_ARITH as isize,
+    /// Compaction of hash values
+    Compact = swifft_op_class_t_SWIFFT_OP_COMPACT as isize,
+    /// The phases of SWIFFT, and updates of hash values
+    Fft = swifft_op_class_t_SWIFFT_OP_FFT as isize,
+    /// Hashing, such as `compute_multiple`
+    Hash = swifft_op_class_t_SWIFFT_OP_HASH as isize,
+}
+
+/// Sets the maximum number of blocks that operations of a class run on the calling thread alone.
+///
+/// # Arguments
+/// * `op` - the class of operations
+/// * `threshold` - the number of blocks, or `usize::MAX` for always running on the calling thread alone
+pub fn set_op_threshold(op: OpClass, threshold: usize) {
+    unsafe {
+        SWIFFT_SetOpThreshold(op as i32, threshold)
+    }
+}
+
+/// Returns the maximum number of blocks that operations of a class run on the calling thread alone.
+pub fn op_threshold(op: OpClass) -> usize {
+    unsafe {
+        SWIFFT_GetOpThreshold(op as i32)
+    }
+}
+
+/// Sets the maximum number of blocks per range that a thread runs at once, for operations of a class.
+///
+/// # Arguments
+/// * `op` - the class of operations
+/// * `grain` - the number of blocks, or 0 for the one of `grain`
+pub fn set_op_grain(op: OpClass, grain: usize) {
+    unsafe {
+        SWIFFT_SetOpGrain(op as i32, grain.try_into().unwrap())
+    }
+}
+
+/// Returns the maximum number of blocks per range that a thread runs at once, for operations of a class.
+pub fn op_grain(op: OpClass) -> usize {
+    unsafe {
+        SWIFFT_GetOpGrain(op as i32) as usize
+    }
+}
+
+/// Runs operations on multiple blocks using the native pool, undoing `use_rayon`.
+/// Call it while no operations on multiple blocks run.
+pub fn use_native_pool() {
+    unsafe {
+        SWIFFT_SetExecutor(None, std::ptr::null_mut())
+    }
+}
+
+/// Runs operations on multiple blocks using rayon, instead of the native pool.
+/// An operation runs on the rayon thread pool of the calling thread, e.g. one
+/// entered using `ThreadPool::install`, or else on the global one.
+/// Call it while no operations on multiple blocks run.
+#[cfg(feature = "rayon")]
+pub fn use_rayon() {
+    unsafe {
+        SWIFFT_SetExecutor(Some(rayon_executor), std::ptr::null_mut())
+    }
+}
+
+/// Runs a task of LibSWIFFT on a rayon thread pool, one parallel item per range of blocks.
+#[cfg(feature = "rayon")]
+unsafe extern "C" fn rayon_executor(_context: *mut c_void, taskfn: swifft_task_fn, task: *mut c_void,
+                                    nblocks: usize, grain: c_int) {
+    use rayon::prelude::*;
+    let taskfn = match taskfn {
+        Some(taskfn) => taskfn,
+        None => return,
+    };
+    // the task outlives the parallel iteration, which completes before returning
+    let task = task as usize;
+    let grain = grain as usize;
+    let num_ranges = (nblocks + grain - 1) / grain;
+    (0..num_ranges).into_par_iter().for_each(|range| {
+        let begin = range * grain;
+        taskfn(task as *mut c_void, begin, (begin + grain).min(nblocks))
+    });
+}
@@ -0,0 +1,379 @@
+//! Asynchronous hashing of batches on a queue
+//!
+//! A `Queue` runs operations on batches on its own worker threads of LibSWIFFT, so
+//! the caller may go on reading input while earlier batches are hashed. Submitting
+//! moves the batches into a `Submission`, a `Future` that gives them back as a
+//! `Completion` once the operation completes. A `Pipeline` keeps submissions in
+//! flight and yields their completions in submission order, and is a `Stream` with
+//! the `futures-core` feature.
+
+use crate::sys::{
+    swifft_queue_t, swifft_request_op_t_SWIFFT_REQUEST_COMPACT, swifft_request_op_t_SWIFFT_REQUEST_COMPUTE,
+    swifft_request_op_t_SWIFFT_REQUEST_COMPUTE_COMPACT, swifft_request_op_t_SWIFFT_REQUEST_COMPUTE_SIGNED_PACKED,
+    swifft_request_t, SWIFFT_QueueCreate, SWIFFT_QueueDestroy, SWIFFT_QueueSubmit
+};
+use crate::constant::{COMPACT_OUTPUT_BLOCK_SIZE, INPUT_BLOCK_SIZE, OUTPUT_BLOCK_SIZE, PACKED_BLOCK_SIZE};
+use crate::batch::{
+    Batch, CompactOutputBatch, InputBatch, OutputBatch, PackedSignedInputBatch, SignInputBatch
+};
+use std::collections::VecDeque;
+use std::future::Future;
+use std::io;
+use std::os::raw::{c_int, c_void};
+use std::pin::Pin;
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::sync::{Arc, Condvar, Mutex};
+use std::task::{Context, Poll, Wake, Waker};
+use std::thread::{self, Thread};
+
+/// The batches of a completed submission, given back for reuse
+pub struct Completion<const INPUT_SIZE: usize, const OUTPUT_SIZE: usize> {
+    /// The blocks of input
+    pub input: Batch<INPUT_SIZE>,
+    /// The blocks of sign bits, for signed submissions
+    pub sign: Option<SignInputBatch>,
+    /// The resulting blocks
+    pub output: Batch<OUTPUT_SIZE>,
+}
+
+/// The state of a queue shared with its submissions and its completion callback
+struct Shared {
+    /// The queue of LibSWIFFT
+    raw: *mut swifft_queue_t,
+    /// The number of completions so far, for submissions that found the queue full
+    completions: AtomicUsize,
+    /// The wakers of submissions that found the queue full
+    waiters: Mutex<Vec<Waker>>,
+}
+
+// the queue of LibSWIFFT is thread-safe
+unsafe impl Send for Shared {}
+unsafe impl Sync for Shared {}
+
+impl Drop for Shared {
+    fn drop(&mut self) {
+        // waits for the submissions in flight, which hold no reference to the queue
+        unsafe {
+            SWIFFT_QueueDestroy(self.raw)
+        }
+    }
+}
+
+/// The completion state of a submission, shared with the completion callback
+#[derive(Default)]
+struct Slot {
+    /// Whether the operation completed, and the waker of the submission
+    state: Mutex<(bool, Option<Waker>)>,
+    /// Signals a dropped submission that the operation completed
+    done: Condvar,
+}
+
+/// Completes a request of a queue, on a worker thread of LibSWIFFT.
+unsafe extern "C" fn complete(context: *mut c_void, request: *const swifft_request_t) {
+    let shared = &*(context as *const Shared);
+    // takes over the reference of the slot held by the request
+    let slot = Arc::from_raw((*request).userData as *const Slot);
+    let waker = {
+        let mut state = slot.state.lock().unwrap();
+        state.0 = true;
+        slot.done.notify_all();
+        state.1.take()
+    };
+    if let Some(waker) = waker {
+        waker.wake();
+    }
+    // the request no longer counts toward the depth of the queue
+    shared.completions.fetch_add(1, Ordering::SeqCst);
+    let waiters = std::mem::take(&mut *shared.waiters.lock().unwrap());
+    for waiter in waiters {
+        waiter.wake();
+    }
+}
+
+/// A queue running operations on batches on its own worker threads
+#[derive(Clone)]
+pub struct Queue(Arc<Shared>);
+
+impl Queue {
+    /// Creates a queue and its worker threads.
+    /// Without the native pool of LibSWIFFT, operations run on the calling thread as they are handed to the queue.
+    ///
+    /// # Arguments
+    /// * `num_workers` - the number of worker threads, or 0 for the number of online processors
+    /// * `depth` - the maximum number of submissions in flight, at least 1
+    pub fn new(num_workers: usize, depth: usize) -> io::Result<Self> {
+        let invalid = || io::Error::new(io::ErrorKind::InvalidInput, "invalid number of workers or depth");
+        let num_workers = c_int::try_from(num_workers).map_err(|_| invalid())?;
+        let depth = c_int::try_from(depth).map_err(|_| invalid())?;
+        let mut shared = Arc::new(Shared {
+            raw: std::ptr::null_mut(),
+            completions: AtomicUsize::new(0),
+            waiters: Mutex::new(Vec::new()),
+        });
+        // the callback gets the shared state, whose address is fixed by now
+        let context = Arc::as_ptr(&shared) as *mut c_void;
+        let raw = unsafe { SWIFFT_QueueCreate(num_workers, depth, Some(complete), context) };
+        if raw.is_null() {
+            return Err(if depth < 1 { invalid() } else { io::Error::last_os_error() });
+        }
+        Arc::get_mut(&mut shared).unwrap().raw = raw;
+        Ok(Self(shared))
+    }
+
+    /// Submits the computation of the result of multiple SWIFFT operations.
+    /// The result is composable with other hash values.
+    /// Panics if the numbers of blocks differ.
+    ///
+    /// # Arguments
+    /// * `input` - the blocks of input, each of 256 bytes (2048 bit)
+    /// * `output` - the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit)
+    pub fn compute(&self, input: InputBatch, output: OutputBatch) -> Submission<INPUT_BLOCK_SIZE, OUTPUT_BLOCK_SIZE> {
+        self.submit(swifft_request_op_t_SWIFFT_REQUEST_COMPUTE, input, None, output)
+    }
+
+    /// Submits the computation of the result of multiple SWIFFT operations on signed input.
+    /// The result is composable with other hash values.
+    /// Panics if the numbers of blocks differ.
+    ///
+    /// # Arguments
+    /// * `input` - the blocks of input, each of 256 bytes (2048 bit)
+    /// * `sign_input` - the blocks of sign bits corresponding to blocks of input of 256 bytes (2048 bit)
+    /// * `output` - the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit)
+    pub fn compute_signed(&self, input: InputBatch, sign_input: SignInputBatch, output: OutputBatch)
+                          -> Submission<INPUT_BLOCK_SIZE, OUTPUT_BLOCK_SIZE> {
+        self.submit(swifft_request_op_t_SWIFFT_REQUEST_COMPUTE, input, Some(sign_input), output)
+    }
+
+    /// Submits the computation of the result of multiple SWIFFT operations on packed signed input.
+    /// Panics if the numbers of blocks differ.
+    ///
+    /// # Arguments
+    /// * `packed_input` - the blocks of packed signed input, each of 512 bytes
+    /// * `output` - the resulting blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit)
+    pub fn compute_signed_packed(&self, packed_input: PackedSignedInputBatch, output: OutputBatch)
+                                 -> Submission<PACKED_BLOCK_SIZE, OUTPUT_BLOCK_SIZE> {
+        self.submit(swifft_request_op_t_SWIFFT_REQUEST_COMPUTE_SIGNED_PACKED, packed_input, None, output)
+    }
+
+    /// Submits the computation and compaction of the result of multiple SWIFFT operations.
+    /// The result is not composable with other compacted hash values.
+    /// Panics if the numbers of blocks differ.
+    ///
+    /// # Arguments
+    /// * `input` - the blocks of input, each of 256 bytes (2048 bit)
+    /// * `compact_output` - the resulting blocks of compacted hash values of SWIFFT, each of size 64 bytes (512 bit)
+    pub fn compute_compact(&self, input: InputBatch, compact_output: CompactOutputBatch)
+                           -> Submission<INPUT_BLOCK_SIZE, COMPACT_OUTPUT_BLOCK_SIZE> {
+        self.submit(swifft_request_op_t_SWIFFT_REQUEST_COMPUTE_COMPACT, input, None, compact_output)
+    }
+
+    /// Submits the compaction of multiple hash values of SWIFFT.
+    /// The result is not composable with other compacted hash values.
+    /// Panics if the numbers of blocks differ.
+    ///
+    /// # Arguments
+    /// * `output` - the blocks of hash values of SWIFFT, each of size 128 bytes (1024 bit)
+    /// * `compact_output` - the resulting blocks of compacted hash values of SWIFFT, each of size 64 bytes (512 bit)
+    pub fn compact(&self, output: OutputBatch, compact_output: CompactOutputBatch)
+                   -> Submission<OUTPUT_BLOCK_SIZE, COMPACT_OUTPUT_BLOCK_SIZE> {
+        self.submit(swifft_request_op_t_SWIFFT_REQUEST_COMPACT, output, None, compact_output)
+    }
+
+    fn submit<const IN: usize, const OUT: usize>(&self, op: u32, input: Batch<IN>, sign: Option<SignInputBatch>,
+                                                 mut output: Batch<OUT>) -> Submission<IN, OUT> {
+        assert_eq!(input.len(), output.len(), "numbers of blocks differ");
+        if let Some(sign) = &sign {
+            assert_eq!(sign.len(), output.len(), "numbers of blocks differ");
+        }
+        // the blocks stay in place on the heap as the batches move
+        let request = swifft_request_t {
+            op: op as c_int,
+            nblocks: output.len(),
+            input: input.as_bytes().as_ptr(),
+            sign: sign.as_ref().map_or(std::ptr::null(), |sign| sign.as_bytes().as_ptr()),
+            output: output.as_bytes_mut().as_mut_ptr(),
+            userData: std::ptr::null_mut(),
+        };
+        Submission {
+            queue: self.0.clone(),
+            request,
+            slot: None,
+            batches: Some(Completion { input, sign, output }),
+        }
+    }
+}
+
+/// An operation on batches submitted to a queue, resolving to its `Completion`.
+/// The operation is handed to the queue when first polled, once the queue has room for it.
+/// Dropping a submission in flight waits for its operation to complete.
+pub struct Submission<const INPUT_SIZE: usize, const OUTPUT_SIZE: usize> {
+    queue: Arc<Shared>,
+    request: swifft_request_t,
+    slot: Option<Arc<Slot>>,
+    batches: Option<Completion<INPUT_SIZE, OUTPUT_SIZE>>,
+}
+
+// the request points into the batches the submission owns
+unsafe impl<const INPUT_SIZE: usize, const OUTPUT_SIZE: usize> Send for Submission<INPUT_SIZE, OUTPUT_SIZE> {}
+
+impl<const INPUT_SIZE: usize, const OUTPUT_SIZE: usize> Submission<INPUT_SIZE, OUTPUT_SIZE> {
+    /// Hands the operation to the queue, unless it is full.
+    /// Returns whether it was handed over.
+    fn try_submit(&mut self) -> bool {
+        let slot = Arc::new(Slot::default());
+        self.request.userData = Arc::into_raw(slot.clone()) as *mut c_void;
+        if unsafe { SWIFFT_QueueSubmit(self.queue.raw, &self.request) } != 0 {
+            // the request did not take the reference of the slot
+            unsafe { Arc::from_raw(self.request.userData as *const Slot) };
+            return false;
+        }
+        self.slot = Some(slot);
+        true
+    }
+
+    /// Blocks the calling thread until the operation completes, and returns its `Completion`.
+    pub fn wait(mut self) -> Completion<INPUT_SIZE, OUTPUT_SIZE> {
+        let waker = Waker::from(Arc::new(Unparker(thread::current())));
+        let mut context = Context::from_waker(&waker);
+        loop {
+            if let Poll::Ready(completion) = Pin::new(&mut self).poll(&mut context) {
+                return completion;
+            }
+            thread::park();
+        }
+    }
+}
+
+impl<const INPUT_SIZE: usize, const OUTPUT_SIZE: usize> Future for Submission<INPUT_SIZE, OUTPUT_SIZE> {
+    type Output = Completion<INPUT_SIZE, OUTPUT_SIZE>;
+
+    fn poll(mut self: Pin<&mut Self>, context: &mut Context<'_>) -> Poll<Self::Output> {
+        assert!(self.batches.is_some(), "submission polled after completion");
+        if self.slot.is_none() {
+            let completions = self.queue.completions.load(Ordering::SeqCst);
+            if !self.try_submit() {
+                let mut waiters = self.queue.waiters.lock().unwrap();
+                // a completion since the queue was found full may have missed the waker
+                if self.queue.completions.load(Ordering::SeqCst) != completions {
+                    context.waker().wake_by_ref();
+                } else {
+                    waiters.push(context.waker().clone());
+                }
+                return Poll::Pending;
+            }
+        }
+        let slot = self.slot.clone().unwrap();
+        let mut state = slot.state.lock().unwrap();
+        if !state.0 {
+            state.1 = Some(context.waker().clone());
+            return Poll::Pending;
+        }
+        drop(state);
+        self.slot = None;
+        Poll::Ready(self.batches.take().unwrap())
+    }
+}
+
+impl<const INPUT_SIZE: usize, const OUTPUT_SIZE: usize> Drop for Submission<INPUT_SIZE, OUTPUT_SIZE> {
+    fn drop(&mut self) {
+        // the batches must outlive the operation in flight
+        if let Some(slot) = &self.slot {
+            let mut state = slot.state.lock().unwrap();
+            while !state.0 {
+                state = slot.done.wait(state).unwrap();
+            }
+        }
+    }
+}
+
+/// Wakes a thread blocked in `Submission::wait`
+struct Unparker(Thread);
+
+impl Wake for Unparker {
+    fn wake(self: Arc<Self>) {
+        self.0.unpark()
+    }
+}
+
+/// Submissions in flight, yielding their completions in submission order
+pub struct Pipeline<const INPUT_SIZE: usize, const OUTPUT_SIZE: usize> {
+    submissions: VecDeque<Submission<INPUT_SIZE, OUTPUT_SIZE>>,
+}
+
+impl<const INPUT_SIZE: usize, const OUTPUT_SIZE: usize> Pipeline<INPUT_SIZE, OUTPUT_SIZE> {
+    /// Creates an empty `Pipeline`
+    pub fn new() -> Self {
+        Self { submissions: VecDeque::new() }
+    }
+
+    /// Appends a submission, and hands it to its queue unless the queue is full, in which
+    /// case it is handed over as completions are polled.
+    ///
+    /// # Arguments
+    /// * `submission` - the submission
+    pub fn push(&mut self, mut submission: Submission<INPUT_SIZE, OUTPUT_SIZE>) {
+        if submission.slot.is_none() {
+            submission.try_submit();
+        }
+        self.submissions.push_back(submission);
+    }
+
+    /// Returns the number of submissions not yet yielded
+    pub fn len(&self) -> usize {
+        self.submissions.len()
+    }
+
+    /// Returns whether all submissions were yielded
+    pub fn is_empty(&self) -> bool {
+        self.submissions.is_empty()
+    }
+
+    /// Polls for the completion of the first submission, or `None` if there are no submissions.
+    pub fn poll_next(&mut self, context: &mut Context<'_>) -> Poll<Option<Completion<INPUT_SIZE, OUTPUT_SIZE>>> {
+        // submissions take the room completions make, in submission order
+        for submission in self.submissions.iter_mut() {
+            if submission.slot.is_none() && !submission.try_submit() {
+                break;
+            }
+        }
+        let first = match self.submissions.front_mut() {
+            Some(first) => first,
+            None => return Poll::Ready(None),
+        };
+        match Pin::new(first).poll(context) {
+            Poll::Ready(completion) => {
+                self.submissions.pop_front();
+                Poll::Ready(Some(completion))
+            },
+            Poll::Pending => Poll::Pending,
+        }
+    }
+
+    /// Blocks the calling thread until the first submission completes, and returns its
+    /// `Completion`, or `None` if there are no submissions.
+    pub fn wait_next(&mut self) -> Option<Completion<INPUT_SIZE, OUTPUT_SIZE>> {
+        let waker = Waker::from(Arc::new(Unparker(thread::current())));
+        let mut context = Context::from_waker(&waker);
+        loop {
+            if let Poll::Ready(completion) = self.poll_next(&mut context) {
+                return completion;
+            }
+            thread::park();
+        }
+    }
+}
+
+impl<const INPUT_SIZE: usize, const OUTPUT_SIZE: usize> Default for Pipeline<INPUT_SIZE, OUTPUT_SIZE> {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+#[cfg(feature = "futures-core")]
+impl<const INPUT_SIZE: usize, const OUTPUT_SIZE: usize> futures_core::Stream for Pipeline<INPUT_SIZE, OUTPUT_SIZE> {
+    type Item = Completion<INPUT_SIZE, OUTPUT_SIZE>;
+
+    fn poll_next(self: Pin<&mut Self>, context: &mut Context<'_>) -> Poll<Option<Self::Item>> {
+        Pipeline::poll_next(self.get_mut(), context)
+    }
+}
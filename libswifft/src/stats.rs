@@ -0,0 +1,157 @@
+//! Statistics of SWIFFT operations
+//!
+//! LibSWIFFT counts, per entry point, its calls, their blocks and the time spent
+//! in them, and for operations on multiple blocks, where they ran and how evenly
+//! their threads shared the work. Statistics are collected only with the `stats`
+//! feature and once enabled using `set_enabled`. The counters only grow, until
+//! `reset`, so they map to Prometheus counters, e.g. using `Stats::write_prometheus`.
+//!
+//! The time is per entry point, not per phase of SWIFFT: the compute functions run the
+//! FFT and FFT-sum phases fused in one pass, so their time is counted whole in their own
+//! entries, and the entries of `SWIFFT_fft`, `SWIFFT_fftsum` and `SWIFFT_Compact` count
+//! only calls to those entry points.
+
+use std::ffi::CStr;
+use std::io::{self, Write};
+use crate::sys::{
+    swifft_stats_t, SWIFFT_GetStats, SWIFFT_ResetStats, SWIFFT_SetStatsEnabled, SWIFFT_StatsEntryName
+};
+
+/// The statistics of an entry point of the SWIFFT API.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct EntryStats {
+    /// The name of the entry point, such as `SWIFFT_Compute`
+    pub name: &'static str,
+    /// The number of calls
+    pub calls: u64,
+    /// The number of blocks operated on by the calls
+    pub blocks: u64,
+    /// The wall-clock time spent in the calls, in nanoseconds
+    pub nanoseconds: u64,
+}
+
+/// A snapshot of the statistics of the SWIFFT API.
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct Stats {
+    /// Whether statistics are being collected
+    pub enabled: bool,
+    /// The name of the instruction set used by the SWIFFT API, such as `AVX2`
+    pub instruction_set: &'static str,
+    /// The statistics per entry point
+    pub entries: Vec<EntryStats>,
+    /// The number of runs of operations on multiple blocks on the calling thread alone
+    pub serial_runs: u64,
+    /// The number of runs on an executor, such as the one of `use_rayon`
+    pub executor_runs: u64,
+    /// The number of runs on the native pool or OpenMP
+    pub parallel_runs: u64,
+    /// The wall-clock time of the parallel runs, in nanoseconds
+    pub parallel_nanoseconds: u64,
+    /// The sum, over the parallel runs, of the busy time of the busiest thread past the mean, in nanoseconds
+    pub imbalance_nanoseconds: u64,
+    /// The number of blocks run by each thread of the parallel runs, up to the last thread that ran any
+    pub thread_blocks: Vec<u64>,
+    /// The busy time of each thread of the parallel runs, in nanoseconds, indexed as `thread_blocks`
+    pub thread_nanoseconds: Vec<u64>,
+}
+
+/// Enables or disables collecting statistics. They are disabled at first.
+/// Returns whether statistics are available, i.e., LibSWIFFT was built with the `stats` feature.
+///
+/// # Arguments
+/// * `enabled` - whether to collect statistics
+pub fn set_enabled(enabled: bool) -> bool {
+    unsafe {
+        SWIFFT_SetStatsEnabled(enabled as i32) == 0
+    }
+}
+
+/// Returns a snapshot of the statistics.
+pub fn stats() -> Stats {
+    let mut raw: swifft_stats_t = unsafe { std::mem::zeroed() };
+    unsafe {
+        SWIFFT_GetStats(&mut raw)
+    }
+    let static_str = |ptr: *const std::os::raw::c_char| -> &'static str {
+        // the strings of LibSWIFFT are static
+        if ptr.is_null() { "" } else { unsafe { CStr::from_ptr(ptr) }.to_str().unwrap_or("") }
+    };
+    let entries = raw.entries.iter().enumerate().map(|(entry, stats)| EntryStats {
+        name: static_str(unsafe { SWIFFT_StatsEntryName(entry as i32) }),
+        calls: stats.calls,
+        blocks: stats.blocks,
+        nanoseconds: stats.nanoseconds,
+    }).collect();
+    let num_threads = raw.threadBlocks.iter().rposition(|&blocks| blocks != 0).map_or(0, |t| t + 1);
+    Stats {
+        enabled: raw.enabled != 0,
+        instruction_set: static_str(raw.iset),
+        entries,
+        serial_runs: raw.serialRuns,
+        executor_runs: raw.executorRuns,
+        parallel_runs: raw.parallelRuns,
+        parallel_nanoseconds: raw.parallelNanoseconds,
+        imbalance_nanoseconds: raw.imbalanceNanoseconds,
+        thread_blocks: raw.threadBlocks[..num_threads].to_vec(),
+        thread_nanoseconds: raw.threadNanoseconds[..num_threads].to_vec(),
+    }
+}
+
+/// Resets all counters of the statistics to zero.
+pub fn reset() {
+    unsafe {
+        SWIFFT_ResetStats()
+    }
+}
+
+impl Stats {
+    /// Writes the statistics in the Prometheus text exposition format, with times in seconds.
+    /// Entry points that were never called are omitted.
+    ///
+    /// # Arguments
+    /// * `out` - the writer
+    pub fn write_prometheus<W: Write>(&self, out: &mut W) -> io::Result<()> {
+        let seconds = |nanoseconds: u64| nanoseconds as f64 / 1e9;
+        writeln!(out, "# HELP swifft_info The instruction set used by LibSWIFFT.")?;
+        writeln!(out, "# TYPE swifft_info gauge")?;
+        writeln!(out, "swifft_info{{iset=\"{}\"}} 1", self.instruction_set)?;
+        let called = || self.entries.iter().filter(|entry| entry.calls != 0);
+        writeln!(out, "# HELP swifft_calls_total The number of calls per entry point.")?;
+        writeln!(out, "# TYPE swifft_calls_total counter")?;
+        for entry in called() {
+            writeln!(out, "swifft_calls_total{{entry=\"{}\"}} {}", entry.name, entry.calls)?;
+        }
+        writeln!(out, "# HELP swifft_blocks_total The number of blocks operated on per entry point.")?;
+        writeln!(out, "# TYPE swifft_blocks_total counter")?;
+        for entry in called() {
+            writeln!(out, "swifft_blocks_total{{entry=\"{}\"}} {}", entry.name, entry.blocks)?;
+        }
+        writeln!(out, "# HELP swifft_seconds_total The wall-clock time spent per entry point.")?;
+        writeln!(out, "# TYPE swifft_seconds_total counter")?;
+        for entry in called() {
+            writeln!(out, "swifft_seconds_total{{entry=\"{}\"}} {}", entry.name, seconds(entry.nanoseconds))?;
+        }
+        writeln!(out, "# HELP swifft_runs_total The number of runs of operations on multiple blocks, by where they ran.")?;
+        writeln!(out, "# TYPE swifft_runs_total counter")?;
+        writeln!(out, "swifft_runs_total{{mode=\"serial\"}} {}", self.serial_runs)?;
+        writeln!(out, "swifft_runs_total{{mode=\"executor\"}} {}", self.executor_runs)?;
+        writeln!(out, "swifft_runs_total{{mode=\"parallel\"}} {}", self.parallel_runs)?;
+        writeln!(out, "# HELP swifft_parallel_seconds_total The wall-clock time of the parallel runs.")?;
+        writeln!(out, "# TYPE swifft_parallel_seconds_total counter")?;
+        writeln!(out, "swifft_parallel_seconds_total {}", seconds(self.parallel_nanoseconds))?;
+        writeln!(out, "# HELP swifft_imbalance_seconds_total The busy time of the busiest thread past the mean, over the parallel runs.")?;
+        writeln!(out, "# TYPE swifft_imbalance_seconds_total counter")?;
+        writeln!(out, "swifft_imbalance_seconds_total {}", seconds(self.imbalance_nanoseconds))?;
+        writeln!(out, "# HELP swifft_thread_blocks_total The number of blocks run per thread of the parallel runs.")?;
+        writeln!(out, "# TYPE swifft_thread_blocks_total counter")?;
+        for (thread, blocks) in self.thread_blocks.iter().enumerate() {
+            writeln!(out, "swifft_thread_blocks_total{{thread=\"{}\"}} {}", thread, blocks)?;
+        }
+        writeln!(out, "# HELP swifft_thread_seconds_total The busy time per thread of the parallel runs.")?;
+        writeln!(out, "# TYPE swifft_thread_seconds_total counter")?;
+        for (thread, &nanoseconds) in self.thread_nanoseconds.iter().enumerate() {
+            writeln!(out, "swifft_thread_seconds_total{{thread=\"{}\"}} {}", thread, seconds(nanoseconds))?;
+        }
+        Ok(())
+    }
+}
@@ -0,0 +1,137 @@
+//! Tuning of SWIFFT operations to the running machine
+//!
+//! A `Profile` holds the instruction set used by LibSWIFFT and, per `OpClass`, the
+//! threshold and grain of parallelizing operations on multiple blocks. `tune` measures
+//! and applies one, as configured for parallelism at the time, e.g. using `set_threads`,
+//! and saves it in a file that later processes load instead of measuring. LibSWIFFT also
+//! applies the profile in the `SWIFFT_PROFILE` environment variable when loaded.
+
+use std::ffi::{CStr, CString};
+use std::fmt::{self, Display, Formatter};
+use std::io;
+use std::os::raw::c_char;
+use std::path::Path;
+use std::str::FromStr;
+use crate::pool::OpClass;
+use crate::sys::{
+    swifft_profile_t, SWIFFT_FormatProfile, SWIFFT_GetInstructionSet, SWIFFT_GetProfile, SWIFFT_ParseProfile,
+    SWIFFT_SetInstructionSet, SWIFFT_SetProfile, SWIFFT_Tune, SWIFFT_PROFILE_MAX_SIZE
+};
+
+/// A profile of tuning LibSWIFFT to a machine, in the text format of LibSWIFFT.
+#[derive(Debug, Clone, Copy)]
+pub struct Profile(swifft_profile_t);
+
+/// Whether `tune` loaded a saved profile or measured one.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum Tuned {
+    /// The profile saved in the file was applied
+    Loaded,
+    /// A profile was measured and applied, and saved in the file, if any
+    Measured,
+}
+
+impl Profile {
+    /// Returns the profile currently applied to LibSWIFFT.
+    pub fn current() -> Self {
+        let mut raw: swifft_profile_t = unsafe { std::mem::zeroed() };
+        unsafe {
+            SWIFFT_GetProfile(&mut raw)
+        }
+        Self(raw)
+    }
+
+    /// Applies the profile to LibSWIFFT. Call it while no operations run.
+    /// Returns whether it was applied, i.e., its instruction set is available.
+    pub fn apply(&self) -> bool {
+        unsafe {
+            SWIFFT_SetProfile(&self.0) == 0
+        }
+    }
+
+    /// Returns the name of the instruction set, such as `AVX2`.
+    pub fn instruction_set(&self) -> &str {
+        unsafe { CStr::from_ptr(self.0.iset.as_ptr()) }.to_str().unwrap_or("")
+    }
+
+    /// Returns the number of threads of the native pool the profile was measured with.
+    pub fn threads(&self) -> usize {
+        self.0.threads as usize
+    }
+
+    /// Returns the maximum number of blocks that operations of a class run on the calling thread alone.
+    pub fn threshold(&self, op: OpClass) -> usize {
+        self.0.threshold[op as usize]
+    }
+
+    /// Returns the maximum number of blocks per range that a thread runs at once, for operations of a class.
+    pub fn grain(&self, op: OpClass) -> usize {
+        self.0.grain[op as usize] as usize
+    }
+}
+
+impl Display for Profile {
+    fn fmt(&self, f: &mut Formatter<'_>) -> fmt::Result {
+        let mut text = [0 as c_char; SWIFFT_PROFILE_MAX_SIZE as usize];
+        if unsafe { SWIFFT_FormatProfile(&self.0, text.as_mut_ptr(), text.len()) } < 0 {
+            return Err(fmt::Error);
+        }
+        f.write_str(unsafe { CStr::from_ptr(text.as_ptr()) }.to_str().map_err(|_| fmt::Error)?)
+    }
+}
+
+impl FromStr for Profile {
+    type Err = io::Error;
+    fn from_str(text: &str) -> Result<Self, Self::Err> {
+        let invalid = || io::Error::new(io::ErrorKind::InvalidData, "not a SWIFFT profile");
+        let text = CString::new(text).map_err(|_| invalid())?;
+        let mut raw: swifft_profile_t = unsafe { std::mem::zeroed() };
+        if unsafe { SWIFFT_ParseProfile(text.as_ptr(), &mut raw) } != 0 {
+            return Err(invalid());
+        }
+        Ok(Self(raw))
+    }
+}
+
+/// Sets the instruction set used by LibSWIFFT. Call it while no operations run.
+/// Returns whether it was set, i.e., it is built into LibSWIFFT and supported by the CPU.
+///
+/// # Arguments
+/// * `iset` - the instruction-set name, such as `AVX2`, or `None` for the best one supported by the CPU
+pub fn set_instruction_set(iset: Option<&str>) -> bool {
+    let iset = match iset.map(CString::new) {
+        Some(Ok(iset)) => Some(iset),
+        Some(Err(_)) => return false,
+        None => None,
+    };
+    unsafe {
+        SWIFFT_SetInstructionSet(iset.as_ref().map_or(std::ptr::null(), |iset| iset.as_ptr())) == 0
+    }
+}
+
+/// Returns the name of the instruction set used by LibSWIFFT, such as `AVX2`.
+pub fn instruction_set() -> &'static str {
+    // the strings of LibSWIFFT are static
+    unsafe { CStr::from_ptr(SWIFFT_GetInstructionSet()) }.to_str().unwrap_or("")
+}
+
+/// Tunes LibSWIFFT to the running machine, as configured for parallelism.
+/// Applies the profile saved in the file, if any, when it is valid for the machine and the
+/// threads of the native pool, or else measures, applies and saves one, in tens of milliseconds.
+/// Call it while no operations run.
+///
+/// # Arguments
+/// * `path` - the file of the profile, or `None` for measuring without saving
+pub fn tune(path: Option<&Path>) -> io::Result<Tuned> {
+    let path = match path {
+        Some(path) => Some(CString::new(path.to_str().ok_or_else(|| {
+            io::Error::new(io::ErrorKind::InvalidInput, "path is not valid UTF-8")
+        })?)?),
+        None => None,
+    };
+    match unsafe { SWIFFT_Tune(path.as_ref().map_or(std::ptr::null(), |path| path.as_ptr())) } {
+        0 => Ok(Tuned::Loaded),
+        1 => Ok(Tuned::Measured),
+        _ => Err(io::Error::new(io::ErrorKind::Other, "measuring or saving the SWIFFT profile failed")),
+    }
+}
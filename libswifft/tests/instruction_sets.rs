@@ -0,0 +1,113 @@
+//! Known-answer tests of the instruction sets of LibSWIFFT. Each instruction set built into
+//! LibSWIFFT and supported by the CPU must give the same bytes as the AVX kernels on x86, which
+//! gave the digests below. They run in a test binary of their own and in a single test, since
+//! switching the instruction set is process-wide and must not race with running operations.
+
+use libswifft::batch::{compact_slice, compute_signed_slice, compute_slice};
+use libswifft::buffer::{CompactOutput, Input, Output, SignInput};
+use libswifft::hash::{compact, compute, compute_signed};
+use libswifft::tune::{instruction_set, set_instruction_set};
+
+/// The instruction sets LibSWIFFT may be built with
+const INSTRUCTION_SETS: [&str; 6] = ["AVX", "AVX2", "AVX512", "AVX512BW", "NEON", "SVE2"];
+
+/// The number of blocks of a small batch, computed per block as well
+const SMALL_BLOCKS: usize = 1000;
+
+/// The number of blocks of a large batch, above SWIFFT_LARGE_BATCH_THRESHOLD
+const LARGE_BLOCKS: usize = 70000;
+
+/// The FNV-1a digests of the outputs of the small batch, unsigned and signed, and of their compaction
+const SMALL_COMPUTE: u64 = 0x328500779f4a4ccb;
+const SMALL_COMPUTE_SIGNED: u64 = 0xdcfa9feec7d25395;
+const SMALL_COMPACT: u64 = 0x51fa888651cde9f3;
+
+/// The FNV-1a digests of the outputs of the large batch, unsigned and signed, and of their compaction
+const LARGE_COMPUTE: u64 = 0x78dda98b82e7b7de;
+const LARGE_COMPUTE_SIGNED: u64 = 0x11b216a2eb10fb38;
+const LARGE_COMPACT: u64 = 0x7eec2f7bfbf2f94c;
+
+/// A xorshift generator of the pseudo-random bytes of inputs.
+struct Bytes(u64);
+
+impl Bytes {
+    fn next(&mut self) -> u8 {
+        self.0 ^= self.0 << 13;
+        self.0 ^= self.0 >> 7;
+        self.0 ^= self.0 << 17;
+        (self.0 >> 24) as u8
+    }
+}
+
+/// Returns `n` blocks of pseudo-random input and their sign blocks, whose sign bits are a subset of the input bits.
+fn inputs(n: usize) -> (Vec<Input>, Vec<SignInput>) {
+    let mut bytes = Bytes(88172645463325252);
+    let mut input: Vec<Input> = (0..n).map(|_| Input::default()).collect();
+    let mut sign_input: Vec<SignInput> = (0..n).map(|_| SignInput::default()).collect();
+    input.iter_mut().for_each(|block| block.0[0].iter_mut().for_each(|b| *b = bytes.next()));
+    for (sign, block) in sign_input.iter_mut().zip(&input) {
+        for (s, b) in sign.0[0].iter_mut().zip(&block.0[0]) {
+            *s = bytes.next() & b;
+        }
+    }
+    (input, sign_input)
+}
+
+/// Returns the FNV-1a digest of the bytes of blocks.
+fn fnv<const N: usize>(blocks: &[libswifft::buffer::AlignedBuffer<N, 1>]) -> u64 {
+    blocks.iter().flat_map(|block| block.0[0].iter()).fold(0xcbf29ce484222325, |h, &b| {
+        (h ^ b as u64).wrapping_mul(0x100000001b3)
+    })
+}
+
+/// Checks the small batch on the current instruction set, through the functions on one block and on multiple blocks.
+fn check_small(iset: &str, input: &[Input], sign_input: &[SignInput]) {
+    let mut output: Vec<Output> = input.iter().map(|_| Output::default()).collect();
+    let mut compact_output: Vec<CompactOutput> = input.iter().map(|_| CompactOutput::default()).collect();
+
+    compute_slice(input, &mut output);
+    assert_eq!(fnv(&output), SMALL_COMPUTE, "{} compute_slice", iset);
+    output.iter_mut().zip(input).for_each(|(o, i)| compute(i, o));
+    assert_eq!(fnv(&output), SMALL_COMPUTE, "{} compute", iset);
+
+    compute_signed_slice(input, sign_input, &mut output);
+    assert_eq!(fnv(&output), SMALL_COMPUTE_SIGNED, "{} compute_signed_slice", iset);
+    output.iter_mut().zip(input.iter().zip(sign_input)).for_each(|(o, (i, s))| compute_signed(i, s, o));
+    assert_eq!(fnv(&output), SMALL_COMPUTE_SIGNED, "{} compute_signed", iset);
+
+    compact_slice(&output, &mut compact_output);
+    assert_eq!(fnv(&compact_output), SMALL_COMPACT, "{} compact_slice", iset);
+    compact_output.iter_mut().zip(&output).for_each(|(c, o)| compact(o, c));
+    assert_eq!(fnv(&compact_output), SMALL_COMPACT, "{} compact", iset);
+}
+
+/// Checks the large batch on the current instruction set, whose output is streamed to memory.
+fn check_large(iset: &str, input: &[Input], sign_input: &[SignInput]) {
+    let mut output: Vec<Output> = input.iter().map(|_| Output::default()).collect();
+    let mut compact_output: Vec<CompactOutput> = input.iter().map(|_| CompactOutput::default()).collect();
+
+    compute_slice(input, &mut output);
+    assert_eq!(fnv(&output), LARGE_COMPUTE, "{} compute_slice", iset);
+    compute_signed_slice(input, sign_input, &mut output);
+    assert_eq!(fnv(&output), LARGE_COMPUTE_SIGNED, "{} compute_signed_slice", iset);
+    compact_slice(&output, &mut compact_output);
+    assert_eq!(fnv(&compact_output), LARGE_COMPACT, "{} compact_slice", iset);
+}
+
+#[test]
+fn instruction_sets_match_avx() {
+    let (small_input, small_sign_input) = inputs(SMALL_BLOCKS);
+    let (large_input, large_sign_input) = inputs(LARGE_BLOCKS);
+    let mut checked = 0;
+    for iset in INSTRUCTION_SETS {
+        if !set_instruction_set(Some(iset)) {
+            continue;
+        }
+        assert_eq!(instruction_set(), iset);
+        check_small(iset, &small_input, &small_sign_input);
+        check_large(iset, &large_input, &large_sign_input);
+        checked += 1;
+    }
+    assert!(set_instruction_set(None));
+    assert!(checked > 0, "no instruction set is available");
+}
@@ -0,0 +1,74 @@
+//! Benchmarks of the SWIFFT hash function, on one block and on batches, and of the Fourier transform it uses.
+
+use criterion::{black_box, criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+use swifft::digest::FourierDigest;
+use swifft::hash::{
+    parse_input_block, swifft_hash, swifft_hash_bytes, swifft_hash_bytes_batch, swifft_hash_fourier,
+    INPUT_BLOCK_SIZE, MULTIPLIER_POLYNOMIALS, OUTPUT_BLOCK_SIZE,
+};
+use swifft::polynomial::Polynomial;
+
+fn bench_swifft_hash(c: &mut Criterion) {
+    let input = parse_input_block(&[0x5a; INPUT_BLOCK_SIZE]);
+    let mut group = c.benchmark_group("hash");
+    group.throughput(Throughput::Bytes(INPUT_BLOCK_SIZE as u64));
+    group.bench_function("swifft_hash", |b| b.iter(|| swifft_hash(black_box(&input))));
+    group.bench_function("swifft_hash_bytes", |b| b.iter(|| swifft_hash_bytes(black_box(&[0x5a; INPUT_BLOCK_SIZE]))));
+    group.bench_function("parse_input_block", |b| b.iter(|| parse_input_block(black_box(&[0x5a; INPUT_BLOCK_SIZE]))));
+    group.finish();
+}
+
+fn bench_swifft_hash_batch(c: &mut Criterion) {
+    let mut group = c.benchmark_group("hash_batch");
+    for nblocks in [64usize, 1024, 16384] {
+        let inputs = vec![[0x5a; INPUT_BLOCK_SIZE]; nblocks];
+        let mut digests = vec![[0; OUTPUT_BLOCK_SIZE]; nblocks];
+        group.throughput(Throughput::Bytes((nblocks * INPUT_BLOCK_SIZE) as u64));
+        group.bench_with_input(BenchmarkId::new("swifft_hash_bytes_batch", nblocks), &inputs, |b, inputs| {
+            b.iter(|| swifft_hash_bytes_batch(black_box(inputs), &mut digests))
+        });
+    }
+    group.finish();
+}
+
+fn bench_aggregate(c: &mut Criterion) {
+    let inputs = vec![parse_input_block(&[0x5a; INPUT_BLOCK_SIZE]); 16];
+    let mut group = c.benchmark_group("aggregate");
+    group.throughput(Throughput::Bytes((inputs.len() * INPUT_BLOCK_SIZE) as u64));
+    group.bench_function("swifft_hash", |b| b.iter(|| {
+        black_box(&inputs).iter().map(swifft_hash).sum::<Polynomial>()
+    }));
+    group.bench_function("swifft_hash_fourier", |b| b.iter(|| {
+        black_box(&inputs).iter().map(swifft_hash_fourier).sum::<FourierDigest>().finalize()
+    }));
+    group.finish();
+}
+
+fn bench_fourier(c: &mut Criterion) {
+    let polynomial = MULTIPLIER_POLYNOMIALS[0];
+    let mut group = c.benchmark_group("fourier");
+    group.bench_function("fourier_coefficients_assign", |b| b.iter(|| {
+        let mut p = black_box(polynomial);
+        p.fourier_coefficients_assign();
+        p
+    }));
+    group.bench_function("fourier_coefficients_assign_reference", |b| b.iter(|| {
+        let mut p = black_box(polynomial);
+        p.fourier_coefficients_assign_reference();
+        p
+    }));
+    group.bench_function("interpolate_fourier_coefficients_assign", |b| b.iter(|| {
+        let mut p = black_box(polynomial);
+        p.interpolate_fourier_coefficients_assign();
+        p
+    }));
+    group.bench_function("interpolate_fourier_coefficients_assign_reference", |b| b.iter(|| {
+        let mut p = black_box(polynomial);
+        p.interpolate_fourier_coefficients_assign_reference();
+        p
+    }));
+    group.finish();
+}
+
+criterion_group!(benches, bench_swifft_hash, bench_swifft_hash_batch, bench_aggregate, bench_fourier);
+criterion_main!(benches);
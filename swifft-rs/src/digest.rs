@@ -0,0 +1,148 @@
+use std::fmt::{Display, Formatter};
+use std::iter::Sum;
+use std::ops::{Add, AddAssign, Index, Mul, MulAssign, Neg, Sub, SubAssign};
+
+use crate::polynomial::Polynomial;
+use crate::z257::Z257;
+
+/// SWIFFT digest kept in the evaluation domain, i.e. as the Fourier coefficients of the digest polynomial.
+/// Since SWIFFT is linear, digests can be added, subtracted and scaled in this domain,
+/// and [`FourierDigest::finalize`] interpolates the result only once
+#[derive(PartialEq, Eq, Clone, Copy, Debug)]
+#[repr(transparent)]
+pub struct FourierDigest(Polynomial);
+
+// STRUCT METHODS
+impl FourierDigest {
+    /// The zero digest, which is the additive identity element, i.e. D + ZERO = D
+    pub const ZERO: Self = Self(Polynomial::ZERO);
+
+    // CONSTRUCTOR METHODS
+    /// Create a digest from the Fourier coefficients provided
+    pub const fn new(fourier_coefficients: Polynomial) -> Self {
+        Self(fourier_coefficients)
+    }
+
+    /// Create a digest from a digest polynomial, computing its Fourier coefficients
+    pub fn from_polynomial(digest: &Polynomial) -> Self {
+        Self(digest.fourier_coefficients())
+    }
+
+    // STRUCT FIELD METHODS
+    /// Fourier coefficients of the digest
+    #[inline]
+    pub const fn fourier_coefficients(&self) -> &Polynomial { &self.0 }
+
+    // CONSTANT OPERATIONS
+    pub const fn cn_neg(&self) -> Self {
+        Self(self.0.cn_neg())
+    }
+
+    pub const fn cn_add(&self, rhs: &Self) -> Self {
+        Self(self.0.cn_add(&rhs.0))
+    }
+
+    pub const fn cn_sub(&self, rhs: &Self) -> Self {
+        Self(self.0.cn_sub(&rhs.0))
+    }
+
+    pub const fn scalar_mul(&self, scalar: &Z257) -> Self {
+        Self(self.0.scalar_mul(scalar))
+    }
+
+    // NON-CONSTANT OPERATIONS
+    pub fn neg_assign(&mut self) {
+        self.0.neg_assign()
+    }
+
+    pub fn scalar_mul_assign(&mut self, scalar: &Z257) {
+        self.0.scalar_mul_assign(scalar)
+    }
+
+    /// Interpolates the Fourier coefficients, returning the digest polynomial
+    pub fn finalize(self) -> Polynomial {
+        let mut digest = self.0;
+        digest.interpolate_fourier_coefficients_assign();
+        digest
+    }
+}
+
+impl Display for FourierDigest {
+    #[inline]
+    fn fmt(&self, f: &mut Formatter<'_>) -> std::fmt::Result {
+        Display::fmt(&self.0, f)
+    }
+}
+
+impl<'a> Into<FourierDigest> for &'a FourierDigest {
+    #[inline]
+    fn into(self) -> FourierDigest {
+        *self
+    }
+}
+
+impl Index<usize> for FourierDigest {
+    type Output = Z257;
+    fn index(&self, index: usize) -> &Self::Output {
+        &self.0[index]
+    }
+}
+
+impl Neg for FourierDigest {
+    type Output = Self;
+    fn neg(self) -> Self::Output {
+        self.cn_neg()
+    }
+}
+
+impl<T: Into<Self>> Add<T> for FourierDigest {
+    type Output = Self;
+    fn add(self, rhs: T) -> Self::Output {
+        self.cn_add(&rhs.into())
+    }
+}
+
+impl<T: Into<Self>> AddAssign<T> for FourierDigest {
+    fn add_assign(&mut self, rhs: T) {
+        self.0 += rhs.into().0
+    }
+}
+
+impl<T: Into<Self>> Sum<T> for FourierDigest {
+    fn sum<I: Iterator<Item=T>>(iter: I) -> Self {
+        iter.fold(Self::ZERO, |acc, next| { acc + next.into() })
+    }
+}
+
+impl<T: Into<Self>> Sub<T> for FourierDigest {
+    type Output = Self;
+    fn sub(self, rhs: T) -> Self::Output {
+        self.cn_sub(&rhs.into())
+    }
+}
+
+impl<T: Into<Self>> SubAssign<T> for FourierDigest {
+    fn sub_assign(&mut self, rhs: T) {
+        self.0 -= rhs.into().0
+    }
+}
+
+impl Mul<Z257> for FourierDigest {
+    type Output = Self;
+    fn mul(self, rhs: Z257) -> Self::Output {
+        self.scalar_mul(&rhs)
+    }
+}
+
+impl MulAssign<Z257> for FourierDigest {
+    fn mul_assign(&mut self, rhs: Z257) {
+        self.scalar_mul_assign(&rhs)
+    }
+}
+
+impl Mul<FourierDigest> for Z257 {
+    type Output = FourierDigest;
+    fn mul(self, rhs: FourierDigest) -> Self::Output {
+        rhs.scalar_mul(&self)
+    }
+}
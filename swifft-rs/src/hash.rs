@@ -1,6 +1,8 @@
 use rayon::prelude::*;
 
+use crate::digest::FourierDigest;
 use crate::multiplier::MULTIPLIER_POLYNOMIAL_COEFFICIENTS;
+use crate::ntt;
 use crate::polynomial::{Coefficients, Polynomial};
 use crate::z257::Z257;
 
@@ -22,61 +24,118 @@ pub const INPUT_SIZE: usize = Polynomial::N * M;
 /// is represented by `1` bit; `8` elements per byte
 pub const INPUT_BLOCK_SIZE: usize = INPUT_SIZE / u8::BITS as usize;
 
+/// The size of a digest that consists of [`u8`] elements,
+/// where each of the [`Polynomial::N`] coefficients of the digest takes `2` bytes, in little-endian order
+pub const OUTPUT_BLOCK_SIZE: usize = 2 * Polynomial::N;
+
+/// The minimum number of inputs that a thread hashes at once in the batch hash functions,
+/// so that scheduling costs less than hashing
+pub const BATCH_MIN_LEN: usize = 16;
+
 
 // HELPER METHODS
-/// Parses input block of $16$ binary polynomials
-pub const fn parse_input_block(input: &[u8; INPUT_BLOCK_SIZE]) -> SwifftInput {
-    // parse inputs into binary polynomial coefficients
-    let mut input_coefficients: [Coefficients; M] = [[Z257::ZERO; Polynomial::N]; M];
-    let mut byte_index = 0; while byte_index < INPUT_BLOCK_SIZE {
-        let mut bit_position = 0; while bit_position < u8::BITS {
-            let input_position = (byte_index as u32 * u8::BITS + bit_position) as usize;
-            let input_index = input_position / Polynomial::N;
-            let coefficient_index = input_position % Polynomial::N;
-            let bit = (input[byte_index] >> bit_position) & 1 != 0;
-            input_coefficients[input_index][coefficient_index] = Z257::from_bool(bit);
-            bit_position += 1
+/// The [`INPUT_BLOCK_SIZE`]` / `[`M`] bytes of the binary polynomial `index` of an input block
+#[inline(always)]
+fn input_polynomial_bytes(input: &[u8; INPUT_BLOCK_SIZE], index: usize) -> &[u8; INPUT_BLOCK_SIZE / M] {
+    let offset = index * (INPUT_BLOCK_SIZE / M);
+    input[offset..offset + INPUT_BLOCK_SIZE / M].try_into().unwrap()
+}
+
+/// Parses the binary polynomial `index` of an input block, from its [`INPUT_BLOCK_SIZE`]` / `[`M`] bytes
+#[inline(always)]
+pub const fn parse_input_polynomial(input: &[u8; INPUT_BLOCK_SIZE], index: usize) -> Polynomial {
+    // each byte holds 8 consecutive coefficients, in ascending bit positions, which are its lanes
+    let mut coefficients: Coefficients = [Z257::ZERO; Polynomial::N];
+    let mut byte_index = 0; while byte_index < INPUT_BLOCK_SIZE / M {
+        let lanes = &ntt::BYTE_LANES[input[index * (INPUT_BLOCK_SIZE / M) + byte_index] as usize];
+        let mut lane = 0; while lane < 8 {
+            coefficients[byte_index * 8 + lane] = Z257::new(lanes[lane] as u16);
+            lane += 1
         }
         byte_index += 1
     }
+    Polynomial::new(coefficients)
+}
 
-    // instantiate input polynomials
+/// Parses input block of $16$ binary polynomials
+pub const fn parse_input_block(input: &[u8; INPUT_BLOCK_SIZE]) -> SwifftInput {
     let mut input_polynomials: [Polynomial; M] = [Polynomial::ZERO; M];
     let mut i = 0; while i < M {
-        input_polynomials[i] = Polynomial::new(input_coefficients[i]);
+        input_polynomials[i] = parse_input_polynomial(input, i);
         i += 1
     }
     input_polynomials
 }
 
+/// Returns the bytes of a digest, see [`OUTPUT_BLOCK_SIZE`]
+pub fn digest_bytes(digest: &Polynomial) -> [u8; OUTPUT_BLOCK_SIZE] {
+    let mut bytes = [0u8; OUTPUT_BLOCK_SIZE];
+    for (i, coefficient) in digest.coefficients().iter().enumerate() {
+        bytes[2*i..2*i+2].copy_from_slice(&coefficient.value().to_le_bytes())
+    }
+    bytes
+}
+
+/// Computes the digest of the [`M`] input polynomials whose Fourier coefficients are given by `fourier_coefficients`,
+/// in the evaluation domain, on the calling thread
+#[inline(always)]
+fn hash_fourier_sequential(fourier_coefficients: impl Fn(usize) -> Coefficients) -> FourierDigest {
+    // accumulate the products A_i * X_i in the Fourier coefficients representation without reducing them,
+    // as M products of elements of Z_257 fit in u32
+    let mut accumulator = [0u32; Polynomial::N];
+    for i in 0..M {
+        let fourier_coefficients = fourier_coefficients(i);
+        for j in 0..Polynomial::N {
+            accumulator[j] += fourier_coefficients[j].value() as u32
+                * MULTIPLIER_FOURIER_COEFFICIENTS[i][j].value() as u32
+        }
+    }
+    FourierDigest::new(Polynomial::new(accumulator.map(|sum| Z257::from_u64(sum as u64))))
+}
+
 // SWIFFT HASH FUNCTION
 /// Type alias representing the input to the SWIFFT hash function
 pub type SwifftInput = [Polynomial; M];
 
-/// Standard SWIFFT hash function, processing a single input
+/// Standard SWIFFT hash function, processing a single input on the calling thread
 pub fn swifft_hash(input: &SwifftInput) -> Polynomial {
-    // Compute 16 individual Polynomial products A_i * X_i
-    // in the Fourier coefficients representation
-    let mut product_fourier_coefficients = input.clone();
-    product_fourier_coefficients.par_iter_mut().enumerate()
-        .for_each(|(i, input)| {
-            // compute Fourier coefficients of input
-            input.fourier_coefficients_assign();
-
-            // compute hadamard product of input and multiplier Fourier coefficients
-            input.hadamard_product_assign(&MULTIPLIER_FOURIER_COEFFICIENTS[i]);
-        });
-    
-    // Compute linear combination of those products
-    let mut digest = Polynomial::ZERO;
-    for product in product_fourier_coefficients {
-        digest += product
-    }
-    
-    // interpolate resulting Fourier coefficients,
-    // and return result
-    digest.interpolate_fourier_coefficients_assign();
-    digest
+    swifft_hash_fourier(input).finalize()
+}
+
+/// SWIFFT hash function in the evaluation domain, processing a single input on the calling thread.
+/// Digests are combined as [`FourierDigest`]s and interpolated once by [`FourierDigest::finalize`]
+pub fn swifft_hash_fourier(input: &SwifftInput) -> FourierDigest {
+    hash_fourier_sequential(|i| *input[i].fourier_coefficients().coefficients())
+}
+
+/// Standard SWIFFT hash function, processing a single input block on the calling thread,
+/// transforming each of its polynomials straight from its bytes
+pub fn swifft_hash_bytes(input: &[u8; INPUT_BLOCK_SIZE]) -> Polynomial {
+    swifft_hash_bytes_fourier(input).finalize()
+}
+
+/// SWIFFT hash function in the evaluation domain, processing a single input block on the calling thread,
+/// see [`swifft_hash_fourier`]. The bytes of each polynomial are fed to the transform directly, see [`ntt::forward_bits`]
+pub fn swifft_hash_bytes_fourier(input: &[u8; INPUT_BLOCK_SIZE]) -> FourierDigest {
+    hash_fourier_sequential(|i| ntt::forward_bits(input_polynomial_bytes(input, i)))
+}
+
+/// Standard SWIFFT hash function, processing a batch of inputs in parallel,
+/// with each input hashed on one thread.
+/// Panics if the numbers of inputs and digests differ
+pub fn swifft_hash_batch(inputs: &[SwifftInput], digests: &mut [Polynomial]) {
+    assert_eq!(inputs.len(), digests.len(), "numbers of inputs and digests differ");
+    inputs.par_iter().zip(digests.par_iter_mut()).with_min_len(BATCH_MIN_LEN)
+        .for_each(|(input, digest)| *digest = swifft_hash(input));
+}
+
+/// Standard SWIFFT hash function, processing a batch of input blocks in parallel into the bytes of their digests,
+/// with each input hashed on one thread.
+/// Panics if the numbers of inputs and digests differ
+pub fn swifft_hash_bytes_batch(inputs: &[[u8; INPUT_BLOCK_SIZE]], digests: &mut [[u8; OUTPUT_BLOCK_SIZE]]) {
+    assert_eq!(inputs.len(), digests.len(), "numbers of inputs and digests differ");
+    inputs.par_iter().zip(digests.par_iter_mut()).with_min_len(BATCH_MIN_LEN)
+        .for_each(|(input, digest)| *digest = digest_bytes(&swifft_hash_bytes(input)));
 }
 
 // PRECOMPUTED CONSTANTS
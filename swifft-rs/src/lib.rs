@@ -1,4 +1,6 @@
+pub mod digest;
 pub mod multiplier;
 pub mod hash;
+pub mod ntt;
 pub mod polynomial;
 pub mod z257;
\ No newline at end of file
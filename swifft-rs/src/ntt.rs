@@ -0,0 +1,530 @@
+//! Dedicated negacyclic number-theoretic transform (NTT) of [`Polynomial::N`] coefficients over $\mathbb{Z}_{257}$
+//!
+//! The forward transform evaluates a polynomial of $\mathbb{Z}\_{257}\[\alpha\]/(\alpha^{64}+1)$ at the
+//! odd powers of [`Z257::OMEGA_ORDER_128`], the same as the generic FFT of `halo2_proofs` after twisting by
+//! [`Polynomial::OMEGA_ORDER_128_POWERS`], but the twist is folded into the twiddle factors.
+//!
+//! The coefficients are held as `i16` in eight vectors of eight lanes, one per row of an $8 \times 8$ matrix.
+//! The first three layers of butterflies operate on whole rows, and after a transpose, so do the last three.
+//! Elements are reduced modulo $257 = 2^8 + 1$ by $x \mapsto (x \mathbin{\\&} 255) - (x \gg 8)$, as in
+//! `SWIFFT_qReduce` of LibSWIFFT, instead of by division, and stay in $[-2, 257]$ between layers.
+
+use crate::polynomial::{Coefficients, Polynomial};
+use crate::z257::Z257;
+
+// VECTOR OPERATIONS
+/// Operations on a vector of eight `i16` lanes, that the transform is written in
+trait Lanes: Copy {
+    /// Loads a vector from eight lanes
+    fn load(lanes: &[i16; 8]) -> Self;
+
+    /// Stores a vector to eight lanes
+    fn store(self, lanes: &mut [i16; 8]);
+
+    fn add(self, rhs: Self) -> Self;
+
+    fn sub(self, rhs: Self) -> Self;
+
+    /// Multiplies lane-wise, keeping the low 16 bits of the products
+    fn mul(self, rhs: Self) -> Self;
+
+    /// Reduces lane-wise from $[-2^{15}, 2^{15})$ to $[-128, 383]$, or to $[-2, 257]$ from $[-512, 767]$
+    fn reduce(self) -> Self;
+
+    /// Centers lane-wise from $[-2, 257]$ to $[-128, 128]$
+    fn center(self) -> Self;
+
+    /// Normalises lane-wise from $[-2, 257]$ to $[0, 256]$
+    fn normalise(self) -> Self;
+
+    /// Transposes the $8 \times 8$ matrix whose rows are the given vectors
+    fn transpose(rows: &mut [Self; 8]);
+}
+
+/// A vector of eight `i16` lanes, in portable code that compilers vectorise
+#[derive(Clone, Copy)]
+#[allow(dead_code)]
+struct Portable([i16; 8]);
+
+impl Portable {
+    #[inline(always)]
+    fn map(self, f: impl Fn(i16) -> i16) -> Self {
+        let mut lanes = self.0;
+        for lane in lanes.iter_mut() {
+            *lane = f(*lane)
+        }
+        Self(lanes)
+    }
+
+    #[inline(always)]
+    fn zip(self, rhs: Self, f: impl Fn(i16, i16) -> i16) -> Self {
+        let mut lanes = self.0;
+        for i in 0..8 {
+            lanes[i] = f(lanes[i], rhs.0[i])
+        }
+        Self(lanes)
+    }
+}
+
+impl Lanes for Portable {
+    #[inline(always)]
+    fn load(lanes: &[i16; 8]) -> Self { Self(*lanes) }
+
+    #[inline(always)]
+    fn store(self, lanes: &mut [i16; 8]) { *lanes = self.0 }
+
+    #[inline(always)]
+    fn add(self, rhs: Self) -> Self { self.zip(rhs, i16::wrapping_add) }
+
+    #[inline(always)]
+    fn sub(self, rhs: Self) -> Self { self.zip(rhs, i16::wrapping_sub) }
+
+    #[inline(always)]
+    fn mul(self, rhs: Self) -> Self { self.zip(rhs, i16::wrapping_mul) }
+
+    #[inline(always)]
+    fn reduce(self) -> Self { self.map(|x| (x & 0xff) - (x >> 8)) }
+
+    #[inline(always)]
+    fn center(self) -> Self { self.map(|x| if x > 128 { x - 257 } else { x }) }
+
+    #[inline(always)]
+    fn normalise(self) -> Self {
+        self.map(|x| {
+            let x = if x < 0 { x + 257 } else { x };
+            if x > 256 { x - 257 } else { x }
+        })
+    }
+
+    #[inline(always)]
+    fn transpose(rows: &mut [Self; 8]) {
+        for i in 0..8 {
+            for j in i+1..8 {
+                let lane = rows[i].0[j];
+                rows[i].0[j] = rows[j].0[i];
+                rows[j].0[i] = lane;
+            }
+        }
+    }
+}
+
+/// A vector of eight `i16` lanes in an SSE2 register, which every `x86_64` processor has
+#[cfg(target_arch = "x86_64")]
+#[derive(Clone, Copy)]
+struct Sse2(std::arch::x86_64::__m128i);
+
+#[cfg(target_arch = "x86_64")]
+impl Lanes for Sse2 {
+    #[inline(always)]
+    fn load(lanes: &[i16; 8]) -> Self {
+        use std::arch::x86_64::*;
+        unsafe { Self(_mm_loadu_si128(lanes.as_ptr() as *const __m128i)) }
+    }
+
+    #[inline(always)]
+    fn store(self, lanes: &mut [i16; 8]) {
+        use std::arch::x86_64::*;
+        unsafe { _mm_storeu_si128(lanes.as_mut_ptr() as *mut __m128i, self.0) }
+    }
+
+    #[inline(always)]
+    fn add(self, rhs: Self) -> Self {
+        unsafe { Self(std::arch::x86_64::_mm_add_epi16(self.0, rhs.0)) }
+    }
+
+    #[inline(always)]
+    fn sub(self, rhs: Self) -> Self {
+        unsafe { Self(std::arch::x86_64::_mm_sub_epi16(self.0, rhs.0)) }
+    }
+
+    #[inline(always)]
+    fn mul(self, rhs: Self) -> Self {
+        unsafe { Self(std::arch::x86_64::_mm_mullo_epi16(self.0, rhs.0)) }
+    }
+
+    #[inline(always)]
+    fn reduce(self) -> Self {
+        use std::arch::x86_64::*;
+        unsafe { Self(_mm_sub_epi16(_mm_and_si128(self.0, _mm_set1_epi16(0xff)), _mm_srai_epi16::<8>(self.0))) }
+    }
+
+    #[inline(always)]
+    fn center(self) -> Self {
+        use std::arch::x86_64::*;
+        unsafe {
+            let above = _mm_cmpgt_epi16(self.0, _mm_set1_epi16(128));
+            Self(_mm_sub_epi16(self.0, _mm_and_si128(above, _mm_set1_epi16(257))))
+        }
+    }
+
+    #[inline(always)]
+    fn normalise(self) -> Self {
+        use std::arch::x86_64::*;
+        unsafe {
+            let p = _mm_set1_epi16(257);
+            let x = _mm_add_epi16(self.0, _mm_and_si128(_mm_cmplt_epi16(self.0, _mm_setzero_si128()), p));
+            Self(_mm_sub_epi16(x, _mm_and_si128(_mm_cmpgt_epi16(x, _mm_set1_epi16(256)), p)))
+        }
+    }
+
+    #[inline(always)]
+    fn transpose(rows: &mut [Self; 8]) {
+        use std::arch::x86_64::*;
+        unsafe {
+            let r = rows.map(|row| row.0);
+            let t0 = _mm_unpacklo_epi16(r[0], r[1]);
+            let t1 = _mm_unpackhi_epi16(r[0], r[1]);
+            let t2 = _mm_unpacklo_epi16(r[2], r[3]);
+            let t3 = _mm_unpackhi_epi16(r[2], r[3]);
+            let t4 = _mm_unpacklo_epi16(r[4], r[5]);
+            let t5 = _mm_unpackhi_epi16(r[4], r[5]);
+            let t6 = _mm_unpacklo_epi16(r[6], r[7]);
+            let t7 = _mm_unpackhi_epi16(r[6], r[7]);
+            let u0 = _mm_unpacklo_epi32(t0, t2);
+            let u1 = _mm_unpackhi_epi32(t0, t2);
+            let u2 = _mm_unpacklo_epi32(t1, t3);
+            let u3 = _mm_unpackhi_epi32(t1, t3);
+            let u4 = _mm_unpacklo_epi32(t4, t6);
+            let u5 = _mm_unpackhi_epi32(t4, t6);
+            let u6 = _mm_unpacklo_epi32(t5, t7);
+            let u7 = _mm_unpackhi_epi32(t5, t7);
+            *rows = [
+                Self(_mm_unpacklo_epi64(u0, u4)), Self(_mm_unpackhi_epi64(u0, u4)),
+                Self(_mm_unpacklo_epi64(u1, u5)), Self(_mm_unpackhi_epi64(u1, u5)),
+                Self(_mm_unpacklo_epi64(u2, u6)), Self(_mm_unpackhi_epi64(u2, u6)),
+                Self(_mm_unpacklo_epi64(u3, u7)), Self(_mm_unpackhi_epi64(u3, u7)),
+            ];
+        }
+    }
+}
+
+/// The vector type the transform runs on
+#[cfg(target_arch = "x86_64")]
+type Vector = Sse2;
+
+/// The vector type the transform runs on
+#[cfg(not(target_arch = "x86_64"))]
+type Vector = Portable;
+
+// TRANSFORM KERNELS
+/// Reverses the order of the 3 low bits of `i`
+const fn bit_reverse_3(i: usize) -> usize {
+    ((i & 1) << 2) | (i & 2) | ((i >> 2) & 1)
+}
+
+/// Reverses the order of the 6 low bits of `i`
+const fn bit_reverse_6(i: usize) -> usize {
+    (bit_reverse_3(i & 7) << 3) | bit_reverse_3(i >> 3)
+}
+
+/// Reorders rows by reversing the bits of their index, which is its own inverse
+#[inline(always)]
+fn bit_reverse_rows<V: Lanes>(rows: &[V; 8]) -> [V; 8] {
+    [rows[0], rows[4], rows[2], rows[6], rows[1], rows[5], rows[3], rows[7]]
+}
+
+/// Computes a Cooley-Tukey butterfly, $(u, v) \mapsto (u + wv, u - wv)$
+#[inline(always)]
+fn ct_butterfly<V: Lanes>(u: &mut V, v: &mut V, w: V) {
+    let t = v.center().mul(w).reduce();
+    *v = u.sub(t).reduce();
+    *u = u.add(t).reduce();
+}
+
+/// Computes a Gentleman-Sande butterfly, $(u, v) \mapsto (u + v, w(u - v))$
+#[inline(always)]
+fn gs_butterfly<V: Lanes>(u: &mut V, v: &mut V, w: V) {
+    let d = u.sub(*v).reduce();
+    *u = u.add(*v).reduce();
+    *v = d.center().mul(w).reduce().reduce();
+}
+
+/// Computes the forward transform of rows of coefficients in $[-2, 257]$, in place,
+/// into rows of Fourier coefficients in $[0, 256]$
+#[inline(always)]
+fn forward<V: Lanes>(rows: &mut [V; 8]) {
+    // layers between rows, with one twiddle factor per butterfly
+    for layer in 0..3 {
+        let distance = 4 >> layer;
+        for row in 0..8 {
+            if row & distance == 0 {
+                let (mut u, mut v) = (rows[row], rows[row + distance]);
+                ct_butterfly(&mut u, &mut v, V::load(&ROW_TWIDDLES[layer][row / (2 * distance)]));
+                rows[row] = u;
+                rows[row + distance] = v;
+            }
+        }
+    }
+    // layers within rows, as layers between the rows of the transpose, with one twiddle factor per lane
+    let mut columns = bit_reverse_rows(rows);
+    V::transpose(&mut columns);
+    for layer in 0..3 {
+        let distance = 4 >> layer;
+        for column in 0..8 {
+            if column & distance == 0 {
+                let (mut u, mut v) = (columns[column], columns[column + distance]);
+                ct_butterfly(&mut u, &mut v, V::load(&LANE_TWIDDLES[layer][column / (2 * distance)]));
+                columns[column] = u;
+                columns[column + distance] = v;
+            }
+        }
+    }
+    // the Fourier coefficients are in bit-reversed order, which reversing the columns undoes
+    *rows = bit_reverse_rows(&columns).map(|row| row.normalise());
+}
+
+/// Computes the inverse transform of rows of Fourier coefficients in $[0, 256]$, in place,
+/// into rows of coefficients in $[0, 256]$
+#[inline(always)]
+fn inverse<V: Lanes>(rows: &mut [V; 8]) {
+    let mut columns = bit_reverse_rows(rows);
+    for layer in (0..3).rev() {
+        let distance = 4 >> layer;
+        for column in 0..8 {
+            if column & distance == 0 {
+                let (mut u, mut v) = (columns[column], columns[column + distance]);
+                gs_butterfly(&mut u, &mut v, V::load(&LANE_TWIDDLES_INV[layer][column / (2 * distance)]));
+                columns[column] = u;
+                columns[column + distance] = v;
+            }
+        }
+    }
+    V::transpose(&mut columns);
+    *rows = bit_reverse_rows(&columns);
+    for layer in (0..3).rev() {
+        let distance = 4 >> layer;
+        for row in 0..8 {
+            if row & distance == 0 {
+                let (mut u, mut v) = (rows[row], rows[row + distance]);
+                gs_butterfly(&mut u, &mut v, V::load(&ROW_TWIDDLES_INV[layer][row / (2 * distance)]));
+                rows[row] = u;
+                rows[row + distance] = v;
+            }
+        }
+    }
+    // each layer doubled the coefficients, which $64^{-1} = -4$ undoes
+    let scale = V::load(&[-4; 8]);
+    *rows = rows.map(|row| row.center().mul(scale).reduce().normalise());
+}
+
+/// Views the coefficients of a polynomial as rows of lanes.
+/// [`Z257`] is a transparent `u16` below $257$, which an `i16` lane holds unchanged
+#[inline(always)]
+fn lanes(coefficients: &mut Coefficients) -> &mut [[i16; 8]; Polynomial::N / 8] {
+    unsafe { &mut *(coefficients as *mut Coefficients as *mut [[i16; 8]; Polynomial::N / 8]) }
+}
+
+// PUBLIC FUNCTIONS
+/// Evaluates the polynomial with the given coefficients at [`Polynomial::N`] ascending odd powers of
+/// [`Z257::OMEGA_ORDER_128`], which is $\omega_{128}, \omega_{128}^3, \dots, \omega_{128}^{127}$, in place
+pub fn forward_assign(coefficients: &mut Coefficients) {
+    let lanes = lanes(coefficients);
+    let mut rows = lanes.map(|row| Vector::load(&row));
+    forward(&mut rows);
+    // the lanes are normalised to $[0, 256]$, so they remain valid elements of $\mathbb{Z}_{257}$
+    for (row, lanes) in rows.iter().zip(lanes.iter_mut()) {
+        row.store(lanes)
+    }
+}
+
+/// Interpolates the Fourier coefficients given by [`forward_assign`] back into the coefficients of a polynomial, in place
+pub fn inverse_assign(coefficients: &mut Coefficients) {
+    let lanes = lanes(coefficients);
+    let mut rows = lanes.map(|row| Vector::load(&row));
+    inverse(&mut rows);
+    // the lanes are normalised to $[0, 256]$, so they remain valid elements of $\mathbb{Z}_{257}$
+    for (row, lanes) in rows.iter().zip(lanes.iter_mut()) {
+        row.store(lanes)
+    }
+}
+
+/// Evaluates the binary polynomial whose [`Polynomial::N`] coefficients are the bits of `bytes`, in ascending
+/// bit positions, as [`forward_assign`] does. Each byte is expanded into its row of lanes by [`BYTE_LANES`],
+/// so the polynomial is never parsed into coefficients first
+pub fn forward_bits(bytes: &[u8; Polynomial::N / 8]) -> Coefficients {
+    let mut rows = bytes.map(|byte| Vector::load(&BYTE_LANES[byte as usize]));
+    forward(&mut rows);
+    let mut coefficients = [Z257::ZERO; Polynomial::N];
+    // the lanes are normalised to $[0, 256]$, so they remain valid elements of $\mathbb{Z}_{257}$
+    for (row, lanes) in rows.iter().zip(lanes(&mut coefficients).iter_mut()) {
+        row.store(lanes)
+    }
+    coefficients
+}
+
+// PRECOMPUTED CONSTANTS
+/// The lanes of each byte, holding its bits in ascending bit positions
+pub const BYTE_LANES: [[i16; 8]; 256] = compute_byte_lanes();
+
+const fn compute_byte_lanes() -> [[i16; 8]; 256] {
+    let mut lanes = [[0i16; 8]; 256];
+    let mut byte = 0; while byte < 256 {
+        let mut bit = 0; while bit < 8 {
+            lanes[byte][bit] = ((byte >> bit) & 1) as i16;
+            bit += 1
+        }
+        byte += 1
+    }
+    lanes
+}
+
+/// The twiddle factor of butterfly block `k`, numbered from 1 across the layers, which is
+/// $\omega_{128}^{r}$ for the bit-reversal $r$ of `k`, or its inverse, centered to $[-128, 128]$
+const fn twiddle(k: usize, inverse: bool) -> i16 {
+    let mut power = Z257::OMEGA_ORDER_128.cn_pow(&Z257::new(bit_reverse_6(k) as u16));
+    if inverse {
+        power = power.cn_inv()
+    }
+    let value = power.value() as i16;
+    if value > 128 { value - 257 } else { value }
+}
+
+/// The twiddle factors of the layers between rows, one per butterfly block, broadcast to all lanes
+const ROW_TWIDDLES: [[[i16; 8]; 4]; 3] = compute_row_twiddles(false);
+
+/// The inverses of [`ROW_TWIDDLES`]
+const ROW_TWIDDLES_INV: [[[i16; 8]; 4]; 3] = compute_row_twiddles(true);
+
+const fn compute_row_twiddles(inverse: bool) -> [[[i16; 8]; 4]; 3] {
+    let mut twiddles = [[[0i16; 8]; 4]; 3];
+    let mut layer = 0; while layer < 3 {
+        let mut block = 0; while block < (1 << layer) {
+            twiddles[layer][block] = [twiddle((1 << layer) + block, inverse); 8];
+            block += 1
+        }
+        layer += 1
+    }
+    twiddles
+}
+
+/// The twiddle factors of the layers between the rows of the transpose, one per butterfly block,
+/// with the lane of each row of the original matrix, in bit-reversed order, holding its twiddle factor
+const LANE_TWIDDLES: [[[i16; 8]; 4]; 3] = compute_lane_twiddles(false);
+
+/// The inverses of [`LANE_TWIDDLES`]
+const LANE_TWIDDLES_INV: [[[i16; 8]; 4]; 3] = compute_lane_twiddles(true);
+
+const fn compute_lane_twiddles(inverse: bool) -> [[[i16; 8]; 4]; 3] {
+    let mut twiddles = [[[0i16; 8]; 4]; 3];
+    let mut layer = 0; while layer < 3 {
+        let mut block = 0; while block < (1 << layer) {
+            let mut lane = 0; while lane < 8 {
+                // the butterfly block of the row across layers 3 to 5 of the whole transform
+                let k = (8 << layer) + (bit_reverse_3(lane) << layer) + block;
+                twiddles[layer][block][lane] = twiddle(k, inverse);
+                lane += 1
+            }
+            block += 1
+        }
+        layer += 1
+    }
+    twiddles
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    /// Coefficients at the edges of the centered lanes, $0$, $128$, $-128 = 129$ and $256 = -1$
+    const EDGES: [u16; 5] = [0, 1, 128, 129, 256];
+
+    /// Polynomials of uniformly random coefficients, from a fixed xorshift seed
+    fn random_polynomials(n: usize) -> Vec<Polynomial> {
+        let mut state: u64 = 0x9e37_79b9_7f4a_7c15;
+        (0..n).map(|_| {
+            let mut coefficients = [0u16; Polynomial::N];
+            for coefficient in coefficients.iter_mut() {
+                state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+                *coefficient = (state % Z257::P as u64) as u16
+            }
+            Polynomial::from_coefficients(&coefficients)
+        }).collect()
+    }
+
+    /// Polynomials of constant edge coefficients, of each pair of them alternating,
+    /// and of a single edge coefficient at each position
+    fn edge_polynomials() -> Vec<Polynomial> {
+        let mut polynomials = Vec::new();
+        for &a in EDGES.iter() {
+            for &b in EDGES.iter() {
+                let coefficients: [u16; Polynomial::N] = core::array::from_fn(|i| if i % 2 == 0 { a } else { b });
+                polynomials.push(Polynomial::from_coefficients(&coefficients))
+            }
+            for position in 0..Polynomial::N {
+                let mut coefficients = [0u16; Polynomial::N];
+                coefficients[position] = a;
+                polynomials.push(Polynomial::from_coefficients(&coefficients))
+            }
+        }
+        polynomials
+    }
+
+    fn test_polynomials() -> Vec<Polynomial> {
+        let mut polynomials = edge_polynomials();
+        polynomials.extend(random_polynomials(256));
+        polynomials
+    }
+
+    /// The generic FFT of `halo2_proofs` of the coefficients twisted by [`Polynomial::OMEGA_ORDER_128_POWERS`]
+    fn reference_forward(polynomial: &Polynomial) -> Polynomial {
+        let mut coefficients = *polynomial.hadamard_product(&Polynomial::OMEGA_ORDER_128_POWERS).coefficients();
+        halo2_proofs::arithmetic::best_fft::<Z257, Z257>(&mut coefficients, Z257::OMEGA_ORDER_64, Polynomial::LOG2_N);
+        Polynomial::new(coefficients)
+    }
+
+    /// The inverse generic FFT of `halo2_proofs` of the Fourier coefficients, untwisted and normalised by
+    /// [`Polynomial::FOURIER_NORMALISATION_COEFFICIENTS`]
+    fn reference_inverse(polynomial: &Polynomial) -> Polynomial {
+        let mut coefficients = *polynomial.coefficients();
+        halo2_proofs::arithmetic::best_fft::<Z257, Z257>(&mut coefficients, Polynomial::OMEGA_ORDER_64_INV, Polynomial::LOG2_N);
+        Polynomial::new(coefficients).hadamard_product(&Polynomial::FOURIER_NORMALISATION_COEFFICIENTS)
+    }
+
+    #[test]
+    fn forward_matches_reference() {
+        for polynomial in test_polynomials() {
+            let mut actual = *polynomial.coefficients();
+            forward_assign(&mut actual);
+            assert_eq!(Polynomial::new(actual), reference_forward(&polynomial), "forward transform of {}", polynomial)
+        }
+    }
+
+    #[test]
+    fn inverse_matches_reference() {
+        for polynomial in test_polynomials() {
+            let mut actual = *polynomial.coefficients();
+            inverse_assign(&mut actual);
+            assert_eq!(Polynomial::new(actual), reference_inverse(&polynomial), "inverse transform of {}", polynomial)
+        }
+    }
+
+    #[test]
+    fn forward_bits_matches_forward() {
+        let mut state: u64 = 0x2545_f491_4f6c_dd1d;
+        let mut inputs: Vec<[u8; Polynomial::N / 8]> = (0..=255u8).map(|byte| [byte; Polynomial::N / 8]).collect();
+        inputs.extend((0..=255u8).map(|byte| core::array::from_fn(|i| byte.rotate_left(i as u32) ^ i as u8)));
+        inputs.extend((0..256).map(|_| {
+            state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+            state.to_le_bytes()
+        }));
+        for bytes in inputs {
+            let bits: [u16; Polynomial::N] = core::array::from_fn(|i| ((bytes[i / 8] >> (i % 8)) & 1) as u16);
+            let mut expected = *Polynomial::from_coefficients(&bits).coefficients();
+            forward_assign(&mut expected);
+            assert_eq!(Polynomial::new(forward_bits(&bytes)), Polynomial::new(expected), "forward transform of {:?}", bytes)
+        }
+    }
+
+    #[test]
+    fn round_trip() {
+        for polynomial in test_polynomials() {
+            let mut coefficients = *polynomial.coefficients();
+            forward_assign(&mut coefficients);
+            inverse_assign(&mut coefficients);
+            assert_eq!(Polynomial::new(coefficients), polynomial, "round trip of {}", polynomial);
+            inverse_assign(&mut coefficients);
+            forward_assign(&mut coefficients);
+            assert_eq!(Polynomial::new(coefficients), polynomial, "round trip of {}", polynomial)
+        }
+    }
+}
@@ -2,6 +2,7 @@ use std::fmt::{Debug, Display, Formatter};
 use std::iter::Sum;
 use std::ops::{Add, AddAssign, Index, Mul, MulAssign, Neg, Sub, SubAssign};
 
+use crate::ntt;
 use crate::z257::Z257;
 
 /// Element of polynomial quotient ring $\mathbb{Z}_{257}[\alpha]/(\alpha^{64} + 1)$
@@ -243,6 +244,14 @@ impl Polynomial {
     /// Equivalent to performing the isomorphism
     /// $$\left(\mathbb{Z}\_{257}\[\alpha\]/(\alpha^{64}+1), +, * \right) \cong \left(\mathbb{Z}_{257}^{64}, +, \circ \right)$$
     pub fn fourier_coefficients_assign(&mut self) {
+        // compute the negacyclic NTT, with the twist folded into its twiddle factors
+        ntt::forward_assign(&mut self.0);
+    }
+
+    /// Evaluates the polynomial at [`Polynomial::N`] ascending odd powers of [`Z257::OMEGA_ORDER_128`],
+    /// as [`Polynomial::fourier_coefficients_assign`] but using the generic FFT of `halo2_proofs`,
+    /// as a reference implementation
+    pub fn fourier_coefficients_assign_reference(&mut self) {
         // multiply point-wise by [`OMEGA_ORDER_128_POWERS`]
         // and compute [`N`]-dimensional FFT of the result
         self.hadamard_product_assign(&Self::OMEGA_ORDER_128_POWERS);
@@ -266,6 +275,14 @@ impl Polynomial {
     /// Equivalent to undoing the isomorphism
     /// $$\left(\mathbb{Z}\_{257}\[\alpha\]/(\alpha^{64}+1), +, * \right) \cong \left(\mathbb{Z}_{257}^{64}, +, \circ \right)$$
     pub fn interpolate_fourier_coefficients_assign(&mut self) {
+        // compute the inverse negacyclic NTT, with the twist and normalisation folded in
+        ntt::inverse_assign(&mut self.0);
+    }
+
+    /// Interpolates the Fourier coefficients back into a polynomial,
+    /// as [`Polynomial::interpolate_fourier_coefficients_assign`] but using the generic FFT of `halo2_proofs`,
+    /// as a reference implementation
+    pub fn interpolate_fourier_coefficients_assign_reference(&mut self) {
         // and compute [`N`]-dimensional inverse FFT of the result
         halo2_proofs::arithmetic::best_fft::<Z257, Z257>(
             &mut self.0, Self::OMEGA_ORDER_64_INV, Self::LOG2_N);